@@ -20,9 +20,14 @@ bool StructTraits<blink::mojom::TransferableMessage::DataView,
       !data.ReadArrayBufferContentsArray(&out->array_buffer_contents_array) ||
       !data.ReadImageBitmapContentsArray(&out->image_bitmap_contents_array) ||
       !data.ReadPorts(&ports) || !data.ReadStreamChannels(&stream_channels) ||
+      !data.ReadStreamDataPipes(&out->stream_data_pipes) ||
       !data.ReadUserActivation(&out->user_activation)) {
     return false;
   }
+  if (!out->stream_data_pipes.empty() &&
+      out->stream_data_pipes.size() != stream_channels.size()) {
+    return false;
+  }
 
   out->ports = blink::MessagePortChannel::CreateFromHandles(std::move(ports));
   out->stream_channels =
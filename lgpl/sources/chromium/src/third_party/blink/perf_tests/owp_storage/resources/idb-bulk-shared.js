@@ -0,0 +1,23 @@
+// Records modeling an offline cache: small structured values keyed by a
+// string, stored in bulk and read back with a full cursor scan.
+const bulkDatabaseName = 'bulk';
+const bulkStoreName = 'records';
+const bulkRecordCount = 20000;
+
+function createBulkRecord(i) {
+  return {
+    id: 'record-' + i.toString().padStart(8, '0'),
+    updated: 1577836800000 + i * 1000,
+    tags: ['cache', 'tag' + (i % 16)],
+    payload: 'x'.repeat(100 + (i % 7) * 50),
+  };
+}
+
+function createBulkStore(db) {
+  return db.createObjectStore(bulkStoreName, {keyPath: 'id'});
+}
+
+function putBulkRecords(store) {
+  for (let i = 0; i < bulkRecordCount; i++)
+    store.put(createBulkRecord(i));
+}
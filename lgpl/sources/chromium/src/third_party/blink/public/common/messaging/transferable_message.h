@@ -9,6 +9,7 @@
 
 #include "base/containers/span.h"
 #include "base/macros.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "third_party/blink/public/common/common_export.h"
 #include "third_party/blink/public/common/messaging/cloneable_message.h"
 #include "third_party/blink/public/common/messaging/message_port_channel.h"
@@ -30,6 +31,9 @@ struct BLINK_COMMON_EXPORT TransferableMessage : public CloneableMessage {
   std::vector<MessagePortChannel> ports;
   // Channels used by transferred WHATWG streams (eg. ReadableStream).
   std::vector<MessagePortChannel> stream_channels;
+  // Data pipes of transferred streams, parallel to |stream_channels|. See
+  // TransferableMessage in transferable_message.mojom.
+  std::vector<mojo::ScopedDataPipeConsumerHandle> stream_data_pipes;
   // The contents of any ArrayBuffers being transferred as part of this message.
   std::vector<mojom::SerializedArrayBufferContentsPtr>
       array_buffer_contents_array;
@@ -32,6 +32,11 @@ struct BLINK_COMMON_EXPORT
     return blink::MessagePortChannel::ReleaseHandles(input.stream_channels);
   }
 
+  static std::vector<mojo::ScopedDataPipeConsumerHandle> stream_data_pipes(
+      blink::TransferableMessage& input) {
+    return std::move(input.stream_data_pipes);
+  }
+
   static std::vector<blink::mojom::SerializedArrayBufferContentsPtr>
   array_buffer_contents_array(blink::TransferableMessage& input) {
     return std::move(input.array_buffer_contents_array);
@@ -0,0 +1,70 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/bindings/core/v8/v8_node_list.h"
+
+#include <algorithm>
+
+#include "third_party/blink/renderer/bindings/core/v8/v8_binding_for_core.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_node.h"
+#include "third_party/blink/renderer/core/dom/node.h"
+#include "third_party/blink/renderer/core/dom/node_list.h"
+#include "third_party/blink/renderer/platform/bindings/dom_data_store.h"
+#include "third_party/blink/renderer/platform/bindings/runtime_call_stats.h"
+#include "third_party/blink/renderer/platform/bindings/v8_dom_wrapper.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
+
+namespace blink {
+
+namespace {
+
+// Number of items that are wrapped together.
+constexpr unsigned kWrapperBatchSize = 64;
+
+// Creates the wrappers of the items from |index| on in one batch, if the item
+// before |index| already has a wrapper. That is the case when script iterates
+// over the list, e.g. over the result of querySelectorAll() or over
+// childNodes, but not for one-off lookups such as list[0].
+void WrapItemsFrom(v8::Isolate* isolate,
+                   v8::Local<v8::Object> holder,
+                   NodeList& list,
+                   unsigned index,
+                   unsigned length) {
+  if (!index)
+    return;
+  Node* previous = list.item(index - 1);
+  if (!previous || DOMDataStore::GetWrapper(previous, isolate).IsEmpty())
+    return;
+
+  RUNTIME_CALL_TIMER_SCOPE(isolate,
+                           RuntimeCallStats::CounterId::kCreateWrapper);
+  V8WrapperBatch batch(isolate, holder, V8Node::GetWrapperTypeInfo());
+  if (batch.AccessCheckFailed())
+    return;
+  unsigned end = std::min(length, index + kWrapperBatchSize);
+  for (unsigned i = index; i < end; ++i) {
+    if (Node* node = list.item(i))
+      batch.Wrap(node);
+  }
+}
+
+}  // namespace
+
+void V8NodeList::IndexedPropertyGetterCustom(
+    uint32_t index,
+    const v8::PropertyCallbackInfo<v8::Value>& info) {
+  NodeList* impl = V8NodeList::ToImpl(info.Holder());
+  unsigned length = impl->length();
+  if (index >= length)
+    return;  // Returns undefined due to out-of-range.
+
+  Node* result = impl->item(index);
+  if (RuntimeEnabledFeatures::NodeListWrapperBatchingEnabled() && result &&
+      DOMDataStore::GetWrapper(result, info.GetIsolate()).IsEmpty()) {
+    WrapItemsFrom(info.GetIsolate(), info.Holder(), *impl, index, length);
+  }
+  V8SetReturnValueFast(info, result, impl);
+}
+
+}  // namespace blink
@@ -0,0 +1,78 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/bindings/core/v8/v8_node_list.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/bindings/core/v8/to_v8_for_core.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_binding_for_testing.h"
+#include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/core/dom/node_list.h"
+#include "third_party/blink/renderer/core/html_names.h"
+#include "third_party/blink/renderer/platform/bindings/dom_data_store.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
+
+namespace blink {
+
+namespace {
+
+class V8NodeListCustomTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    Document& document = scope_.GetDocument();
+    Element* container = document.CreateRawElement(html_names::kDivTag);
+    for (int i = 0; i < 10; ++i)
+      container->AppendChild(document.CreateRawElement(html_names::kSpanTag));
+    list_ = container->childNodes();
+    wrapper_ = ToV8(list_.Get(), scope_.GetContext()->Global(),
+                    scope_.GetIsolate())
+                   .As<v8::Object>();
+  }
+
+  v8::Local<v8::Value> Get(uint32_t index) {
+    return wrapper_->Get(scope_.GetContext(), index).ToLocalChecked();
+  }
+
+  bool HasWrapper(unsigned index) {
+    return !DOMDataStore::GetWrapper(list_->item(index), scope_.GetIsolate())
+                .IsEmpty();
+  }
+
+  V8TestingScope scope_;
+  Persistent<NodeList> list_;
+  v8::Local<v8::Object> wrapper_;
+};
+
+TEST_F(V8NodeListCustomTest, WrapsItemsInBatchesWhenIterating) {
+  ScopedNodeListWrapperBatchingForTest batching(true);
+
+  // A one-off lookup only wraps the item looked up.
+  v8::Local<v8::Value> first = Get(0);
+  EXPECT_TRUE(HasWrapper(0));
+  EXPECT_FALSE(HasWrapper(1));
+
+  // Looking up the next item wraps the rest of the list.
+  Get(1);
+  for (unsigned i = 0; i < list_->length(); ++i)
+    EXPECT_TRUE(HasWrapper(i)) << i;
+
+  // The items keep the wrappers created for them.
+  EXPECT_EQ(first, Get(0));
+  EXPECT_EQ(ToV8(list_->item(5), wrapper_, scope_.GetIsolate()), Get(5));
+  EXPECT_TRUE(Get(list_->length())->IsUndefined());
+}
+
+TEST_F(V8NodeListCustomTest, WrapsItemsOneByOneWithoutBatching) {
+  ScopedNodeListWrapperBatchingForTest batching(false);
+
+  Get(0);
+  Get(1);
+  EXPECT_TRUE(HasWrapper(1));
+  EXPECT_FALSE(HasWrapper(2));
+}
+
+}  // namespace
+
+}  // namespace blink
@@ -12,14 +12,18 @@
 #include "third_party/blink/renderer/core/frame/frame.h"
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/imagebitmap/image_bitmap.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 
 namespace blink {
 
-scoped_refptr<SerializedScriptValue> PostMessageHelper::SerializeMessageByMove(
+namespace {
+
+scoped_refptr<SerializedScriptValue> SerializeMessageByMoveInternal(
     v8::Isolate* isolate,
     const ScriptValue& message,
     const PostMessageOptions* options,
     Transferables& transferables,
+    bool clone_array_buffers_out_of_band,
     ExceptionState& exception_state) {
   if (options->hasTransfer() && !options->transfer().IsEmpty()) {
     if (!SerializedScriptValue::ExtractTransferables(
@@ -30,6 +34,8 @@ scoped_refptr<SerializedScriptValue> PostMessageHelper::SerializeMessageByMove(
 
   SerializedScriptValue::SerializeOptions serialize_options;
   serialize_options.transferables = &transferables;
+  serialize_options.clone_array_buffers_out_of_band =
+      clone_array_buffers_out_of_band;
   scoped_refptr<SerializedScriptValue> serialized_message =
       SerializedScriptValue::Serialize(isolate, message.V8Value(),
                                        serialize_options, exception_state);
@@ -40,6 +46,31 @@ scoped_refptr<SerializedScriptValue> PostMessageHelper::SerializeMessageByMove(
   return serialized_message;
 }
 
+}  // namespace
+
+scoped_refptr<SerializedScriptValue> PostMessageHelper::SerializeMessageByMove(
+    v8::Isolate* isolate,
+    const ScriptValue& message,
+    const PostMessageOptions* options,
+    Transferables& transferables,
+    ExceptionState& exception_state) {
+  return SerializeMessageByMoveInternal(isolate, message, options,
+                                        transferables, false, exception_state);
+}
+
+scoped_refptr<SerializedScriptValue>
+PostMessageHelper::SerializeMessageToWorkerByMove(
+    v8::Isolate* isolate,
+    const ScriptValue& message,
+    const PostMessageOptions* options,
+    Transferables& transferables,
+    ExceptionState& exception_state) {
+  return SerializeMessageByMoveInternal(
+      isolate, message, options, transferables,
+      RuntimeEnabledFeatures::CloneArrayBuffersOutOfBandEnabled(),
+      exception_state);
+}
+
 scoped_refptr<SerializedScriptValue> PostMessageHelper::SerializeMessageByCopy(
     v8::Isolate* isolate,
     const ScriptValue& message,
@@ -34,6 +34,17 @@ class CORE_EXPORT PostMessageHelper {
       Transferables& transferables,
       ExceptionState&);
 
+  // Like SerializeMessageByMove(), for a message to a dedicated worker. The
+  // worker has a single world, so the message is deserialized once, and large
+  // cloned ArrayBuffers may be copied out of band, see
+  // SerializedScriptValue::SerializeOptions::clone_array_buffers_out_of_band.
+  static scoped_refptr<SerializedScriptValue> SerializeMessageToWorkerByMove(
+      v8::Isolate*,
+      const ScriptValue& message,
+      const PostMessageOptions* options,
+      Transferables& transferables,
+      ExceptionState&);
+
   static scoped_refptr<SerializedScriptValue> SerializeMessageByCopy(
       v8::Isolate*,
       const ScriptValue& message,
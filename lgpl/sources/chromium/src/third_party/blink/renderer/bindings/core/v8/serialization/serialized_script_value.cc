@@ -398,6 +398,20 @@ void SerializedScriptValue::TransferReadableStream(
     ReadableStream* readable_stream,
     ExceptionState& exception_state) {
   MessagePort* local_port = AddStreamChannel(execution_context);
+  if (RuntimeEnabledFeatures::TransferableStreamDataPipesEnabled()) {
+    mojo::ScopedDataPipeConsumerHandle data_pipe =
+        readable_stream->SerializeAsDataPipe(script_state, local_port,
+                                             exception_state);
+    if (exception_state.HadException())
+      return;
+    if (data_pipe.is_valid()) {
+      // Entries for the streams before this one stay null, as they are
+      // transferred chunk by chunk.
+      stream_data_pipes_.resize(stream_channels_.size());
+      stream_data_pipes_.back() = std::move(data_pipe);
+      return;
+    }
+  }
   readable_stream->Serialize(script_state, local_port, exception_state);
   if (exception_state.HadException())
     return;
@@ -452,6 +466,8 @@ MessagePort* SerializedScriptValue::AddStreamChannel(
   auto* local_port = MakeGarbageCollected<MessagePort>(*execution_context);
   local_port->Entangle(pipe.TakePort0());
   stream_channels_.push_back(MessagePortChannel(pipe.TakePort1()));
+  if (!stream_data_pipes_.IsEmpty())
+    stream_data_pipes_.resize(stream_channels_.size());
   return local_port;
 }
 
@@ -463,6 +479,23 @@ void SerializedScriptValue::TransferArrayBuffers(
       TransferArrayBufferContents(isolate, array_buffers, exception_state);
 }
 
+bool SerializedScriptValue::CloneArrayBuffersOutOfBand(
+    const ArrayBufferArray& array_buffers,
+    wtf_size_t first_index) {
+  DCHECK_LE(array_buffer_contents_array_.size(), first_index);
+  array_buffer_contents_array_.Grow(first_index + array_buffers.size());
+  for (wtf_size_t i = 0; i < array_buffers.size(); i++) {
+    DOMArrayBufferBase* array_buffer = array_buffers[i];
+    DCHECK(!array_buffer->IsShared());
+    ArrayBufferContents& contents =
+        array_buffer_contents_array_[first_index + i];
+    array_buffer->Content()->CopyTo(contents);
+    if (!contents.IsValid())
+      return false;
+  }
+  return true;
+}
+
 void SerializedScriptValue::CloneSharedArrayBuffers(
     SharedArrayBufferArray& array_buffers) {
   if (!array_buffers.size())
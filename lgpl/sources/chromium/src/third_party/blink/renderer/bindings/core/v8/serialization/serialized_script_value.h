@@ -36,6 +36,7 @@
 #include "base/containers/span.h"
 #include "base/optional.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "third_party/blink/public/common/messaging/message_port_channel.h"
 #include "third_party/blink/public/mojom/native_file_system/native_file_system_transfer_token.mojom-blink-forward.h"
 #include "third_party/blink/renderer/bindings/core/v8/native_value_traits.h"
@@ -78,6 +79,7 @@ class CORE_EXPORT SerializedScriptValue
   using ImageBitmapContentsArray = Vector<scoped_refptr<StaticBitmapImage>, 1>;
   using TransferredWasmModulesArray = WTF::Vector<v8::CompiledWasmModule>;
   using MessagePortChannelArray = Vector<MessagePortChannel>;
+  using StreamDataPipeArray = Vector<mojo::ScopedDataPipeConsumerHandle>;
   using NativeFileSystemTokensArray =
       Vector<mojo::PendingRemote<mojom::blink::NativeFileSystemTransferToken>>;
 
@@ -143,7 +145,20 @@ class CORE_EXPORT SerializedScriptValue
     WebBlobInfoArray* blob_info = nullptr;
     WasmSerializationPolicy wasm_policy = kTransfer;
     StoragePolicy for_storage = kNotForStorage;
+    // Whether large ArrayBuffers which are cloned rather than transferred may
+    // be copied into their own contents, next to the transferred ones, instead
+    // of into the wire data. The receiver then adopts the copy as is. Only for
+    // values which are sent with their ArrayBuffer contents, e.g. in a
+    // TransferableMessage, and deserialized once: a second deserialization,
+    // e.g. of a MessageEvent's data in another world, would share the copy
+    // with the first, as it does transferred ArrayBuffers.
+    bool clone_array_buffers_out_of_band = false;
   };
+
+  // ArrayBuffers at least this large are cloned out of band, see
+  // SerializeOptions::clone_array_buffers_out_of_band.
+  static constexpr size_t kOutOfBandArrayBufferCloneThreshold = 1024 * 1024;
+
   static scoped_refptr<SerializedScriptValue> Serialize(v8::Isolate*,
                                                         v8::Local<v8::Value>,
                                                         const SerializeOptions&,
@@ -267,6 +282,10 @@ class CORE_EXPORT SerializedScriptValue
 
   MessagePortChannelArray& GetStreamChannels() { return stream_channels_; }
 
+  // Either empty, or parallel to GetStreamChannels(). A valid entry holds the
+  // bytes of a transferred stream, whose channel only reports its end.
+  StreamDataPipeArray& GetStreamDataPipes() { return stream_data_pipes_; }
+
   bool IsLockedToAgentCluster() const {
     return !wasm_modules_.IsEmpty() ||
            !shared_array_buffers_contents_.IsEmpty() ||
@@ -327,6 +346,11 @@ class CORE_EXPORT SerializedScriptValue
   void TransferArrayBuffers(v8::Isolate*,
                             const ArrayBufferArray&,
                             ExceptionState&);
+  // Copies |array_buffers| into the contents array, starting at |first_index|,
+  // leaving the source buffers untouched. Returns false if memory could not be
+  // allocated for a copy.
+  bool CloneArrayBuffersOutOfBand(const ArrayBufferArray& array_buffers,
+                                  wtf_size_t first_index);
   void TransferImageBitmaps(v8::Isolate*,
                             const ImageBitmapArray&,
                             ExceptionState&);
@@ -363,8 +387,9 @@ class CORE_EXPORT SerializedScriptValue
   ImageBitmapContentsArray image_bitmap_contents_array_;
 
   // |stream_channels_| is also single-use but is special-cased because it works
-  // with ServiceWorkers.
+  // with ServiceWorkers. |stream_data_pipes_| travels with it.
   MessagePortChannelArray stream_channels_;
+  StreamDataPipeArray stream_data_pipes_;
 
   // These do not have one-use transferred contents, like the above.
   TransferredWasmModulesArray wasm_modules_;
@@ -11,6 +11,7 @@
 #include "third_party/blink/renderer/bindings/core/v8/worker_or_worklet_script_controller.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/typed_arrays/dom_array_buffer.h"
+#include "third_party/blink/renderer/core/typed_arrays/dom_typed_array.h"
 #include "third_party/blink/renderer/core/workers/worker_thread_test_helper.h"
 #include "third_party/blink/renderer/platform/bindings/exception_state.h"
 #include "third_party/blink/renderer/platform/bindings/to_v8.h"
@@ -84,4 +85,68 @@ TEST(SerializedScriptValueThreadedTest,
   worker_thread.WaitForShutdownForTesting();
 }
 
+// Posts a large typed array to a worker without transferring it, with and
+// without out of band cloning. Either way, the worker gets the contents and the
+// sender keeps its own buffer.
+TEST(SerializedScriptValueThreadedTest, CloneLargeTypedArrayToWorker) {
+  constexpr size_t kMessageSize =
+      2 * SerializedScriptValue::kOutOfBandArrayBufferCloneThreshold;
+  V8TestingScope scope;
+
+  WorkerReportingProxy proxy;
+  WorkerThreadForTest worker_thread(proxy);
+  worker_thread.StartWithSourceCode(scope.GetDocument().GetSecurityOrigin(),
+                                    "/* no worker script */");
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner =
+      worker_thread.GetWorkerBackingThread().BackingThread().GetTaskRunner();
+
+  DOMUint8Array* pixels = DOMUint8Array::Create(kMessageSize);
+  memset(pixels->Data(), 42, kMessageSize);
+  v8::Local<v8::Value> message =
+      ToV8(pixels, scope.GetContext()->Global(), scope.GetIsolate());
+
+  for (bool out_of_band : {false, true}) {
+    SerializedScriptValue::SerializeOptions options;
+    options.clone_array_buffers_out_of_band = out_of_band;
+    scoped_refptr<SerializedScriptValue> serialized =
+        SerializedScriptValue::Serialize(scope.GetIsolate(), message, options,
+                                         ASSERT_NO_EXCEPTION);
+    EXPECT_FALSE(pixels->IsDetached());
+    EXPECT_EQ(out_of_band ? 1u : 0u,
+              serialized->GetArrayBufferContentsArray().size());
+
+    base::WaitableEvent done;
+    PostCrossThreadTask(
+        *task_runner, FROM_HERE,
+        CrossThreadBindOnce(
+            [](WorkerThread* worker_thread,
+               scoped_refptr<SerializedScriptValue> serialized,
+               size_t expected_size, base::WaitableEvent* done) {
+              WorkerOrWorkletScriptController* script =
+                  worker_thread->GlobalScope()->ScriptController();
+              ScriptState::Scope worker_scope(script->GetScriptState());
+              v8::Local<v8::Value> value =
+                  SerializedScriptValue::Unpack(std::move(serialized))
+                      ->Deserialize(worker_thread->GetIsolate());
+              EXPECT_TRUE(value->IsUint8Array());
+              if (value->IsUint8Array()) {
+                v8::Local<v8::Uint8Array> array = value.As<v8::Uint8Array>();
+                EXPECT_EQ(expected_size, array->Length());
+                uint8_t bytes[2] = {};
+                array->CopyContents(bytes, sizeof(bytes));
+                EXPECT_EQ(42, bytes[0]);
+                EXPECT_EQ(42, bytes[1]);
+              }
+              done->Signal();
+            },
+            CrossThreadUnretained(&worker_thread), std::move(serialized),
+            kMessageSize, CrossThreadUnretained(&done)));
+    done.Wait();
+    EXPECT_EQ(42, pixels->Data()[kMessageSize - 1]);
+  }
+
+  worker_thread.Terminate();
+  worker_thread.WaitForShutdownForTesting();
+}
+
 }  // namespace blink
@@ -13,6 +13,7 @@
 #include "third_party/blink/renderer/bindings/core/v8/v8_dom_point_init.h"
 #include "third_party/blink/renderer/core/dom/dom_exception.h"
 #include "third_party/blink/renderer/core/execution_context/execution_context.h"
+#include "third_party/blink/renderer/core/fetch/body_stream_buffer.h"
 #include "third_party/blink/renderer/core/fileapi/blob.h"
 #include "third_party/blink/renderer/core/fileapi/file.h"
 #include "third_party/blink/renderer/core/fileapi/file_list.h"
@@ -553,9 +554,16 @@ ScriptWrappable* V8ScriptValueDeserializer::ReadDOMObject(
           index >= transferred_stream_ports_->size()) {
         return nullptr;
       }
-      return ReadableStream::Deserialize(
-          script_state_, (*transferred_stream_ports_)[index].Get(),
-          exception_state);
+      MessagePort* port = (*transferred_stream_ports_)[index].Get();
+      auto& stream_data_pipes = serialized_script_value_->GetStreamDataPipes();
+      if (index < stream_data_pipes.size() &&
+          stream_data_pipes[index].is_valid()) {
+        // The bytes of the stream come in a data pipe; |port| only carries its
+        // end.
+        return BodyStreamBuffer::CreateStreamForTransferredDataPipe(
+            script_state_, std::move(stream_data_pipes[index]), port);
+      }
+      return ReadableStream::Deserialize(script_state_, port, exception_state);
     }
     case kWritableStreamTransferTag: {
       if (!TransferableStreamsEnabled())
@@ -8,6 +8,7 @@
 #include "third_party/blink/public/mojom/web_feature/web_feature.mojom-blink.h"
 #include "third_party/blink/public/platform/web_blob_info.h"
 #include "third_party/blink/renderer/bindings/core/v8/to_v8_for_core.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_array_buffer.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_blob.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_dom_exception.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_dom_matrix.h"
@@ -42,7 +43,10 @@
 #include "third_party/blink/renderer/core/streams/readable_stream.h"
 #include "third_party/blink/renderer/core/streams/transform_stream.h"
 #include "third_party/blink/renderer/core/streams/writable_stream.h"
+#include "third_party/blink/renderer/core/typed_arrays/dom_array_buffer.h"
 #include "third_party/blink/renderer/core/typed_arrays/dom_array_buffer_base.h"
+#include "third_party/blink/renderer/platform/bindings/v8_binding.h"
+#include "third_party/blink/renderer/platform/bindings/v8_dom_wrapper.h"
 #include "third_party/blink/renderer/platform/file_metadata.h"
 #include "third_party/blink/renderer/platform/instrumentation/use_counter.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
@@ -52,6 +56,33 @@
 
 namespace blink {
 
+namespace {
+
+// Bounds the number of properties looked at when scanning a value for large
+// ArrayBuffers to clone out of band.
+constexpr uint32_t kMaxOutOfBandScanProperties = 64;
+
+// Returns false if |value| is neither an ArrayBuffer nor a view. Otherwise,
+// |array_buffer| is the underlying buffer, or empty if there is none yet.
+bool GetArrayBuffer(v8::Local<v8::Value> value,
+                    v8::Local<v8::ArrayBuffer>* array_buffer) {
+  if (value->IsArrayBuffer()) {
+    *array_buffer = value.As<v8::ArrayBuffer>();
+    return true;
+  }
+  if (value->IsArrayBufferView()) {
+    v8::Local<v8::ArrayBufferView> view = value.As<v8::ArrayBufferView>();
+    // Small typed arrays are allocated on the V8 heap, don't materialize a
+    // buffer for them.
+    *array_buffer = view->HasBuffer() ? view->Buffer()
+                                      : v8::Local<v8::ArrayBuffer>();
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 // The "Blink-side" serialization version, which defines how Blink will behave
 // during the serialization process, is in
 // SerializedScriptValue::wireFormatVersion. The serialization format has two
@@ -77,7 +108,9 @@ V8ScriptValueSerializer::V8ScriptValueSerializer(ScriptState* script_state,
       transferables_(options.transferables),
       blob_info_array_(options.blob_info),
       wasm_policy_(options.wasm_policy),
-      for_storage_(options.for_storage == SerializedScriptValue::kForStorage) {}
+      for_storage_(options.for_storage == SerializedScriptValue::kForStorage),
+      clone_array_buffers_out_of_band_(
+          options.clone_array_buffers_out_of_band) {}
 
 scoped_refptr<SerializedScriptValue> V8ScriptValueSerializer::Serialize(
     v8::Local<v8::Value> value,
@@ -94,6 +127,7 @@ scoped_refptr<SerializedScriptValue> V8ScriptValueSerializer::Serialize(
   PrepareTransfer(exception_state);
   if (exception_state.HadException())
     return nullptr;
+  PrepareOutOfBandArrayBuffers(value);
 
   // Write out the file header.
   WriteTag(kVersionTag);
@@ -145,6 +179,100 @@ void V8ScriptValueSerializer::PrepareTransfer(ExceptionState& exception_state) {
   }
 }
 
+void V8ScriptValueSerializer::PrepareOutOfBandArrayBuffers(
+    v8::Local<v8::Value> value) {
+  if (!clone_array_buffers_out_of_band_ || for_storage_)
+    return;
+
+  Vector<v8::Local<v8::ArrayBuffer>, 8> candidates;
+  v8::Local<v8::ArrayBuffer> candidate;
+  if (GetArrayBuffer(value, &candidate))
+    candidates.push_back(candidate);
+  else if (!CollectArrayBuffersFromProperties(value, &candidates))
+    return;
+
+  for (v8::Local<v8::ArrayBuffer> v8_array_buffer : candidates) {
+    // Views on SharedArrayBuffers are handled by GetSharedArrayBufferId().
+    if (v8_array_buffer.IsEmpty() || !v8_array_buffer->IsArrayBuffer() ||
+        v8_array_buffer->ByteLength() <
+            SerializedScriptValue::kOutOfBandArrayBufferCloneThreshold) {
+      continue;
+    }
+    DOMArrayBuffer* array_buffer = V8ArrayBuffer::ToImpl(v8_array_buffer);
+    if (array_buffer->IsDetached() ||
+        out_of_band_array_buffers_.Contains(array_buffer) ||
+        (transferables_ &&
+         transferables_->array_buffers.Contains(array_buffer))) {
+      continue;
+    }
+    serializer_.TransferArrayBuffer(
+        FirstOutOfBandArrayBufferIndex() + out_of_band_array_buffers_.size(),
+        v8_array_buffer);
+    out_of_band_array_buffers_.push_back(array_buffer);
+  }
+}
+
+bool V8ScriptValueSerializer::CollectArrayBuffersFromProperties(
+    v8::Local<v8::Value> value,
+    Vector<v8::Local<v8::ArrayBuffer>, 8>* array_buffers) {
+  if (!value->IsObject() || value->IsProxy() || value->IsMap() ||
+      value->IsSet() || value->IsNativeError()) {
+    return false;
+  }
+  v8::Isolate* isolate = script_state_->GetIsolate();
+  v8::Local<v8::Object> object = value.As<v8::Object>();
+  if (V8DOMWrapper::IsWrapper(isolate, object))
+    return false;
+
+  v8::Local<v8::Context> context = script_state_->GetContext();
+  v8::TryCatch try_catch(isolate);
+  v8::Local<v8::Array> keys;
+  if (!object
+           ->GetOwnPropertyNames(
+               context,
+               static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                               v8::SKIP_SYMBOLS),
+               v8::KeyConversionMode::kConvertToString)
+           .ToLocal(&keys) ||
+      keys->Length() > kMaxOutOfBandScanProperties) {
+    return false;
+  }
+  // Holes may be looked up on the prototype chain.
+  if (object->IsArray() && keys->Length() != object.As<v8::Array>()->Length())
+    return false;
+
+  v8::Local<v8::String> value_key = V8AtomicString(isolate, "value");
+  for (uint32_t i = 0; i < keys->Length(); i++) {
+    v8::Local<v8::Value> key;
+    v8::Local<v8::Value> descriptor;
+    if (!keys->Get(context, i).ToLocal(&key) || !key->IsString() ||
+        !object->GetOwnPropertyDescriptor(context, key.As<v8::String>())
+             .ToLocal(&descriptor) ||
+        !descriptor->IsObject()) {
+      return false;
+    }
+    // Accessor descriptors have no "value", their getter may run script.
+    v8::Local<v8::Object> descriptor_object = descriptor.As<v8::Object>();
+    v8::Local<v8::Value> property;
+    if (!descriptor_object->HasOwnProperty(context, value_key)
+             .FromMaybe(false) ||
+        !descriptor_object->Get(context, value_key).ToLocal(&property)) {
+      return false;
+    }
+
+    v8::Local<v8::ArrayBuffer> array_buffer;
+    if (GetArrayBuffer(property, &array_buffer))
+      array_buffers->push_back(array_buffer);
+    else if (property->IsObject())
+      return false;
+  }
+  return true;
+}
+
+wtf_size_t V8ScriptValueSerializer::FirstOutOfBandArrayBufferIndex() const {
+  return transferables_ ? transferables_->array_buffers.size() : 0;
+}
+
 void V8ScriptValueSerializer::FinalizeTransfer(
     ExceptionState& exception_state) {
   // TODO(jbroman): Strictly speaking, this is not correct; transfer should
@@ -174,6 +302,14 @@ void V8ScriptValueSerializer::FinalizeTransfer(
       return;
   }
 
+  if (!out_of_band_array_buffers_.IsEmpty() &&
+      !serialized_script_value_->CloneArrayBuffersOutOfBand(
+          out_of_band_array_buffers_, FirstOutOfBandArrayBufferIndex())) {
+    exception_state.ThrowDOMException(DOMExceptionCode::kDataCloneError,
+                                      "An ArrayBuffer could not be cloned.");
+    return;
+  }
+
   if (transferables_) {
     serialized_script_value_->TransferImageBitmaps(
         isolate, transferables_->image_bitmaps, exception_state);
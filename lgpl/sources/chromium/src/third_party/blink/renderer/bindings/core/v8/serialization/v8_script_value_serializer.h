@@ -86,6 +86,19 @@ class CORE_EXPORT V8ScriptValueSerializer
   void PrepareTransfer(ExceptionState&);
   void FinalizeTransfer(ExceptionState&);
 
+  // Registers the large ArrayBuffers of |value| which are cloned out of band
+  // as transferred, so that only an index is serialized. They are copied when
+  // the transfer is finalized, which is only equivalent to copying them when
+  // they are visited if no script can run during serialization. Hence only
+  // ArrayBuffers and views, and objects and arrays whose properties are all
+  // data properties holding those or primitives, are considered.
+  void PrepareOutOfBandArrayBuffers(v8::Local<v8::Value>);
+  bool CollectArrayBuffersFromProperties(
+      v8::Local<v8::Value>,
+      Vector<v8::Local<v8::ArrayBuffer>, 8>* array_buffers);
+  // Out of band ArrayBuffers are indexed after the transferred ones.
+  wtf_size_t FirstOutOfBandArrayBufferIndex() const;
+
   // Shared between File and FileList logic; does not write a leading tag.
   bool WriteFile(File*, ExceptionState&);
 
@@ -117,8 +130,10 @@ class CORE_EXPORT V8ScriptValueSerializer
   const ExceptionState* exception_state_ = nullptr;
   WebBlobInfoArray* blob_info_array_ = nullptr;
   SharedArrayBufferArray shared_array_buffers_;
+  ArrayBufferArray out_of_band_array_buffers_;
   Options::WasmSerializationPolicy wasm_policy_;
   bool for_storage_ = false;
+  bool clone_array_buffers_out_of_band_ = false;
 #if DCHECK_IS_ON()
   bool serialize_invoked_ = false;
 #endif
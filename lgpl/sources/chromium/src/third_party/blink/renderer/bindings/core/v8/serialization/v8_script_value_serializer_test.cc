@@ -6,8 +6,10 @@
 
 #include "base/time/time.h"
 #include "build/build_config.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/public/platform/web_blob_info.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_controller.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_source_code.h"
@@ -34,6 +36,7 @@
 #include "third_party/blink/renderer/bindings/core/v8/v8_offscreen_canvas.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_readable_stream.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_string_resource.h"
+#include "third_party/blink/renderer/core/fetch/body_stream_buffer.h"
 #include "third_party/blink/renderer/core/fileapi/blob.h"
 #include "third_party/blink/renderer/core/fileapi/file.h"
 #include "third_party/blink/renderer/core/fileapi/file_list.h"
@@ -54,6 +57,7 @@
 #include "third_party/blink/renderer/platform/file_metadata.h"
 #include "third_party/blink/renderer/platform/graphics/unaccelerated_static_bitmap_image.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
+#include "third_party/blink/renderer/platform/loader/fetch/data_pipe_bytes_consumer.h"
 #include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 #include "third_party/blink/renderer/platform/wtf/date_math.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -1906,6 +1910,81 @@ TEST(V8ScriptValueSerializerTest, RoundTripReadableStream) {
   EXPECT_FALSE(transferred->locked());
 }
 
+// A Fetch body stream gives up its data pipe when transferred, while other
+// streams keep going chunk by chunk. The data pipes stay parallel to the
+// stream channels, with null entries for the chunked streams.
+TEST(V8ScriptValueSerializerTest, RoundTripReadableStreamsWithDataPipe) {
+  ScopedTransferableStreamsForTest enable_transferable_streams(true);
+  ScopedTransferableStreamDataPipesForTest enable_data_pipes(true);
+
+  V8TestingScope scope;
+  auto* isolate = scope.GetIsolate();
+  auto* script_state = scope.GetScriptState();
+
+  mojo::DataPipe pipe;
+  ASSERT_TRUE(pipe.producer_handle.is_valid());
+  uint32_t write_size = 5;
+  ASSERT_EQ(MOJO_RESULT_OK,
+            pipe.producer_handle->WriteData("hello", &write_size,
+                                            MOJO_WRITE_DATA_FLAG_NONE));
+  pipe.producer_handle.reset();
+  DataPipeBytesConsumer::CompletionNotifier* notifier = nullptr;
+  auto* consumer = MakeGarbageCollected<DataPipeBytesConsumer>(
+      scope.GetDocument().GetTaskRunner(TaskType::kNetworking),
+      std::move(pipe.consumer_handle), &notifier);
+  BodyStreamBuffer* body = BodyStreamBuffer::Create(
+      script_state, consumer, /* abort_signal = */ nullptr);
+
+  HeapVector<Member<ReadableStream>> streams = {
+      ReadableStream::Create(script_state, ASSERT_NO_EXCEPTION), body->Stream(),
+      ReadableStream::Create(script_state, ASSERT_NO_EXCEPTION)};
+  HeapVector<ScriptValue> transferable_array;
+  v8::Local<v8::Array> wrapper = v8::Array::New(isolate, streams.size());
+  for (wtf_size_t i = 0; i < streams.size(); ++i) {
+    v8::Local<v8::Value> stream_wrapper = ToV8(streams[i], script_state);
+    transferable_array.push_back(ScriptValue(isolate, stream_wrapper));
+    ASSERT_TRUE(
+        wrapper->Set(scope.GetContext(), i, stream_wrapper).FromMaybe(false));
+  }
+  Transferables transferables;
+  ASSERT_TRUE(SerializedScriptValue::ExtractTransferables(
+      isolate, transferable_array, transferables, ASSERT_NO_EXCEPTION));
+
+  V8ScriptValueSerializer::Options serialize_options;
+  serialize_options.transferables = &transferables;
+  V8ScriptValueSerializer serializer(script_state, serialize_options);
+  scoped_refptr<SerializedScriptValue> serialized_script_value =
+      serializer.Serialize(wrapper, ASSERT_NO_EXCEPTION);
+  ASSERT_TRUE(serialized_script_value);
+  ASSERT_EQ(3u, serialized_script_value->GetStreamChannels().size());
+  auto& data_pipes = serialized_script_value->GetStreamDataPipes();
+  ASSERT_EQ(3u, data_pipes.size());
+  EXPECT_FALSE(data_pipes[0].is_valid());
+  EXPECT_TRUE(data_pipes[1].is_valid());
+  EXPECT_FALSE(data_pipes[2].is_valid());
+  for (const auto& stream : streams)
+    EXPECT_TRUE(stream->locked());
+
+  UnpackedSerializedScriptValue* unpacked =
+      SerializedScriptValue::Unpack(std::move(serialized_script_value));
+  V8ScriptValueDeserializer deserializer(script_state, unpacked);
+  v8::Local<v8::Value> result = deserializer.Deserialize();
+  ASSERT_TRUE(result->IsArray());
+  v8::Local<v8::Array> result_array = result.As<v8::Array>();
+  ASSERT_EQ(streams.size(), result_array->Length());
+  for (wtf_size_t i = 0; i < streams.size(); ++i) {
+    v8::Local<v8::Value> element =
+        result_array->Get(scope.GetContext(), i).ToLocalChecked();
+    ASSERT_TRUE(V8ReadableStream::HasInstance(element, isolate));
+    ReadableStream* transferred =
+        V8ReadableStream::ToImpl(element.As<v8::Object>());
+    EXPECT_NE(streams[i], transferred);
+    EXPECT_FALSE(transferred->locked());
+  }
+  // The data pipe was moved into the deserialized body stream.
+  EXPECT_FALSE(unpacked->Value()->GetStreamDataPipes()[1].is_valid());
+}
+
 TEST(V8ScriptValueSerializerTest, RoundTripDOMException) {
   V8TestingScope scope;
   DOMException* exception =
@@ -1930,4 +2009,66 @@ TEST(V8ScriptValueSerializerTest, DecodeDOMExceptionWithInvalidNameString) {
   EXPECT_TRUE(result->IsNull());
 }
 
+TEST(V8ScriptValueSerializerTest, CloneLargeArrayBufferOutOfBand) {
+  V8TestingScope scope;
+  ScriptState* script_state = scope.GetScriptState();
+  v8::Local<v8::Context> context = scope.GetContext();
+  v8::Local<v8::Value> input = Eval(
+      "var message = { id: 1, pixels: new Uint8Array(2 * 1024 * 1024) };"
+      "message.pixels.fill(42);"
+      "message",
+      scope);
+
+  V8ScriptValueSerializer::Options options;
+  options.clone_array_buffers_out_of_band = true;
+  scoped_refptr<SerializedScriptValue> serialized =
+      V8ScriptValueSerializer(script_state, options)
+          .Serialize(input, ASSERT_NO_EXCEPTION);
+  // Only an index is written for the buffer.
+  EXPECT_LT(serialized->DataLengthInBytes(), 1024u);
+  ASSERT_EQ(1u, serialized->GetArrayBufferContentsArray().size());
+
+  // The sender keeps its buffer, and its writes are not seen by the receiver.
+  v8::Local<v8::Value> sender_length =
+      Eval("message.pixels[0] = 1; message.pixels.length", scope);
+  EXPECT_EQ(2 * 1024 * 1024, sender_length.As<v8::Int32>()->Value());
+
+  UnpackedSerializedScriptValue* unpacked =
+      SerializedScriptValue::Unpack(std::move(serialized));
+  v8::Local<v8::Value> result =
+      V8ScriptValueDeserializer(script_state, unpacked).Deserialize();
+  ASSERT_TRUE(result->IsObject());
+  v8::Local<v8::Value> pixels =
+      result.As<v8::Object>()
+          ->Get(context, V8AtomicString(scope.GetIsolate(), "pixels"))
+          .ToLocalChecked();
+  ASSERT_TRUE(pixels->IsUint8Array());
+  EXPECT_EQ(2u * 1024 * 1024, pixels.As<v8::Uint8Array>()->Length());
+  EXPECT_EQ(42, pixels.As<v8::Object>()
+                    ->Get(context, 0)
+                    .ToLocalChecked()
+                    .As<v8::Int32>()
+                    ->Value());
+}
+
+TEST(V8ScriptValueSerializerTest, DontCloneArrayBufferOutOfBandIfScriptMayRun) {
+  V8TestingScope scope;
+  V8ScriptValueSerializer::Options options;
+  options.clone_array_buffers_out_of_band = true;
+  const char* const kInputs[] = {
+      // Small buffers are serialized inline.
+      "new Uint8Array(1024)",
+      // A getter could modify the buffer after it has been serialized.
+      "({ get pixels() { return new Uint8Array(2 * 1024 * 1024); } })",
+      // Nested objects are not scanned.
+      "({ frame: { pixels: new Uint8Array(2 * 1024 * 1024) } })",
+  };
+  for (const char* input : kInputs) {
+    scoped_refptr<SerializedScriptValue> serialized =
+        V8ScriptValueSerializer(scope.GetScriptState(), options)
+            .Serialize(Eval(input, scope), ASSERT_NO_EXCEPTION);
+    EXPECT_TRUE(serialized->GetArrayBufferContentsArray().IsEmpty()) << input;
+  }
+}
+
 }  // namespace blink
@@ -41,7 +41,7 @@ v8::Local<v8::Function> CreateInterfaceObject(const WrapperTypeInfo* type,
 }
 
 // TODO(peria): This method is almost a copy of
-// V8PerContext::CreateWrapperFromCacheSlowCase(), so merge with it.
+// V8PerContext::CreateWrapperBoilerplate(), so merge with it.
 v8::Local<v8::Object> CreatePlainWrapper(v8::Isolate* isolate,
                                          const DOMWrapperWorld& world,
                                          v8::Local<v8::Context> context,
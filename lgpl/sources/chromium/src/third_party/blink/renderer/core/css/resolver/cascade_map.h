@@ -10,6 +10,8 @@
 #include "third_party/blink/renderer/core/css/properties/css_bitset.h"
 #include "third_party/blink/renderer/core/css/resolver/cascade_priority.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/scratch_allocator.h"
+#include "third_party/blink/renderer/platform/wtf/hash_map.h"
 
 namespace blink {
 
@@ -72,7 +74,15 @@ class CORE_EXPORT CascadeMap {
                                               sizeof(CascadePriority)];
   };
 
-  using CustomMap = HashMap<CSSPropertyName, CascadePriority>;
+  // CascadeMaps only live for the duration of a single style resolution, so
+  // the custom property tables are allocated from the style phase's scratch
+  // arena.
+  using CustomMap = HashMap<CSSPropertyName,
+                            CascadePriority,
+                            DefaultHash<CSSPropertyName>::Hash,
+                            HashTraits<CSSPropertyName>,
+                            HashTraits<CascadePriority>,
+                            ScratchAllocator>;
 
  private:
   uint64_t high_priority_ = 0;
@@ -337,12 +337,17 @@ void ContainerNode::InsertNodeVector(
 void ContainerNode::DidInsertNodeVector(
     const NodeVector& targets,
     Node* next,
-    const NodeVector& post_insertion_notification_targets) {
-  Node* unchanged_previous =
-      targets.size() > 0 ? targets[0]->previousSibling() : nullptr;
-  for (const auto& target_node : targets) {
-    ChildrenChanged(ChildrenChange::ForInsertion(
-        *target_node, unchanged_previous, next, ChildrenChangeSource::kAPI));
+    const NodeVector& post_insertion_notification_targets,
+    bool all_children_inserted) {
+  if (all_children_inserted) {
+    ChildrenChanged(ChildrenChange::ForAllChildrenInserted(targets));
+  } else {
+    Node* unchanged_previous =
+        targets.size() > 0 ? targets[0]->previousSibling() : nullptr;
+    for (const auto& target_node : targets) {
+      ChildrenChanged(ChildrenChange::ForInsertion(
+          *target_node, unchanged_previous, next, ChildrenChangeSource::kAPI));
+    }
   }
   for (const auto& descendant : post_insertion_notification_targets) {
     if (descendant->isConnected())
@@ -871,7 +876,13 @@ Node* ContainerNode::AppendChild(Node* new_child,
     InsertNodeVector(targets, nullptr, AdoptAndAppendChild(),
                      &post_insertion_notification_targets);
   }
-  DidInsertNodeVector(targets, nullptr, post_insertion_notification_targets);
+  // When the children of a fragment fill a node that had none, e.g. for
+  // innerHTML, they are notified in one ChildrenChanged() call.
+  bool all_children_inserted = targets.size() > 1 &&
+                               firstChild() == targets.front() &&
+                               lastChild() == targets.back();
+  DidInsertNodeVector(targets, nullptr, post_insertion_notification_targets,
+                      all_children_inserted);
   return new_child;
 }
 
@@ -1024,11 +1035,18 @@ void ContainerNode::ChildrenChanged(const ChildrenChange& change) {
     GetDocument().GetStyleEngine().ChildrenRemoved(*this);
     return;
   }
-  if (!change.IsChildInsertion())
+  if (change.type == ChildrenChangeType::kAllChildrenInserted) {
+    for (Node* inserted_node : *change.inserted_nodes)
+      DidInsertChild(*inserted_node);
     return;
-  Node* inserted_node = change.sibling_changed;
-  if (inserted_node->IsContainerNode() || inserted_node->IsTextNode())
-    inserted_node->ClearFlatTreeNodeDataIfHostChanged(*this);
+  }
+  if (change.IsChildInsertion())
+    DidInsertChild(*change.sibling_changed);
+}
+
+void ContainerNode::DidInsertChild(Node& inserted_node) {
+  if (inserted_node.IsContainerNode() || inserted_node.IsTextNode())
+    inserted_node.ClearFlatTreeNodeDataIfHostChanged(*this);
   if (!InActiveDocument())
     return;
   if (IsElementNode() && !GetComputedStyle()) {
@@ -1039,8 +1057,8 @@ void ContainerNode::ChildrenChanged(const ChildrenChange& change) {
     // the ComputedStyle goes from null to non-null.
     return;
   }
-  if (inserted_node->IsContainerNode() || inserted_node->IsTextNode())
-    inserted_node->SetStyleChangeOnInsertion();
+  if (inserted_node.IsContainerNode() || inserted_node.IsTextNode())
+    inserted_node.SetStyleChangeOnInsertion();
 }
 
 bool ContainerNode::ChildrenChangedAllChildrenRemovedNeedsList() const {
@@ -1503,8 +1521,17 @@ void ContainerNode::InvalidateNodeListCachesInAncestors(
   GetDocument().InvalidateNodeListCaches(attr_name);
 
   for (ContainerNode* node = this; node; node = node->parentNode()) {
-    if (NodeListsNodeData* lists = node->NodeLists())
+    NodeListsNodeData* lists = node->NodeLists();
+    if (!lists)
+      continue;
+    if (change) {
+      lists->InvalidateCachesForChildrenChange(*this, *change);
+    } else if (attr_name && attribute_owner_element) {
+      lists->InvalidateCachesForAttributeChange(*attr_name,
+                                                *attribute_owner_element);
+    } else {
       lists->InvalidateCaches(attr_name);
+    }
   }
 }
 
@@ -300,6 +300,7 @@ class CORE_EXPORT ContainerNode : public Node {
     kElementRemoved,
     kNonElementRemoved,
     kAllChildrenRemoved,
+    kAllChildrenInserted,
     kTextChanged
   };
   enum class ChildrenChangeSource : uint8_t { kAPI, kParser };
@@ -322,6 +323,19 @@ class CORE_EXPORT ContainerNode : public Node {
       return change;
     }
 
+    // For |nodes| appended at once to a parent that had no children, see
+    // AppendChild().
+    static ChildrenChange ForAllChildrenInserted(const NodeVector& nodes) {
+      ChildrenChange change = {ChildrenChangeType::kAllChildrenInserted,
+                               ChildrenChangeSource::kAPI,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               &nodes};
+      return change;
+    }
+
     static ChildrenChange ForRemoval(Node& node,
                                      Node* previous_sibling,
                                      Node* next_sibling,
@@ -370,6 +384,9 @@ class CORE_EXPORT ContainerNode : public Node {
     // This is available only if ChildrenChangedAllChildrenRemovedNeedsList()
     // returns true.
     HeapVector<Member<Node>>* removed_nodes;
+    // List of inserted nodes for ChildrenChangeType::kAllChildrenInserted, in
+    // tree order. They are all of the parent's children.
+    const NodeVector* inserted_nodes = nullptr;
   };
 
   // Notifies the node that it's list of children have changed (either by adding
@@ -436,7 +453,9 @@ class CORE_EXPORT ContainerNode : public Node {
   void DidInsertNodeVector(
       const NodeVector&,
       Node* next,
-      const NodeVector& post_insertion_notification_targets);
+      const NodeVector& post_insertion_notification_targets,
+      bool all_children_inserted = false);
+  void DidInsertChild(Node& inserted_node);
   class AdoptAndInsertBefore;
   class AdoptAndAppendChild;
   friend class AdoptAndInsertBefore;
@@ -321,6 +321,7 @@
 #include "third_party/blink/renderer/platform/weborigin/scheme_registry.h"
 #include "third_party/blink/renderer/platform/weborigin/security_origin.h"
 #include "third_party/blink/renderer/platform/widget/frame_widget.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/scratch_arena.h"
 #include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
 #include "third_party/blink/renderer/platform/wtf/functional.h"
 #include "third_party/blink/renderer/platform/wtf/hash_functions.h"
@@ -2558,6 +2559,7 @@ void Document::UpdateStyle() {
 
   unsigned initial_element_count = GetStyleEngine().StyleForElementCount();
 
+  ScratchArena::PhaseScope scratch_scope(ScratchArena::Phase::kStyle);
   lifecycle_.AdvanceTo(DocumentLifecycle::kInStyleRecalc);
 
   // SetNeedsStyleRecalc should only happen on Element and Text nodes.
@@ -3379,7 +3381,8 @@ DocumentParser* Document::CreateParser() {
                                                     parser_sync_policy_);
   }
   // FIXME: this should probably pass the frame instead
-  return MakeGarbageCollected<XMLDocumentParser>(*this, View());
+  return MakeGarbageCollected<XMLDocumentParser>(*this, View(),
+                                                 parser_sync_policy_);
 }
 
 bool Document::IsFrameSet() const {
@@ -3835,6 +3835,8 @@ void Element::ChildrenChanged(const ChildrenChange& change) {
   CheckForEmptyStyleChange(change.sibling_before_change,
                            change.sibling_after_change);
 
+  // kAllChildrenInserted needs no sibling checks: none of the inserted nodes
+  // had siblings before.
   if (!change.ByParser() && change.IsChildElementChange())
     CheckForSiblingStyleChanges(
         change.type == ChildrenChangeType::kElementRemoved
@@ -8,6 +8,7 @@
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/public/web/web_plugin.h"
+#include "third_party/blink/renderer/core/css/properties/longhands.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/dom/dom_token_list.h"
 #include "third_party/blink/renderer/core/dom/node_computed_style.h"
@@ -15,6 +16,7 @@
 #include "third_party/blink/renderer/core/exported/web_plugin_container_impl.h"
 #include "third_party/blink/renderer/core/frame/local_frame_view.h"
 #include "third_party/blink/renderer/core/geometry/dom_rect.h"
+#include "third_party/blink/renderer/core/html/html_collection.h"
 #include "third_party/blink/renderer/core/html/html_html_element.h"
 #include "third_party/blink/renderer/core/html/html_plugin_element.h"
 #include "third_party/blink/renderer/core/layout/layout_box_model_object.h"
@@ -462,6 +464,37 @@ TEST_F(ElementTest, OptionElementDisplayNoneComputedStyle) {
   EXPECT_FALSE(document.getElementById("inner-option")->GetComputedStyle());
 }
 
+TEST_F(ElementTest, InnerHTMLBatchedInsertionUpdatesEmptyAndCollections) {
+  Document& document = GetDocument();
+  SetBodyContent(R"HTML(
+    <style>#target:empty { color: green; }</style>
+    <div id=target><span class=item></span><span class=item></span></div>
+  )HTML");
+  UpdateAllLifecyclePhasesForTest();
+
+  Element* target = document.getElementById("target");
+  HTMLCollection* items = target->getElementsByClassName("item");
+  EXPECT_EQ(2u, items->length());
+
+  target->setInnerHTML("");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_EQ(0u, items->length());
+  EXPECT_EQ(MakeRGB(0, 128, 0),
+            target->GetComputedStyle()->VisitedDependentColor(
+                GetCSSPropertyColor()));
+
+  // Several children inserted into an empty element are notified as a batch.
+  target->setInnerHTML(
+      "<span class=item></span>text<span class=item></span>"
+      "<span class=item></span>");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_EQ(3u, items->length());
+  EXPECT_EQ(target->lastChild(), items->item(2));
+  EXPECT_NE(MakeRGB(0, 128, 0),
+            target->GetComputedStyle()->VisitedDependentColor(
+                GetCSSPropertyColor()));
+}
+
 // A fake plugin which will assert that script is allowed in Destroy.
 class ScriptOnDestroyPlugin : public GarbageCollected<ScriptOnDestroyPlugin>,
                               public WebPlugin {
@@ -36,6 +36,26 @@ void LiveNodeListBase::InvalidateCacheForAttribute(
     To<HTMLCollection>(this)->InvalidateCacheForAttribute(attr_name);
 }
 
+void LiveNodeListBase::InvalidateCacheForChildrenChange(
+    const ContainerNode& parent,
+    const ContainerNode::ChildrenChange& change) const {
+  if (IsLiveNodeListType(GetType()))
+    To<LiveNodeList>(this)->InvalidateCache();
+  else
+    To<HTMLCollection>(this)->InvalidateCacheForChildrenChange(parent, change);
+}
+
+void LiveNodeListBase::InvalidateCacheForAttributeChange(
+    const QualifiedName& attr_name,
+    Element& owner) const {
+  if (IsLiveNodeListType(GetType())) {
+    To<LiveNodeList>(this)->InvalidateCacheForAttribute(&attr_name);
+  } else {
+    To<HTMLCollection>(this)->InvalidateCacheForAttributeChange(attr_name,
+                                                                owner);
+  }
+}
+
 ContainerNode& LiveNodeListBase::RootNode() const {
   if (IsRootedAtTreeScope() && owner_node_->IsInTreeScope())
     return owner_node_->ContainingTreeScope().RootNode();
@@ -73,6 +73,11 @@ class CORE_EXPORT LiveNodeListBase : public GarbageCollectedMixin {
 
   virtual void InvalidateCache(Document* old_document = nullptr) const = 0;
   void InvalidateCacheForAttribute(const QualifiedName*) const;
+  void InvalidateCacheForChildrenChange(
+      const ContainerNode& parent,
+      const ContainerNode::ChildrenChange&) const;
+  void InvalidateCacheForAttributeChange(const QualifiedName&,
+                                         Element& owner) const;
 
   static bool ShouldInvalidateTypeOnAttributeChange(NodeListInvalidationType,
                                                     const QualifiedName&);
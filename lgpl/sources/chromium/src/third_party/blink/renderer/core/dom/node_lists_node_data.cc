@@ -45,6 +45,23 @@ void NodeListsNodeData::InvalidateCaches(const QualifiedName* attr_name) {
     cache.value->InvalidateCache();
 }
 
+void NodeListsNodeData::InvalidateCachesForChildrenChange(
+    const ContainerNode& parent,
+    const ContainerNode::ChildrenChange& change) {
+  for (const auto& cache : atomic_name_caches_)
+    cache.value->InvalidateCacheForChildrenChange(parent, change);
+
+  for (auto& cache : tag_collection_ns_caches_)
+    cache.value->InvalidateCacheForChildrenChange(parent, change);
+}
+
+void NodeListsNodeData::InvalidateCachesForAttributeChange(
+    const QualifiedName& attr_name,
+    Element& owner) {
+  for (const auto& cache : atomic_name_caches_)
+    cache.value->InvalidateCacheForAttributeChange(attr_name, owner);
+}
+
 void NodeListsNodeData::Trace(Visitor* visitor) const {
   visitor->Trace(child_node_list_);
   visitor->Trace(atomic_name_caches_);
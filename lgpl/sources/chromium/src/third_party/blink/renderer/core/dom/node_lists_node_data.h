@@ -135,6 +135,12 @@ class NodeListsNodeData final : public GarbageCollected<NodeListsNodeData> {
   NodeListsNodeData() : child_node_list_(nullptr) {}
 
   void InvalidateCaches(const QualifiedName* attr_name = nullptr);
+  // Like InvalidateCaches(), but gives the lists the mutation so that they can
+  // update their caches in place where possible.
+  void InvalidateCachesForChildrenChange(const ContainerNode& parent,
+                                         const ContainerNode::ChildrenChange&);
+  void InvalidateCachesForAttributeChange(const QualifiedName& attr_name,
+                                          Element& owner);
 
   bool IsEmpty() const {
     return !child_node_list_ && atomic_name_caches_.IsEmpty() &&
@@ -13,6 +13,7 @@
 #include "third_party/blink/renderer/core/fetch/readable_stream_bytes_consumer.h"
 #include "third_party/blink/renderer/core/streams/readable_stream.h"
 #include "third_party/blink/renderer/core/streams/readable_stream_default_controller_with_script_scope.h"
+#include "third_party/blink/renderer/core/streams/transferable_streams.h"
 #include "third_party/blink/renderer/core/typed_arrays/dom_array_buffer.h"
 #include "third_party/blink/renderer/core/typed_arrays/dom_typed_array.h"
 #include "third_party/blink/renderer/platform/bindings/exception_code.h"
@@ -21,6 +22,7 @@
 #include "third_party/blink/renderer/platform/bindings/v8_throw_exception.h"
 #include "third_party/blink/renderer/platform/blob/blob_data.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
+#include "third_party/blink/renderer/platform/loader/fetch/data_pipe_bytes_consumer.h"
 #include "third_party/blink/renderer/platform/network/encoded_form_data.h"
 #include "third_party/blink/renderer/platform/wtf/assertions.h"
 #include "third_party/blink/renderer/platform/wtf/functional.h"
@@ -116,6 +118,24 @@ BodyStreamBuffer* BodyStreamBuffer::Create(
   return buffer;
 }
 
+// static
+ReadableStream* BodyStreamBuffer::CreateStreamForTransferredDataPipe(
+    ScriptState* script_state,
+    mojo::ScopedDataPipeConsumerHandle data_pipe,
+    MessagePort* port) {
+  DCHECK(data_pipe.is_valid());
+  // Creating the stream runs the start algorithm of the underlying source.
+  v8::Isolate::AllowJavascriptExecutionScope allow_js(
+      script_state->GetIsolate());
+  DataPipeBytesConsumer::CompletionNotifier* notifier = nullptr;
+  auto* consumer = MakeGarbageCollected<DataPipeBytesConsumer>(
+      ExecutionContext::From(script_state)
+          ->GetTaskRunner(TaskType::kNetworking),
+      std::move(data_pipe), &notifier);
+  ReceiveCrossRealmDataPipeEnd(script_state, port, notifier);
+  return Create(script_state, consumer, nullptr /* AbortSignal */)->Stream();
+}
+
 BodyStreamBuffer::BodyStreamBuffer(PassKey,
                                    ScriptState* script_state,
                                    BytesConsumer* consumer,
@@ -225,6 +245,35 @@ void BodyStreamBuffer::DrainAsChunkedDataPipeGetter(
           ->GetTaskRunner(TaskType::kNetworking));
 }
 
+BytesConsumer* BodyStreamBuffer::DrainAsDataPipe(
+    mojo::ScopedDataPipeConsumerHandle* data_pipe,
+    ExceptionState& exception_state) {
+  DCHECK(!IsStreamLocked());
+  DCHECK(!IsStreamDisturbed());
+  if (IsStreamClosed() || IsStreamErrored() || stream_broken_)
+    return nullptr;
+
+  if (made_from_readable_stream_ || !consumer_ || !GetExecutionContext())
+    return nullptr;
+
+  *data_pipe = consumer_->DrainAsDataPipe();
+  if (!data_pipe->is_valid())
+    return nullptr;
+
+  // The consumer no longer has data, but it still learns how the body ends, so
+  // it is handed to the caller rather than cancelled by
+  // CloseAndLockAndDisturb().
+  side_data_blob_.reset();
+  BytesConsumer* consumer = consumer_.Release();
+  consumer->ClearClient();
+  CloseAndLockAndDisturb(exception_state);
+  if (exception_state.HadException()) {
+    data_pipe->reset();
+    return nullptr;
+  }
+  return consumer;
+}
+
 void BodyStreamBuffer::StartLoading(FetchDataLoader* loader,
                                     FetchDataLoader::Client* client,
                                     ExceptionState& exception_state) {
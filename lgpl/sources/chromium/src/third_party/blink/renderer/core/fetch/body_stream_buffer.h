@@ -8,6 +8,7 @@
 #include <memory>
 #include "base/util/type_safety/pass_key.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "services/network/public/mojom/chunked_data_pipe_getter.mojom-blink.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_promise.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_value.h"
@@ -25,6 +26,7 @@ namespace blink {
 class BytesUploader;
 class EncodedFormData;
 class ExceptionState;
+class MessagePort;
 class ReadableStream;
 class ScriptState;
 
@@ -46,6 +48,14 @@ class CORE_EXPORT BodyStreamBuffer final : public UnderlyingSourceBase,
       AbortSignal* signal,
       scoped_refptr<BlobDataHandle> side_data_blob = nullptr);
 
+  // Creates the stream of a body that was transferred from another realm with
+  // its bytes in |data_pipe|. The end of the body is reported on |port|. See
+  // ReadableStream::SerializeAsDataPipe().
+  static ReadableStream* CreateStreamForTransferredDataPipe(
+      ScriptState*,
+      mojo::ScopedDataPipeConsumerHandle data_pipe,
+      MessagePort* port);
+
   // Create() should be used instead of calling this constructor directly.
   BodyStreamBuffer(PassKey,
                    ScriptState*,
@@ -76,6 +86,8 @@ class CORE_EXPORT BodyStreamBuffer final : public UnderlyingSourceBase,
   // UnderlyingSourceBase
   ScriptPromise pull(ScriptState*) override;
   ScriptPromise Cancel(ScriptState*, ScriptValue reason) override;
+  BytesConsumer* DrainAsDataPipe(mojo::ScopedDataPipeConsumerHandle*,
+                                 ExceptionState&) override;
   bool HasPendingActivity() const override;
   void ContextDestroyed() override;
 
@@ -6,6 +6,7 @@
 
 #include <memory>
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_binding_for_testing.h"
@@ -15,6 +16,7 @@
 #include "third_party/blink/renderer/core/fetch/bytes_consumer_test_util.h"
 #include "third_party/blink/renderer/core/fetch/form_data_bytes_consumer.h"
 #include "third_party/blink/renderer/core/html/forms/form_data.h"
+#include "third_party/blink/renderer/core/messaging/message_channel.h"
 #include "third_party/blink/renderer/core/streams/readable_stream.h"
 #include "third_party/blink/renderer/core/streams/readable_stream_default_controller_with_script_scope.h"
 #include "third_party/blink/renderer/core/streams/test_underlying_source.h"
@@ -26,6 +28,7 @@
 #include "third_party/blink/renderer/platform/heap/garbage_collected.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
 #include "third_party/blink/renderer/platform/loader/fetch/bytes_consumer.h"
+#include "third_party/blink/renderer/platform/loader/fetch/data_pipe_bytes_consumer.h"
 #include "third_party/blink/renderer/platform/loader/fetch/text_resource_decoder_options.h"
 #include "third_party/blink/renderer/platform/loader/testing/replaying_bytes_consumer.h"
 #include "third_party/blink/renderer/platform/network/encoded_form_data.h"
@@ -769,6 +772,81 @@ TEST_F(BodyStreamBufferTest,
   checkpoint.Call(3);
 }
 
+TEST_F(BodyStreamBufferTest, TransferAsDataPipe) {
+  V8TestingScope scope;
+  ScriptState* script_state = scope.GetScriptState();
+  Checkpoint checkpoint;
+  auto* client = MakeGarbageCollected<MockFetchDataLoaderClient>();
+
+  InSequence s;
+  EXPECT_CALL(checkpoint, Call(1));
+  EXPECT_CALL(*client, DidFetchDataLoadedString(String("hello")));
+  EXPECT_CALL(checkpoint, Call(2));
+
+  mojo::DataPipe pipe;
+  ASSERT_TRUE(pipe.producer_handle.is_valid());
+  uint32_t write_size = 5;
+  ASSERT_EQ(MOJO_RESULT_OK,
+            pipe.producer_handle->WriteData("hello", &write_size,
+                                            MOJO_WRITE_DATA_FLAG_NONE));
+  ASSERT_EQ(5u, write_size);
+  pipe.producer_handle.reset();
+
+  DataPipeBytesConsumer::CompletionNotifier* notifier = nullptr;
+  auto* src = MakeGarbageCollected<DataPipeBytesConsumer>(
+      scope.GetDocument().GetTaskRunner(TaskType::kNetworking),
+      std::move(pipe.consumer_handle), &notifier);
+  BodyStreamBuffer* buffer = BodyStreamBuffer::Create(
+      script_state, src, /* abort_signal = */ nullptr);
+
+  auto* channel =
+      MakeGarbageCollected<MessageChannel>(scope.GetExecutionContext());
+  mojo::ScopedDataPipeConsumerHandle data_pipe =
+      buffer->Stream()->SerializeAsDataPipe(script_state, channel->port1(),
+                                            ASSERT_NO_EXCEPTION);
+  ASSERT_TRUE(data_pipe.is_valid());
+  EXPECT_TRUE(buffer->IsStreamLocked());
+  EXPECT_TRUE(buffer->IsStreamDisturbed());
+
+  ReadableStream* transferred =
+      BodyStreamBuffer::CreateStreamForTransferredDataPipe(
+          script_state, std::move(data_pipe), channel->port2());
+  ASSERT_TRUE(transferred);
+  auto* transferred_buffer =
+      MakeGarbageCollected<BodyStreamBuffer>(script_state, transferred);
+  transferred_buffer->StartLoading(
+      FetchDataLoader::CreateLoaderAsString(
+          TextResourceDecoderOptions::CreateUTF8Decode()),
+      client, ASSERT_NO_EXCEPTION);
+
+  // The body only ends once the original consumer is told that it completed.
+  test::RunPendingTasks();
+  checkpoint.Call(1);
+  notifier->SignalComplete();
+  test::RunPendingTasks();
+  checkpoint.Call(2);
+}
+
+TEST_F(BodyStreamBufferTest, TransferAsDataPipeReturnsInvalidHandle) {
+  V8TestingScope scope;
+  // This BytesConsumer is not drainable.
+  BytesConsumer* src = MakeGarbageCollected<ReplayingBytesConsumer>(
+      scope.GetDocument().GetTaskRunner(TaskType::kNetworking));
+  BodyStreamBuffer* buffer = BodyStreamBuffer::Create(
+      scope.GetScriptState(), src, /* abort_signal = */ nullptr);
+
+  auto* channel =
+      MakeGarbageCollected<MessageChannel>(scope.GetExecutionContext());
+  EXPECT_FALSE(buffer->Stream()
+                   ->SerializeAsDataPipe(scope.GetScriptState(),
+                                         channel->port1(), ASSERT_NO_EXCEPTION)
+                   .is_valid());
+
+  EXPECT_FALSE(buffer->IsStreamLocked());
+  EXPECT_FALSE(buffer->IsStreamDisturbed());
+  EXPECT_TRUE(buffer->IsStreamReadable());
+}
+
 TEST_F(BodyStreamBufferTest, TakeSideDataBlob) {
   V8TestingScope scope;
   scoped_refptr<BlobDataHandle> blob_data_handle = CreateBlob("hello");
@@ -156,6 +156,7 @@
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/scheduler/public/frame_scheduler.h"
 #include "third_party/blink/renderer/platform/web_test_support.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/scratch_arena.h"
 #include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/base/cursor/cursor.h"
@@ -734,6 +735,7 @@ void LocalFrameView::PerformLayout(bool in_subtree_layout) {
   PrepareLayoutAnalyzer();
 
   ScriptForbiddenScope forbid_script;
+  ScratchArena::PhaseScope scratch_scope(ScratchArena::Phase::kLayout);
 
   if (in_subtree_layout && HasOrthogonalWritingModeRoots()) {
     // If we're going to lay out from each subtree root, rather than once from
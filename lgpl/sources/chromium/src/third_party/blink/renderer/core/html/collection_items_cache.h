@@ -56,6 +56,17 @@ class CollectionItemsCache : public CollectionIndexCache<Collection, NodeType> {
   NodeType* NodeAt(const Collection&, unsigned index);
   void Invalidate();
 
+  // The full item list is built by NodeCount(). Once it exists, collections
+  // whose membership only depends on the elements themselves can bring it up
+  // to date after DOM mutations with SetList(), instead of invalidating it and
+  // re-walking the subtree.
+  bool IsListValid() const { return list_valid_; }
+  const HeapVector<Member<NodeType>>& CachedList() const {
+    return cached_list_;
+  }
+  // Replaces the cached list with |list|, leaving the old list in |list|.
+  void SetList(HeapVector<Member<NodeType>>& list);
+
  private:
   bool list_valid_;
   HeapVector<Member<NodeType>> cached_list_;
@@ -107,6 +118,17 @@ inline NodeType* CollectionItemsCache<Collection, NodeType>::NodeAt(
   return Base::NodeAt(collection, index);
 }
 
+template <typename Collection, typename NodeType>
+void CollectionItemsCache<Collection, NodeType>::SetList(
+    HeapVector<Member<NodeType>>& list) {
+  DCHECK(list_valid_);
+  cached_list_.swap(list);
+  // The list is authoritative; drop the traversal position of the base cache
+  // and keep its count in sync with the list.
+  Base::Invalidate();
+  this->SetCachedNodeCount(cached_list_.size());
+}
+
 }  // namespace blink
 
 #endif  // THIRD_PARTY_BLINK_RENDERER_CORE_HTML_COLLECTION_ITEMS_CACHE_H_
@@ -95,6 +95,11 @@ void HTMLOptGroupElement::ChildrenChanged(const ChildrenChange& change) {
   } else if (change.type == ChildrenChangeType::kElementRemoved) {
     if (auto* option = DynamicTo<HTMLOptionElement>(change.sibling_changed))
       select->OptionRemoved(*option);
+  } else if (change.type == ChildrenChangeType::kAllChildrenInserted) {
+    for (Node* node : *change.inserted_nodes) {
+      if (auto* option = DynamicTo<HTMLOptionElement>(node))
+        select->OptionInserted(*option, option->Selected());
+    }
   } else if (change.type == ChildrenChangeType::kAllChildrenRemoved) {
     DCHECK(change.removed_nodes);
     for (Node* node : *change.removed_nodes) {
@@ -29,6 +29,7 @@
 #include "third_party/blink/renderer/bindings/core/v8/v8_mutation_observer_init.h"
 #include "third_party/blink/renderer/core/accessibility/ax_object_cache.h"
 #include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/element_traversal.h"
 #include "third_party/blink/renderer/core/dom/mutation_observer.h"
 #include "third_party/blink/renderer/core/dom/node_computed_style.h"
 #include "third_party/blink/renderer/core/dom/node_traversal.h"
@@ -322,7 +323,12 @@ void HTMLOptionElement::ChildrenChanged(const ChildrenChange& change) {
 
   // If an element is inserted, We need to use MutationObserver to detect
   // textContent changes.
-  if (change.type == ChildrenChangeType::kElementInserted && !text_observer_)
+  // kAllChildrenInserted inserts all of the children.
+  bool element_inserted =
+      change.type == ChildrenChangeType::kElementInserted ||
+      (change.type == ChildrenChangeType::kAllChildrenInserted &&
+       ElementTraversal::FirstChild(*this));
+  if (element_inserted && !text_observer_)
     text_observer_ = MakeGarbageCollected<OptionTextObserver>(*this);
 }
 
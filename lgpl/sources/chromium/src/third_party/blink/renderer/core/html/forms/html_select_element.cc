@@ -715,6 +715,15 @@ void HTMLSelectElement::ChildrenChanged(const ChildrenChange& change) {
       for (auto& option : Traversal<HTMLOptionElement>::ChildrenOf(*optgroup))
         OptionRemoved(option);
     }
+  } else if (change.type == ChildrenChangeType::kAllChildrenInserted) {
+    for (Node* node : *change.inserted_nodes) {
+      if (auto* option = DynamicTo<HTMLOptionElement>(node)) {
+        OptionInserted(*option, option->Selected());
+      } else if (auto* optgroup = DynamicTo<HTMLOptGroupElement>(node)) {
+        for (auto& option : Traversal<HTMLOptionElement>::ChildrenOf(*optgroup))
+          OptionInserted(option, option.Selected());
+      }
+    }
   } else if (change.type == ChildrenChangeType::kAllChildrenRemoved) {
     DCHECK(change.removed_nodes);
     for (Node* node : *change.removed_nodes) {
@@ -609,4 +609,17 @@ TEST_F(HTMLSelectElementTest, AddingNotOwnedOption) {
   // This test passes if the above appendChild() doesn't cause a DCHECK failure.
 }
 
+TEST_F(HTMLSelectElementTest, InnerHTMLInsertsAllOptions) {
+  SetHtmlInnerHTML("<select id=sel></select>");
+  auto* select = To<HTMLSelectElement>(GetElementById("sel"));
+  // The options fill an empty select, so they are notified in one
+  // kAllChildrenInserted ChildrenChanged() call.
+  select->setInnerHTML(
+      "<option>a</option><optgroup><option>b</option></optgroup>"
+      "<option selected>c</option>");
+  EXPECT_EQ(3u, select->length());
+  EXPECT_EQ(2, select->selectedIndex());
+  EXPECT_EQ("c", select->value());
+}
+
 }  // namespace blink
@@ -23,6 +23,8 @@
 
 #include "third_party/blink/renderer/core/html/html_collection.h"
 
+#include <algorithm>
+
 #include "third_party/blink/renderer/core/dom/class_collection.h"
 #include "third_party/blink/renderer/core/dom/element_traversal.h"
 #include "third_party/blink/renderer/core/dom/node_rare_data.h"
@@ -191,15 +193,18 @@ HTMLCollection::HTMLCollection(ContainerNode& owner_node,
 HTMLCollection::~HTMLCollection() = default;
 
 void HTMLCollection::InvalidateCache(Document* old_document) const {
+  pending_mutations_.Clear();
   collection_items_cache_.Invalidate();
   InvalidateIdNameCacheMaps(old_document);
 }
 
 unsigned HTMLCollection::length() const {
+  ApplyPendingMutationsIfNeeded();
   return collection_items_cache_.NodeCount(*this);
 }
 
 Element* HTMLCollection::item(unsigned offset) const {
+  ApplyPendingMutationsIfNeeded();
   return collection_items_cache_.NodeAt(*this, offset);
 }
 
@@ -323,6 +328,220 @@ static inline IsMatch<HTMLCollectionType> MakeIsMatch(
   return IsMatch<HTMLCollectionType>(list);
 }
 
+bool HTMLCollection::SupportsIncrementalCacheUpdate() const {
+  // Only collections whose membership is a pure function of each element in
+  // the subtree (and not of its position, siblings or form association) can
+  // be patched in place.
+  switch (GetType()) {
+    case kClassCollectionType:
+    case kTagCollectionType:
+    case kTagCollectionNSType:
+    case kHTMLTagCollectionType:
+    case kDocAll:
+    case kDocImages:
+    case kDocScripts:
+    case kDocForms:
+    case kDocEmbeds:
+      return !OverridesItemAfter() && !ShouldOnlyIncludeDirectChildren() &&
+             !IsRootedAtTreeScope() && collection_items_cache_.IsListValid();
+    default:
+      return false;
+  }
+}
+
+void HTMLCollection::CollectMatchingElements(
+    Node& subtree_root,
+    HeapVector<Member<Element>>& result) const {
+  auto* element = DynamicTo<Element>(subtree_root);
+  if (!element)
+    return;
+  IsMatch<HTMLCollection> is_match(*this);
+  if (is_match(*element))
+    result.push_back(element);
+  for (Element* descendant =
+           ElementTraversal::FirstWithin(*element, is_match);
+       descendant;
+       descendant = ElementTraversal::Next(*descendant, element, is_match)) {
+    result.push_back(descendant);
+  }
+}
+
+// Mutations under RootNode() since the cached item list was last brought up to
+// date. Recording one is cheap; ApplyPendingMutations() applies all of them in
+// a single pass over the list when the collection is next read, so a
+// collection that is mutated many times between reads, or never read again,
+// doesn't pay for every mutation.
+class HTMLCollection::PendingMutations final
+    : public GarbageCollected<HTMLCollection::PendingMutations> {
+ public:
+  // Beyond this many mutations, locating each of them in the list costs more
+  // than re-walking the subtree, so the cache is invalidated instead.
+  static constexpr unsigned kMaxMutations = 32;
+
+  void Trace(Visitor* visitor) const {
+    visitor->Trace(inserted_roots);
+    visitor->Trace(removed_items);
+    visitor->Trace(changed_elements);
+  }
+
+  // Roots of inserted subtrees, in insertion order. Some may have been
+  // removed again since.
+  HeapVector<Member<Node>> inserted_roots;
+  // Matching elements of removed subtrees. Some may have been inserted again
+  // since, under one of |inserted_roots|.
+  HeapHashSet<Member<Element>> removed_items;
+  // Elements whose attributes changed in a way that may affect membership.
+  HeapHashSet<Member<Element>> changed_elements;
+  unsigned count = 0;
+};
+
+HTMLCollection::PendingMutations* HTMLCollection::PendingMutationsForUpdate()
+    const {
+  if (!SupportsIncrementalCacheUpdate())
+    return nullptr;
+  if (!pending_mutations_)
+    pending_mutations_ = MakeGarbageCollected<PendingMutations>();
+  if (++pending_mutations_->count > PendingMutations::kMaxMutations)
+    return nullptr;
+  return pending_mutations_;
+}
+
+void HTMLCollection::ApplyPendingMutations() const {
+  PendingMutations* pending = pending_mutations_.Release();
+  DCHECK(pending);
+  DCHECK(collection_items_cache_.IsListValid());
+  ContainerNode& root = RootNode();
+
+  // Cached items that are no longer in the tree or may no longer match are
+  // dropped. The relative order of the remaining ones is unchanged: an item
+  // that moved was removed along with a subtree first.
+  HeapVector<Member<Element>> list;
+  list.ReserveInitialCapacity(collection_items_cache_.CachedList().size());
+  for (Element* item : collection_items_cache_.CachedList()) {
+    if (!pending->removed_items.Contains(item) &&
+        !pending->changed_elements.Contains(item)) {
+      list.push_back(item);
+    }
+  }
+
+  // The outermost inserted subtrees that are still under the root.
+  HeapVector<Member<Node>> inserted_roots;
+  for (Node* node : pending->inserted_roots) {
+    if (node->IsDescendantOf(&root) && !inserted_roots.Contains(node))
+      inserted_roots.push_back(node);
+  }
+  auto is_inside_inserted_root = [&inserted_roots](const Node& node) {
+    for (Node* inserted_root : inserted_roots) {
+      if (inserted_root != &node && inserted_root->contains(&node))
+        return true;
+    }
+    return false;
+  };
+
+  // Items to add, as runs that are each contiguous in document order and go
+  // in front of |list[position]|.
+  struct Run {
+    wtf_size_t begin;
+    wtf_size_t end;
+    wtf_size_t position;
+  };
+  Vector<Run> runs;
+  HeapVector<Member<Element>> added;
+  for (Node* inserted_root : inserted_roots) {
+    if (is_inside_inserted_root(*inserted_root))
+      continue;
+    wtf_size_t begin = added.size();
+    CollectMatchingElements(*inserted_root, added);
+    if (added.size() != begin)
+      runs.push_back(Run{begin, added.size(), 0});
+  }
+  for (Element* element : pending->changed_elements) {
+    if (element->IsDescendantOf(&root) && ElementMatches(*element) &&
+        !inserted_roots.Contains(element) &&
+        !is_inside_inserted_root(*element)) {
+      runs.push_back(Run{added.size(), added.size() + 1, 0});
+      added.push_back(element);
+    }
+  }
+
+  if (runs.IsEmpty()) {
+    collection_items_cache_.SetList(list);
+    return;
+  }
+
+  // None of |list| is inside a run, so each item either precedes or follows
+  // the whole run.
+  for (Run& run : runs) {
+    Element* first = added[run.begin];
+    run.position = static_cast<wtf_size_t>(
+        std::partition_point(list.begin(), list.end(),
+                             [first](const Member<Element>& item) {
+                               return first->compareDocumentPosition(item) &
+                                      Node::kDocumentPositionPreceding;
+                             }) -
+        list.begin());
+  }
+  std::sort(runs.begin(), runs.end(),
+            [&added](const Run& a, const Run& b) {
+              if (a.position != b.position)
+                return a.position < b.position;
+              return added[a.begin]->compareDocumentPosition(added[b.begin]) &
+                     Node::kDocumentPositionFollowing;
+            });
+
+  HeapVector<Member<Element>> merged;
+  merged.ReserveInitialCapacity(list.size() + added.size());
+  wtf_size_t next = 0;
+  for (const Run& run : runs) {
+    for (; next < run.position; ++next)
+      merged.push_back(list[next]);
+    for (wtf_size_t i = run.begin; i < run.end; ++i)
+      merged.push_back(added[i]);
+  }
+  for (; next < list.size(); ++next)
+    merged.push_back(list[next]);
+  collection_items_cache_.SetList(merged);
+}
+
+void HTMLCollection::InvalidateCacheForChildrenChange(
+    const ContainerNode& parent,
+    const ContainerNode::ChildrenChange& change) const {
+  PendingMutations* pending = nullptr;
+  if (change.IsChildInsertion() || change.IsChildRemoval())
+    pending = PendingMutationsForUpdate();
+  if (!pending) {
+    InvalidateCache();
+    return;
+  }
+  if (change.IsChildInsertion()) {
+    pending->inserted_roots.push_back(change.sibling_changed);
+  } else {
+    // |sibling_changed| is detached already, so whatever it contains has to
+    // be recorded now.
+    HeapVector<Member<Element>> removed_elements;
+    CollectMatchingElements(*change.sibling_changed, removed_elements);
+    for (Element* element : removed_elements)
+      pending->removed_items.insert(element);
+  }
+  InvalidateIdNameCacheMaps();
+}
+
+void HTMLCollection::InvalidateCacheForAttributeChange(
+    const QualifiedName& attr_name,
+    Element& owner) const {
+  if (!ShouldInvalidateTypeOnAttributeChange(InvalidationType(), attr_name)) {
+    InvalidateCacheForAttribute(&attr_name);
+    return;
+  }
+  PendingMutations* pending = PendingMutationsForUpdate();
+  if (!pending) {
+    InvalidateCache();
+    return;
+  }
+  pending->changed_elements.insert(&owner);
+  InvalidateIdNameCacheMaps();
+}
+
 Element* HTMLCollection::VirtualItemAfter(Element*) const {
   NOTREACHED();
   return nullptr;
@@ -547,6 +766,7 @@ HTMLCollection::NamedItemCache::NamedItemCache() = default;
 void HTMLCollection::Trace(Visitor* visitor) const {
   visitor->Trace(named_item_cache_);
   visitor->Trace(collection_items_cache_);
+  visitor->Trace(pending_mutations_);
   ScriptWrappable::Trace(visitor);
   LiveNodeListBase::Trace(visitor);
 }
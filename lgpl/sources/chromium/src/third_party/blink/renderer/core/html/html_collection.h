@@ -83,6 +83,15 @@ class CORE_EXPORT HTMLCollection : public ScriptWrappable,
   ~HTMLCollection() override;
   void InvalidateCache(Document* old_document = nullptr) const override;
   void InvalidateCacheForAttribute(const QualifiedName*) const;
+  // Called for child list and attribute mutations under RootNode(). When the
+  // full item list is cached and membership only depends on the elements
+  // themselves, the mutation is recorded and the list is brought up to date
+  // the next time the collection is read; otherwise the cache is invalidated.
+  void InvalidateCacheForChildrenChange(
+      const ContainerNode& parent,
+      const ContainerNode::ChildrenChange&) const;
+  void InvalidateCacheForAttributeChange(const QualifiedName&,
+                                         Element& owner) const;
 
   // DOM API
   unsigned length() const;
@@ -93,8 +102,12 @@ class CORE_EXPORT HTMLCollection : public ScriptWrappable,
 
   // Non-DOM API
   void NamedItems(const AtomicString& name, HeapVector<Member<Element>>&) const;
-  bool IsEmpty() const { return collection_items_cache_.IsEmpty(*this); }
+  bool IsEmpty() const {
+    ApplyPendingMutationsIfNeeded();
+    return collection_items_cache_.IsEmpty(*this);
+  }
   bool HasExactlyOneItem() const {
+    ApplyPendingMutationsIfNeeded();
     return collection_items_cache_.HasExactlyOneNode(*this);
   }
   bool ElementMatches(const Element&) const;
@@ -187,6 +200,20 @@ class CORE_EXPORT HTMLCollection : public ScriptWrappable,
   }
 
  private:
+  class PendingMutations;
+
+  bool SupportsIncrementalCacheUpdate() const;
+  // Returns nullptr if the mutation can't be recorded and the cache has to be
+  // invalidated instead.
+  PendingMutations* PendingMutationsForUpdate() const;
+  void ApplyPendingMutationsIfNeeded() const {
+    if (pending_mutations_)
+      ApplyPendingMutations();
+  }
+  void ApplyPendingMutations() const;
+  void CollectMatchingElements(Node& subtree_root,
+                               HeapVector<Member<Element>>& result) const;
+
   void InvalidateIdNameCacheMaps(Document* old_document = nullptr) const {
     if (!HasValidIdNameCache())
       return;
@@ -211,6 +238,8 @@ class CORE_EXPORT HTMLCollection : public ScriptWrappable,
   const unsigned should_only_include_direct_children_ : 1;
   mutable Member<NamedItemCache> named_item_cache_;
   mutable CollectionItemsCache<HTMLCollection, Element> collection_items_cache_;
+  // Mutations not reflected in |collection_items_cache_| yet.
+  mutable Member<PendingMutations> pending_mutations_;
 };
 
 template <>
@@ -0,0 +1,145 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/html/html_collection.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/dom/static_node_list.h"
+#include "third_party/blink/renderer/core/html/html_element.h"
+#include "third_party/blink/renderer/core/html_names.h"
+#include "third_party/blink/renderer/core/testing/page_test_base.h"
+#include "third_party/blink/renderer/platform/bindings/exception_state.h"
+
+namespace blink {
+
+class HTMLCollectionTest : public PageTestBase {
+ protected:
+  // Checks |collection| against a fresh, non-cached query for |selector|.
+  void ExpectItemsMatch(HTMLCollection& collection, const char* selector) {
+    StaticElementList* expected =
+        GetDocument().body()->QuerySelectorAll(selector, ASSERT_NO_EXCEPTION);
+    ASSERT_EQ(expected->length(), collection.length());
+    for (unsigned i = 0; i < expected->length(); ++i)
+      EXPECT_EQ(expected->item(i), collection.item(i)) << "index " << i;
+  }
+
+  Element* CreateRow(const char* class_name) {
+    Element* row = GetDocument().CreateRawElement(html_names::kDivTag);
+    row->setAttribute(html_names::kClassAttr, class_name);
+    return row;
+  }
+};
+
+TEST_F(HTMLCollectionTest, ClassCollectionTracksInsertions) {
+  SetBodyContent(
+      "<div id=grid><div class=row></div><div class=row></div></div>");
+  Element* grid = GetElementById("grid");
+  HTMLCollection* rows = GetDocument().body()->getElementsByClassName("row");
+  EXPECT_EQ(2u, rows->length());
+
+  grid->appendChild(CreateRow("row"));
+  ExpectItemsMatch(*rows, ".row");
+  grid->insertBefore(CreateRow("row"), grid->firstChild());
+  ExpectItemsMatch(*rows, ".row");
+  grid->insertBefore(CreateRow("other"), grid->firstChild());
+  ExpectItemsMatch(*rows, ".row");
+
+  // A subtree with matches at several depths.
+  Element* group = CreateRow("row");
+  group->appendChild(CreateRow("row"));
+  group->appendChild(CreateRow("other"));
+  group->lastChild()->appendChild(CreateRow("row"));
+  grid->insertBefore(group, grid->lastChild());
+  ExpectItemsMatch(*rows, ".row");
+}
+
+TEST_F(HTMLCollectionTest, ClassCollectionTracksRemovals) {
+  SetBodyContent(
+      "<div id=grid>"
+      "<div class=row id=first></div>"
+      "<div class=row id=group><div class=row></div><div class=row></div>"
+      "</div>"
+      "<div class=row id=last></div>"
+      "</div>");
+  HTMLCollection* rows = GetDocument().body()->getElementsByClassName("row");
+  EXPECT_EQ(5u, rows->length());
+
+  GetElementById("group")->remove();
+  ExpectItemsMatch(*rows, ".row");
+  GetElementById("last")->remove();
+  ExpectItemsMatch(*rows, ".row");
+  GetElementById("first")->remove();
+  ExpectItemsMatch(*rows, ".row");
+  EXPECT_EQ(0u, rows->length());
+}
+
+TEST_F(HTMLCollectionTest, ClassCollectionTracksClassChanges) {
+  SetBodyContent(
+      "<div class=row></div><div id=target></div><div class=row></div>");
+  HTMLCollection* rows = GetDocument().body()->getElementsByClassName("row");
+  EXPECT_EQ(2u, rows->length());
+
+  Element* target = GetElementById("target");
+  target->setAttribute(html_names::kClassAttr, "row");
+  ExpectItemsMatch(*rows, ".row");
+  EXPECT_EQ(target, rows->item(1));
+  target->setAttribute(html_names::kClassAttr, "other");
+  ExpectItemsMatch(*rows, ".row");
+}
+
+TEST_F(HTMLCollectionTest, TagCollectionTracksMovedSubtree) {
+  SetBodyContent(
+      "<div id=a><span></span><span></span></div>"
+      "<div id=b><span></span></div>");
+  HTMLCollection* spans = GetDocument().body()->getElementsByTagName("span");
+  EXPECT_EQ(3u, spans->length());
+
+  // Moving a node is a removal followed by an insertion.
+  GetElementById("b")->appendChild(GetElementById("a"));
+  ExpectItemsMatch(*spans, "span");
+}
+
+TEST_F(HTMLCollectionTest, ClassCollectionAppliesMutationsBetweenReads) {
+  SetBodyContent(
+      "<div id=grid>"
+      "<div class=row id=a><div class=row></div></div>"
+      "<div class=row id=b></div>"
+      "<div id=c></div>"
+      "</div>");
+  Element* grid = GetElementById("grid");
+  HTMLCollection* rows = GetDocument().body()->getElementsByClassName("row");
+  EXPECT_EQ(4u, rows->length());
+
+  // Several mutations before the next read, some of them undoing or moving
+  // the results of earlier ones.
+  Element* inserted = CreateRow("row");
+  inserted->appendChild(CreateRow("row"));
+  grid->insertBefore(inserted, GetElementById("b"));
+  GetElementById("c")->setAttribute(html_names::kClassAttr, "row");
+  GetElementById("b")->appendChild(GetElementById("a"));
+  inserted->firstChild()->appendChild(CreateRow("row"));
+  GetElementById("b")->setAttribute(html_names::kClassAttr, "other");
+  Element* removed_again = CreateRow("row");
+  grid->appendChild(removed_again);
+  removed_again->remove();
+  ExpectItemsMatch(*rows, ".row");
+
+  // A collection whose cache was dropped for too many mutations is rebuilt.
+  for (int i = 0; i < 100; ++i)
+    grid->insertBefore(CreateRow("row"), grid->firstChild());
+  ExpectItemsMatch(*rows, ".row");
+}
+
+TEST_F(HTMLCollectionTest, MutationsOutsideRootDoNotAffectCollection) {
+  SetBodyContent("<div id=root><p></p></div><div id=outside></div>");
+  HTMLCollection* paragraphs =
+      GetElementById("root")->getElementsByTagName("p");
+  EXPECT_EQ(1u, paragraphs->length());
+
+  GetElementById("outside")->appendChild(
+      GetDocument().CreateRawElement(html_names::kPTag));
+  EXPECT_EQ(1u, paragraphs->length());
+}
+
+}  // namespace blink
@@ -72,7 +72,8 @@ const QualifiedName& HTMLScriptElement::SubResourceAttributeName() const {
 
 void HTMLScriptElement::ChildrenChanged(const ChildrenChange& change) {
   HTMLElement::ChildrenChanged(change);
-  if (change.IsChildInsertion())
+  if (change.IsChildInsertion() ||
+      change.type == ChildrenChangeType::kAllChildrenInserted)
     loader_->ChildrenChanged();
 
   // We'll record whether the script element children were ever changed by
@@ -498,29 +498,36 @@ void InspectorNetworkAgent::Restore() {
 
 static std::unique_ptr<protocol::Network::ResourceTiming> BuildObjectForTiming(
     const ResourceLoadTiming& timing) {
-  return protocol::Network::ResourceTiming::create()
-      .setRequestTime(timing.RequestTime().since_origin().InSecondsF())
-      .setProxyStart(timing.CalculateMillisecondDelta(timing.ProxyStart()))
-      .setProxyEnd(timing.CalculateMillisecondDelta(timing.ProxyEnd()))
-      .setDnsStart(timing.CalculateMillisecondDelta(timing.DnsStart()))
-      .setDnsEnd(timing.CalculateMillisecondDelta(timing.DnsEnd()))
-      .setConnectStart(timing.CalculateMillisecondDelta(timing.ConnectStart()))
-      .setConnectEnd(timing.CalculateMillisecondDelta(timing.ConnectEnd()))
-      .setSslStart(timing.CalculateMillisecondDelta(timing.SslStart()))
-      .setSslEnd(timing.CalculateMillisecondDelta(timing.SslEnd()))
-      .setWorkerStart(timing.CalculateMillisecondDelta(timing.WorkerStart()))
-      .setWorkerReady(timing.CalculateMillisecondDelta(timing.WorkerReady()))
-      .setWorkerFetchStart(
-          timing.CalculateMillisecondDelta(timing.WorkerFetchStart()))
-      .setWorkerRespondWithSettled(
-          timing.CalculateMillisecondDelta(timing.WorkerRespondWithSettled()))
-      .setSendStart(timing.CalculateMillisecondDelta(timing.SendStart()))
-      .setSendEnd(timing.CalculateMillisecondDelta(timing.SendEnd()))
-      .setReceiveHeadersEnd(
-          timing.CalculateMillisecondDelta(timing.ReceiveHeadersEnd()))
-      .setPushStart(timing.PushStart().since_origin().InSecondsF())
-      .setPushEnd(timing.PushEnd().since_origin().InSecondsF())
-      .build();
+  std::unique_ptr<protocol::Network::ResourceTiming> result =
+      protocol::Network::ResourceTiming::create()
+          .setRequestTime(timing.RequestTime().since_origin().InSecondsF())
+          .setProxyStart(timing.CalculateMillisecondDelta(timing.ProxyStart()))
+          .setProxyEnd(timing.CalculateMillisecondDelta(timing.ProxyEnd()))
+          .setDnsStart(timing.CalculateMillisecondDelta(timing.DnsStart()))
+          .setDnsEnd(timing.CalculateMillisecondDelta(timing.DnsEnd()))
+          .setConnectStart(
+              timing.CalculateMillisecondDelta(timing.ConnectStart()))
+          .setConnectEnd(timing.CalculateMillisecondDelta(timing.ConnectEnd()))
+          .setSslStart(timing.CalculateMillisecondDelta(timing.SslStart()))
+          .setSslEnd(timing.CalculateMillisecondDelta(timing.SslEnd()))
+          .setWorkerStart(
+              timing.CalculateMillisecondDelta(timing.WorkerStart()))
+          .setWorkerReady(
+              timing.CalculateMillisecondDelta(timing.WorkerReady()))
+          .setWorkerFetchStart(
+              timing.CalculateMillisecondDelta(timing.WorkerFetchStart()))
+          .setWorkerRespondWithSettled(timing.CalculateMillisecondDelta(
+              timing.WorkerRespondWithSettled()))
+          .setSendStart(timing.CalculateMillisecondDelta(timing.SendStart()))
+          .setSendEnd(timing.CalculateMillisecondDelta(timing.SendEnd()))
+          .setReceiveHeadersEnd(
+              timing.CalculateMillisecondDelta(timing.ReceiveHeadersEnd()))
+          .setPushStart(timing.PushStart().since_origin().InSecondsF())
+          .setPushEnd(timing.PushEnd().since_origin().InSecondsF())
+          .build();
+  if (!timing.QueueingTime().is_zero())
+    result->setRendererQueueingTime(timing.QueueingTime().InMillisecondsF());
+  return result;
 }
 
 static bool FormDataToString(scoped_refptr<EncodedFormData> body,
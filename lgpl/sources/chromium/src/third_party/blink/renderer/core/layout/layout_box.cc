@@ -79,6 +79,7 @@
 #include "third_party/blink/renderer/core/layout/ng/ng_constraint_space.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_fragmentation_utils.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_layout_result.h"
+#include "third_party/blink/renderer/core/layout/ng/ng_measure_result_cache.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_layout_utils.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_length_utils.h"
 #include "third_party/blink/renderer/core/layout/shapes/shape_outside_info.h"
@@ -248,6 +249,8 @@ LayoutBoxRareData::LayoutBoxRareData()
       snap_container_(nullptr),
       snap_areas_(nullptr) {}
 
+LayoutBoxRareData::~LayoutBoxRareData() = default;
+
 void LayoutBoxRareData::Trace(Visitor* visitor) const {
   visitor->Trace(layout_child_);
 }
@@ -300,9 +303,15 @@ void LayoutBox::WillBeDestroyed() {
     }
     if (measure_result_)
       measure_result_->PhysicalFragment().LayoutObjectWillBeDestroyed();
+    if (NGMeasureResultCache* cache = GetMeasureResultCache()) {
+      for (const auto& result : cache->Entries())
+        result->PhysicalFragment().LayoutObjectWillBeDestroyed();
+    }
     for (auto result : layout_results_)
       result->PhysicalFragment().LayoutObjectWillBeDestroyed();
   }
+  if (NGMeasureResultCache* cache = GetMeasureResultCache())
+    cache->Clear();
 
   SetSnapContainer(nullptr);
   LayoutBoxModelObject::WillBeDestroyed();
@@ -2581,16 +2590,29 @@ void LayoutBox::SetCachedLayoutResult(
       NGCacheSlot::kMeasure) {
     // We don't early return here, when setting the "measure" result we also
     // set the "layout" result.
-    if (measure_result_)
-      InvalidateItems(*measure_result_);
+    if (measure_result_) {
+      // If we are only being measured again because our constraint space
+      // changed, the previous result is still valid and may be reused if our
+      // parent goes back to it. Otherwise all previous results are stale.
+      if (NeedsLayout()) {
+        ClearMeasureResults();
+      } else {
+        if (!GetMeasureResultCache()) {
+          EnsureRareData().measure_result_cache_ =
+              std::make_unique<NGMeasureResultCache>();
+        }
+        if (scoped_refptr<const NGLayoutResult> removed =
+                rare_data_->measure_result_cache_->Add(
+                    std::move(measure_result_)))
+          InvalidateItems(*removed);
+      }
+    }
     measure_result_ = result;
   } else {
     // We have a "layout" result, and we may need to clear the old "measure"
     // result if we needed non-simplified layout.
-    if (measure_result_ && NeedsLayout() && !NeedsSimplifiedLayoutOnly()) {
-      InvalidateItems(*measure_result_);
-      measure_result_ = nullptr;
-    }
+    if (measure_result_ && NeedsLayout() && !NeedsSimplifiedLayoutOnly())
+      ClearMeasureResults();
   }
 
   AddLayoutResult(std::move(result), 0);
@@ -2646,11 +2668,24 @@ void LayoutBox::ReplaceLayoutResult(scoped_refptr<const NGLayoutResult> result,
 }
 
 void LayoutBox::ClearLayoutResults() {
+  ClearMeasureResults();
+  ShrinkLayoutResults(0);
+}
+
+NGMeasureResultCache* LayoutBox::GetMeasureResultCache() const {
+  return rare_data_ ? rare_data_->measure_result_cache_.get() : nullptr;
+}
+
+void LayoutBox::ClearMeasureResults() {
   if (measure_result_)
     InvalidateItems(*measure_result_);
   measure_result_ = nullptr;
 
-  ShrinkLayoutResults(0);
+  if (NGMeasureResultCache* cache = GetMeasureResultCache()) {
+    for (const auto& result : cache->Entries())
+      InvalidateItems(*result);
+    cache->Clear();
+  }
 }
 
 void LayoutBox::ShrinkLayoutResults(wtf_size_t results_to_keep) {
@@ -2730,6 +2765,50 @@ scoped_refptr<const NGLayoutResult> LayoutBox::CachedLayoutResult(
   if (early_break)
     return nullptr;
 
+  scoped_refptr<const NGLayoutResult> result = CachedLayoutResultFrom(
+      cached_layout_result, use_layout_cache_slot, new_space,
+      initial_fragment_geometry, out_cache_status);
+  if (result || use_layout_cache_slot)
+    return result;
+  return CachedLayoutResultFromMeasureCache(
+      new_space, initial_fragment_geometry, out_cache_status);
+}
+
+scoped_refptr<const NGLayoutResult>
+LayoutBox::CachedLayoutResultFromMeasureCache(
+    const NGConstraintSpace& new_space,
+    base::Optional<NGFragmentGeometry>* initial_fragment_geometry,
+    NGLayoutCacheStatus* out_cache_status) {
+  NGMeasureResultCache* cache = GetMeasureResultCache();
+  // Older results are only kept while we are layout clean, see
+  // SetCachedLayoutResult().
+  if (!cache || cache->IsEmpty() || NeedsLayout())
+    return nullptr;
+
+  scoped_refptr<const NGLayoutResult> result;
+  cache->Find(new_space, [&](const NGLayoutResult& entry) {
+    result = CachedLayoutResultFrom(&entry, /* use_layout_cache_slot */ false,
+                                    new_space, initial_fragment_geometry,
+                                    out_cache_status);
+    // An older result can only be reused as is. It can't be the input to
+    // "simplified" layout or line reuse, as our children have been laid out
+    // since.
+    if (result && *out_cache_status == NGLayoutCacheStatus::kHit)
+      return true;
+    result = nullptr;
+    *out_cache_status = NGLayoutCacheStatus::kNeedsLayout;
+    return false;
+  });
+  return result;
+}
+
+scoped_refptr<const NGLayoutResult> LayoutBox::CachedLayoutResultFrom(
+    const NGLayoutResult* cached_layout_result,
+    bool use_layout_cache_slot,
+    const NGConstraintSpace& new_space,
+    base::Optional<NGFragmentGeometry>* initial_fragment_geometry,
+    NGLayoutCacheStatus* out_cache_status) {
+  *out_cache_status = NGLayoutCacheStatus::kNeedsLayout;
   DCHECK_EQ(cached_layout_result->Status(), NGLayoutResult::kSuccess);
 
   // Set our initial temporary cache status to "hit".
@@ -47,6 +47,7 @@ class NGBreakToken;
 struct NGFragmentGeometry;
 enum class NGLayoutCacheStatus;
 class NGLayoutResult;
+class NGMeasureResultCache;
 struct NGPhysicalBoxStrut;
 struct PaintInfo;
 
@@ -68,6 +69,7 @@ using SnapAreaSet = HashSet<LayoutBox*>;
 struct LayoutBoxRareData final : public GarbageCollected<LayoutBoxRareData> {
  public:
   LayoutBoxRareData();
+  ~LayoutBoxRareData();
 
   void Trace(Visitor* visitor) const;
 
@@ -116,6 +118,9 @@ struct LayoutBoxRareData final : public GarbageCollected<LayoutBoxRareData> {
   // layout upon. Only created if IsCustomItem() is true.
   Member<CustomLayoutChild> layout_child_;
 
+  // The "measure" layout results which precede LayoutBox::measure_result_.
+  std::unique_ptr<NGMeasureResultCache> measure_result_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(LayoutBoxRareData);
 };
 
@@ -996,6 +1001,10 @@ class CORE_EXPORT LayoutBox : public LayoutBoxModelObject {
   //
   // |out_cache_status| indicates what type of layout pass is required.
   //
+  // For the "measure" cache slot, older results which are still valid are
+  // also considered if the most recent one can't be reused. See
+  // NGMeasureResultCache.
+  //
   // TODO(ikilpatrick): Move this function into NGBlockNode.
   scoped_refptr<const NGLayoutResult> CachedLayoutResult(
       const NGConstraintSpace&,
@@ -1910,6 +1919,22 @@ class CORE_EXPORT LayoutBox : public LayoutBoxModelObject {
   friend class LayoutBoxTest;
 
  private:
+  // Checks if |cached_layout_result| can be reused for |new_space|, see
+  // CachedLayoutResult().
+  scoped_refptr<const NGLayoutResult> CachedLayoutResultFrom(
+      const NGLayoutResult* cached_layout_result,
+      bool use_layout_cache_slot,
+      const NGConstraintSpace& new_space,
+      base::Optional<NGFragmentGeometry>* initial_fragment_geometry,
+      NGLayoutCacheStatus* out_cache_status);
+  scoped_refptr<const NGLayoutResult> CachedLayoutResultFromMeasureCache(
+      const NGConstraintSpace& new_space,
+      base::Optional<NGFragmentGeometry>* initial_fragment_geometry,
+      NGLayoutCacheStatus* out_cache_status);
+  NGMeasureResultCache* GetMeasureResultCache() const;
+  // Drops |measure_result_| and all older "measure" results.
+  void ClearMeasureResults();
+
   LogicalToPhysicalSetter<LayoutUnit, LayoutBox> LogicalMarginToPhysicalSetter(
       const ComputedStyle* override_style) {
     const auto& style = override_style ? *override_style : StyleRef();
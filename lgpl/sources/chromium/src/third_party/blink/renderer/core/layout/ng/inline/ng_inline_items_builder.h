@@ -11,6 +11,7 @@
 #include "third_party/blink/renderer/core/layout/ng/inline/ng_line_height_metrics.h"
 #include "third_party/blink/renderer/core/layout/ng/inline/ng_offset_mapping_builder.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/scratch_allocator.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 #include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 #include "third_party/blink/renderer/platform/wtf/vector.h"
@@ -171,14 +172,16 @@ class NGInlineItemsBuilderTemplate {
     bool ShouldCreateBoxFragmentForChild(const BoxInfo& child) const;
     void SetShouldCreateBoxFragment(Vector<NGInlineItem>* items);
   };
-  Vector<BoxInfo> boxes_;
+  // |boxes_| and |bidi_context_| are only used while collecting inlines, so
+  // their backings come from the layout phase's scratch arena.
+  Vector<BoxInfo, 0, ScratchAllocator> boxes_;
 
   struct BidiContext {
     LayoutObject* node;
     UChar enter;
     UChar exit;
   };
-  Vector<BidiContext> bidi_context_;
+  Vector<BidiContext, 0, ScratchAllocator> bidi_context_;
 
   bool has_bidi_controls_ = false;
   bool has_ruby_ = false;
@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "base/trace_event/trace_event.h"
 #include "third_party/blink/renderer/core/frame/local_frame_view.h"
 #include "third_party/blink/renderer/core/html/forms/html_input_element.h"
 #include "third_party/blink/renderer/core/html/html_marquee_element.h"
@@ -455,8 +456,18 @@ scoped_refptr<const NGLayoutResult> NGBlockNode::Layout(
   bool before_layout_intrinsic_logical_widths_dirty =
       box_->IntrinsicLogicalWidthsDirty();
 
-  if (!layout_result)
-    layout_result = LayoutWithAlgorithm(params);
+  if (!layout_result) {
+    if (UNLIKELY(IsIndependentLayoutRoot(constraint_space))) {
+      // Instrumentation only: the subtree is laid out like any other, on this
+      // thread. The trace event shows how much of a layout pass is spent in
+      // subtrees that only depend on their constraint space.
+      TRACE_EVENT0("blink,benchmark",
+                   "NGBlockNode::Layout (instrumented independent root)");
+      layout_result = LayoutWithAlgorithm(params);
+    } else {
+      layout_result = LayoutWithAlgorithm(params);
+    }
+  }
 
   FinishLayout(block_flow, constraint_space, break_token, layout_result);
 
@@ -1309,6 +1320,19 @@ LogicalSize NGBlockNode::GetAspectRatio() const {
                      LayoutUnit(legacy_sizing_info.aspect_ratio.Height()));
 }
 
+bool NGBlockNode::IsIndependentLayoutRoot(
+    const NGConstraintSpace& constraint_space) const {
+  // Size containment makes the size of the box independent of its contents,
+  // and layout containment makes it the containing block of all its
+  // positioned descendants, and stops floats and margins from escaping.
+  // Fragmented boxes depend on the fragmentainer, and legacy layout may
+  // mutate the tree outside of the subtree.
+  if (!CanUseNewLayout() || constraint_space.HasBlockFragmentation())
+    return false;
+  return box_->ShouldApplySizeContainment() &&
+         box_->ShouldApplyLayoutContainment();
+}
+
 bool NGBlockNode::IsCustomLayoutLoaded() const {
   DCHECK(box_->IsLayoutNGCustom());
   return To<LayoutNGCustom>(box_)->IsLoaded();
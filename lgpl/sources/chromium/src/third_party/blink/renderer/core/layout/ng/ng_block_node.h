@@ -129,6 +129,13 @@ class CORE_EXPORT NGBlockNode final : public NGLayoutInputNode {
   // for the web-developer defined layout is ready).
   bool IsCustomLayoutLoaded() const;
 
+  // Returns true if the layout of this node with the given constraint space
+  // only depends on the constraint space and its own subtree, and nothing in
+  // the subtree can affect layout outside of it. This is the case for
+  // unfragmented boxes with both size and layout containment. Layout() only
+  // uses this to trace such subtrees; they are not scheduled separately.
+  bool IsIndependentLayoutRoot(const NGConstraintSpace&) const;
+
   // Get script type for scripts (msub, msup, msubsup, munder, mover and
   // munderover).
   MathScriptType ScriptType() const;
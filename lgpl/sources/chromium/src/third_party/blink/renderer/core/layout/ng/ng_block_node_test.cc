@@ -5,6 +5,8 @@
 #include "third_party/blink/renderer/core/layout/ng/ng_block_node.h"
 
 #include "third_party/blink/renderer/core/layout/min_max_sizes.h"
+#include "third_party/blink/renderer/core/layout/ng/ng_base_layout_algorithm_test.h"
+#include "third_party/blink/renderer/core/layout/ng/ng_constraint_space.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_layout_test.h"
 
 namespace blink {
@@ -184,5 +186,35 @@ TEST_F(NGBlockNodeForTest, MinAndMaxContent) {
   EXPECT_EQ(LayoutUnit(kWidth), sizes.min_size);
   EXPECT_EQ(LayoutUnit(kWidth), sizes.max_size);
 }
+
+TEST_F(NGBlockNodeForTest, IsIndependentLayoutRoot) {
+  SetBodyInnerHTML(R"HTML(
+    <!DOCTYPE html>
+    <div id=strict style="contain: strict; width: 100px; height: 50px"></div>
+    <div id=size-layout style="contain: size layout"></div>
+    <div id=layout-only style="contain: layout"></div>
+    <div id=size-only style="contain: size"></div>
+  )HTML");
+  NGConstraintSpace space = ConstructBlockLayoutTestConstraintSpace(
+      WritingMode::kHorizontalTb, TextDirection::kLtr,
+      LogicalSize(LayoutUnit(800), kIndefiniteSize));
+  auto is_independent = [&](const char* id) {
+    return NGBlockNode(ToLayoutBox(GetLayoutObjectByElementId(id)))
+        .IsIndependentLayoutRoot(space);
+  };
+  EXPECT_TRUE(is_independent("strict"));
+  EXPECT_TRUE(is_independent("size-layout"));
+  EXPECT_FALSE(is_independent("layout-only"));
+  EXPECT_FALSE(is_independent("size-only"));
+
+  // A fragmented box depends on the fragmentainer.
+  NGConstraintSpace fragmented_space = ConstructBlockLayoutTestConstraintSpace(
+      WritingMode::kHorizontalTb, TextDirection::kLtr,
+      LogicalSize(LayoutUnit(800), kIndefiniteSize), /* shrink_to_fit */ false,
+      /* is_new_formatting_context */ false,
+      /* fragmentainer_space_available */ LayoutUnit(100));
+  NGBlockNode strict(ToLayoutBox(GetLayoutObjectByElementId("strict")));
+  EXPECT_FALSE(strict.IsIndependentLayoutRoot(fragmented_space));
+}
 }  // namespace
 }  // namespace blink
@@ -2,10 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "third_party/blink/renderer/core/html_names.h"
 #include "third_party/blink/renderer/core/layout/ng/geometry/ng_fragment_geometry.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_layout_result.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_layout_test.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_layout_utils.h"
+#include "third_party/blink/renderer/core/layout/ng/ng_measure_result_cache.h"
 
 namespace blink {
 namespace {
@@ -1703,5 +1705,48 @@ TEST_F(NGLayoutResultCachingTest, HitOrthogonalRoot) {
   EXPECT_NE(result.get(), nullptr);
 }
 
+TEST_F(NGLayoutResultCachingTest, HitOlderMeasureResultInFlex) {
+  SetBodyInnerHTML(R"HTML(
+    <div id="container"
+         style="display: flex; flex-direction: column; width: 100px;">
+      <div id="item">text text text text text text text text</div>
+    </div>
+  )HTML");
+
+  Element* container = GetDocument().getElementById("container");
+  auto* item = To<LayoutBlockFlow>(GetLayoutObjectByElementId("item"));
+  NGMeasureResultCache::ResetStatsForTesting();
+
+  // Resizing the container measures the (clean) item with a new constraint
+  // space, and keeps the previous result.
+  container->setAttribute(
+      html_names::kStyleAttr,
+      "display: flex; flex-direction: column; width: 200px;");
+  UpdateAllLifecyclePhasesForTest();
+  const NGLayoutResult* measure_result_200 = item->GetCachedMeasureResult();
+  ASSERT_TRUE(measure_result_200);
+  EXPECT_EQ(0u, NGMeasureResultCache::GetStats().hits);
+  EXPECT_GE(NGMeasureResultCache::GetStats().live_entries, 1u);
+
+  // Going back to the original size reuses the older result.
+  container->setAttribute(
+      html_names::kStyleAttr,
+      "display: flex; flex-direction: column; width: 100px;");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_GE(NGMeasureResultCache::GetStats().hits, 1u);
+  EXPECT_EQ(measure_result_200, item->GetCachedMeasureResult());
+
+  // Changing the item itself invalidates all of its measure results.
+  GetDocument().getElementById("item")->setAttribute(html_names::kStyleAttr,
+                                                     "font-size: 20px");
+  UpdateAllLifecyclePhasesForTest();
+  size_t hits = NGMeasureResultCache::GetStats().hits;
+  container->setAttribute(
+      html_names::kStyleAttr,
+      "display: flex; flex-direction: column; width: 200px;");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_EQ(hits, NGMeasureResultCache::GetStats().hits);
+}
+
 }  // namespace
 }  // namespace blink
@@ -0,0 +1,139 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/layout/ng/ng_measure_result_cache.h"
+
+#include <utility>
+
+#include "third_party/blink/renderer/core/layout/ng/ng_constraint_space.h"
+#include "third_party/blink/renderer/core/layout/ng/ng_physical_box_fragment.h"
+#include "third_party/blink/renderer/platform/wtf/wtf.h"
+
+namespace blink {
+
+namespace {
+
+NGMeasureResultCache::Stats& MutableStats() {
+  // Layout only happens on the main thread.
+  DCHECK(IsMainThread());
+  static NGMeasureResultCache::Stats stats;
+  return stats;
+}
+
+// An estimate of the memory kept alive by |result|. The child fragments are
+// shared with other results of the children, so only the links are counted.
+size_t EstimatedSize(const NGLayoutResult& result) {
+  const auto& fragment = To<NGPhysicalBoxFragment>(result.PhysicalFragment());
+  return sizeof(NGLayoutResult) + sizeof(NGPhysicalBoxFragment) +
+         fragment.Children().size() * sizeof(NGLink);
+}
+
+void DidAddEntry(const NGLayoutResult& result) {
+  NGMeasureResultCache::Stats& stats = MutableStats();
+  stats.additions++;
+  stats.live_entries++;
+  stats.live_bytes += EstimatedSize(result);
+}
+
+void DidRemoveEntry(const NGLayoutResult& result) {
+  NGMeasureResultCache::Stats& stats = MutableStats();
+  DCHECK_GT(stats.live_entries, 0u);
+  stats.live_entries--;
+  stats.live_bytes -= EstimatedSize(result);
+}
+
+}  // namespace
+
+// static
+const NGMeasureResultCache::Stats& NGMeasureResultCache::GetStats() {
+  return MutableStats();
+}
+
+// static
+void NGMeasureResultCache::ResetStatsForTesting() {
+  Stats& stats = MutableStats();
+  Stats reset;
+  reset.live_entries = stats.live_entries;
+  reset.live_bytes = stats.live_bytes;
+  stats = reset;
+}
+
+NGMeasureResultCache::~NGMeasureResultCache() {
+  Clear();
+}
+
+scoped_refptr<const NGLayoutResult> NGMeasureResultCache::Add(
+    scoped_refptr<const NGLayoutResult> result) {
+  DCHECK(result);
+  DCHECK(!result->IsSingleUse());
+  DCHECK_EQ(result->GetConstraintSpaceForCaching().CacheSlot(),
+            NGCacheSlot::kMeasure);
+
+  // A result for the same sizes supersedes the older one.
+  const NGConstraintSpace& space = result->GetConstraintSpaceForCaching();
+  wtf_size_t index = kNotFound;
+  for (wtf_size_t i = 0; i < entries_.size(); ++i) {
+    if (MayReuseForSpace(*entries_[i], space)) {
+      index = i;
+      break;
+    }
+  }
+
+  // Replacing an entry doesn't change the number of live entries, so the
+  // budget only applies when this cache would grow. Check it before removing
+  // anything, so that at most one result ever needs to be invalidated.
+  if (index == kNotFound && entries_.size() < kCapacity &&
+      MutableStats().live_entries >= kMaxTotalEntries) {
+    MutableStats().rejected_over_budget++;
+    return result;
+  }
+
+  if (index == kNotFound && entries_.size() == kCapacity) {
+    index = entries_.size() - 1;
+    MutableStats().evictions++;
+  }
+
+  scoped_refptr<const NGLayoutResult> removed;
+  if (index != kNotFound) {
+    removed = std::move(entries_[index]);
+    entries_.EraseAt(index);
+    DidRemoveEntry(*removed);
+  }
+
+  DidAddEntry(*result);
+  entries_.push_front(std::move(result));
+  return removed;
+}
+
+void NGMeasureResultCache::Clear() {
+  for (const auto& entry : entries_)
+    DidRemoveEntry(*entry);
+  entries_.clear();
+}
+
+// static
+bool NGMeasureResultCache::MayReuseForSpace(const NGLayoutResult& result,
+                                            const NGConstraintSpace& space) {
+  const NGConstraintSpace& old_space = result.GetConstraintSpaceForCaching();
+  return old_space.AreSizesEqual(space) &&
+         old_space.AreSizeConstraintsEqual(space);
+}
+
+// static
+void NGMeasureResultCache::RecordLookup(bool hit) {
+  Stats& stats = MutableStats();
+  stats.lookups++;
+  if (hit)
+    stats.hits++;
+}
+
+void NGMeasureResultCache::MoveToFront(wtf_size_t index) {
+  if (!index)
+    return;
+  scoped_refptr<const NGLayoutResult> entry = std::move(entries_[index]);
+  entries_.EraseAt(index);
+  entries_.push_front(std::move(entry));
+}
+
+}  // namespace blink
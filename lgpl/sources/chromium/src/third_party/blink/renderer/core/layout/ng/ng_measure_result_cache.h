@@ -0,0 +1,105 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_LAYOUT_NG_NG_MEASURE_RESULT_CACHE_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_LAYOUT_NG_NG_MEASURE_RESULT_CACHE_H_
+
+#include "base/memory/scoped_refptr.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/core/layout/ng/ng_layout_result.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+class NGConstraintSpace;
+
+// Holds the "measure" layout results of a LayoutBox which precede its most
+// recent one (LayoutBox::GetCachedMeasureResult()).
+//
+// Flex and grid items are typically measured with a different constraint space
+// each time their container changes size, and containers which toggle between
+// a few sizes (e.g. when resizing between breakpoints) would otherwise throw
+// away results which are still valid.
+//
+// Entries are only valid as long as the subtree of the box is unchanged. The
+// owner must Clear() the cache whenever the box is laid out while it needs
+// layout.
+class CORE_EXPORT NGMeasureResultCache {
+  USING_FAST_MALLOC(NGMeasureResultCache);
+
+ public:
+  // The number of results kept per box, in addition to the most recent one.
+  static constexpr wtf_size_t kCapacity = 3;
+  // The number of results kept by all caches on the thread. Beyond this
+  // results are dropped instead of being added.
+  static constexpr size_t kMaxTotalEntries = 8192;
+
+  struct Stats {
+    size_t lookups = 0;
+    size_t hits = 0;
+    size_t additions = 0;
+    size_t evictions = 0;
+    size_t rejected_over_budget = 0;
+    // Entries currently held by all caches, and an estimate of the memory
+    // they keep alive.
+    size_t live_entries = 0;
+    size_t live_bytes = 0;
+  };
+  static const Stats& GetStats();
+  // Resets the counters, but not the live entry accounting.
+  static void ResetStatsForTesting();
+
+  NGMeasureResultCache() = default;
+  NGMeasureResultCache(const NGMeasureResultCache&) = delete;
+  NGMeasureResultCache& operator=(const NGMeasureResultCache&) = delete;
+  ~NGMeasureResultCache();
+
+  bool IsEmpty() const { return entries_.IsEmpty(); }
+  wtf_size_t size() const { return entries_.size(); }
+  const Vector<scoped_refptr<const NGLayoutResult>, kCapacity>& Entries()
+      const {
+    return entries_;
+  }
+
+  // Adds |result| as the most recently used entry. Returns the entry which
+  // was replaced or evicted to make room for it, or |result| itself if it was
+  // rejected because the thread-wide budget is exhausted. Either way the owner
+  // must invalidate the returned result, if any.
+  scoped_refptr<const NGLayoutResult> Add(
+      scoped_refptr<const NGLayoutResult> result);
+  void Clear();
+
+  // Calls |is_reusable| with the entries which may be reused for |space|, most
+  // recently used first, and returns the first one it accepts. The accepted
+  // entry becomes the most recently used one.
+  template <typename Predicate>
+  const NGLayoutResult* Find(const NGConstraintSpace& space,
+                             Predicate is_reusable) {
+    for (wtf_size_t i = 0; i < entries_.size(); ++i) {
+      const NGLayoutResult* entry = entries_[i].get();
+      if (!MayReuseForSpace(*entry, space) || !is_reusable(*entry))
+        continue;
+      MoveToFront(i);
+      RecordLookup(/* hit */ true);
+      return entry;
+    }
+    RecordLookup(/* hit */ false);
+    return nullptr;
+  }
+
+ private:
+  // Cheap check that the sizes in the constraint space match. The caller still
+  // performs the full cache check.
+  static bool MayReuseForSpace(const NGLayoutResult&, const NGConstraintSpace&);
+  static void RecordLookup(bool hit);
+
+  void MoveToFront(wtf_size_t index);
+
+  Vector<scoped_refptr<const NGLayoutResult>, kCapacity> entries_;
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_LAYOUT_NG_NG_MEASURE_RESULT_CACHE_H_
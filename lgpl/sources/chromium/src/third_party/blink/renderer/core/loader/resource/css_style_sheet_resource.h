@@ -65,6 +65,8 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
   void SaveParsedStyleSheet(StyleSheetContents*);
   network::mojom::ReferrerPolicy GetReferrerPolicy() const;
 
+  bool CanProcessResponseBodyInBackground() const override { return true; }
+
  private:
   class CSSStyleSheetResourceFactory : public ResourceFactory {
    public:
@@ -78,6 +78,9 @@ class CORE_EXPORT ScriptResource final : public TextResource {
   void ResponseBodyReceived(
       ResponseBodyLoaderDrainableInterface& body_loader,
       scoped_refptr<base::SingleThreadTaskRunner> loader_task_runner) override;
+  // The source is only decoded in SourceText(), once loading is finished, so
+  // the body can be assembled off the loading thread when it isn't streamed.
+  bool CanProcessResponseBodyInBackground() const override { return true; }
 
   void Trace(Visitor*) const override;
 
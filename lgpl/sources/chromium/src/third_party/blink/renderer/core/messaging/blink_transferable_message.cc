@@ -62,6 +62,8 @@ BlinkTransferableMessage BlinkTransferableMessage::FromMessageEvent(
   auto& stream_channels = serialized_script_value->GetStreamChannels();
   result.message->GetStreamChannels().AppendRange(stream_channels.begin(),
                                                   stream_channels.end());
+  result.message->GetStreamDataPipes() =
+      std::move(serialized_script_value->GetStreamDataPipes());
   // Array buffer contents array.
   auto& source_array_buffer_contents_array =
       serialized_script_value->GetArrayBufferContentsArray();
@@ -153,6 +155,9 @@ BlinkTransferableMessage BlinkTransferableMessage::FromTransferableMessage(
   result.ports.AppendRange(message.ports.begin(), message.ports.end());
   result.message->GetStreamChannels().AppendRange(
       message.stream_channels.begin(), message.stream_channels.end());
+  result.message->GetStreamDataPipes().AppendRange(
+      std::make_move_iterator(message.stream_data_pipes.begin()),
+      std::make_move_iterator(message.stream_data_pipes.end()));
   if (message.user_activation) {
     result.user_activation = mojom::blink::UserActivationSnapshot::New(
         message.user_activation->has_been_active,
@@ -33,6 +33,7 @@ bool StructTraits<blink::mojom::blink::TransferableMessage::DataView,
          blink::BlinkTransferableMessage* out) {
   Vector<blink::MessagePortDescriptor> ports;
   Vector<blink::MessagePortDescriptor> stream_channels;
+  blink::SerializedScriptValue::StreamDataPipeArray stream_data_pipes;
   blink::SerializedScriptValue::ArrayBufferContentsArray
       array_buffer_contents_array;
   Vector<SkBitmap> sk_bitmaps;
@@ -40,9 +41,14 @@ bool StructTraits<blink::mojom::blink::TransferableMessage::DataView,
       !data.ReadArrayBufferContentsArray(&array_buffer_contents_array) ||
       !data.ReadImageBitmapContentsArray(&sk_bitmaps) ||
       !data.ReadPorts(&ports) || !data.ReadStreamChannels(&stream_channels) ||
+      !data.ReadStreamDataPipes(&stream_data_pipes) ||
       !data.ReadUserActivation(&out->user_activation)) {
     return false;
   }
+  if (!stream_data_pipes.IsEmpty() &&
+      stream_data_pipes.size() != stream_channels.size()) {
+    return false;
+  }
 
   out->ports.ReserveInitialCapacity(ports.size());
   out->ports.AppendRange(std::make_move_iterator(ports.begin()),
@@ -50,6 +56,7 @@ bool StructTraits<blink::mojom::blink::TransferableMessage::DataView,
   out->message->GetStreamChannels().AppendRange(
       std::make_move_iterator(stream_channels.begin()),
       std::make_move_iterator(stream_channels.end()));
+  out->message->GetStreamDataPipes() = std::move(stream_data_pipes);
   out->transfer_user_activation = data.transfer_user_activation();
   out->allow_autoplay = data.allow_autoplay();
 
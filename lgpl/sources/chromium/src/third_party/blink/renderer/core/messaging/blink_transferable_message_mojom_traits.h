@@ -46,6 +46,11 @@ struct CORE_EXPORT
     return result;
   }
 
+  static blink::SerializedScriptValue::StreamDataPipeArray stream_data_pipes(
+      blink::BlinkTransferableMessage& input) {
+    return std::move(input.message->GetStreamDataPipes());
+  }
+
   static const blink::SerializedScriptValue::ArrayBufferContentsArray&
   array_buffer_contents_array(const blink::BlinkCloneableMessage& input) {
     return input.message->GetArrayBufferContentsArray();
@@ -9,6 +9,7 @@
 
 #include "base/metrics/histogram_functions.h"
 #include "third_party/blink/public/platform/platform.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_offscreen_canvas_frame_pacing_stats.h"
 #include "third_party/blink/renderer/core/css/css_font_selector.h"
 #include "third_party/blink/renderer/core/css/offscreen_font_selector.h"
 #include "third_party/blink/renderer/core/css/style_engine.h"
@@ -25,6 +26,7 @@
 #include "third_party/blink/renderer/core/html/canvas/ukm_parameters.h"
 #include "third_party/blink/renderer/core/imagebitmap/image_bitmap.h"
 #include "third_party/blink/renderer/core/workers/dedicated_worker_global_scope.h"
+#include "third_party/blink/renderer/platform/bindings/exception_state.h"
 #include "third_party/blink/renderer/platform/bindings/microtask.h"
 #include "third_party/blink/renderer/platform/graphics/canvas_resource_dispatcher.h"
 #include "third_party/blink/renderer/platform/graphics/canvas_resource_provider.h"
@@ -36,18 +38,31 @@
 #include "third_party/blink/renderer/platform/image-encoders/image_encoder_utils.h"
 #include "third_party/blink/renderer/platform/instrumentation/histogram.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/wtf/math_extras.h"
 #include "third_party/skia/include/core/SkFilterQuality.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace blink {
 
+namespace {
+
+// With OffscreenCanvasFramePacing, a frame can be produced while the previous
+// two are still in flight to the compositor.
+constexpr int kFramePacingMaxPendingFrames = 3;
+
+}  // namespace
+
 OffscreenCanvas::OffscreenCanvas(ExecutionContext* context, const IntSize& size)
     : CanvasRenderingContextHost(
           CanvasRenderingContextHost::HostType::kOffscreenCanvasHost,
           base::make_optional<UkmParameters>()),
       execution_context_(context),
-      size_(size) {
+      size_(size),
+      max_pending_frames_(
+          RuntimeEnabledFeatures::OffscreenCanvasFramePacingEnabled()
+              ? kFramePacingMaxPendingFrames
+              : CanvasResourceDispatcher::kDefaultMaxPendingCompositorFrames) {
   // Other code in Blink watches for destruction of the context; be
   // robust here as well.
   if (!context->IsContextDestroyed()) {
@@ -93,10 +108,23 @@ void OffscreenCanvas::Commit(scoped_refptr<CanvasResource> canvas_resource,
 
   base::TimeTicks commit_start_time = base::TimeTicks::Now();
   current_frame_damage_rect_.join(damage_rect);
-  GetOrCreateResourceDispatcher()->DispatchFrameSync(
-      std::move(canvas_resource), commit_start_time, current_frame_damage_rect_,
-      !RenderingContext()->IsOriginTopLeft() /* needs_vertical_flip */,
-      IsOpaque());
+  CanvasResourceDispatcher* dispatcher = GetOrCreateResourceDispatcher();
+  // With frame pacing, commit() does not block the worker. A frame committed
+  // while every buffer is in flight waits for the next ack, so that no more
+  // than the maximum number of frames are pending.
+  if (RuntimeEnabledFeatures::OffscreenCanvasFramePacingEnabled()) {
+    dispatcher->DispatchOrDeferFrame(
+        std::move(canvas_resource), commit_start_time,
+        current_frame_damage_rect_,
+        !RenderingContext()->IsOriginTopLeft() /* needs_vertical_flip */,
+        IsOpaque());
+  } else {
+    dispatcher->DispatchFrameSync(
+        std::move(canvas_resource), commit_start_time,
+        current_frame_damage_rect_,
+        !RenderingContext()->IsOriginTopLeft() /* needs_vertical_flip */,
+        IsOpaque());
+  }
   current_frame_damage_rect_ = SkIRect::MakeEmpty();
 }
 
@@ -346,6 +374,7 @@ CanvasResourceDispatcher* OffscreenCanvas::GetOrCreateResourceDispatcher() {
     // throughout the lifetime of this OffscreenCanvas.
     frame_dispatcher_ = std::make_unique<CanvasResourceDispatcher>(
         this, client_id_, sink_id_, placeholder_canvas_id_, size_);
+    frame_dispatcher_->SetMaxPendingCompositorFrames(max_pending_frames_);
 
     if (HasPlaceholderCanvas())
       frame_dispatcher_->SetPlaceholderCanvasDispatcher(placeholder_canvas_id_);
@@ -418,6 +447,7 @@ CanvasResourceProvider* OffscreenCanvas::GetOrCreateResourceProvider() {
                               ResourceProvider()->IsAccelerated());
     base::UmaHistogramEnumeration("Blink.Canvas.ResourceProviderType",
                                   ResourceProvider()->GetType());
+    ResourceProvider()->SetMaxRecycledResources(max_pending_frames_);
     ResourceProvider()->Clear();
     DidDraw();
 
@@ -484,6 +514,48 @@ bool OffscreenCanvas::PushFrame(scoped_refptr<CanvasResource> canvas_resource,
   return true;
 }
 
+void OffscreenCanvas::setMaxPendingFrames(unsigned max_pending_frames,
+                                          ExceptionState& exception_state) {
+  if (max_pending_frames < 1 ||
+      max_pending_frames >
+          CanvasResourceDispatcher::kMaxPendingCompositorFramesLimit) {
+    exception_state.ThrowRangeError(
+        "The number of pending frames must be between 1 and " +
+        String::Number(
+            CanvasResourceDispatcher::kMaxPendingCompositorFramesLimit) +
+        ".");
+    return;
+  }
+  max_pending_frames_ = max_pending_frames;
+  if (frame_dispatcher_)
+    frame_dispatcher_->SetMaxPendingCompositorFrames(max_pending_frames_);
+  if (ResourceProvider())
+    ResourceProvider()->SetMaxRecycledResources(max_pending_frames_);
+}
+
+OffscreenCanvasFramePacingStats* OffscreenCanvas::getFramePacingStats() const {
+  auto* stats = OffscreenCanvasFramePacingStats::Create();
+  stats->setMaxPendingFrames(max_pending_frames_);
+  // Frames are only dispatched to the compositor once control was transferred
+  // from a placeholder canvas.
+  if (!frame_dispatcher_)
+    return stats;
+
+  const CanvasResourceDispatcher::FramePacingStatistics& statistics =
+      frame_dispatcher_->frame_pacing_statistics();
+  stats->setFramesSubmitted(statistics.frames_submitted);
+  stats->setFramesPresented(statistics.frames_presented);
+  stats->setFramesDropped(statistics.frames_dropped);
+  stats->setPendingFrames(frame_dispatcher_->PendingCompositorFrames());
+  stats->setBackPressure(frame_dispatcher_->HasTooManyPendingFrames());
+  if (statistics.frames_presented) {
+    stats->setAverageLatency(statistics.total_latency.InMillisecondsF() /
+                             statistics.frames_presented);
+  }
+  stats->setMaxLatency(statistics.max_latency.InMillisecondsF());
+  return stats;
+}
+
 bool OffscreenCanvas::ShouldAccelerate2dContext() const {
   base::WeakPtr<WebGraphicsContext3DProviderWrapper> context_provider_wrapper =
       SharedGpuContext::ContextProviderWrapper();
@@ -24,6 +24,7 @@ namespace blink {
 class CanvasContextCreationAttributesCore;
 class CanvasResourceProvider;
 class ImageBitmap;
+class OffscreenCanvasFramePacingStats;
 #if defined(SUPPORT_WEBGL2_COMPUTE_CONTEXT)
 class
     OffscreenCanvasRenderingContext2DOrWebGLRenderingContextOrWebGL2RenderingContextOrWebGL2ComputeRenderingContextOrImageBitmapRenderingContext;
@@ -67,6 +68,9 @@ class CORE_EXPORT OffscreenCanvas final
 
   // API Methods
   ImageBitmap* transferToImageBitmap(ScriptState*, ExceptionState&);
+  unsigned maxPendingFrames() const { return max_pending_frames_; }
+  void setMaxPendingFrames(unsigned, ExceptionState&);
+  OffscreenCanvasFramePacingStats* getFramePacingStats() const;
 
   const IntSize& Size() const override { return size_; }
   void SetSize(const IntSize&);
@@ -193,6 +197,8 @@ class CORE_EXPORT OffscreenCanvas final
         // If we are blocked with too many frames, we must stop.
         if (canvas->GetOrCreateResourceDispatcher()
                 ->HasTooManyPendingFrames()) {
+          canvas->GetOrCreateResourceDispatcher()
+              ->DidDropFrameForBackPressure();
           abort_raf_ = true;
           return false;
         }
@@ -247,6 +253,10 @@ class CORE_EXPORT OffscreenCanvas final
 
   SkIRect current_frame_damage_rect_;
 
+  // Frames which may be in flight to the compositor, and resources kept for
+  // recycling, before the producer is throttled.
+  int max_pending_frames_;
+
   bool needs_matrix_clip_restore_ = false;
   bool needs_push_frame_ = false;
   bool inside_worker_raf_ = false;
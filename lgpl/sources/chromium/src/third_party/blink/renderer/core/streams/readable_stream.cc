@@ -1150,6 +1150,7 @@ ReadableStream* ReadableStream::CreateWithCountQueueingStrategy(
       ToV8(underlying_source, script_state);
 
   auto* stream = MakeGarbageCollected<ReadableStream>();
+  stream->native_underlying_source_ = underlying_source;
   stream->InitInternal(
       script_state,
       ScriptValue(script_state->GetIsolate(), underlying_source_v8),
@@ -1617,6 +1618,24 @@ void ReadableStream::Serialize(ScriptState* script_state,
   promise.MarkAsHandled();
 }
 
+mojo::ScopedDataPipeConsumerHandle ReadableStream::SerializeAsDataPipe(
+    ScriptState* script_state,
+    MessagePort* port,
+    ExceptionState& exception_state) {
+  if (!native_underlying_source_ || IsLocked(this) || IsDisturbed(this))
+    return {};
+
+  mojo::ScopedDataPipeConsumerHandle data_pipe;
+  BytesConsumer* consumer =
+      native_underlying_source_->DrainAsDataPipe(&data_pipe, exception_state);
+  if (!consumer)
+    return {};
+  DCHECK(data_pipe.is_valid());
+
+  ForwardCrossRealmDataPipeEnd(script_state, consumer, port);
+  return data_pipe;
+}
+
 ReadableStream* ReadableStream::Deserialize(ScriptState* script_state,
                                             MessagePort* port,
                                             ExceptionState& exception_state) {
@@ -1654,6 +1673,7 @@ v8::Local<v8::Value> ReadableStream::GetStoredError(
 void ReadableStream::Trace(Visitor* visitor) const {
   visitor->Trace(readable_stream_controller_);
   visitor->Trace(reader_);
+  visitor->Trace(native_underlying_source_);
   visitor->Trace(stored_error_);
   ScriptWrappable::Trace(visitor);
 }
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include "base/optional.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_value.h"
 #include "third_party/blink/renderer/core/streams/readable_stream_default_reader.h"
 #include "third_party/blink/renderer/platform/bindings/script_wrappable.h"
@@ -157,6 +158,14 @@ class CORE_EXPORT ReadableStream : public ScriptWrappable {
 
   void Serialize(ScriptState*, MessagePort* port, ExceptionState&);
 
+  // Used instead of Serialize() for streams whose native source reads from a
+  // mojo data pipe: the pipe is returned to be moved to the other realm, and
+  // only the end of the stream is posted on |port|. Returns an invalid handle,
+  // leaving the stream untouched, for other streams.
+  mojo::ScopedDataPipeConsumerHandle SerializeAsDataPipe(ScriptState*,
+                                                         MessagePort* port,
+                                                         ExceptionState&);
+
   static ReadableStream* Deserialize(ScriptState*,
                                      MessagePort* port,
                                      ExceptionState&);
@@ -284,6 +293,8 @@ class CORE_EXPORT ReadableStream : public ScriptWrappable {
   State state_ = kReadable;
   Member<ReadableStreamDefaultController> readable_stream_controller_;
   Member<ReadableStreamReader> reader_;
+  // The source passed to CreateWithCountQueueingStrategy(), if any.
+  Member<UnderlyingSourceBase> native_underlying_source_;
   TraceWrapperV8Reference<v8::Value> stored_error_;
 };
 
@@ -14,6 +14,7 @@
 #include "third_party/blink/renderer/core/dom/dom_exception.h"
 #include "third_party/blink/renderer/core/dom/events/native_event_listener.h"
 #include "third_party/blink/renderer/core/events/message_event.h"
+#include "third_party/blink/renderer/core/execution_context/execution_context_lifecycle_observer.h"
 #include "third_party/blink/renderer/core/messaging/message_port.h"
 #include "third_party/blink/renderer/core/streams/miscellaneous_operations.h"
 #include "third_party/blink/renderer/core/streams/promise_handler.h"
@@ -27,7 +28,9 @@
 #include "third_party/blink/renderer/platform/bindings/script_state.h"
 #include "third_party/blink/renderer/platform/bindings/v8_binding.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
+#include "third_party/blink/renderer/platform/heap/self_keep_alive.h"
 #include "third_party/blink/renderer/platform/heap/visitor.h"
+#include "third_party/blink/renderer/platform/loader/fetch/bytes_consumer.h"
 #include "third_party/blink/renderer/platform/wtf/assertions.h"
 #include "v8/include/v8.h"
 
@@ -861,6 +864,145 @@ void CrossRealmTransformReadable::HandleError(v8::Local<v8::Value> error) {
   ReadableStreamDefaultController::Error(script_state_, controller_, error);
 }
 
+// Class for the sending side of a stream whose bytes were moved to the other
+// realm in a mojo data pipe. The drained BytesConsumer still receives the
+// completion signal of the body, which is forwarded to the peer as a kClose or
+// kError message. No chunks are sent, and the values of the messages are
+// always undefined.
+class CrossRealmDataPipeEndForwarder final
+    : public GarbageCollected<CrossRealmDataPipeEndForwarder>,
+      public ExecutionContextLifecycleObserver,
+      public BytesConsumer::Client {
+  USING_GARBAGE_COLLECTED_MIXIN(CrossRealmDataPipeEndForwarder);
+
+ public:
+  CrossRealmDataPipeEndForwarder(ScriptState* script_state,
+                                 BytesConsumer* consumer,
+                                 MessagePort* port)
+      : ExecutionContextLifecycleObserver(ExecutionContext::From(script_state)),
+        script_state_(script_state),
+        consumer_(consumer),
+        message_port_(port),
+        keep_alive_(PERSISTENT_FROM_HERE, this) {}
+
+  void Start() {
+    consumer_->SetClient(this);
+    // The consumer may already have ended while it was being drained.
+    if (consumer_->GetPublicState() !=
+        BytesConsumer::PublicState::kReadableOrWaiting) {
+      OnStateChange();
+    }
+  }
+
+  // BytesConsumer::Client
+  void OnStateChange() override {
+    const BytesConsumer::PublicState state = consumer_->GetPublicState();
+    if (state == BytesConsumer::PublicState::kReadableOrWaiting)
+      return;
+    const MessageType type = state == BytesConsumer::PublicState::kClosed
+                                 ? MessageType::kClose
+                                 : MessageType::kError;
+
+    if (script_state_->ContextIsValid()) {
+      ScriptState::Scope scope(script_state_);
+      ExceptionState exception_state(script_state_->GetIsolate(),
+                                     ExceptionState::kUnknownContext, "", "");
+      PackAndPostMessage(script_state_, message_port_, type,
+                         v8::Undefined(script_state_->GetIsolate()),
+                         exception_state);
+      if (exception_state.HadException()) {
+        DLOG(WARNING) << "Ignoring exception from PackAndPostMessage";
+        exception_state.ClearException();
+      }
+      message_port_->close();
+    }
+    Stop();
+  }
+  String DebugName() const override { return "CrossRealmDataPipeEndForwarder"; }
+
+  // ExecutionContextLifecycleObserver
+  void ContextDestroyed() override { Stop(); }
+
+  void Trace(Visitor* visitor) const override {
+    visitor->Trace(script_state_);
+    visitor->Trace(consumer_);
+    visitor->Trace(message_port_);
+    ExecutionContextLifecycleObserver::Trace(visitor);
+    BytesConsumer::Client::Trace(visitor);
+  }
+
+ private:
+  void Stop() {
+    consumer_->ClearClient();
+    keep_alive_.Clear();
+  }
+
+  const Member<ScriptState> script_state_;
+  const Member<BytesConsumer> consumer_;
+  const Member<MessagePort> message_port_;
+  // Nothing else refers to the drained consumer, so this object keeps it alive
+  // until the body ends.
+  SelfKeepAlive<CrossRealmDataPipeEndForwarder> keep_alive_;
+};
+
+// Class for the receiving side of a stream whose bytes were moved from the
+// other realm in a mojo data pipe. The stream reads the pipe itself; this only
+// relays the end of the body, as sent by CrossRealmDataPipeEndForwarder, to the
+// consumer of the pipe.
+class CrossRealmDataPipeEndReceiver final : public CrossRealmTransformStream {
+ public:
+  CrossRealmDataPipeEndReceiver(
+      ScriptState* script_state,
+      MessagePort* port,
+      DataPipeBytesConsumer::CompletionNotifier* notifier)
+      : script_state_(script_state), message_port_(port), notifier_(notifier) {}
+
+  void Start() {
+    message_port_->setOnmessage(
+        MakeGarbageCollected<CrossRealmTransformMessageListener>(this));
+    message_port_->setOnmessageerror(
+        MakeGarbageCollected<CrossRealmTransformErrorListener>(this));
+  }
+
+  ScriptState* GetScriptState() const override { return script_state_; }
+  MessagePort* GetMessagePort() const override { return message_port_; }
+
+  void HandleMessage(MessageType type, v8::Local<v8::Value>) override {
+    switch (type) {
+      case MessageType::kClose:
+        notifier_->SignalComplete();
+        message_port_->close();
+        return;
+
+      case MessageType::kError:
+        notifier_->SignalError(BytesConsumer::Error("network error"));
+        message_port_->close();
+        return;
+
+      default:
+        DLOG(WARNING) << "Invalid message from peer ignored (invalid type): "
+                      << static_cast<int>(type);
+        return;
+    }
+  }
+
+  void HandleError(v8::Local<v8::Value>) override {
+    notifier_->SignalError(BytesConsumer::Error("network error"));
+  }
+
+  void Trace(Visitor* visitor) const override {
+    visitor->Trace(script_state_);
+    visitor->Trace(message_port_);
+    visitor->Trace(notifier_);
+    CrossRealmTransformStream::Trace(visitor);
+  }
+
+ private:
+  const Member<ScriptState> script_state_;
+  const Member<MessagePort> message_port_;
+  const Member<DataPipeBytesConsumer::CompletionNotifier> notifier_;
+};
+
 }  // namespace
 
 CORE_EXPORT WritableStream* CreateCrossRealmTransformWritable(
@@ -879,4 +1021,21 @@ CORE_EXPORT ReadableStream* CreateCrossRealmTransformReadable(
       ->CreateReadableStream(exception_state);
 }
 
+CORE_EXPORT void ForwardCrossRealmDataPipeEnd(ScriptState* script_state,
+                                              BytesConsumer* consumer,
+                                              MessagePort* port) {
+  MakeGarbageCollected<CrossRealmDataPipeEndForwarder>(script_state, consumer,
+                                                       port)
+      ->Start();
+}
+
+CORE_EXPORT void ReceiveCrossRealmDataPipeEnd(
+    ScriptState* script_state,
+    MessagePort* port,
+    DataPipeBytesConsumer::CompletionNotifier* notifier) {
+  MakeGarbageCollected<CrossRealmDataPipeEndReceiver>(script_state, port,
+                                                      notifier)
+      ->Start();
+}
+
 }  // namespace blink
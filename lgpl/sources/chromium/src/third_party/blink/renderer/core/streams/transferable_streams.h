@@ -8,9 +8,11 @@
 #define THIRD_PARTY_BLINK_RENDERER_CORE_STREAMS_TRANSFERABLE_STREAMS_H_
 
 #include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/platform/loader/fetch/data_pipe_bytes_consumer.h"
 
 namespace blink {
 
+class BytesConsumer;
 class ExceptionState;
 class MessagePort;
 class ReadableStream;
@@ -30,6 +32,21 @@ CORE_EXPORT ReadableStream* CreateCrossRealmTransformReadable(ScriptState*,
                                                               MessagePort* port,
                                                               ExceptionState&);
 
+// Used instead of the above when the bytes of a stream are moved to the other
+// realm in a mojo data pipe, so that only the end of the stream is sent over
+// |port|. Posts a close or error message on |port| once |consumer|, whose data
+// pipe has been drained, is closed or errored.
+CORE_EXPORT void ForwardCrossRealmDataPipeEnd(ScriptState*,
+                                              BytesConsumer* consumer,
+                                              MessagePort* port);
+
+// Signals |notifier| when the message posted by ForwardCrossRealmDataPipeEnd()
+// arrives on |port|.
+CORE_EXPORT void ReceiveCrossRealmDataPipeEnd(
+    ScriptState*,
+    MessagePort* port,
+    DataPipeBytesConsumer::CompletionNotifier* notifier);
+
 }  // namespace blink
 
 #endif  // THIRD_PARTY_BLINK_RENDERER_CORE_STREAMS_TRANSFERABLE_STREAMS_H_
@@ -5,6 +5,7 @@
 #ifndef THIRD_PARTY_BLINK_RENDERER_CORE_STREAMS_UNDERLYING_SOURCE_BASE_H_
 #define THIRD_PARTY_BLINK_RENDERER_CORE_STREAMS_UNDERLYING_SOURCE_BASE_H_
 
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "third_party/blink/renderer/bindings/core/v8/active_script_wrappable.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_promise.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_value.h"
@@ -18,6 +19,8 @@
 
 namespace blink {
 
+class BytesConsumer;
+class ExceptionState;
 class ReadableStreamDefaultControllerWithScriptScope;
 
 class CORE_EXPORT UnderlyingSourceBase
@@ -41,6 +44,18 @@ class CORE_EXPORT UnderlyingSourceBase
 
   ScriptValue type(ScriptState*) const;
 
+  // Sources that read their bytes from a mojo data pipe can give the pipe up
+  // when their stream is transferred, so that it moves to the other realm
+  // rather than having each chunk posted over a MessagePort. On success the
+  // pipe is stored in |data_pipe|, the stream is closed, and the returned
+  // consumer, which has no data left, only reports how the body ends. Returns
+  // null, leaving the stream untouched, otherwise.
+  virtual BytesConsumer* DrainAsDataPipe(
+      mojo::ScopedDataPipeConsumerHandle* data_pipe,
+      ExceptionState&) {
+    return nullptr;
+  }
+
   // ExecutionContextLifecycleObserver
   // TODO(ricea): Is this still useful?
   void ContextDestroyed() override;
@@ -181,6 +181,7 @@
 #include "third_party/blink/renderer/platform/network/network_state_notifier.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread.h"
+#include "third_party/blink/renderer/platform/scheduler/public/thread_scheduler.h"
 #include "third_party/blink/renderer/platform/testing/url_test_helpers.h"
 #include "third_party/blink/renderer/platform/text/layout_locale.h"
 #include "third_party/blink/renderer/platform/weborigin/scheme_registry.h"
@@ -3497,4 +3498,12 @@ void Internals::generateTestReport(const String& message) {
   ReportingContext::From(document_->domWindow())->QueueReport(report);
 }
 
+String Internals::taskQueueLatencyStats() const {
+  return ThreadScheduler::Current()->GetTaskQueueLatencyStatsAsJSON();
+}
+
+void Internals::resetTaskQueueLatencyStats() {
+  ThreadScheduler::Current()->ResetTaskQueueLatencyStats();
+}
+
 }  // namespace blink
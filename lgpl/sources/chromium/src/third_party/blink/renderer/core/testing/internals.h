@@ -598,6 +598,9 @@ class Internals final : public ScriptWrappable {
 
   void generateTestReport(const String& message);
 
+  String taskQueueLatencyStats() const;
+  void resetTaskQueueLatencyStats();
+
  private:
   Document* ContextDocument() const;
   Vector<String> IconURLs(Document*, int icon_types_mask) const;
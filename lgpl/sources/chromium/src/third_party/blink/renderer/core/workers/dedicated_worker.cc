@@ -137,9 +137,9 @@ void DedicatedWorker::postMessage(ScriptState* script_state,
   BlinkTransferableMessage transferable_message;
   Transferables transferables;
   scoped_refptr<SerializedScriptValue> serialized_message =
-      PostMessageHelper::SerializeMessageByMove(script_state->GetIsolate(),
-                                                message, options, transferables,
-                                                exception_state);
+      PostMessageHelper::SerializeMessageToWorkerByMove(
+          script_state->GetIsolate(), message, options, transferables,
+          exception_state);
   if (exception_state.HadException())
     return;
   DCHECK(serialized_message);
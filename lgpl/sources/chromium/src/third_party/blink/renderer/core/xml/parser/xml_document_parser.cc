@@ -75,8 +75,10 @@
 #include "third_party/blink/renderer/platform/loader/fetch/resource_request.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_response.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
+#include "third_party/blink/renderer/platform/scheduler/public/thread_scheduler.h"
 #include "third_party/blink/renderer/platform/weborigin/security_origin.h"
 #include "third_party/blink/renderer/platform/wtf/shared_buffer.h"
+#include "third_party/blink/renderer/platform/wtf/text/unicode.h"
 #include "third_party/blink/renderer/platform/wtf/text/utf8.h"
 #include "third_party/blink/renderer/platform/wtf/threading.h"
 #include "third_party/blink/renderer/platform/wtf/vector.h"
@@ -86,6 +88,12 @@ namespace blink {
 // FIXME: HTMLConstructionSite has a limit of 512, should these match?
 static const unsigned kMaxXMLTreeDepth = 5000;
 
+// Input is fed to libxml in slices of at most this many characters when the
+// parser may yield, and parsing yields once a slice ends past the budget.
+static const unsigned kMaxSliceLength = 64 * 1024;
+static constexpr base::TimeDelta kParserTimeBudget =
+    base::TimeDelta::FromMilliseconds(50);
+
 static inline String ToString(const xmlChar* string, size_t length) {
   return String::FromUTF8(reinterpret_cast<const char*>(string), length);
 }
@@ -387,6 +395,7 @@ bool XMLDocumentParser::UpdateLeafTextNode() {
 }
 
 void XMLDocumentParser::Detach() {
+  continue_parse_task_handle_.Cancel();
   if (script_runner_)
     script_runner_->Detach();
   script_runner_ = nullptr;
@@ -531,7 +540,7 @@ static void SwitchEncoding(xmlParserCtxtPtr ctxt, bool is_8bit) {
                                                 : XML_CHAR_ENCODING_UTF16BE);
 }
 
-static void ParseChunk(xmlParserCtxtPtr ctxt, const String& chunk) {
+static void ParseChunk(xmlParserCtxtPtr ctxt, const StringView& chunk) {
   bool is_8bit = chunk.Is8Bit();
   SwitchEncoding(ctxt, is_8bit);
   if (is_8bit)
@@ -741,8 +750,10 @@ bool XMLDocumentParser::SupportsXMLVersion(const String& version) {
   return version == "1.0";
 }
 
-XMLDocumentParser::XMLDocumentParser(Document& document,
-                                     LocalFrameView* frame_view)
+XMLDocumentParser::XMLDocumentParser(
+    Document& document,
+    LocalFrameView* frame_view,
+    ParserSynchronizationPolicy parser_sync_policy)
     : ScriptableDocumentParser(document),
       context_(nullptr),
       current_node_(&document),
@@ -762,7 +773,10 @@ XMLDocumentParser::XMLDocumentParser(Document& document,
                          : nullptr),  // Don't execute scripts for
                                       // documents without frames.
       script_start_position_(TextPosition::BelowRangePosition()),
-      parsing_fragment_(false) {
+      parsing_fragment_(false),
+      may_yield_(RuntimeEnabledFeatures::XMLParserYieldingEnabled() &&
+                 parser_sync_policy != kForceSynchronousParsing),
+      time_budget_(kParserTimeBudget) {
   // This is XML being used as a document resource.
   if (frame_view && IsA<XMLDocument>(document))
     UseCounter::Count(document, WebFeature::kXMLDocument);
@@ -787,7 +801,8 @@ XMLDocumentParser::XMLDocumentParser(DocumentFragment* fragment,
       document_(&fragment->GetDocument()),
       script_runner_(nullptr),  // Don't execute scripts for document fragments.
       script_start_position_(TextPosition::BelowRangePosition()),
-      parsing_fragment_(true) {
+      parsing_fragment_(true),
+      may_yield_(false) {
   // Step 2 of
   // https://html.spec.whatwg.org/C/#xml-fragment-parsing-algorithm
   // The following code collects prefix-namespace mapping in scope on
@@ -855,12 +870,40 @@ void XMLDocumentParser::DoWrite(const String& parse_string) {
     XMLDocumentParserScope scope(GetDocument());
     base::AutoReset<bool> encoding_scope(&is_currently_parsing8_bit_chunk_,
                                          parse_string.Is8Bit());
-    ParseChunk(context->Context(), parse_string);
-
-    // JavaScript (which may be run under the parseChunk callstack) may
-    // cause the parser to be stopped or detached.
-    if (IsStopped())
-      return;
+    base::TimeTicks start_time = base::TimeTicks::Now();
+    unsigned offset = 0;
+    while (offset < parse_string.length()) {
+      unsigned end = parse_string.length();
+      if (may_yield_ && end - offset > kMaxSliceLength) {
+        end = offset + kMaxSliceLength;
+        // Keep surrogate pairs within a slice.
+        if (!parse_string.Is8Bit() && U16_IS_LEAD(parse_string[end - 1]))
+          --end;
+      }
+      ParseChunk(context->Context(),
+                 StringView(parse_string, offset, end - offset));
+      offset = end;
+
+      // JavaScript (which may be run under the parseChunk callstack) may
+      // cause the parser to be stopped or detached.
+      if (IsStopped())
+        return;
+
+      if (offset == parse_string.length())
+        break;
+      // A script or a stylesheet paused the parser, or the slice used up
+      // the time budget. The rest of the input is parsed on resumption.
+      if (parser_paused_ || ShouldYield(start_time)) {
+        SegmentedString rest(parse_string.Substring(offset));
+        rest.Append(pending_src_);
+        pending_src_ = rest;
+        if (!parser_paused_) {
+          parser_paused_ = true;
+          ScheduleForUnpause();
+        }
+        return;
+      }
+    }
   }
 
   // FIXME: Why is this here? And why is it after we process the passed
@@ -874,6 +917,25 @@ void XMLDocumentParser::DoWrite(const String& parse_string) {
   }
 }
 
+bool XMLDocumentParser::ShouldYield(base::TimeTicks start_time) const {
+  if (ThreadScheduler::Current()->ShouldYieldForHighPriorityWork())
+    return true;
+  return base::TimeTicks::Now() - start_time >= time_budget_;
+}
+
+void XMLDocumentParser::ScheduleForUnpause() {
+  continue_parse_task_handle_ = PostCancellableTask(
+      *GetDocument()->GetTaskRunner(TaskType::kNetworking), FROM_HERE,
+      WTF::Bind(&XMLDocumentParser::ResumeParsingAfterYield,
+                WrapWeakPersistent(this)));
+}
+
+void XMLDocumentParser::ResumeParsingAfterYield() {
+  if (IsDetached() || IsStopped())
+    return;
+  ResumeParsing();
+}
+
 struct xmlSAX2Namespace {
   const xmlChar* prefix;
   const xmlChar* uri;
@@ -1628,6 +1690,8 @@ void XMLDocumentParser::ResumeParsing() {
   DCHECK(parser_paused_);
 
   parser_paused_ = false;
+  // Input held back by a yield is written below, whoever resumes first.
+  continue_parse_task_handle_.Cancel();
 
   // First, execute any pending callbacks
   while (!pending_callbacks_.IsEmpty()) {
@@ -1648,14 +1712,17 @@ void XMLDocumentParser::ResumeParsing() {
   // There is normally only one string left, so toString() shouldn't copy.
   // In any case, the XML parser runs on the main thread and it's OK if
   // the passed string has more than one reference.
-  Append(rest.ToString().Impl());
+  // Pending data went through Append() already, and was recorded for XSLT
+  // there, so it is written directly.
+  if (!IsStopped() && !saw_xsl_transform_)
+    DoWrite(rest.ToString());
 
   if (IsDetached())
     return;
 
   // Finally, if finish() has been called and write() didn't result
-  // in any further callbacks being queued, call end()
-  if (finish_called_ && pending_callbacks_.IsEmpty())
+  // in any further callbacks being queued or yield, call end()
+  if (finish_called_ && !parser_paused_ && pending_callbacks_.IsEmpty())
     end();
 }
 
@@ -28,13 +28,16 @@
 
 #include <libxml/tree.h>
 #include <memory>
+#include "base/time/time.h"
 #include "third_party/blink/renderer/core/dom/parser_content_policy.h"
 #include "third_party/blink/renderer/core/dom/scriptable_document_parser.h"
+#include "third_party/blink/renderer/core/html/parser/parser_synchronization_policy.h"
 #include "third_party/blink/renderer/core/script/xml_parser_script_runner.h"
 #include "third_party/blink/renderer/core/script/xml_parser_script_runner_host.h"
 #include "third_party/blink/renderer/core/xml/parser/xml_errors.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_client.h"
+#include "third_party/blink/renderer/platform/scheduler/public/post_cancellable_task.h"
 #include "third_party/blink/renderer/platform/text/segmented_string.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
 #include "third_party/blink/renderer/platform/wtf/hash_map.h"
@@ -74,7 +77,10 @@ class XMLDocumentParser final : public ScriptableDocumentParser,
   USING_GARBAGE_COLLECTED_MIXIN(XMLDocumentParser);
 
  public:
-  explicit XMLDocumentParser(Document&, LocalFrameView* = nullptr);
+  explicit XMLDocumentParser(
+      Document&,
+      LocalFrameView* = nullptr,
+      ParserSynchronizationPolicy = kForceSynchronousParsing);
   XMLDocumentParser(DocumentFragment*, Element*, ParserContentPolicy);
   ~XMLDocumentParser() override;
   void Trace(Visitor*) const override;
@@ -123,6 +129,12 @@ class XMLDocumentParser final : public ScriptableDocumentParser,
 
   void SetScriptStartPosition(TextPosition);
 
+  // Parsing yields to the event loop once it has run for |budget|. Zero
+  // yields after every slice of input.
+  void SetTimeBudgetForTesting(base::TimeDelta budget) {
+    time_budget_ = budget;
+  }
+
  private:
   // From DocumentParser
   void insert(const String&) override { NOTREACHED(); }
@@ -187,6 +199,10 @@ class XMLDocumentParser final : public ScriptableDocumentParser,
   void DoWrite(const String&);
   void DoEnd();
 
+  bool ShouldYield(base::TimeTicks start_time) const;
+  void ScheduleForUnpause();
+  void ResumeParsingAfterYield();
+
   void CheckIfBlockingStyleSheetAdded();
 
   SegmentedString original_source_for_transform_;
@@ -216,6 +232,13 @@ class XMLDocumentParser final : public ScriptableDocumentParser,
   bool waiting_for_stylesheets_ = false;
   bool added_pending_parser_blocking_stylesheet_ = false;
 
+  // Documents loaded asynchronously are fed to libxml in slices, and parsing
+  // yields to the event loop between slices once |time_budget_| is spent, so
+  // that large documents don't block the main thread for their whole load.
+  const bool may_yield_;
+  base::TimeDelta time_budget_;
+  TaskHandle continue_parse_task_handle_;
+
   XMLErrors xml_errors_;
 
   Member<Document> document_;
@@ -8,6 +8,9 @@
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/dom/element.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
+#include "third_party/blink/renderer/platform/testing/unit_test_helpers.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 
 namespace blink {
 
@@ -25,4 +28,52 @@ TEST(XMLDocumentParserTest, NodeNamespaceWithParseError) {
   EXPECT_EQ(foo->localName(), "d:foo");
 }
 
+namespace {
+
+constexpr unsigned kItemCount = 20000;
+
+String LargeDocumentSource() {
+  StringBuilder builder;
+  builder.Append("<root>");
+  for (unsigned i = 0; i < kItemCount; ++i)
+    builder.Append("<item>text</item>");
+  builder.Append("</root>");
+  return builder.ToString();
+}
+
+}  // namespace
+
+TEST(XMLDocumentParserTest, YieldsWhenParsingAsynchronously) {
+  ScopedXMLParserYieldingForTest yielding(true);
+  auto& doc = *Document::CreateForTest();
+  DocumentParser* parser = doc.ImplicitOpen(kAllowAsynchronousParsing);
+  static_cast<XMLDocumentParser*>(parser)->SetTimeBudgetForTesting(
+      base::TimeDelta());
+
+  parser->Append(LargeDocumentSource());
+  parser->Finish();
+  // Parsing stopped after the first slice of input.
+  ASSERT_TRUE(doc.documentElement());
+  EXPECT_TRUE(doc.Parsing());
+  EXPECT_LT(doc.documentElement()->CountChildren(), kItemCount);
+
+  for (int i = 0; i < 100 && doc.Parsing(); ++i)
+    test::RunPendingTasks();
+  EXPECT_FALSE(doc.Parsing());
+  EXPECT_EQ(kItemCount, doc.documentElement()->CountChildren());
+}
+
+TEST(XMLDocumentParserTest, DoesNotYieldWhenParsingSynchronously) {
+  ScopedXMLParserYieldingForTest yielding(true);
+  auto& doc = *Document::CreateForTest();
+  DocumentParser* parser = doc.ImplicitOpen(kForceSynchronousParsing);
+  static_cast<XMLDocumentParser*>(parser)->SetTimeBudgetForTesting(
+      base::TimeDelta());
+
+  parser->Append(LargeDocumentSource());
+  parser->Finish();
+  EXPECT_FALSE(doc.Parsing());
+  EXPECT_EQ(kItemCount, doc.documentElement()->CountChildren());
+}
+
 }  // namespace blink
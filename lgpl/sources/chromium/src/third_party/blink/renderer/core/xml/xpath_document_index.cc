@@ -0,0 +1,107 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/xml/xpath_document_index.h"
+
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/core/dom/element_traversal.h"
+
+namespace blink {
+namespace xpath {
+
+// static
+const char DocumentIndex::kSupplementName[] = "XPathDocumentIndex";
+
+// static
+DocumentIndex* DocumentIndex::FromIfUnchanged(Document& document) {
+  DocumentIndex* index = Supplement<Document>::From<DocumentIndex>(document);
+  if (!index) {
+    Supplement<Document>::ProvideTo(
+        document, MakeGarbageCollected<DocumentIndex>(document));
+    return nullptr;
+  }
+  if (index->dom_tree_version_ != document.DomTreeVersion()) {
+    index->Reset();
+    return nullptr;
+  }
+  return index;
+}
+
+DocumentIndex::DocumentIndex(Document& document)
+    : Supplement<Document>(document),
+      dom_tree_version_(document.DomTreeVersion()),
+      empty_list_(MakeGarbageCollected<ElementList>()) {}
+
+const DocumentIndex::ElementList& DocumentIndex::ElementsWithLocalName(
+    const AtomicString& local_name) {
+  auto result = elements_by_local_name_.insert(local_name, nullptr);
+  if (!result.is_new_entry)
+    return *result.stored_value->value;
+
+  auto* elements = MakeGarbageCollected<ElementList>();
+  for (Element& element :
+       ElementTraversal::DescendantsOf(*GetSupplementable())) {
+    if (element.localName() == local_name)
+      elements->push_back(&element);
+  }
+  result.stored_value->value = elements;
+  DidBuild();
+  return *elements;
+}
+
+const DocumentIndex::ElementList& DocumentIndex::ElementsWithAttributeValue(
+    const AtomicString& local_name,
+    const AtomicString& value) {
+  auto result = elements_by_attribute_.insert(local_name, nullptr);
+  if (result.is_new_entry) {
+    auto* values = MakeGarbageCollected<AttributeValueMap>();
+    for (Element& element :
+         ElementTraversal::DescendantsOf(*GetSupplementable())) {
+      if (!element.hasAttributes())
+        continue;
+      // Attributes() synchronizes lazy attributes, like attribute axis
+      // lookups do, so that no match is missed.
+      for (const Attribute& attribute : element.Attributes()) {
+        if (attribute.LocalName() != local_name)
+          continue;
+        auto& elements =
+            values->insert(attribute.Value(), nullptr).stored_value->value;
+        if (!elements)
+          elements = MakeGarbageCollected<ElementList>();
+        // The same element can carry the name in several namespaces.
+        if (elements->IsEmpty() || elements->back() != &element)
+          elements->push_back(&element);
+      }
+    }
+    result.stored_value->value = values;
+    DidBuild();
+  }
+
+  auto it = result.stored_value->value->find(value);
+  if (it == result.stored_value->value->end())
+    return *empty_list_;
+  return *it->value;
+}
+
+void DocumentIndex::Reset() {
+  dom_tree_version_ = GetSupplementable()->DomTreeVersion();
+  elements_by_local_name_.clear();
+  elements_by_attribute_.clear();
+}
+
+void DocumentIndex::DidBuild() {
+  // Synchronizing lazy attributes while building may bump the version without
+  // changing what the lists contain.
+  dom_tree_version_ = GetSupplementable()->DomTreeVersion();
+}
+
+void DocumentIndex::Trace(Visitor* visitor) const {
+  visitor->Trace(elements_by_local_name_);
+  visitor->Trace(elements_by_attribute_);
+  visitor->Trace(empty_list_);
+  Supplement<Document>::Trace(visitor);
+}
+
+}  // namespace xpath
+}  // namespace blink
@@ -0,0 +1,70 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_XML_XPATH_DOCUMENT_INDEX_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_XML_XPATH_DOCUMENT_INDEX_H_
+
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/platform/heap/handle.h"
+#include "third_party/blink/renderer/platform/supplementable.h"
+#include "third_party/blink/renderer/platform/wtf/text/atomic_string_hash.h"
+
+namespace blink {
+
+class Element;
+
+namespace xpath {
+
+// Lazily built indexes of the elements of a document, used to evaluate
+// descendant steps such as "//item" and "//item[@id='x']" without walking
+// the whole tree. Each list is built by a single traversal the first time it
+// is looked up, and holds elements in document order, so results derived
+// from it are still sorted and free of duplicates.
+//
+// The index is dropped whenever the DOM tree version of the document changes.
+class CORE_EXPORT DocumentIndex final : public GarbageCollected<DocumentIndex>,
+                                        public Supplement<Document> {
+  USING_GARBAGE_COLLECTED_MIXIN(DocumentIndex);
+
+ public:
+  using ElementList = HeapVector<Member<Element>>;
+
+  static const char kSupplementName[];
+
+  // Returns the index of |document|, or null if the document has changed
+  // since the previous lookup. Lists are only built for documents that are
+  // queried repeatedly without intervening mutations, so that scripts which
+  // alternate DOM changes and queries don't pay for rebuilding them.
+  static DocumentIndex* FromIfUnchanged(Document&);
+
+  explicit DocumentIndex(Document&);
+
+  // Elements whose local name is |local_name|, in any namespace.
+  const ElementList& ElementsWithLocalName(const AtomicString& local_name);
+
+  // Elements that have an attribute whose local name is |local_name|, in any
+  // namespace, and whose value is |value|.
+  const ElementList& ElementsWithAttributeValue(const AtomicString& local_name,
+                                                const AtomicString& value);
+
+  void Trace(Visitor*) const override;
+
+ private:
+  using AttributeValueMap = HeapHashMap<AtomicString, Member<ElementList>>;
+
+  void Reset();
+  void DidBuild();
+
+  uint64_t dom_tree_version_;
+  HeapHashMap<AtomicString, Member<ElementList>> elements_by_local_name_;
+  HeapHashMap<AtomicString, Member<AttributeValueMap>> elements_by_attribute_;
+  Member<ElementList> empty_list_;
+};
+
+}  // namespace xpath
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_XML_XPATH_DOCUMENT_INDEX_H_
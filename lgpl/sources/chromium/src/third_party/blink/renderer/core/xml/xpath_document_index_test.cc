@@ -0,0 +1,115 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/xml/xpath_document_index.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/bindings/core/v8/script_value.h"
+#include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/core/xml/xpath_expression.h"
+#include "third_party/blink/renderer/core/xml/xpath_result.h"
+#include "third_party/blink/renderer/platform/bindings/exception_state.h"
+#include "third_party/blink/renderer/platform/heap/handle.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
+
+namespace blink {
+
+class XPathDocumentIndexTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    document_ = Document::CreateForTest();
+    Element* root = CreateElement("root");
+    document_->AppendChild(root);
+    for (int i = 0; i < 10; ++i) {
+      Element* item = CreateElement("item");
+      item->setAttribute("id", AtomicString("item" + String::Number(i)));
+      item->setAttribute("class", i % 2 ? "odd" : "even");
+      root->AppendChild(item);
+      // Nested items, so that matches are not all siblings.
+      if (i % 3 == 0) {
+        Element* nested = CreateElement("item");
+        nested->setAttribute("class", "odd");
+        item->AppendChild(nested);
+      }
+    }
+  }
+
+  Element* CreateElement(const char* local_name) {
+    return document_->CreateRawElement(
+        QualifiedName(g_null_atom, local_name, g_null_atom));
+  }
+
+  HeapVector<Member<Node>> Evaluate(const String& expression) {
+    XPathExpression* xpath = XPathExpression::CreateExpression(
+        expression, nullptr, ASSERT_NO_EXCEPTION);
+    XPathResult* result =
+        xpath->evaluate(document_, XPathResult::kOrderedNodeSnapshotType,
+                        ScriptValue(), ASSERT_NO_EXCEPTION);
+    HeapVector<Member<Node>> nodes;
+    for (unsigned i = 0; i < result->snapshotLength(ASSERT_NO_EXCEPTION); ++i)
+      nodes.push_back(result->snapshotItem(i, ASSERT_NO_EXCEPTION));
+    return nodes;
+  }
+
+  // Evaluates |expression| with the index, twice so that the index is
+  // populated, and checks the result against a tree traversal.
+  void ExpectSameResultAsTraversal(const String& expression) {
+    HeapVector<Member<Node>> expected;
+    {
+      ScopedXPathDocumentIndexForTest index(false);
+      expected = Evaluate(expression);
+    }
+    ScopedXPathDocumentIndexForTest index(true);
+    EXPECT_EQ(expected, Evaluate(expression)) << expression;
+    EXPECT_EQ(expected, Evaluate(expression)) << expression;
+  }
+
+  Persistent<Document> document_;
+};
+
+TEST_F(XPathDocumentIndexTest, SameResultsAsTraversal) {
+  ExpectSameResultAsTraversal("//item");
+  ExpectSameResultAsTraversal("//item[@id='item4']");
+  ExpectSameResultAsTraversal("//item['item4'=@id]");
+  ExpectSameResultAsTraversal("//item[@class='odd']");
+  ExpectSameResultAsTraversal("//*[@class='odd']");
+  ExpectSameResultAsTraversal("//item[@class='odd'][@id]");
+  ExpectSameResultAsTraversal("//item[@class='none']");
+  ExpectSameResultAsTraversal("//missing");
+  ExpectSameResultAsTraversal("/descendant::item[@class='odd'][2]");
+  ExpectSameResultAsTraversal("/descendant::item[2][@class='odd']");
+  ExpectSameResultAsTraversal("//root//item[@class='even']");
+}
+
+TEST_F(XPathDocumentIndexTest, ResultsAreSortedAndUnique) {
+  ScopedXPathDocumentIndexForTest index(true);
+  Evaluate("//item");
+  HeapVector<Member<Node>> nodes = Evaluate("//item[@class='odd']");
+  ASSERT_EQ(9u, nodes.size());
+  for (wtf_size_t i = 1; i < nodes.size(); ++i) {
+    EXPECT_TRUE(nodes[i - 1]->compareDocumentPosition(nodes[i]) &
+                Node::kDocumentPositionFollowing);
+  }
+}
+
+TEST_F(XPathDocumentIndexTest, InvalidatedByMutations) {
+  ScopedXPathDocumentIndexForTest index(true);
+  EXPECT_EQ(1u, Evaluate("//item[@id='item4']").size());
+  EXPECT_EQ(1u, Evaluate("//item[@id='item4']").size());
+  EXPECT_TRUE(xpath::DocumentIndex::FromIfUnchanged(*document_));
+
+  Element* item = To<Element>(Evaluate("//item[@id='item4']")[0].Get());
+  item->setAttribute("id", "renamed");
+  EXPECT_FALSE(xpath::DocumentIndex::FromIfUnchanged(*document_));
+  EXPECT_EQ(0u, Evaluate("//item[@id='item4']").size());
+  EXPECT_EQ(1u, Evaluate("//item[@id='renamed']").size());
+
+  item->remove();
+  EXPECT_EQ(0u, Evaluate("//item[@id='renamed']").size());
+  EXPECT_EQ(0u, Evaluate("//item[@id='renamed']").size());
+  EXPECT_EQ(13u, Evaluate("//item").size());
+}
+
+}  // namespace blink
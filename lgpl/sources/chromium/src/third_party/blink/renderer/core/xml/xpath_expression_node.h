@@ -93,6 +93,10 @@ class CORE_EXPORT Expression : public ParseNode {
 
   virtual Value::Type ResultType() const = 0;
 
+  virtual bool IsEqTestOp() const { return false; }
+  virtual bool IsLocationPath() const { return false; }
+  virtual bool IsStringExpression() const { return false; }
+
  protected:
   unsigned SubExprCount() const { return sub_expressions_.size(); }
   Expression* SubExpr(unsigned i) { return sub_expressions_[i].Get(); }
@@ -157,6 +157,18 @@ void LocationPath::Evaluate(EvaluationContext& context, NodeSet& nodes) const {
   nodes.MarkSorted(result_is_sorted);
 }
 
+const Step* LocationPath::SingleAttributeStep() const {
+  if (absolute_ || steps_.size() != 1)
+    return nullptr;
+  const Step* step = steps_[0];
+  const Step::NodeTest& node_test = step->GetNodeTest();
+  if (step->GetAxis() != Step::kAttributeAxis ||
+      node_test.GetKind() != Step::NodeTest::kNameTest ||
+      node_test.Data() == g_star_atom || step->HasPredicates())
+    return nullptr;
+  return step;
+}
+
 void LocationPath::AppendStep(Step* step) {
   unsigned step_count = steps_.size();
   if (step_count && OptimizeStepPair(steps_[step_count - 1], step))
@@ -29,6 +29,7 @@
 
 #include "third_party/blink/renderer/core/xml/xpath_expression_node.h"
 #include "third_party/blink/renderer/core/xml/xpath_node_set.h"
+#include "third_party/blink/renderer/platform/wtf/casting.h"
 
 namespace blink {
 
@@ -68,6 +69,12 @@ class LocationPath final : public Expression {
   void AppendStep(Step*);
   void InsertFirstStep(Step*);
 
+  bool IsLocationPath() const override { return true; }
+
+  // Returns the step of a relative path like "@name" that selects a single
+  // named attribute of the context node, or null for any other path.
+  const Step* SingleAttributeStep() const;
+
  private:
   Value::Type ResultType() const override { return Value::kNodeSetValue; }
 
@@ -92,5 +99,12 @@ class Path final : public Expression {
 
 }  // namespace xpath
 
+template <>
+struct DowncastTraits<xpath::LocationPath> {
+  static bool AllowFrom(const xpath::Expression& expression) {
+    return expression.IsLocationPath();
+  }
+};
+
 }  // namespace blink
 #endif  // THIRD_PARTY_BLINK_RENDERER_CORE_XML_XPATH_PATH_H_
@@ -28,7 +28,10 @@
 #include "third_party/blink/renderer/core/xml/xpath_predicate.h"
 
 #include <math.h>
+#include <utility>
 #include "third_party/blink/renderer/core/xml/xpath_functions.h"
+#include "third_party/blink/renderer/core/xml/xpath_path.h"
+#include "third_party/blink/renderer/core/xml/xpath_step.h"
 #include "third_party/blink/renderer/core/xml/xpath_util.h"
 #include "third_party/blink/renderer/platform/wtf/math_extras.h"
 
@@ -99,6 +102,26 @@ EqTestOp::EqTestOp(Opcode opcode, Expression* lhs, Expression* rhs)
   AddSubExpression(rhs);
 }
 
+bool EqTestOp::IsAttributeValueTest(AtomicString* local_name,
+                                    String* value) const {
+  if (opcode_ != kOpcodeEqual)
+    return false;
+
+  const Expression* path = SubExpr(0);
+  const Expression* literal = SubExpr(1);
+  if (path->IsStringExpression())
+    std::swap(path, literal);
+  if (!path->IsLocationPath() || !literal->IsStringExpression())
+    return false;
+
+  const Step* step = To<LocationPath>(path)->SingleAttributeStep();
+  if (!step)
+    return false;
+  *local_name = step->GetNodeTest().Data();
+  *value = To<StringExpression>(literal)->GetString();
+  return true;
+}
+
 bool EqTestOp::Compare(EvaluationContext& context,
                        const Value& lhs,
                        const Value& rhs) const {
@@ -266,6 +289,12 @@ void Predicate::Trace(Visitor* visitor) const {
   visitor->Trace(expr_);
 }
 
+bool Predicate::IsAttributeValueTest(AtomicString* local_name,
+                                     String* value) const {
+  const auto* eq_test = DynamicTo<EqTestOp>(expr_.Get());
+  return eq_test && eq_test->IsAttributeValueTest(local_name, value);
+}
+
 bool Predicate::Evaluate(EvaluationContext& context) const {
   DCHECK(expr_);
 
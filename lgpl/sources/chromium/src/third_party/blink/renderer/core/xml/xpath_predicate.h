@@ -31,6 +31,7 @@
 #include "third_party/blink/renderer/core/core_export.h"
 #include "third_party/blink/renderer/core/xml/xpath_expression_node.h"
 #include "third_party/blink/renderer/core/xml/xpath_value.h"
+#include "third_party/blink/renderer/platform/wtf/casting.h"
 
 namespace blink {
 
@@ -53,6 +54,9 @@ class CORE_EXPORT StringExpression final : public Expression {
   explicit StringExpression(const String&);
   void Trace(Visitor*) const override;
 
+  bool IsStringExpression() const override { return true; }
+  String GetString() const { return value_.ToString(); }
+
  private:
   Value Evaluate(EvaluationContext&) const override;
   Value::Type ResultType() const override { return Value::kStringValue; }
@@ -91,6 +95,13 @@ class EqTestOp final : public Expression {
   EqTestOp(Opcode, Expression* lhs, Expression* rhs);
   Value Evaluate(EvaluationContext&) const override;
 
+  bool IsEqTestOp() const override { return true; }
+
+  // Returns true if this is "@name = 'value'" or "'value' = @name", where
+  // @name is a relative path with a single attribute step that names one
+  // attribute.
+  bool IsAttributeValueTest(AtomicString* local_name, String* value) const;
+
  private:
   Value::Type ResultType() const override { return Value::kBooleanValue; }
   bool Compare(EvaluationContext&, const Value&, const Value&) const;
@@ -130,6 +141,8 @@ class Predicate final : public GarbageCollected<Predicate> {
   bool IsContextSizeSensitive() const {
     return expr_->IsContextSizeSensitive();
   }
+  // See EqTestOp::IsAttributeValueTest().
+  bool IsAttributeValueTest(AtomicString* local_name, String* value) const;
 
  private:
   Member<Expression> expr_;
@@ -138,6 +151,20 @@ class Predicate final : public GarbageCollected<Predicate> {
 
 }  // namespace xpath
 
+template <>
+struct DowncastTraits<xpath::EqTestOp> {
+  static bool AllowFrom(const xpath::Expression& expression) {
+    return expression.IsEqTestOp();
+  }
+};
+
+template <>
+struct DowncastTraits<xpath::StringExpression> {
+  static bool AllowFrom(const xpath::Expression& expression) {
+    return expression.IsStringExpression();
+  }
+};
+
 }  // namespace blink
 
 #endif  // THIRD_PARTY_BLINK_RENDERER_CORE_XML_XPATH_PREDICATE_H_
@@ -32,9 +32,12 @@
 #include "third_party/blink/renderer/core/dom/element.h"
 #include "third_party/blink/renderer/core/dom/node_traversal.h"
 #include "third_party/blink/renderer/core/html/html_document.h"
+#include "third_party/blink/renderer/core/xml/xpath_document_index.h"
 #include "third_party/blink/renderer/core/xml/xpath_parser.h"
+#include "third_party/blink/renderer/core/xml/xpath_predicate.h"
 #include "third_party/blink/renderer/core/xml/xpath_util.h"
 #include "third_party/blink/renderer/core/xmlns_names.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 
 namespace blink {
 namespace xpath {
@@ -77,6 +80,26 @@ void Step::Optimize() {
     }
   }
   swap(remaining_predicates, predicates_);
+
+  // Remember an attribute value test among merged predicates, so that the
+  // candidates for descendant steps like "//foo[@id='bar']" can be looked up
+  // instead of enumerated. Positions would be miscounted if any merged
+  // predicate depended on them.
+  indexed_attribute_name_ = g_null_atom;
+  indexed_attribute_value_ = g_null_atom;
+  for (const auto& predicate : GetNodeTest().MergedPredicates()) {
+    if (predicate->IsContextPositionSensitive()) {
+      indexed_attribute_name_ = g_null_atom;
+      break;
+    }
+    AtomicString local_name;
+    String value;
+    if (indexed_attribute_name_.IsNull() &&
+        predicate->IsAttributeValueTest(&local_name, &value)) {
+      indexed_attribute_name_ = local_name;
+      indexed_attribute_value_ = AtomicString(value);
+    }
+  }
 }
 
 bool OptimizeStepPair(Step* first, Step* second) {
@@ -263,6 +286,29 @@ static inline bool NodeMatches(EvaluationContext& evaluation_context,
   return true;
 }
 
+const HeapVector<Member<Element>>* Step::IndexedDescendants(
+    Node& context) const {
+  if (!RuntimeEnabledFeatures::XPathDocumentIndexEnabled())
+    return nullptr;
+  // Names are matched case-insensitively in HTML documents, see
+  // NodeMatchesBasicTest().
+  auto* document = DynamicTo<Document>(context);
+  if (!document || IsA<HTMLDocument>(document) ||
+      GetNodeTest().GetKind() != NodeTest::kNameTest)
+    return nullptr;
+  if (indexed_attribute_name_.IsNull() && GetNodeTest().Data() == g_star_atom)
+    return nullptr;
+
+  DocumentIndex* index = DocumentIndex::FromIfUnchanged(*document);
+  if (!index)
+    return nullptr;
+  if (!indexed_attribute_name_.IsNull()) {
+    return &index->ElementsWithAttributeValue(indexed_attribute_name_,
+                                              indexed_attribute_value_);
+  }
+  return &index->ElementsWithLocalName(GetNodeTest().Data());
+}
+
 // Result nodes are ordered in axis order. Node test (including merged
 // predicates) is applied.
 void Step::NodesInAxis(EvaluationContext& evaluation_context,
@@ -286,6 +332,18 @@ void Step::NodesInAxis(EvaluationContext& evaluation_context,
       if (context->IsAttributeNode())
         return;
 
+      // Indexed candidates are in document order, and are a superset of the
+      // matching nodes, so the result is the same as that of a traversal.
+      if (const HeapVector<Member<Element>>* candidates =
+              IndexedDescendants(*context)) {
+        for (Element* element : *candidates) {
+          if (NodeMatches(evaluation_context, element, kDescendantAxis,
+                          GetNodeTest()))
+            nodes.Append(element);
+        }
+        return;
+      }
+
       for (Node& n : NodeTraversal::DescendantsOf(*context)) {
         if (NodeMatches(evaluation_context, &n, kDescendantAxis, GetNodeTest()))
           nodes.Append(&n);
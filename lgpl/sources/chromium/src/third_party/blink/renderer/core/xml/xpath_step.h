@@ -33,6 +33,7 @@
 
 namespace blink {
 
+class Element;
 class Node;
 
 namespace xpath {
@@ -118,6 +119,9 @@ class Step final : public ParseNode {
 
   Axis GetAxis() const { return axis_; }
   const NodeTest& GetNodeTest() const { return *node_test_; }
+  bool HasPredicates() const {
+    return !predicates_.IsEmpty() || !node_test_->MergedPredicates().IsEmpty();
+  }
 
  private:
   friend bool OptimizeStepPair(Step*, Step*);
@@ -126,11 +130,17 @@ class Step final : public ParseNode {
 
   void ParseNodeTest(const String&);
   void NodesInAxis(EvaluationContext&, Node* context, NodeSet&) const;
+  const HeapVector<Member<Element>>* IndexedDescendants(Node& context) const;
   String NamespaceFromNodetest(const String& node_test) const;
 
   Axis axis_;
   Member<NodeTest> node_test_;
   HeapVector<Member<Predicate>> predicates_;
+
+  // Set by Optimize() when a merged predicate is "@name = 'value'", so that
+  // descendant steps can take their candidates from a DocumentIndex.
+  AtomicString indexed_attribute_name_;
+  AtomicString indexed_attribute_value_;
   DISALLOW_COPY_AND_ASSIGN(Step);
 };
 
@@ -97,6 +97,7 @@ void BaseRenderingContext2D::restore() {
   if (GetState().IsTransformInvertible())
     path_.Transform(GetState().Transform());
 
+  ++state_generation_;
   state_stack_.pop_back();
   state_stack_.back()->ClearResolvedFilter();
 
@@ -140,6 +141,7 @@ void BaseRenderingContext2D::UnwindStateStack() {
 
 void BaseRenderingContext2D::Reset() {
   ValidateStateStack();
+  ++state_generation_;
   UnwindStateStack();
   state_stack_.resize(1);
   state_stack_.front() = MakeGarbageCollected<CanvasRenderingContext2DState>();
@@ -317,6 +319,7 @@ void BaseRenderingContext2D::setShadowOffsetX(double x) {
     return;
   if (GetState().ShadowOffset().Width() == x)
     return;
+  ++state_generation_;
   ModifiableState().SetShadowOffsetX(clampTo<float>(x));
 }
 
@@ -329,6 +332,7 @@ void BaseRenderingContext2D::setShadowOffsetY(double y) {
     return;
   if (GetState().ShadowOffset().Height() == y)
     return;
+  ++state_generation_;
   ModifiableState().SetShadowOffsetY(clampTo<float>(y));
 }
 
@@ -341,6 +345,7 @@ void BaseRenderingContext2D::setShadowBlur(double blur) {
     return;
   if (GetState().ShadowBlur() == blur)
     return;
+  ++state_generation_;
   ModifiableState().SetShadowBlur(clampTo<float>(blur));
 }
 
@@ -354,6 +359,7 @@ void BaseRenderingContext2D::setShadowColor(const String& color_string) {
     return;
   if (GetState().ShadowColor() == color)
     return;
+  ++state_generation_;
   ModifiableState().SetShadowColor(color.Rgb());
 }
 
@@ -409,6 +415,7 @@ void BaseRenderingContext2D::setGlobalCompositeOperation(
   SkBlendMode sk_blend_mode = WebCoreCompositeToSkiaComposite(op, blend_mode);
   if (GetState().GlobalComposite() == sk_blend_mode)
     return;
+  ++state_generation_;
   ModifiableState().SetGlobalComposite(sk_blend_mode);
 }
 
@@ -430,6 +437,7 @@ void BaseRenderingContext2D::setFilter(
   if (!filter_value || filter_value->IsCSSWideKeyword())
     return;
 
+  ++state_generation_;
   ModifiableState().SetUnparsedFilter(filter_string);
   ModifiableState().SetFilter(filter_value);
   SnapshotStateForFilter();
@@ -450,6 +458,7 @@ void BaseRenderingContext2D::scale(double sx, double sy) {
   if (GetState().Transform() == new_transform)
     return;
 
+  ++state_generation_;
   ModifiableState().SetTransform(new_transform);
   if (!GetState().IsTransformInvertible())
     return;
@@ -471,6 +480,7 @@ void BaseRenderingContext2D::rotate(double angle_in_radians) {
   if (GetState().Transform() == new_transform)
     return;
 
+  ++state_generation_;
   ModifiableState().SetTransform(new_transform);
   if (!GetState().IsTransformInvertible())
     return;
@@ -496,6 +506,7 @@ void BaseRenderingContext2D::translate(double tx, double ty) {
   if (GetState().Transform() == new_transform)
     return;
 
+  ++state_generation_;
   ModifiableState().SetTransform(new_transform);
   if (!GetState().IsTransformInvertible())
     return;
@@ -530,6 +541,7 @@ void BaseRenderingContext2D::transform(double m11,
   if (GetState().Transform() == new_transform)
     return;
 
+  ++state_generation_;
   ModifiableState().SetTransform(new_transform);
   if (!GetState().IsTransformInvertible())
     return;
@@ -550,6 +562,7 @@ void BaseRenderingContext2D::resetTransform() {
   if (ctm.IsIdentity() && invertible_ctm)
     return;
 
+  ++state_generation_;
   // resetTransform() resolves the non-invertible CTM state.
   ModifiableState().ResetTransform();
   c->setMatrix(AffineTransformToSkMatrix(AffineTransform()));
@@ -696,6 +709,9 @@ void BaseRenderingContext2D::fillRect(double x,
   float fy = clampTo<float>(y);
   float fwidth = clampTo<float>(width);
   float fheight = clampTo<float>(height);
+  SkRect rect = SkRect::MakeXYWH(fx, fy, fwidth, fheight);
+  if (TryFillRectFastPath(rect))
+    return;
 
   // We are assuming that if the pattern is not accelerated and the current
   // canvas is accelerated, the texture of the pattern will not be able to be
@@ -708,7 +724,6 @@ void BaseRenderingContext2D::fillRect(double x,
       !GetState().PatternIsAccelerated(
           CanvasRenderingContext2DState::kFillPaintType))
     DisableAcceleration();
-  SkRect rect = SkRect::MakeXYWH(fx, fy, fwidth, fheight);
   Draw([&rect](cc::PaintCanvas* c, const PaintFlags* flags)  // draw lambda
        { c->drawRect(rect, *flags); },
        [&rect, this](const SkIRect& clip_bounds)  // overdraw test lambda
@@ -717,6 +732,90 @@ void BaseRenderingContext2D::fillRect(double x,
        GetState().HasPattern(CanvasRenderingContext2DState::kFillPaintType)
            ? CanvasRenderingContext2DState::kNonOpaqueImage
            : CanvasRenderingContext2DState::kNoImage);
+  MaybeSetUpFillRectFastPath();
+}
+
+bool BaseRenderingContext2D::TryFillRectFastPath(const SkRect& rect) {
+  FillRectFastPath& fast_path = fill_rect_fast_path_;
+  if (!fast_path.canvas || fast_path.state_generation != state_generation_ ||
+      fast_path.canvas != GetOrCreatePaintCanvas()) {
+    return false;
+  }
+  // The fill style does not bump the state generation, only patterns need
+  // the checks of Draw().
+  if (GetState().HasPattern(CanvasRenderingContext2DState::kFillPaintType))
+    return false;
+
+  // The transform only scales and translates, see MaybeSetUpFillRectFastPath.
+  SkRect canvas_rect = GetState().Transform().MapRect(FloatRect(rect));
+  // Draw() checks fills covering the clip for overdraw.
+  if (canvas_rect.contains(SkRect::Make(fast_path.clip_bounds)))
+    return false;
+
+  SkIRect dirty_rect;
+  canvas_rect.roundOut(&dirty_rect);
+  if (!dirty_rect.intersect(fast_path.clip_bounds))
+    return true;
+
+  fast_path.canvas->drawRect(
+      rect, *GetState().GetFlags(CanvasRenderingContext2DState::kFillPaintType,
+                                 kDrawShadowAndForeground,
+                                 CanvasRenderingContext2DState::kNoImage));
+  DidDrawFillRectFastPath(dirty_rect);
+  fast_path.pending_dirty_rect.join(dirty_rect);
+  // Bounds the recording between two checks for a flush in DidDraw().
+  constexpr unsigned kMaxPendingDraws = 256;
+  if (++fast_path.pending_draws == kMaxPendingDraws)
+    FlushFillRectFastPathDraws();
+  return true;
+}
+
+void BaseRenderingContext2D::MaybeSetUpFillRectFastPath() {
+  FinishFillRectFastPath();
+
+  FillRectFastPath& fast_path = fill_rect_fast_path_;
+  const CanvasRenderingContext2DState& state = GetState();
+  if (state.HasPattern(CanvasRenderingContext2DState::kFillPaintType))
+    return;
+  // Keeps fillRect() cheap in a state which does not allow the fast path,
+  // StateHasFilter() may have to resolve the filter.
+  if (fast_path.state_rejected &&
+      fast_path.state_generation == state_generation_) {
+    return;
+  }
+  fast_path.state_generation = state_generation_;
+  const AffineTransform& transform = state.Transform();
+  fast_path.state_rejected =
+      !CanUseFillRectFastPath() || !state.IsTransformInvertible() ||
+      transform.B() || transform.C() ||
+      IsFullCanvasCompositeMode(state.GlobalComposite()) ||
+      state.GlobalComposite() == SkBlendMode::kSrc ||
+      AlphaChannel(state.ShadowColor()) || StateHasFilter();
+  if (fast_path.state_rejected)
+    return;
+
+  cc::PaintCanvas* canvas = GetOrCreatePaintCanvas();
+  SkIRect clip_bounds;
+  if (!canvas || !canvas->getDeviceClipBounds(&clip_bounds))
+    return;
+
+  fast_path.canvas = canvas;
+  fast_path.clip_bounds = clip_bounds;
+}
+
+void BaseRenderingContext2D::FinishFillRectFastPath() {
+  FlushFillRectFastPathDraws();
+  fill_rect_fast_path_.canvas = nullptr;
+}
+
+void BaseRenderingContext2D::FlushFillRectFastPathDraws() {
+  FillRectFastPath& fast_path = fill_rect_fast_path_;
+  if (!fast_path.pending_draws)
+    return;
+  SkIRect dirty_rect = fast_path.pending_dirty_rect;
+  fast_path.pending_dirty_rect = SkIRect::MakeEmpty();
+  fast_path.pending_draws = 0;
+  DidDraw(dirty_rect);
 }
 
 static void StrokeRectOnCanvas(const FloatRect& rect,
@@ -782,6 +881,7 @@ void BaseRenderingContext2D::ClipInternal(const Path& path,
 
   SkPath sk_path = path.GetSkPath();
   sk_path.setFillType(ParseWinding(winding_rule_string));
+  ++state_generation_;
   ModifiableState().ClipPath(sk_path, clip_antialiasing_);
   c->clipPath(sk_path, SkClipOp::kIntersect,
               clip_antialiasing_ == kAntiAliased);
@@ -372,6 +372,18 @@ class MODULES_EXPORT BaseRenderingContext2D : public GarbageCollectedMixin,
 
   virtual void FinalizeFrame() {}
 
+  // Consecutive fillRect() calls drawn with the same transform, clip,
+  // composite mode, filter and shadow skip the state validation of Draw()
+  // once the first one has been drawn, and report their dirty rects to
+  // DidDraw() in batches. Subclasses opting in must call
+  // FinishFillRectFastPath() before finalizing a frame, so that the next
+  // frame starts with a regular draw.
+  virtual bool CanUseFillRectFastPath() const { return false; }
+  // Called for each rect drawn by the fast path, before its dirty rect is
+  // reported to DidDraw(), so that readbacks in between see it.
+  virtual void DidDrawFillRectFastPath(const SkIRect& dirty_rect) {}
+  void FinishFillRectFastPath();
+
   float GetFontBaseline(const SimpleFontData&) const;
 
   static const char kDefaultFont[];
@@ -437,6 +449,14 @@ class MODULES_EXPORT BaseRenderingContext2D : public GarbageCollectedMixin,
 
   void ClearCanvas();
   bool RectContainsTransformedRect(const FloatRect&, const SkIRect&) const;
+
+  // Draws |rect| without validating the state again, if the fast path is set
+  // up for the current state. Returns false if it is not.
+  bool TryFillRectFastPath(const SkRect& rect);
+  // Sets up the fast path after a fillRect() went through Draw(), if the
+  // current state allows it.
+  void MaybeSetUpFillRectFastPath();
+  void FlushFillRectFastPathDraws();
   // Sets the origin to be tainted by the content of the canvas, such
   // as a cross-origin image. This is as opposed to some other reason
   // such as tainting from a filter applied to the canvas.
@@ -459,6 +479,27 @@ class MODULES_EXPORT BaseRenderingContext2D : public GarbageCollectedMixin,
 
   bool origin_tainted_by_content_;
 
+  // Incremented by changes to the transform, clip, composite mode, filter or
+  // shadow, which decide whether the fillRect() fast path may skip the
+  // validation of Draw(). Fill style and alpha changes do not count, the fast
+  // path computes the flags of every rect.
+  uint64_t state_generation_ = 0;
+  struct FillRectFastPath {
+    DISALLOW_NEW();
+
+    // Null if the fast path is not set up.
+    cc::PaintCanvas* canvas = nullptr;
+    // The state generation checked last, and whether it ruled the fast path
+    // out.
+    uint64_t state_generation = 0;
+    bool state_rejected = false;
+    SkIRect clip_bounds = SkIRect::MakeEmpty();
+    // Union of the dirty rects not reported to DidDraw() yet.
+    SkIRect pending_dirty_rect = SkIRect::MakeEmpty();
+    unsigned pending_draws = 0;
+  };
+  FillRectFastPath fill_rect_fast_path_;
+
   DISALLOW_COPY_AND_ASSIGN(BaseRenderingContext2D);
 };
 
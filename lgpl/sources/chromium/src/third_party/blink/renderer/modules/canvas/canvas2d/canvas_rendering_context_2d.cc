@@ -691,10 +691,27 @@ ImageData* CanvasRenderingContext2D::getImageData(
 
 void CanvasRenderingContext2D::FinalizeFrame() {
   TRACE_EVENT0("blink", "CanvasRenderingContext2D::FinalizeFrame");
+  FinishFillRectFastPath();
   if (IsPaintable())
     canvas()->GetCanvas2DLayerBridge()->FinalizeFrame();
 }
 
+bool CanvasRenderingContext2D::CanUseFillRectFastPath() const {
+  // Low latency canvases use the dirty rect before finalizing the frame.
+  return RuntimeEnabledFeatures::Canvas2dFillRectFastPathEnabled() &&
+         !canvas()->LowLatencyEnabled();
+}
+
+void CanvasRenderingContext2D::DidDrawFillRectFastPath(
+    const SkIRect& dirty_rect) {
+  // The bridge only flushes its recording for a snapshot, e.g. for
+  // getImageData(), toBlob() or drawImage() of this canvas, if it has been
+  // told about a draw since the last flush. The canvas element itself is only
+  // needed to present the frame, and is told in batches.
+  canvas()->GetCanvas2DLayerBridge()->DidDraw(
+      FloatRect(SkRect::Make(dirty_rect)));
+}
+
 bool CanvasRenderingContext2D::ParseColorOrCurrentColor(
     Color& color,
     const String& color_string) const {
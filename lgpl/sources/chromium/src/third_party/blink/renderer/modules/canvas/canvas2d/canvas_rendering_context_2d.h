@@ -197,6 +197,8 @@ class MODULES_EXPORT CanvasRenderingContext2D final
   void ValidateStateStackWithCanvas(const cc::PaintCanvas*) const final;
 
   void FinalizeFrame() override;
+  bool CanUseFillRectFastPath() const override;
+  void DidDrawFillRectFastPath(const SkIRect& dirty_rect) override;
 
   bool IsPaintable() const final {
     return canvas() && canvas()->GetCanvas2DLayerBridge();
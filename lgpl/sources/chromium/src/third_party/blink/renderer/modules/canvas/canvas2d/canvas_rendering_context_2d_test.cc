@@ -431,6 +431,104 @@ TEST_F(CanvasRenderingContext2DTest, detectOverdrawWithFillRect) {
                   fillRect(0, 0, 10, 10));
 }
 
+TEST_F(CanvasRenderingContext2DTest, detectOverdrawWithFillRectFastPath) {
+  ScopedCanvas2dFillRectFastPathForTest fill_rect_fast_path(true);
+  CreateContext(kNonOpaque);
+
+  // The fast path leaves fills covering the clip to Draw().
+  TEST_OVERDRAW_3(1, fillRect(0, 0, 1, 1), fillRect(1, 1, 1, 1),
+                  fillRect(-1, -1, 12, 12));
+  TEST_OVERDRAW_4(0, fillRect(0, 0, 1, 1), fillRect(1, 1, 1, 1),
+                  setGlobalAlpha(0.5f), fillRect(0, 0, 10, 10));
+  TEST_OVERDRAW_4(1, fillRect(0, 0, 1, 1), fillRect(1, 1, 1, 1),
+                  setGlobalCompositeOperation(String("copy")),
+                  fillRect(0, 0, 1, 1));
+}
+
+TEST_F(CanvasRenderingContext2DTest, FillRectFastPath) {
+  ScopedCanvas2dFillRectFastPathForTest fill_rect_fast_path(true);
+  CreateContext(kNonOpaque);
+  CanvasRenderingContext2D* context = Context2D();
+
+  // The first fillRect() sets up the fast path, the next ones use it.
+  for (int x = 0; x < 10; x++)
+    context->fillRect(x, 0, 1, 1);
+  EXPECT_TRUE(CanvasElement().IsDirty());
+  // The fast path computes the flags of every rect, and a transform change
+  // goes through Draw() again.
+  context->setGlobalAlpha(0.5);
+  context->fillRect(0, 1, 1, 1);
+  context->fillRect(1, 1, 1, 1);
+  context->translate(2, 0);
+  context->fillRect(0, 1, 1, 1);
+
+  NonThrowableExceptionState exception_state;
+  const uint8_t* pixels = static_cast<const uint8_t*>(
+      context->getImageData(0, 0, 10, 2, exception_state)->BufferBase()->Data());
+  auto alpha = [pixels](int x, int y) { return pixels[(y * 10 + x) * 4 + 3]; };
+  for (int x = 0; x < 10; x++)
+    EXPECT_EQ(255, alpha(x, 0)) << x;
+  EXPECT_NEAR(128, alpha(0, 1), 1);
+  EXPECT_NEAR(128, alpha(1, 1), 1);
+  EXPECT_NEAR(128, alpha(2, 1), 1);
+  EXPECT_EQ(0, alpha(3, 1));
+}
+
+TEST_F(CanvasRenderingContext2DTest, FillRectFastPathWithChangingStyles) {
+  ScopedCanvas2dFillRectFastPathForTest fill_rect_fast_path(true);
+  CreateContext(kNonOpaque);
+  CanvasRenderingContext2D* context = Context2D();
+
+  // Interleaved colors share the fast path.
+  StringOrCanvasGradientOrCanvasPattern red;
+  StringOrCanvasGradientOrCanvasPattern blue;
+  red.SetString("#ff0000");
+  blue.SetString("#0000ff");
+  for (int x = 0; x < 10; x++) {
+    context->setFillStyle(x % 2 ? blue : red);
+    context->fillRect(x, 0, 1, 1);
+  }
+  // A shadow goes through Draw() again.
+  context->setShadowColor("#00ff00");
+  context->setShadowOffsetY(1);
+  context->fillRect(0, 2, 1, 1);
+
+  NonThrowableExceptionState exception_state;
+  const uint8_t* pixels = static_cast<const uint8_t*>(
+      context->getImageData(0, 0, 10, 4, exception_state)->BufferBase()->Data());
+  auto pixel = [pixels](int x, int y) { return pixels + (y * 10 + x) * 4; };
+  for (int x = 0; x < 10; x++) {
+    EXPECT_EQ(x % 2 ? 0 : 255, pixel(x, 0)[0]) << x;
+    EXPECT_EQ(x % 2 ? 255 : 0, pixel(x, 0)[2]) << x;
+  }
+  EXPECT_EQ(255, pixel(0, 2)[2]);
+  EXPECT_EQ(255, pixel(0, 3)[1]);
+}
+
+TEST_F(CanvasRenderingContext2DTest, FillRectFastPathThenGetImageData) {
+  ScopedCanvas2dFillRectFastPathForTest fill_rect_fast_path(true);
+  CreateContext(kNonOpaque);
+  CanvasRenderingContext2D* context = Context2D();
+  NonThrowableExceptionState exception_state;
+  auto alpha_at = [context, &exception_state](int x) {
+    return static_cast<const uint8_t*>(
+        context->getImageData(x, 0, 1, 1, exception_state)
+            ->BufferBase()
+            ->Data())[3];
+  };
+
+  // Each getImageData() flushes the recording, the rects drawn by the fast
+  // path after it, within the same frame, must still be seen by the next one.
+  context->fillRect(0, 0, 1, 1);
+  EXPECT_EQ(255, alpha_at(0));
+  context->fillRect(1, 0, 1, 1);
+  EXPECT_EQ(255, alpha_at(1));
+  context->fillRect(2, 0, 1, 1);
+  context->fillRect(3, 0, 1, 1);
+  EXPECT_EQ(255, alpha_at(3));
+  EXPECT_EQ(0, alpha_at(4));
+}
+
 TEST_F(CanvasRenderingContext2DTest, detectOverdrawWithClearRect) {
   CreateContext(kNonOpaque);
 
@@ -0,0 +1,300 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/modules/compression/background_inflate_transformer.h"
+
+#include <string.h>
+#include <limits>
+#include <utility>
+
+#include "base/task/thread_pool.h"
+#include "third_party/blink/renderer/bindings/core/v8/array_buffer_or_array_buffer_view.h"
+#include "third_party/blink/renderer/bindings/core/v8/script_promise.h"
+#include "third_party/blink/renderer/bindings/core/v8/script_promise_resolver.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_binding_for_core.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_uint8_array.h"
+#include "third_party/blink/renderer/core/execution_context/execution_context.h"
+#include "third_party/blink/renderer/core/streams/transform_stream_default_controller.h"
+#include "third_party/blink/renderer/core/typed_arrays/array_buffer/array_buffer_contents.h"
+#include "third_party/blink/renderer/core/typed_arrays/array_buffer_view_helpers.h"
+#include "third_party/blink/renderer/core/typed_arrays/dom_array_buffer.h"
+#include "third_party/blink/renderer/core/typed_arrays/dom_typed_array.h"
+#include "third_party/blink/renderer/modules/compression/compression_format.h"
+#include "third_party/blink/renderer/modules/compression/zlib_partition_alloc.h"
+#include "third_party/blink/renderer/platform/bindings/exception_state.h"
+#include "third_party/blink/renderer/platform/bindings/to_v8.h"
+#include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
+#include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+#include "third_party/zlib/zlib.h"
+#include "v8/include/v8.h"
+
+namespace blink {
+
+struct BackgroundInflateTransformer::Result {
+  USING_FAST_MALLOC(Result);
+
+ public:
+  enum class Error { kNone, kInvalidData, kJunk, kTruncated, kOutOfMemory };
+
+  Vector<ArrayBufferContents> outputs;
+  Error error = Error::kNone;
+  // Set by zlib for kInvalidData, points to a string literal.
+  const char* zlib_message = nullptr;
+};
+
+class BackgroundInflateTransformer::Inflater {
+  USING_FAST_MALLOC(Inflater);
+
+ public:
+  explicit Inflater(CompressionFormat format) {
+    memset(&stream_, 0, sizeof(z_stream));
+    ZlibPartitionAlloc::Configure(&stream_);
+    constexpr int kWindowBits = 15;
+    constexpr int kUseGzip = 16;
+    int err;
+    switch (format) {
+      case CompressionFormat::kDeflate:
+        err = inflateInit2(&stream_, kWindowBits);
+        break;
+      case CompressionFormat::kGzip:
+        err = inflateInit2(&stream_, kWindowBits + kUseGzip);
+        break;
+    }
+    // The parameters are valid, so anything else is Z_MEM_ERROR. It is
+    // reported by the first Inflate().
+    DCHECK(err == Z_OK || err == Z_MEM_ERROR);
+    initialized_ = err == Z_OK;
+  }
+
+  ~Inflater() {
+    if (initialized_)
+      inflateEnd(&stream_);
+  }
+
+  std::unique_ptr<Result> Inflate(const Vector<uint8_t>& input,
+                                  bool finished) {
+    auto result = std::make_unique<Result>();
+    if (!initialized_) {
+      result->error = Result::Error::kOutOfMemory;
+      return result;
+    }
+    if (reached_end_ && !input.IsEmpty()) {
+      // zlib will ignore data after the end of the stream, so we have to
+      // explicitly report an error.
+      result->error = Result::Error::kJunk;
+      return result;
+    }
+
+    stream_.avail_in = input.size();
+    // Zlib treats this pointer as const, so this cast is safe.
+    stream_.next_in = const_cast<uint8_t*>(input.data());
+
+    do {
+      // Inflated into the backing store directly, so that the main thread
+      // only has to wrap it.
+      ArrayBufferContents output(kBufferSize, 1,
+                                 ArrayBufferContents::kNotShared,
+                                 ArrayBufferContents::kDontInitialize);
+      if (!output.IsValid()) {
+        result->error = Result::Error::kOutOfMemory;
+        return result;
+      }
+      stream_.avail_out = kBufferSize;
+      stream_.next_out = static_cast<uint8_t*>(output.Data());
+      const int err = inflate(&stream_, finished ? Z_FINISH : Z_NO_FLUSH);
+      if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR) {
+        DCHECK_NE(err, Z_STREAM_ERROR);
+        result->error = Result::Error::kInvalidData;
+        if (err == Z_DATA_ERROR)
+          result->zlib_message = stream_.msg;
+        return result;
+      }
+
+      const wtf_size_t bytes = kBufferSize - stream_.avail_out;
+      if (bytes && bytes < kBufferSize) {
+        // Only the last, partial buffer of a chunk is copied, into a backing
+        // store of the right size.
+        ArrayBufferContents trimmed(bytes, 1, ArrayBufferContents::kNotShared,
+                                    ArrayBufferContents::kDontInitialize);
+        if (!trimmed.IsValid()) {
+          result->error = Result::Error::kOutOfMemory;
+          return result;
+        }
+        memcpy(trimmed.Data(), output.Data(), bytes);
+        output = std::move(trimmed);
+      }
+      if (bytes)
+        result->outputs.push_back(std::move(output));
+
+      if (err == Z_STREAM_END) {
+        reached_end_ = true;
+        if (stream_.avail_in)
+          result->error = Result::Error::kJunk;
+        return result;
+      }
+    } while (stream_.avail_out == 0);
+
+    if (finished && !reached_end_)
+      result->error = Result::Error::kTruncated;
+    return result;
+  }
+
+ private:
+  // Same as InflateTransformer.
+  static constexpr wtf_size_t kBufferSize = 65536;
+
+  z_stream stream_;
+  bool initialized_ = false;
+  bool reached_end_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(Inflater);
+};
+
+BackgroundInflateTransformer::BackgroundInflateTransformer(
+    ScriptState* script_state,
+    CompressionFormat format)
+    : script_state_(script_state),
+      task_runner_(ExecutionContext::From(script_state)
+                       ->GetTaskRunner(TaskType::kMiscPlatformAPI)),
+      background_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::USER_VISIBLE})),
+      inflater_(std::make_unique<Inflater>(format).release(),
+                base::OnTaskRunnerDeleter(background_task_runner_)) {}
+
+BackgroundInflateTransformer::~BackgroundInflateTransformer() = default;
+
+ScriptPromise BackgroundInflateTransformer::Transform(
+    v8::Local<v8::Value> chunk,
+    TransformStreamDefaultController* controller,
+    ExceptionState& exception_state) {
+  ArrayBufferOrArrayBufferView buffer_source;
+  V8ArrayBufferOrArrayBufferView::ToImpl(
+      script_state_->GetIsolate(), chunk, buffer_source,
+      UnionTypeConversionMode::kNotNullable, exception_state);
+  if (exception_state.HadException()) {
+    return ScriptPromise();
+  }
+  const uint8_t* start;
+  size_t length;
+  if (buffer_source.IsArrayBufferView()) {
+    const auto* view = buffer_source.GetAsArrayBufferView().View();
+    start = static_cast<const uint8_t*>(view->BaseAddress());
+    length = view->byteLengthAsSizeT();
+  } else {
+    DCHECK(buffer_source.IsArrayBuffer());
+    const auto* array_buffer = buffer_source.GetAsArrayBuffer();
+    start = static_cast<const uint8_t*>(array_buffer->Data());
+    length = array_buffer->ByteLengthAsSizeT();
+  }
+  if (length > std::numeric_limits<wtf_size_t>::max()) {
+    exception_state.ThrowRangeError(
+        "Buffer size exceeds maximum heap object size.");
+    return ScriptPromise();
+  }
+
+  controller_ = controller;
+  // The chunk may be changed by script as soon as Transform() returns.
+  Vector<uint8_t> input;
+  input.Append(start, static_cast<wtf_size_t>(length));
+  return StartInflate(std::move(input), /*finished=*/false);
+}
+
+ScriptPromise BackgroundInflateTransformer::Flush(
+    TransformStreamDefaultController* controller,
+    ExceptionState& exception_state) {
+  DCHECK(!was_flush_called_);
+  controller_ = controller;
+  was_flush_called_ = true;
+  return StartInflate(Vector<uint8_t>(), /*finished=*/true);
+}
+
+ScriptPromise BackgroundInflateTransformer::StartInflate(Vector<uint8_t> input,
+                                                         bool finished) {
+  DCHECK(!resolver_);
+  resolver_ = MakeGarbageCollected<ScriptPromiseResolver>(script_state_);
+  // |inflater_| is deleted on |background_task_runner_|, after this task.
+  PostCrossThreadTask(
+      *background_task_runner_, FROM_HERE,
+      CrossThreadBindOnce(&BackgroundInflateTransformer::InflateInBackground,
+                          CrossThreadUnretained(inflater_.get()),
+                          std::move(input), finished,
+                          WrapCrossThreadWeakPersistent(this), task_runner_));
+  return resolver_->Promise();
+}
+
+// static
+void BackgroundInflateTransformer::InflateInBackground(
+    Inflater* inflater,
+    Vector<uint8_t> input,
+    bool finished,
+    CrossThreadWeakPersistent<BackgroundInflateTransformer> transformer,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
+  std::unique_ptr<Result> result = inflater->Inflate(input, finished);
+  PostCrossThreadTask(
+      *task_runner, FROM_HERE,
+      CrossThreadBindOnce(&BackgroundInflateTransformer::DidInflate,
+                          std::move(transformer),
+                          WTF::Passed(std::move(result))));
+}
+
+void BackgroundInflateTransformer::DidInflate(std::unique_ptr<Result> result) {
+  DCHECK(resolver_);
+  if (was_flush_called_)
+    inflater_.reset();
+  ScriptPromiseResolver* resolver = resolver_.Release();
+  if (!script_state_->ContextIsValid())
+    return;
+
+  ScriptState::Scope scope(script_state_);
+  ExceptionState exception_state(script_state_->GetIsolate(),
+                                 ExceptionState::kUnknownContext, "", "");
+  for (ArrayBufferContents& output : result->outputs) {
+    DOMArrayBuffer* buffer = DOMArrayBuffer::Create(std::move(output));
+    controller_->enqueue(
+        script_state_,
+        ScriptValue::From(script_state_, DOMUint8Array::Create(
+                                             buffer, 0, buffer->ByteLength())),
+        exception_state);
+    if (exception_state.HadException()) {
+      resolver->Reject(exception_state);
+      return;
+    }
+  }
+
+  switch (result->error) {
+    case Result::Error::kNone:
+      resolver->Resolve();
+      return;
+    case Result::Error::kInvalidData:
+      if (result->zlib_message) {
+        exception_state.ThrowTypeError(
+            String("The compressed data was not valid: ") +
+            result->zlib_message + ".");
+      } else {
+        exception_state.ThrowTypeError("The compressed data was not valid.");
+      }
+      break;
+    case Result::Error::kJunk:
+      exception_state.ThrowTypeError(
+          "Junk found after end of compressed data.");
+      break;
+    case Result::Error::kTruncated:
+      exception_state.ThrowTypeError("Compressed input was truncated.");
+      break;
+    case Result::Error::kOutOfMemory:
+      exception_state.ThrowRangeError("Out of memory.");
+      break;
+  }
+  resolver->Reject(exception_state);
+}
+
+void BackgroundInflateTransformer::Trace(Visitor* visitor) const {
+  visitor->Trace(script_state_);
+  visitor->Trace(controller_);
+  visitor->Trace(resolver_);
+  TransformStreamTransformer::Trace(visitor);
+}
+
+}  // namespace blink
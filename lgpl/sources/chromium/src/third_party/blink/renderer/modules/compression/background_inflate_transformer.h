@@ -0,0 +1,74 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_BACKGROUND_INFLATE_TRANSFORMER_H_
+#define THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_BACKGROUND_INFLATE_TRANSFORMER_H_
+
+#include <memory>
+
+#include "base/memory/scoped_refptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/single_thread_task_runner.h"
+#include "third_party/blink/renderer/core/streams/transform_stream_transformer.h"
+#include "third_party/blink/renderer/modules/modules_export.h"
+#include "third_party/blink/renderer/platform/heap/persistent.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+enum class CompressionFormat;
+class ScriptPromiseResolver;
+
+// Same as InflateTransformer, but zlib runs on a background sequence. Inflate
+// cannot be split into independent parts, so chunks are still processed one
+// after the other. Transform() and Flush() return a promise which settles once
+// the chunk has been inflated and its output enqueued, which keeps
+// backpressure intact.
+class MODULES_EXPORT BackgroundInflateTransformer final
+    : public TransformStreamTransformer {
+ public:
+  BackgroundInflateTransformer(ScriptState*, CompressionFormat);
+  ~BackgroundInflateTransformer() override;
+
+  ScriptPromise Transform(v8::Local<v8::Value> chunk,
+                          TransformStreamDefaultController*,
+                          ExceptionState&) override;
+
+  ScriptPromise Flush(TransformStreamDefaultController*,
+                      ExceptionState&) override;
+
+  ScriptState* GetScriptState() override { return script_state_; }
+
+  void Trace(Visitor*) const override;
+
+ private:
+  // Owns the z_stream. Only used on |background_task_runner_|.
+  class Inflater;
+  struct Result;
+
+  ScriptPromise StartInflate(Vector<uint8_t> input, bool finished);
+  static void InflateInBackground(
+      Inflater*,
+      Vector<uint8_t> input,
+      bool finished,
+      CrossThreadWeakPersistent<BackgroundInflateTransformer>,
+      scoped_refptr<base::SingleThreadTaskRunner>);
+  void DidInflate(std::unique_ptr<Result>);
+
+  Member<ScriptState> script_state_;
+  Member<TransformStreamDefaultController> controller_;
+  Member<ScriptPromiseResolver> resolver_;
+
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
+  scoped_refptr<base::SequencedTaskRunner> background_task_runner_;
+  std::unique_ptr<Inflater, base::OnTaskRunnerDeleter> inflater_;
+
+  bool was_flush_called_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundInflateTransformer);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_BACKGROUND_INFLATE_TRANSFORMER_H_
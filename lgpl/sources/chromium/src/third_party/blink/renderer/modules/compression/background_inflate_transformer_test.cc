@@ -0,0 +1,113 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/modules/compression/background_inflate_transformer.h"
+
+#include <string.h>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_binding_for_testing.h"
+#include "third_party/blink/renderer/modules/compression/compression_format.h"
+#include "third_party/blink/renderer/modules/compression/test_utils.h"
+#include "third_party/blink/renderer/platform/heap/heap.h"
+#include "third_party/zlib/zlib.h"
+
+namespace blink {
+
+namespace {
+
+// Compresses |input| in one go, independently of the transformers.
+Vector<uint8_t> CompressWithZlib(CompressionFormat format,
+                                 const Vector<uint8_t>& input) {
+  z_stream stream;
+  memset(&stream, 0, sizeof(z_stream));
+  constexpr int kWindowBits = 15;
+  constexpr int kUseGzip = 16;
+  int err = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                         format == CompressionFormat::kGzip
+                             ? kWindowBits + kUseGzip
+                             : kWindowBits,
+                         8, Z_DEFAULT_STRATEGY);
+  EXPECT_EQ(Z_OK, err);
+  Vector<uint8_t> output;
+  output.Grow(static_cast<wtf_size_t>(deflateBound(&stream, input.size())));
+  stream.next_in = const_cast<uint8_t*>(input.data());
+  stream.avail_in = input.size();
+  stream.next_out = output.data();
+  stream.avail_out = output.size();
+  err = deflate(&stream, Z_FINISH);
+  EXPECT_EQ(Z_STREAM_END, err);
+  output.Shrink(output.size() - stream.avail_out);
+  deflateEnd(&stream);
+  return output;
+}
+
+class BackgroundInflateTransformerTest
+    : public testing::TestWithParam<CompressionFormat> {
+ protected:
+  bool Inflate(const Vector<Vector<uint8_t>>& chunks, Vector<uint8_t>* output) {
+    return RunTransformer(scope_,
+                          MakeGarbageCollected<BackgroundInflateTransformer>(
+                              scope_.GetScriptState(), GetParam()),
+                          chunks, output);
+  }
+
+  V8TestingScope scope_;
+};
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         BackgroundInflateTransformerTest,
+                         testing::Values(CompressionFormat::kDeflate,
+                                         CompressionFormat::kGzip));
+
+TEST_P(BackgroundInflateTransformerTest, SingleChunk) {
+  // Large enough for several output buffers.
+  const Vector<uint8_t> input = CompressionTestInput(300000);
+  Vector<uint8_t> output;
+  ASSERT_TRUE(Inflate({CompressWithZlib(GetParam(), input)}, &output));
+  EXPECT_EQ(input, output);
+}
+
+TEST_P(BackgroundInflateTransformerTest, ChunkBoundaries) {
+  // Small chunks split the header, the deflate data and the trailer.
+  const Vector<uint8_t> input = CompressionTestInput(20000);
+  const Vector<uint8_t> compressed = CompressWithZlib(GetParam(), input);
+  for (wtf_size_t chunk_size : {1u, 3u, 7u, 1000u}) {
+    SCOPED_TRACE(chunk_size);
+    Vector<uint8_t> output;
+    ASSERT_TRUE(Inflate(SplitIntoChunks(compressed, chunk_size), &output));
+    EXPECT_EQ(input, output);
+  }
+}
+
+TEST_P(BackgroundInflateTransformerTest, EmptyChunks) {
+  const Vector<uint8_t> input = CompressionTestInput(1000);
+  Vector<Vector<uint8_t>> chunks = {Vector<uint8_t>()};
+  chunks.AppendVector(SplitIntoChunks(CompressWithZlib(GetParam(), input), 5));
+  chunks.push_back(Vector<uint8_t>());
+  Vector<uint8_t> output;
+  ASSERT_TRUE(Inflate(chunks, &output));
+  EXPECT_EQ(input, output);
+}
+
+TEST_P(BackgroundInflateTransformerTest, Truncated) {
+  Vector<uint8_t> compressed =
+      CompressWithZlib(GetParam(), CompressionTestInput(1000));
+  compressed.Shrink(compressed.size() - 1);
+  Vector<uint8_t> output;
+  EXPECT_FALSE(Inflate(SplitIntoChunks(compressed, 100), &output));
+}
+
+TEST_P(BackgroundInflateTransformerTest, JunkAfterEnd) {
+  Vector<uint8_t> compressed =
+      CompressWithZlib(GetParam(), CompressionTestInput(1000));
+  Vector<Vector<uint8_t>> chunks = SplitIntoChunks(compressed, 100);
+  chunks.push_back(Vector<uint8_t>({0}));
+  Vector<uint8_t> output;
+  EXPECT_FALSE(Inflate(chunks, &output));
+}
+
+}  // namespace
+
+}  // namespace blink
@@ -7,7 +7,9 @@
 #include "base/metrics/histogram_macros.h"
 #include "third_party/blink/renderer/modules/compression/compression_format.h"
 #include "third_party/blink/renderer/modules/compression/deflate_transformer.h"
+#include "third_party/blink/renderer/modules/compression/parallel_deflate_transformer.h"
 #include "third_party/blink/renderer/platform/bindings/exception_state.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 
 namespace blink {
 
@@ -45,11 +47,16 @@ CompressionStream::CompressionStream(ScriptState* script_state,
   // default level is hardcoded for now.
   // TODO(arenevier): Make level configurable
   const int deflate_level = 6;
+  TransformStreamTransformer* transformer;
+  if (RuntimeEnabledFeatures::CompressionStreamsOffThreadEnabled()) {
+    transformer = MakeGarbageCollected<ParallelDeflateTransformer>(
+        script_state, deflate_format, deflate_level);
+  } else {
+    transformer = MakeGarbageCollected<DeflateTransformer>(
+        script_state, deflate_format, deflate_level);
+  }
   transform_ =
-      TransformStream::Create(script_state,
-                              MakeGarbageCollected<DeflateTransformer>(
-                                  script_state, deflate_format, deflate_level),
-                              exception_state);
+      TransformStream::Create(script_state, transformer, exception_state);
 }
 
 }  // namespace blink
@@ -5,9 +5,11 @@
 #include "third_party/blink/renderer/modules/compression/decompression_stream.h"
 
 #include "base/metrics/histogram_macros.h"
+#include "third_party/blink/renderer/modules/compression/background_inflate_transformer.h"
 #include "third_party/blink/renderer/modules/compression/compression_format.h"
 #include "third_party/blink/renderer/modules/compression/inflate_transformer.h"
 #include "third_party/blink/renderer/platform/bindings/exception_state.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 
 namespace blink {
 
@@ -43,10 +45,16 @@ DecompressionStream::DecompressionStream(ScriptState* script_state,
   UMA_HISTOGRAM_ENUMERATION("Blink.Compression.DecompressionStream.Format",
                             inflate_format);
 
-  transform_ = TransformStream::Create(
-      script_state,
-      MakeGarbageCollected<InflateTransformer>(script_state, inflate_format),
-      exception_state);
+  TransformStreamTransformer* transformer;
+  if (RuntimeEnabledFeatures::CompressionStreamsOffThreadEnabled()) {
+    transformer = MakeGarbageCollected<BackgroundInflateTransformer>(
+        script_state, inflate_format);
+  } else {
+    transformer =
+        MakeGarbageCollected<InflateTransformer>(script_state, inflate_format);
+  }
+  transform_ =
+      TransformStream::Create(script_state, transformer, exception_state);
 }
 
 }  // namespace blink
@@ -0,0 +1,180 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/modules/compression/deflate_blocks.h"
+
+#include <string.h>
+#include <algorithm>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/notreached.h"
+#include "third_party/blink/renderer/modules/compression/compression_format.h"
+#include "third_party/blink/renderer/modules/compression/zlib_partition_alloc.h"
+#include "third_party/zlib/zlib.h"
+
+namespace blink {
+
+constexpr wtf_size_t DeflateBlocks::kDictionarySize;
+
+// static
+Vector<uint8_t> DeflateBlocks::Header(CompressionFormat format, int level) {
+  DCHECK(level >= 1 && level <= 9);
+  switch (format) {
+    case CompressionFormat::kDeflate: {
+      // RFC 1950: deflate with a 32kB window, and the level as zlib reports
+      // it. The header must be a multiple of 31.
+      const unsigned level_flags =
+          level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+      unsigned header = (0x78 << 8) | (level_flags << 6);
+      header += 31 - header % 31;
+      return Vector<uint8_t>(
+          {static_cast<uint8_t>(header >> 8), static_cast<uint8_t>(header)});
+    }
+    case CompressionFormat::kGzip: {
+      // RFC 1952: no flags, no modification time and an unknown OS.
+      const uint8_t extra_flags = level == 9 ? 2 : level == 1 ? 4 : 0;
+      return Vector<uint8_t>(
+          {0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, extra_flags, 0xff});
+    }
+  }
+  NOTREACHED();
+  return Vector<uint8_t>();
+}
+
+// static
+size_t DeflateBlocks::CompressBlockBound(size_t input_length) {
+  // Without a stream zlib returns a bound which holds for every level. A
+  // sync flush adds at most an empty stored block, and one spare byte tells
+  // a complete flush from one which ran out of space.
+  constexpr size_t kSyncFlushSize = 6;
+  return deflateBound(nullptr, input_length) + kSyncFlushSize + 1;
+}
+
+// static
+base::Optional<size_t> DeflateBlocks::CompressBlock(
+    base::span<const uint8_t> dictionary,
+    base::span<const uint8_t> input,
+    int level,
+    bool last,
+    base::span<uint8_t> output) {
+  DCHECK_LE(dictionary.size(), kDictionarySize);
+  DCHECK_GE(output.size(), CompressBlockBound(input.size()));
+  z_stream stream;
+  memset(&stream, 0, sizeof(z_stream));
+  ZlibPartitionAlloc::Configure(&stream);
+  constexpr int kRawDeflateWindowBits = -15;
+  int err = deflateInit2(&stream, level, Z_DEFLATED, kRawDeflateWindowBits, 8,
+                         Z_DEFAULT_STRATEGY);
+  if (err != Z_OK) {
+    // The parameters are valid, so this is Z_MEM_ERROR.
+    DCHECK_EQ(Z_MEM_ERROR, err);
+    return base::nullopt;
+  }
+  if (!dictionary.empty()) {
+    err = deflateSetDictionary(&stream, dictionary.data(), dictionary.size());
+    DCHECK_EQ(Z_OK, err);
+  }
+
+  stream.next_in = const_cast<uint8_t*>(input.data());
+  stream.avail_in = static_cast<uInt>(input.size());
+  stream.next_out = output.data();
+  stream.avail_out = static_cast<uInt>(output.size());
+  err = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+  DCHECK(err == Z_OK || err == Z_STREAM_END);
+  // A full output buffer would mean the block was cut short.
+  CHECK_GT(stream.avail_out, 0u);
+  DCHECK_EQ(0u, stream.avail_in);
+  DCHECK(!last || err == Z_STREAM_END);
+  deflateEnd(&stream);
+  return output.size() - stream.avail_out;
+}
+
+// static
+Vector<uint8_t> DeflateBlocks::CompressBlock(
+    base::span<const uint8_t> dictionary,
+    base::span<const uint8_t> input,
+    int level,
+    bool last) {
+  Vector<uint8_t> output;
+  output.Grow(static_cast<wtf_size_t>(CompressBlockBound(input.size())));
+  base::Optional<size_t> size =
+      CompressBlock(dictionary, input, level, last, output);
+  output.Shrink(static_cast<wtf_size_t>(size.value_or(0)));
+  return output;
+}
+
+// static
+uint32_t DeflateBlocks::InitialChecksum(CompressionFormat format) {
+  switch (format) {
+    case CompressionFormat::kDeflate:
+      return adler32(0, nullptr, 0);
+    case CompressionFormat::kGzip:
+      return crc32(0, nullptr, 0);
+  }
+  NOTREACHED();
+  return 0;
+}
+
+// static
+uint32_t DeflateBlocks::Checksum(CompressionFormat format,
+                                 base::span<const uint8_t> input) {
+  uint32_t checksum = InitialChecksum(format);
+  // zlib takes lengths as 32 bit integers.
+  constexpr size_t kMaxLength = 1u << 30;
+  while (!input.empty()) {
+    base::span<const uint8_t> part =
+        input.first(std::min(input.size(), kMaxLength));
+    switch (format) {
+      case CompressionFormat::kDeflate:
+        checksum = adler32(checksum, part.data(), part.size());
+        break;
+      case CompressionFormat::kGzip:
+        checksum = crc32(checksum, part.data(), part.size());
+        break;
+    }
+    input = input.subspan(part.size());
+  }
+  return checksum;
+}
+
+// static
+uint32_t DeflateBlocks::CombineChecksums(CompressionFormat format,
+                                         uint32_t first,
+                                         uint32_t second,
+                                         size_t second_length) {
+  switch (format) {
+    case CompressionFormat::kDeflate:
+      return adler32_combine(first, second, second_length);
+    case CompressionFormat::kGzip:
+      return crc32_combine(first, second, second_length);
+  }
+  NOTREACHED();
+  return 0;
+}
+
+// static
+Vector<uint8_t> DeflateBlocks::Trailer(CompressionFormat format,
+                                       uint32_t checksum,
+                                       uint64_t total_input_length) {
+  Vector<uint8_t> trailer;
+  switch (format) {
+    case CompressionFormat::kDeflate:
+      // RFC 1950: Adler-32, most significant byte first.
+      for (int shift = 24; shift >= 0; shift -= 8)
+        trailer.push_back(static_cast<uint8_t>(checksum >> shift));
+      break;
+    case CompressionFormat::kGzip:
+      // RFC 1952: CRC-32 and the input length modulo 2^32, least significant
+      // byte first.
+      for (int shift = 0; shift < 32; shift += 8)
+        trailer.push_back(static_cast<uint8_t>(checksum >> shift));
+      for (int shift = 0; shift < 32; shift += 8)
+        trailer.push_back(static_cast<uint8_t>(total_input_length >> shift));
+      break;
+  }
+  return trailer;
+}
+
+}  // namespace blink
@@ -0,0 +1,69 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_DEFLATE_BLOCKS_H_
+#define THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_DEFLATE_BLOCKS_H_
+
+#include <stdint.h>
+
+#include "base/containers/span.h"
+#include "base/optional.h"
+#include "third_party/blink/renderer/modules/modules_export.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+enum class CompressionFormat;
+
+// Compresses a stream as a sequence of independent blocks, the way pigz does.
+// Each block is a raw deflate stream primed with the input which precedes it,
+// and ends on a byte boundary. Blocks can therefore be compressed in parallel
+// and concatenated between Header() and Trailer(). The checksum of the whole
+// input is obtained by combining the checksums of the blocks in order.
+class MODULES_EXPORT DeflateBlocks {
+  STATIC_ONLY(DeflateBlocks);
+
+ public:
+  // Amount of preceding input a block is primed with, the deflate window.
+  static constexpr wtf_size_t kDictionarySize = 32768;
+
+  static Vector<uint8_t> Header(CompressionFormat, int level);
+
+  // Largest output CompressBlock() can produce for |input_length| bytes.
+  static size_t CompressBlockBound(size_t input_length);
+
+  // Only the last block ends the deflate stream. |output| must hold at least
+  // CompressBlockBound() bytes. Returns the number of bytes written, or
+  // nullopt if zlib could not be set up, which means it ran out of memory.
+  static base::Optional<size_t> CompressBlock(
+      base::span<const uint8_t> dictionary,
+      base::span<const uint8_t> input,
+      int level,
+      bool last,
+      base::span<uint8_t> output);
+  // Same as above. Returns an empty vector on failure, a block is never empty
+  // otherwise.
+  static Vector<uint8_t> CompressBlock(base::span<const uint8_t> dictionary,
+                                       base::span<const uint8_t> input,
+                                       int level,
+                                       bool last);
+
+  static uint32_t InitialChecksum(CompressionFormat);
+  static uint32_t Checksum(CompressionFormat, base::span<const uint8_t> input);
+  // Returns the checksum of A followed by B, where |second_length| is the
+  // length of B.
+  static uint32_t CombineChecksums(CompressionFormat,
+                                   uint32_t first,
+                                   uint32_t second,
+                                   size_t second_length);
+
+  static Vector<uint8_t> Trailer(CompressionFormat,
+                                 uint32_t checksum,
+                                 uint64_t total_input_length);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_DEFLATE_BLOCKS_H_
@@ -0,0 +1,137 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/modules/compression/deflate_blocks.h"
+
+#include <string.h>
+#include <algorithm>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/modules/compression/compression_format.h"
+#include "third_party/zlib/zlib.h"
+
+namespace blink {
+
+namespace {
+
+Vector<uint8_t> TestInput(wtf_size_t size) {
+  // Repetitive enough for matches to cross block boundaries.
+  Vector<uint8_t> input;
+  for (wtf_size_t i = 0; i < size; ++i)
+    input.push_back(static_cast<uint8_t>((i * 7) % 251 + (i / 1000) % 3));
+  return input;
+}
+
+// Compresses |input| the way ParallelDeflateTransformer does.
+Vector<uint8_t> CompressInBlocks(CompressionFormat format,
+                                 const Vector<uint8_t>& input,
+                                 wtf_size_t block_size) {
+  constexpr int kLevel = 6;
+  Vector<uint8_t> output = DeflateBlocks::Header(format, kLevel);
+  uint32_t checksum = DeflateBlocks::InitialChecksum(format);
+  wtf_size_t offset = 0;
+  do {
+    const wtf_size_t size = std::min(block_size, input.size() - offset);
+    const wtf_size_t dictionary_start =
+        offset > DeflateBlocks::kDictionarySize
+            ? offset - DeflateBlocks::kDictionarySize
+            : 0;
+    base::span<const uint8_t> data(input.data(), input.size());
+    base::span<const uint8_t> block = data.subspan(offset, size);
+    const bool last = offset + size == input.size();
+    output.AppendVector(DeflateBlocks::CompressBlock(
+        data.subspan(dictionary_start, offset - dictionary_start), block,
+        kLevel, last));
+    checksum = DeflateBlocks::CombineChecksums(
+        format, checksum, DeflateBlocks::Checksum(format, block), size);
+    offset += size;
+  } while (offset < input.size());
+  output.AppendVector(DeflateBlocks::Trailer(format, checksum, input.size()));
+  return output;
+}
+
+// Returns false if zlib does not accept |compressed| as a complete stream.
+bool Inflate(CompressionFormat format,
+             const Vector<uint8_t>& compressed,
+             Vector<uint8_t>* output) {
+  z_stream stream;
+  memset(&stream, 0, sizeof(z_stream));
+  constexpr int kWindowBits = 15;
+  constexpr int kUseGzip = 16;
+  if (inflateInit2(&stream, format == CompressionFormat::kGzip
+                                ? kWindowBits + kUseGzip
+                                : kWindowBits) != Z_OK) {
+    return false;
+  }
+  stream.next_in = const_cast<uint8_t*>(compressed.data());
+  stream.avail_in = compressed.size();
+  uint8_t buffer[4096];
+  int err;
+  do {
+    stream.next_out = buffer;
+    stream.avail_out = sizeof(buffer);
+    err = inflate(&stream, Z_NO_FLUSH);
+    output->Append(buffer, sizeof(buffer) - stream.avail_out);
+  } while (err == Z_OK);
+  inflateEnd(&stream);
+  return err == Z_STREAM_END && stream.avail_in == 0;
+}
+
+class DeflateBlocksTest : public testing::TestWithParam<CompressionFormat> {};
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         DeflateBlocksTest,
+                         testing::Values(CompressionFormat::kDeflate,
+                                         CompressionFormat::kGzip));
+
+TEST_P(DeflateBlocksTest, SingleBlock) {
+  Vector<uint8_t> input = TestInput(1000);
+  Vector<uint8_t> output;
+  ASSERT_TRUE(Inflate(GetParam(), CompressInBlocks(GetParam(), input, 4096),
+                      &output));
+  EXPECT_EQ(input, output);
+}
+
+TEST_P(DeflateBlocksTest, EmptyInput) {
+  Vector<uint8_t> output;
+  ASSERT_TRUE(Inflate(GetParam(),
+                      CompressInBlocks(GetParam(), Vector<uint8_t>(), 4096),
+                      &output));
+  EXPECT_TRUE(output.IsEmpty());
+}
+
+TEST_P(DeflateBlocksTest, ManyBlocks) {
+  // Blocks both smaller and larger than the dictionary.
+  Vector<uint8_t> input = TestInput(300000);
+  for (wtf_size_t block_size : {1000u, 65536u, 128u * 1024u}) {
+    Vector<uint8_t> output;
+    ASSERT_TRUE(Inflate(GetParam(),
+                        CompressInBlocks(GetParam(), input, block_size),
+                        &output))
+        << block_size;
+    EXPECT_EQ(input, output) << block_size;
+  }
+}
+
+TEST_P(DeflateBlocksTest, CombinedChecksum) {
+  Vector<uint8_t> input = TestInput(10000);
+  base::span<const uint8_t> data(input.data(), input.size());
+  const CompressionFormat format = GetParam();
+  EXPECT_EQ(DeflateBlocks::Checksum(format, data),
+            DeflateBlocks::CombineChecksums(
+                format, DeflateBlocks::Checksum(format, data.first(3000)),
+                DeflateBlocks::Checksum(format, data.subspan(3000)), 7000));
+}
+
+TEST_P(DeflateBlocksTest, CorruptTrailer) {
+  Vector<uint8_t> compressed =
+      CompressInBlocks(GetParam(), TestInput(1000), 4096);
+  compressed.back() ^= 1;
+  Vector<uint8_t> output;
+  EXPECT_FALSE(Inflate(GetParam(), compressed, &output));
+}
+
+}  // namespace
+
+}  // namespace blink
@@ -0,0 +1,310 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/modules/compression/parallel_deflate_transformer.h"
+
+#include <string.h>
+#include <algorithm>
+#include <limits>
+
+#include "base/system/sys_info.h"
+#include "third_party/blink/renderer/bindings/core/v8/array_buffer_or_array_buffer_view.h"
+#include "third_party/blink/renderer/bindings/core/v8/script_promise.h"
+#include "third_party/blink/renderer/bindings/core/v8/script_promise_resolver.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_binding_for_core.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_uint8_array.h"
+#include "third_party/blink/renderer/core/execution_context/execution_context.h"
+#include "third_party/blink/renderer/core/streams/transform_stream_default_controller.h"
+#include "third_party/blink/renderer/core/typed_arrays/array_buffer_view_helpers.h"
+#include "third_party/blink/renderer/core/typed_arrays/dom_array_buffer.h"
+#include "third_party/blink/renderer/core/typed_arrays/dom_typed_array.h"
+#include "third_party/blink/renderer/modules/compression/compression_format.h"
+#include "third_party/blink/renderer/modules/compression/deflate_blocks.h"
+#include "third_party/blink/renderer/platform/bindings/exception_state.h"
+#include "third_party/blink/renderer/platform/bindings/to_v8.h"
+#include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
+#include "third_party/blink/renderer/platform/scheduler/public/worker_pool.h"
+#include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
+#include "v8/include/v8.h"
+
+namespace blink {
+
+constexpr wtf_size_t ParallelDeflateTransformer::kBlockSize;
+
+ParallelDeflateTransformer::ParallelDeflateTransformer(
+    ScriptState* script_state,
+    CompressionFormat format,
+    int level)
+    : script_state_(script_state),
+      format_(format),
+      level_(level),
+      max_blocks_in_flight_(
+          std::max(2, base::SysInfo::NumberOfProcessors())),
+      task_runner_(ExecutionContext::From(script_state)
+                       ->GetTaskRunner(TaskType::kMiscPlatformAPI)),
+      checksum_(DeflateBlocks::InitialChecksum(format)) {
+  DCHECK(level >= 1 && level <= 9);
+}
+
+ParallelDeflateTransformer::~ParallelDeflateTransformer() = default;
+
+ScriptPromise ParallelDeflateTransformer::Transform(
+    v8::Local<v8::Value> chunk,
+    TransformStreamDefaultController* controller,
+    ExceptionState& exception_state) {
+  DCHECK(!resolver_);
+  ArrayBufferOrArrayBufferView buffer_source;
+  V8ArrayBufferOrArrayBufferView::ToImpl(
+      script_state_->GetIsolate(), chunk, buffer_source,
+      UnionTypeConversionMode::kNotNullable, exception_state);
+  if (exception_state.HadException()) {
+    return ScriptPromise();
+  }
+  const uint8_t* start;
+  size_t length;
+  if (buffer_source.IsArrayBufferView()) {
+    const auto* view = buffer_source.GetAsArrayBufferView().View();
+    start = static_cast<const uint8_t*>(view->BaseAddress());
+    length = view->byteLengthAsSizeT();
+  } else {
+    DCHECK(buffer_source.IsArrayBuffer());
+    const auto* array_buffer = buffer_source.GetAsArrayBuffer();
+    start = static_cast<const uint8_t*>(array_buffer->Data());
+    length = array_buffer->ByteLengthAsSizeT();
+  }
+  if (length > std::numeric_limits<wtf_size_t>::max()) {
+    exception_state.ThrowRangeError(
+        "Buffer size exceeds maximum heap object size.");
+    return ScriptPromise();
+  }
+
+  controller_ = controller;
+  AppendInput(base::make_span(start, length));
+  StartQueuedBlocks();
+  if (CanTakeInput())
+    return ScriptPromise::CastUndefined(script_state_);
+  resolver_ = MakeGarbageCollected<ScriptPromiseResolver>(script_state_);
+  return resolver_->Promise();
+}
+
+ScriptPromise ParallelDeflateTransformer::Flush(
+    TransformStreamDefaultController* controller,
+    ExceptionState& exception_state) {
+  DCHECK(!resolver_);
+  DCHECK(!was_flush_called_);
+  // Flush() is only called once the last Transform() promise resolved.
+  DCHECK(queued_inputs_.IsEmpty());
+  controller_ = controller;
+  was_flush_called_ = true;
+  Vector<uint8_t> rest;
+  rest.swap(pending_input_);
+  StartBlock(std::move(rest), /*last=*/true);
+  dictionary_.clear();
+  resolver_ = MakeGarbageCollected<ScriptPromiseResolver>(script_state_);
+  return resolver_->Promise();
+}
+
+void ParallelDeflateTransformer::AppendInput(base::span<const uint8_t> input) {
+  // The chunk belongs to script, which may change it once Transform()
+  // returns, so full blocks are copied out of it right away.
+  total_input_length_ += input.size();
+  if (!pending_input_.IsEmpty()) {
+    const size_t missing = kBlockSize - pending_input_.size();
+    if (input.size() < missing) {
+      pending_input_.Append(input.data(),
+                            static_cast<wtf_size_t>(input.size()));
+      return;
+    }
+    pending_input_.Append(input.data(), static_cast<wtf_size_t>(missing));
+    input = input.subspan(missing);
+    Vector<uint8_t> block_input;
+    block_input.swap(pending_input_);
+    queued_inputs_.push_back(std::move(block_input));
+  }
+  while (input.size() >= kBlockSize) {
+    Vector<uint8_t> block_input;
+    block_input.Append(input.data(), kBlockSize);
+    queued_inputs_.push_back(std::move(block_input));
+    input = input.subspan(kBlockSize);
+  }
+  pending_input_.Append(input.data(), static_cast<wtf_size_t>(input.size()));
+}
+
+void ParallelDeflateTransformer::StartQueuedBlocks() {
+  while (!queued_inputs_.IsEmpty() && blocks_.size() < max_blocks_in_flight_)
+    StartBlock(queued_inputs_.TakeFirst(), /*last=*/false);
+}
+
+bool ParallelDeflateTransformer::CanTakeInput() const {
+  return queued_inputs_.IsEmpty() && blocks_.size() < max_blocks_in_flight_;
+}
+
+void ParallelDeflateTransformer::StartBlock(Vector<uint8_t> input, bool last) {
+  Vector<uint8_t> dictionary = dictionary_;
+
+  if (input.size() >= DeflateBlocks::kDictionarySize) {
+    dictionary_.clear();
+    dictionary_.Append(
+        input.data() + input.size() - DeflateBlocks::kDictionarySize,
+        DeflateBlocks::kDictionarySize);
+  } else {
+    dictionary_.Append(input.data(), input.size());
+    if (dictionary_.size() > DeflateBlocks::kDictionarySize) {
+      dictionary_.EraseAt(0,
+                          dictionary_.size() - DeflateBlocks::kDictionarySize);
+    }
+  }
+
+  Block block;
+  block.input_size = input.size();
+  blocks_.push_back(std::move(block));
+  const uint64_t index = first_block_index_ + blocks_.size() - 1;
+  worker_pool::PostTask(
+      FROM_HERE,
+      CrossThreadBindOnce(&ParallelDeflateTransformer::CompressBlockInBackground,
+                          WrapCrossThreadWeakPersistent(this), task_runner_,
+                          index, std::move(dictionary), std::move(input),
+                          format_, level_, last));
+}
+
+// static
+void ParallelDeflateTransformer::CompressBlockInBackground(
+    CrossThreadWeakPersistent<ParallelDeflateTransformer> transformer,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+    uint64_t index,
+    Vector<uint8_t> dictionary,
+    Vector<uint8_t> input,
+    CompressionFormat format,
+    int level,
+    bool last) {
+  const uint32_t checksum = DeflateBlocks::Checksum(format, input);
+  // Compressed into the backing store directly, so that the main thread can
+  // wrap it in an ArrayBuffer without copying it.
+  const size_t bound = DeflateBlocks::CompressBlockBound(input.size());
+  ArrayBufferContents output(bound, 1, ArrayBufferContents::kNotShared,
+                             ArrayBufferContents::kDontInitialize);
+  size_t output_size = 0;
+  if (output.IsValid()) {
+    base::Optional<size_t> compressed_size = DeflateBlocks::CompressBlock(
+        dictionary, input, level, last,
+        base::make_span(static_cast<uint8_t*>(output.Data()), bound));
+    // An invalid |output| errors the stream on the main thread.
+    if (!compressed_size)
+      output = ArrayBufferContents();
+    else
+      output_size = *compressed_size;
+  }
+  if (output.IsValid()) {
+    // The ArrayBuffer keeps all of the backing store alive. Blocks which
+    // compressed well are small enough to copy into one of the right size.
+    if (output_size < bound / 2) {
+      ArrayBufferContents trimmed(output_size, 1,
+                                  ArrayBufferContents::kNotShared,
+                                  ArrayBufferContents::kDontInitialize);
+      if (trimmed.IsValid()) {
+        memcpy(trimmed.Data(), output.Data(), output_size);
+        output = std::move(trimmed);
+      }
+    }
+  }
+  PostCrossThreadTask(
+      *task_runner, FROM_HERE,
+      CrossThreadBindOnce(&ParallelDeflateTransformer::DidCompressBlock,
+                          std::move(transformer), index, checksum,
+                          static_cast<wtf_size_t>(output_size),
+                          std::move(output)));
+}
+
+void ParallelDeflateTransformer::DidCompressBlock(uint64_t index,
+                                                  uint32_t checksum,
+                                                  wtf_size_t output_size,
+                                                  ArrayBufferContents output) {
+  if (errored_ || !script_state_->ContextIsValid())
+    return;
+  DCHECK_GE(index, first_block_index_);
+  Block& block = blocks_[static_cast<wtf_size_t>(index - first_block_index_)];
+  DCHECK(!block.done);
+  block.done = true;
+  block.checksum = checksum;
+  block.output_size = output_size;
+  block.output = std::move(output);
+  EnqueueCompletedBlocks();
+}
+
+void ParallelDeflateTransformer::EnqueueCompletedBlocks() {
+  ScriptState::Scope scope(script_state_);
+  ExceptionState exception_state(script_state_->GetIsolate(),
+                                 ExceptionState::kUnknownContext, "", "");
+  while (!blocks_.IsEmpty() && blocks_.front().done) {
+    Block block = blocks_.TakeFirst();
+    ++first_block_index_;
+    // Either the backing store or zlib's state could not be allocated.
+    if (!block.output.IsValid()) {
+      exception_state.ThrowRangeError("Out of memory.");
+      break;
+    }
+    if (!header_enqueued_) {
+      header_enqueued_ = true;
+      Vector<uint8_t> header = DeflateBlocks::Header(format_, level_);
+      Enqueue(DOMArrayBuffer::Create(header.data(), header.size()),
+              header.size(), exception_state);
+      if (exception_state.HadException())
+        break;
+    }
+    checksum_ = DeflateBlocks::CombineChecksums(format_, checksum_,
+                                                block.checksum,
+                                                block.input_size);
+    Enqueue(DOMArrayBuffer::Create(std::move(block.output)), block.output_size,
+            exception_state);
+    if (exception_state.HadException())
+      break;
+  }
+
+  if (!exception_state.HadException()) {
+    StartQueuedBlocks();
+    if (was_flush_called_ && blocks_.IsEmpty()) {
+      Vector<uint8_t> trailer =
+          DeflateBlocks::Trailer(format_, checksum_, total_input_length_);
+      Enqueue(DOMArrayBuffer::Create(trailer.data(), trailer.size()),
+              trailer.size(), exception_state);
+    }
+  }
+
+  if (exception_state.HadException()) {
+    // The readable side is gone, stop compressing.
+    errored_ = true;
+    blocks_.clear();
+    queued_inputs_.clear();
+    if (resolver_)
+      resolver_.Release()->Reject(exception_state);
+    else
+      exception_state.ClearException();
+    return;
+  }
+
+  if (!resolver_)
+    return;
+  if (was_flush_called_ ? blocks_.IsEmpty() : CanTakeInput()) {
+    resolver_.Release()->Resolve();
+  }
+}
+
+void ParallelDeflateTransformer::Enqueue(DOMArrayBuffer* buffer,
+                                         wtf_size_t length,
+                                         ExceptionState& exception_state) {
+  controller_->enqueue(
+      script_state_,
+      ScriptValue::From(script_state_,
+                        DOMUint8Array::Create(buffer, 0, length)),
+      exception_state);
+}
+
+void ParallelDeflateTransformer::Trace(Visitor* visitor) const {
+  visitor->Trace(script_state_);
+  visitor->Trace(controller_);
+  visitor->Trace(resolver_);
+  TransformStreamTransformer::Trace(visitor);
+}
+
+}  // namespace blink
@@ -0,0 +1,120 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_PARALLEL_DEFLATE_TRANSFORMER_H_
+#define THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_PARALLEL_DEFLATE_TRANSFORMER_H_
+
+#include "base/containers/span.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/single_thread_task_runner.h"
+#include "third_party/blink/renderer/core/streams/transform_stream_transformer.h"
+#include "third_party/blink/renderer/core/typed_arrays/array_buffer/array_buffer_contents.h"
+#include "third_party/blink/renderer/modules/modules_export.h"
+#include "third_party/blink/renderer/platform/heap/persistent.h"
+#include "third_party/blink/renderer/platform/wtf/deque.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+enum class CompressionFormat;
+class DOMArrayBuffer;
+class ScriptPromiseResolver;
+
+// Compresses on the worker pool, with several blocks in flight at once. The
+// input is cut into blocks of kBlockSize bytes which are compressed
+// independently, see DeflateBlocks. Blocks are compressed straight into
+// ArrayBuffer backing stores, which are enqueued in order.
+//
+// At most as many blocks as there are cores are pending at once. The full
+// blocks of a chunk beyond that are queued, and started as earlier blocks are
+// enqueued. Transform() only waits for compression once the limit is reached.
+// The TransformStream does not pass the next chunk before the promise it
+// returns settles, so backpressure still reaches the writer.
+class MODULES_EXPORT ParallelDeflateTransformer final
+    : public TransformStreamTransformer {
+ public:
+  // Same as pigz.
+  static constexpr wtf_size_t kBlockSize = 128 * 1024;
+
+  ParallelDeflateTransformer(ScriptState*, CompressionFormat, int level);
+  ~ParallelDeflateTransformer() override;
+
+  ScriptPromise Transform(v8::Local<v8::Value> chunk,
+                          TransformStreamDefaultController*,
+                          ExceptionState&) override;
+
+  ScriptPromise Flush(TransformStreamDefaultController*,
+                      ExceptionState&) override;
+
+  ScriptState* GetScriptState() override { return script_state_; }
+
+  void Trace(Visitor*) const override;
+
+ private:
+  struct Block {
+    DISALLOW_NEW();
+
+    bool done = false;
+    wtf_size_t input_size = 0;
+    uint32_t checksum = 0;
+    // Compressed bytes at the start of |output|, which may be larger.
+    wtf_size_t output_size = 0;
+    ArrayBufferContents output;
+  };
+
+  void AppendInput(base::span<const uint8_t>);
+  // Starts queued blocks while fewer than |max_blocks_in_flight_| are pending.
+  void StartQueuedBlocks();
+  void StartBlock(Vector<uint8_t> input, bool last);
+  bool CanTakeInput() const;
+  static void CompressBlockInBackground(
+      CrossThreadWeakPersistent<ParallelDeflateTransformer>,
+      scoped_refptr<base::SingleThreadTaskRunner>,
+      uint64_t index,
+      Vector<uint8_t> dictionary,
+      Vector<uint8_t> input,
+      CompressionFormat,
+      int level,
+      bool last);
+  void DidCompressBlock(uint64_t index,
+                        uint32_t checksum,
+                        wtf_size_t output_size,
+                        ArrayBufferContents output);
+  // Enqueues the leading completed blocks, and settles the pending promise
+  // when possible.
+  void EnqueueCompletedBlocks();
+  void Enqueue(DOMArrayBuffer*, wtf_size_t length, ExceptionState&);
+
+  Member<ScriptState> script_state_;
+  Member<TransformStreamDefaultController> controller_;
+  // Returned by a Transform() or Flush() call which waits for blocks.
+  Member<ScriptPromiseResolver> resolver_;
+
+  const CompressionFormat format_;
+  const int level_;
+  const wtf_size_t max_blocks_in_flight_;
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
+
+  // Input which does not fill a block yet.
+  Vector<uint8_t> pending_input_;
+  // Full blocks which wait for a slot, in order.
+  Deque<Vector<uint8_t>> queued_inputs_;
+  // The last DeflateBlocks::kDictionarySize bytes passed to a block.
+  Vector<uint8_t> dictionary_;
+  // Blocks which were started but not enqueued yet, in order.
+  Deque<Block> blocks_;
+  uint64_t first_block_index_ = 0;
+
+  uint32_t checksum_;
+  uint64_t total_input_length_ = 0;
+  bool header_enqueued_ = false;
+  bool was_flush_called_ = false;
+  bool errored_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelDeflateTransformer);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_PARALLEL_DEFLATE_TRANSFORMER_H_
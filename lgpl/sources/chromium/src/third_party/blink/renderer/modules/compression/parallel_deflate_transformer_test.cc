@@ -0,0 +1,94 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/modules/compression/parallel_deflate_transformer.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_binding_for_testing.h"
+#include "third_party/blink/renderer/modules/compression/background_inflate_transformer.h"
+#include "third_party/blink/renderer/modules/compression/compression_format.h"
+#include "third_party/blink/renderer/modules/compression/test_utils.h"
+#include "third_party/blink/renderer/platform/heap/heap.h"
+
+namespace blink {
+
+namespace {
+
+constexpr int kLevel = 6;
+constexpr wtf_size_t kDeflateBlockSize =
+    ParallelDeflateTransformer::kBlockSize;
+
+class ParallelDeflateTransformerTest
+    : public testing::TestWithParam<CompressionFormat> {
+ protected:
+  // Compresses |chunks|, then decompresses the result in a single chunk with
+  // BackgroundInflateTransformer.
+  void ExpectRoundTrip(const Vector<Vector<uint8_t>>& chunks) {
+    V8TestingScope scope;
+    Vector<uint8_t> input;
+    for (const auto& chunk : chunks)
+      input.AppendVector(chunk);
+
+    Vector<uint8_t> compressed;
+    ASSERT_TRUE(RunTransformer(
+        scope,
+        MakeGarbageCollected<ParallelDeflateTransformer>(
+            scope.GetScriptState(), GetParam(), kLevel),
+        chunks, &compressed));
+    Vector<uint8_t> output;
+    ASSERT_TRUE(RunTransformer(
+        scope,
+        MakeGarbageCollected<BackgroundInflateTransformer>(
+            scope.GetScriptState(), GetParam()),
+        {compressed}, &output));
+    EXPECT_EQ(input, output);
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         ParallelDeflateTransformerTest,
+                         testing::Values(CompressionFormat::kDeflate,
+                                         CompressionFormat::kGzip));
+
+TEST_P(ParallelDeflateTransformerTest, EmptyInput) {
+  ExpectRoundTrip({});
+  ExpectRoundTrip({Vector<uint8_t>()});
+}
+
+TEST_P(ParallelDeflateTransformerTest, SmallChunks) {
+  ExpectRoundTrip(SplitIntoChunks(CompressionTestInput(5000), 1));
+  ExpectRoundTrip(SplitIntoChunks(CompressionTestInput(300000), 1000));
+}
+
+TEST_P(ParallelDeflateTransformerTest, ChunksAroundBlockSize) {
+  const Vector<uint8_t> input =
+      CompressionTestInput(3 * kDeflateBlockSize + 10);
+  for (wtf_size_t chunk_size :
+       {kDeflateBlockSize - 1, kDeflateBlockSize, kDeflateBlockSize + 1}) {
+    SCOPED_TRACE(chunk_size);
+    ExpectRoundTrip(SplitIntoChunks(input, chunk_size));
+  }
+}
+
+TEST_P(ParallelDeflateTransformerTest, EmptyChunksBetweenBlocks) {
+  const Vector<Vector<uint8_t>> blocks = SplitIntoChunks(
+      CompressionTestInput(2 * kDeflateBlockSize), kDeflateBlockSize);
+  ExpectRoundTrip({Vector<uint8_t>(), blocks[0], Vector<uint8_t>(), blocks[1],
+                   Vector<uint8_t>()});
+}
+
+TEST_P(ParallelDeflateTransformerTest, LargeChunk) {
+  // More blocks than fit in flight at once, so most of them are queued.
+  ExpectRoundTrip({CompressionTestInput(40 * kDeflateBlockSize + 123)});
+}
+
+TEST_P(ParallelDeflateTransformerTest, LargeChunkAfterPartialBlock) {
+  ExpectRoundTrip({CompressionTestInput(1000),
+                   CompressionTestInput(40 * kDeflateBlockSize + 123),
+                   CompressionTestInput(1000)});
+}
+
+}  // namespace
+
+}  // namespace blink
@@ -0,0 +1,123 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/modules/compression/test_utils.h"
+
+#include <algorithm>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/bindings/core/v8/script_promise.h"
+#include "third_party/blink/renderer/bindings/core/v8/script_promise_tester.h"
+#include "third_party/blink/renderer/bindings/core/v8/script_value.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_binding_for_testing.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_extras_test_utils.h"
+#include "third_party/blink/renderer/bindings/core/v8/v8_uint8_array.h"
+#include "third_party/blink/renderer/core/streams/readable_stream.h"
+#include "third_party/blink/renderer/core/streams/transform_stream.h"
+#include "third_party/blink/renderer/core/streams/transform_stream_transformer.h"
+#include "third_party/blink/renderer/core/streams/writable_stream.h"
+#include "third_party/blink/renderer/core/typed_arrays/dom_typed_array.h"
+#include "third_party/blink/renderer/platform/bindings/exception_state.h"
+#include "third_party/blink/renderer/platform/bindings/to_v8.h"
+#include "third_party/blink/renderer/platform/bindings/v8_binding.h"
+#include "v8/include/v8.h"
+
+namespace blink {
+
+bool RunTransformer(V8TestingScope& scope,
+                    TransformStreamTransformer* transformer,
+                    const Vector<Vector<uint8_t>>& chunks,
+                    Vector<uint8_t>* output) {
+  ScriptState* script_state = scope.GetScriptState();
+  v8::Isolate* isolate = scope.GetIsolate();
+  auto* stream =
+      TransformStream::Create(script_state, transformer, ASSERT_NO_EXCEPTION);
+  auto set_global = [&scope](const char* name, v8::Local<v8::Value> value) {
+    v8::Local<v8::Object> global = scope.GetContext()->Global();
+    EXPECT_TRUE(global
+                    ->Set(scope.GetContext(),
+                          V8String(scope.GetIsolate(), name), value)
+                    .IsJust());
+  };
+
+  v8::Local<v8::Array> chunk_array = v8::Array::New(isolate, chunks.size());
+  for (wtf_size_t i = 0; i < chunks.size(); ++i) {
+    EXPECT_TRUE(chunk_array
+                    ->Set(scope.GetContext(), i,
+                          ToV8(DOMUint8Array::Create(chunks[i].data(),
+                                                     chunks[i].size()),
+                               script_state))
+                    .IsJust());
+  }
+  set_global("chunks", chunk_array);
+  set_global("readable", ToV8(stream->Readable(), script_state));
+  set_global("writable", ToV8(stream->Writable(), script_state));
+
+  ScriptValue result = EvalWithPrintingError(
+      &scope,
+      "(async () => {\n"
+      "  const reader = readable.getReader();\n"
+      "  const reading = (async () => {\n"
+      "    const outputs = [];\n"
+      "    for (;;) {\n"
+      "      const {value, done} = await reader.read();\n"
+      "      if (done)\n"
+      "        return outputs;\n"
+      "      outputs.push(value);\n"
+      "    }\n"
+      "  })();\n"
+      "  const writer = writable.getWriter();\n"
+      "  for (const chunk of chunks)\n"
+      "    await writer.write(chunk);\n"
+      "  await writer.close();\n"
+      "  const outputs = await reading;\n"
+      "  let length = 0;\n"
+      "  for (const output of outputs)\n"
+      "    length += output.length;\n"
+      "  const result = new Uint8Array(length);\n"
+      "  let offset = 0;\n"
+      "  for (const output of outputs) {\n"
+      "    result.set(output, offset);\n"
+      "    offset += output.length;\n"
+      "  }\n"
+      "  return result;\n"
+      "})()");
+  ScriptPromiseTester tester(script_state,
+                             ScriptPromise::Cast(script_state, result));
+  tester.WaitUntilSettled();
+  if (!tester.IsFulfilled())
+    return false;
+
+  DOMUint8Array* array =
+      V8Uint8Array::ToImplWithTypeCheck(isolate, tester.Value().V8Value());
+  EXPECT_TRUE(array);
+  if (!array)
+    return false;
+  output->clear();
+  output->Append(array->Data(),
+                 static_cast<wtf_size_t>(array->byteLengthAsSizeT()));
+  return true;
+}
+
+Vector<uint8_t> CompressionTestInput(wtf_size_t size) {
+  Vector<uint8_t> input;
+  input.ReserveInitialCapacity(size);
+  for (wtf_size_t i = 0; i < size; ++i)
+    input.push_back(static_cast<uint8_t>((i * 7) % 251 + (i / 1000) % 3));
+  return input;
+}
+
+Vector<Vector<uint8_t>> SplitIntoChunks(const Vector<uint8_t>& input,
+                                        wtf_size_t chunk_size) {
+  Vector<Vector<uint8_t>> chunks;
+  for (wtf_size_t offset = 0; offset < input.size(); offset += chunk_size) {
+    Vector<uint8_t> chunk;
+    chunk.Append(input.data() + offset,
+                 std::min(chunk_size, input.size() - offset));
+    chunks.push_back(std::move(chunk));
+  }
+  return chunks;
+}
+
+}  // namespace blink
@@ -0,0 +1,37 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Utilities for testing classes in this directory. They assume they are running
+// inside a gtest test.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_TEST_UTILS_H_
+#define THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_TEST_UTILS_H_
+
+#include <stdint.h>
+
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+class TransformStreamTransformer;
+class V8TestingScope;
+
+// Writes |chunks| to a TransformStream using |transformer|, one write at a
+// time, and reads the output concurrently. Returns true and sets |output| to
+// the concatenated output if the stream closed cleanly, false if it errored.
+bool RunTransformer(V8TestingScope&,
+                    TransformStreamTransformer* transformer,
+                    const Vector<Vector<uint8_t>>& chunks,
+                    Vector<uint8_t>* output);
+
+// Compressible input which is not just a repeated pattern.
+Vector<uint8_t> CompressionTestInput(wtf_size_t size);
+
+// Cuts |input| into chunks of |chunk_size| bytes. The last one may be shorter.
+Vector<Vector<uint8_t>> SplitIntoChunks(const Vector<uint8_t>& input,
+                                        wtf_size_t chunk_size);
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_MODULES_COMPRESSION_TEST_UTILS_H_
@@ -6,15 +6,23 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+
 #include "base/single_thread_task_runner.h"
+#include "base/time/default_tick_clock.h"
 #include "mojo/public/cpp/bindings/self_owned_associated_receiver.h"
 #include "third_party/blink/public/mojom/indexeddb/indexeddb.mojom-blink.h"
 #include "third_party/blink/renderer/modules/indexeddb/idb_key_range.h"
 #include "third_party/blink/renderer/modules/indexeddb/indexed_db_dispatcher.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/wtf/functional.h"
 
 namespace blink {
 
+constexpr int WebIDBCursorImpl::kMaxAdaptivePrefetchAmount;
+constexpr size_t WebIDBCursorImpl::kMaxAdaptivePrefetchBytes;
+constexpr base::TimeDelta WebIDBCursorImpl::kPrefetchBatchDuration;
+
 WebIDBCursorImpl::WebIDBCursorImpl(
     mojo::PendingAssociatedRemote<mojom::blink::IDBCursor> cursor_info,
     int64_t transaction_id,
@@ -24,6 +32,7 @@ WebIDBCursorImpl::WebIDBCursorImpl(
       used_prefetches_(0),
       pending_onsuccess_callbacks_(0),
       prefetch_amount_(kMinPrefetchAmount),
+      clock_(base::DefaultTickClock::GetInstance()),
       task_runner_(task_runner) {
   cursor_.Bind(std::move(cursor_info), std::move(task_runner));
   IndexedDBDispatcher::RegisterCursor(this);
@@ -109,6 +118,9 @@ void WebIDBCursorImpl::CursorContinue(const IDBKey* key,
     }
 
     if (continue_count_ > kPrefetchContinueThreshold) {
+      if (RuntimeEnabledFeatures::IndexedDBAdaptivePrefetchEnabled())
+        AdaptPrefetchAmount();
+
       // Request pre-fetch.
       ++pending_onsuccess_callbacks_;
 
@@ -117,10 +129,13 @@ void WebIDBCursorImpl::CursorContinue(const IDBKey* key,
                         WTF::Bind(&WebIDBCursorImpl::PrefetchCallback,
                                   WTF::Unretained(this), std::move(callbacks)));
 
-      // Increase prefetch_amount_ exponentially.
-      prefetch_amount_ *= 2;
-      if (prefetch_amount_ > kMaxPrefetchAmount)
-        prefetch_amount_ = kMaxPrefetchAmount;
+      // Increase prefetch_amount_ exponentially. An amount that was already
+      // raised past the limit by AdaptPrefetchAmount() is kept.
+      if (prefetch_amount_ < kMaxPrefetchAmount) {
+        prefetch_amount_ *= 2;
+        if (prefetch_amount_ > kMaxPrefetchAmount)
+          prefetch_amount_ = kMaxPrefetchAmount;
+      }
 
       return;
     }
@@ -242,6 +257,44 @@ void WebIDBCursorImpl::SetPrefetchData(
 
   used_prefetches_ = 0;
   pending_onsuccess_callbacks_ = 0;
+
+  prefetch_batch_size_ = prefetch_values_.size();
+  prefetch_batch_bytes_ = 0;
+  for (const auto& value : prefetch_values_)
+    prefetch_batch_bytes_ += value->DataSize();
+  prefetch_batch_received_time_ = clock_->NowTicks();
+}
+
+void WebIDBCursorImpl::AdaptPrefetchAmount() {
+  // Only a batch that was consumed entirely tells how fast script iterates.
+  if (!prefetch_batch_size_ || used_prefetches_ < prefetch_batch_size_)
+    return;
+
+  // Values larger than the byte budget still get the minimum batch size.
+  int max_amount = kMaxAdaptivePrefetchAmount;
+  if (prefetch_batch_bytes_) {
+    uint64_t max_by_size = static_cast<uint64_t>(kMaxAdaptivePrefetchBytes) *
+                           prefetch_batch_size_ / prefetch_batch_bytes_;
+    if (max_by_size < static_cast<uint64_t>(kMinPrefetchAmount))
+      max_amount = kMinPrefetchAmount;
+    else if (max_by_size < static_cast<uint64_t>(max_amount))
+      max_amount = static_cast<int>(max_by_size);
+  }
+
+  // The batch is consumed between its arrival and the continue() call that
+  // finds the cache empty, which is now.
+  int64_t elapsed_us = std::max<int64_t>(
+      (clock_->NowTicks() - prefetch_batch_received_time_).InMicroseconds(), 1);
+  int64_t amount = kPrefetchBatchDuration.InMicroseconds() *
+                   prefetch_batch_size_ / elapsed_us;
+
+  // Never go below what the fixed doubling would request, but drop amounts
+  // above its limit once iteration slows down.
+  int64_t min_amount =
+      prefetch_amount_ < kMaxPrefetchAmount ? prefetch_amount_
+                                            : int64_t{kMaxPrefetchAmount};
+  prefetch_amount_ = static_cast<int>(
+      std::min<int64_t>(std::max(amount, min_amount), max_amount));
 }
 
 void WebIDBCursorImpl::CachedAdvance(uint32_t count,
@@ -295,6 +348,7 @@ void WebIDBCursorImpl::CachedContinue(WebIDBCallbacks* callbacks) {
 void WebIDBCursorImpl::ResetPrefetchCache() {
   continue_count_ = 0;
   prefetch_amount_ = kMinPrefetchAmount;
+  prefetch_batch_size_ = 0;
 
   if (prefetch_keys_.IsEmpty()) {
     // No prefetch cache, so no need to reset the cursor in the back-end.
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include "base/gtest_prod_util.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
 #include "third_party/blink/public/mojom/indexeddb/indexeddb.mojom-blink.h"
@@ -16,6 +17,10 @@
 #include "third_party/blink/renderer/modules/indexeddb/web_idb_cursor.h"
 #include "third_party/blink/renderer/modules/modules_export.h"
 
+namespace base {
+class TickClock;
+}
+
 namespace blink {
 
 class MODULES_EXPORT WebIDBCursorImpl : public WebIDBCursor {
@@ -58,6 +63,9 @@ class MODULES_EXPORT WebIDBCursorImpl : public WebIDBCursor {
 
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorReset);
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorTransactionId);
+  FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, AdaptivePrefetchByteLimit);
+  FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, AdaptivePrefetchFastIteration);
+  FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, AdaptivePrefetchSlowIteration);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, AdvancePrefetchTest);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchReset);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchTest);
@@ -66,6 +74,20 @@ class MODULES_EXPORT WebIDBCursorImpl : public WebIDBCursor {
   static constexpr int kMinPrefetchAmount = 5;
   static constexpr int kMaxPrefetchAmount = 100;
 
+  // Limits used when prefetches are sized from the iteration rate. A batch is
+  // sized to last about kPrefetchBatchDuration at the rate the previous batch
+  // was consumed, up to kMaxAdaptivePrefetchAmount records and about
+  // kMaxAdaptivePrefetchBytes of values.
+  static constexpr int kMaxAdaptivePrefetchAmount = 2000;
+  static constexpr size_t kMaxAdaptivePrefetchBytes = 8 * 1024 * 1024;
+  static constexpr base::TimeDelta kPrefetchBatchDuration =
+      base::TimeDelta::FromMilliseconds(50);
+
+  // Grows |prefetch_amount_| so that the next batch covers
+  // kPrefetchBatchDuration of iteration, based on how quickly the current
+  // batch was consumed.
+  void AdaptPrefetchAmount();
+
   int64_t transaction_id_;
 
   mojo::AssociatedRemote<mojom::blink::IDBCursor> cursor_;
@@ -89,6 +111,14 @@ class MODULES_EXPORT WebIDBCursorImpl : public WebIDBCursor {
   // Number of items to request in next prefetch.
   int prefetch_amount_;
 
+  // Size of the current prefetch batch, the total size of its values, and
+  // when it was received. Used to estimate the iteration rate.
+  int prefetch_batch_size_ = 0;
+  size_t prefetch_batch_bytes_ = 0;
+  base::TimeTicks prefetch_batch_received_time_;
+
+  const base::TickClock* clock_;
+
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
   base::WeakPtrFactory<WebIDBCursorImpl> weak_factory_{this};
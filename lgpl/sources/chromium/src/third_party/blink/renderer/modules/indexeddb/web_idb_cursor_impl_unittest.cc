@@ -11,6 +11,7 @@
 
 #include "base/bind.h"
 #include "base/macros.h"
+#include "base/test/simple_test_tick_clock.h"
 #include "mojo/public/cpp/bindings/associated_receiver.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
@@ -18,6 +19,7 @@
 #include "third_party/blink/public/platform/scheduler/test/renderer_scheduler_test_support.h"
 #include "third_party/blink/renderer/modules/indexeddb/idb_key_range.h"
 #include "third_party/blink/renderer/modules/indexeddb/mock_web_idb_callbacks.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 #include "third_party/blink/renderer/platform/testing/testing_platform_support.h"
 #include "third_party/blink/renderer/platform/testing/unit_test_helpers.h"
 
@@ -108,6 +110,22 @@ class MockContinueCallbacks : public testing::StrictMock<MockWebIDBCallbacks> {
   Vector<WebBlobInfo>* blobs_;
 };
 
+// Fills |cursor|'s prefetch cache with |count| records whose values are
+// |value_size| bytes each.
+void SetPrefetchData(WebIDBCursorImpl* cursor, int count, size_t value_size) {
+  Vector<std::unique_ptr<IDBKey>> keys;
+  Vector<std::unique_ptr<IDBKey>> primary_keys;
+  Vector<std::unique_ptr<IDBValue>> values;
+  for (int i = 0; i < count; ++i) {
+    keys.emplace_back(IDBKey::CreateNumber(i));
+    primary_keys.emplace_back();
+    values.emplace_back(std::make_unique<IDBValue>(
+        SharedBuffer::Create(value_size), Vector<WebBlobInfo>()));
+  }
+  cursor->SetPrefetchData(std::move(keys), std::move(primary_keys),
+                          std::move(values));
+}
+
 }  // namespace
 
 class WebIDBCursorImplTest : public testing::Test {
@@ -361,4 +379,98 @@ TEST_F(WebIDBCursorImplTest, PrefetchReset) {
   EXPECT_TRUE(mock_cursor_->destroyed());
 }
 
+TEST_F(WebIDBCursorImplTest, AdaptivePrefetchFastIteration) {
+  ScopedIndexedDBAdaptivePrefetchForTest adaptive_prefetch(true);
+  base::SimpleTestTickClock clock;
+  cursor_->clock_ = &clock;
+
+  // Call continue() until prefetching should kick in, then initiate it.
+  for (int i = 0; i <= WebIDBCursorImpl::kPrefetchContinueThreshold; ++i) {
+    cursor_->CursorContinue(null_key_.get(), null_key_.get(),
+                            new MockContinueCallbacks());
+  }
+  platform_->RunUntilIdle();
+  EXPECT_EQ(1, mock_cursor_->prefetch_calls());
+  const int prefetch_count = mock_cursor_->last_prefetch_count();
+  SetPrefetchData(cursor_.get(), prefetch_count, 100);
+
+  // Consume the whole batch in a millisecond.
+  for (int i = 0; i < prefetch_count; ++i) {
+    cursor_->CursorContinue(null_key_.get(), null_key_.get(),
+                            new MockContinueCallbacks());
+  }
+  clock.Advance(base::TimeDelta::FromMilliseconds(1));
+
+  // The next batch is sized to last kPrefetchBatchDuration at that rate,
+  // which is more than the fixed doubling allows.
+  cursor_->CursorContinue(null_key_.get(), null_key_.get(),
+                          new MockContinueCallbacks());
+  platform_->RunUntilIdle();
+  EXPECT_EQ(2, mock_cursor_->prefetch_calls());
+  EXPECT_EQ(WebIDBCursorImpl::kPrefetchBatchDuration.InMicroseconds() *
+                prefetch_count / 1000,
+            mock_cursor_->last_prefetch_count());
+  EXPECT_GT(mock_cursor_->last_prefetch_count(),
+            static_cast<int>(WebIDBCursorImpl::kMaxPrefetchAmount));
+}
+
+TEST_F(WebIDBCursorImplTest, AdaptivePrefetchSlowIteration) {
+  ScopedIndexedDBAdaptivePrefetchForTest adaptive_prefetch(true);
+  base::SimpleTestTickClock clock;
+  cursor_->clock_ = &clock;
+
+  for (int i = 0; i <= WebIDBCursorImpl::kPrefetchContinueThreshold; ++i) {
+    cursor_->CursorContinue(null_key_.get(), null_key_.get(),
+                            new MockContinueCallbacks());
+  }
+  platform_->RunUntilIdle();
+  const int prefetch_count = mock_cursor_->last_prefetch_count();
+  SetPrefetchData(cursor_.get(), prefetch_count, 100);
+
+  // Consume the whole batch slowly.
+  for (int i = 0; i < prefetch_count; ++i) {
+    cursor_->CursorContinue(null_key_.get(), null_key_.get(),
+                            new MockContinueCallbacks());
+  }
+  clock.Advance(base::TimeDelta::FromSeconds(10));
+
+  // The amount grows as it would without adaptive prefetching.
+  cursor_->CursorContinue(null_key_.get(), null_key_.get(),
+                          new MockContinueCallbacks());
+  platform_->RunUntilIdle();
+  EXPECT_EQ(2, mock_cursor_->prefetch_calls());
+  EXPECT_EQ(prefetch_count * 2, mock_cursor_->last_prefetch_count());
+}
+
+TEST_F(WebIDBCursorImplTest, AdaptivePrefetchByteLimit) {
+  ScopedIndexedDBAdaptivePrefetchForTest adaptive_prefetch(true);
+  base::SimpleTestTickClock clock;
+  cursor_->clock_ = &clock;
+
+  for (int i = 0; i <= WebIDBCursorImpl::kPrefetchContinueThreshold; ++i) {
+    cursor_->CursorContinue(null_key_.get(), null_key_.get(),
+                            new MockContinueCallbacks());
+  }
+  platform_->RunUntilIdle();
+  const int prefetch_count = mock_cursor_->last_prefetch_count();
+  const size_t value_size = 1024 * 1024;
+  SetPrefetchData(cursor_.get(), prefetch_count, value_size);
+
+  // Iterate quickly over large values.
+  for (int i = 0; i < prefetch_count; ++i) {
+    cursor_->CursorContinue(null_key_.get(), null_key_.get(),
+                            new MockContinueCallbacks());
+  }
+  clock.Advance(base::TimeDelta::FromMilliseconds(1));
+
+  // The next batch stays within the byte budget.
+  cursor_->CursorContinue(null_key_.get(), null_key_.get(),
+                          new MockContinueCallbacks());
+  platform_->RunUntilIdle();
+  EXPECT_EQ(2, mock_cursor_->prefetch_calls());
+  EXPECT_EQ(
+      static_cast<int>(WebIDBCursorImpl::kMaxAdaptivePrefetchBytes / value_size),
+      mock_cursor_->last_prefetch_count());
+}
+
 }  // namespace blink
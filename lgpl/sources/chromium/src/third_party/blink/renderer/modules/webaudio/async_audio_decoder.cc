@@ -25,6 +25,10 @@
 
 #include "third_party/blink/renderer/modules/webaudio/async_audio_decoder.h"
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
 #include "base/location.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/core/typed_arrays/dom_array_buffer.h"
@@ -32,6 +36,8 @@
 #include "third_party/blink/renderer/modules/webaudio/base_audio_context.h"
 #include "third_party/blink/renderer/platform/audio/audio_bus.h"
 #include "third_party/blink/renderer/platform/audio/audio_file_reader.h"
+#include "third_party/blink/renderer/platform/audio/sinc_resampler.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread.h"
 #include "third_party/blink/renderer/platform/scheduler/public/worker_pool.h"
@@ -63,6 +69,62 @@ void AsyncAudioDecoder::DecodeAsync(DOMArrayBuffer* audio_data,
                           std::move(task_runner)));
 }
 
+struct AsyncAudioDecoder::DecodedAudio {
+  USING_FAST_MALLOC(DecodedAudio);
+
+ public:
+  Vector<ArrayBufferContents> channels;
+  uint32_t length = 0;
+  float sample_rate = 0;
+};
+
+std::unique_ptr<AsyncAudioDecoder::DecodedAudio>
+AsyncAudioDecoder::ConvertForAudioBuffer(const AudioBus& bus,
+                                         float sample_rate) {
+  DCHECK(bus.SampleRate());
+  // A zero |sample_rate| means to keep the file's sample-rate.
+  if (!sample_rate)
+    sample_rate = bus.SampleRate();
+  double sample_rate_ratio = bus.SampleRate() / sample_rate;
+  size_t source_length = bus.length();
+  // Same length as AudioBus::CreateBySampleRateConverting() gives.
+  size_t length = sample_rate_ratio == 1
+                      ? source_length
+                      : static_cast<size_t>(source_length / sample_rate_ratio);
+  if (length > std::numeric_limits<uint32_t>::max())
+    return nullptr;
+
+  auto decoded = std::make_unique<DecodedAudio>();
+  decoded->length = static_cast<uint32_t>(length);
+  decoded->sample_rate = sample_rate;
+  decoded->channels.ReserveInitialCapacity(bus.NumberOfChannels());
+
+  for (unsigned i = 0; i < bus.NumberOfChannels(); ++i) {
+    ArrayBufferContents contents(length, sizeof(float),
+                                 ArrayBufferContents::kNotShared,
+                                 ArrayBufferContents::kDontInitialize);
+    if (length && !contents.IsValid())
+      return nullptr;
+
+    const float* source = bus.Channel(i)->Data();
+    float* destination = static_cast<float*>(contents.Data());
+    if (!length) {
+      // Nothing to write.
+    } else if (bus.Channel(i)->IsSilent()) {
+      std::fill(destination, destination + length, 0);
+    } else if (sample_rate_ratio == 1) {
+      memcpy(destination, source, length * sizeof(float));
+    } else {
+      // SincResampler works through the source in blocks and writes its output
+      // directly to |destination|, so no intermediate bus is needed.
+      SincResampler resampler(sample_rate_ratio);
+      resampler.Process(source, destination, source_length);
+    }
+    decoded->channels.push_back(std::move(contents));
+  }
+  return decoded;
+}
+
 void AsyncAudioDecoder::DecodeOnBackgroundThread(
     DOMArrayBuffer* audio_data,
     float sample_rate,
@@ -72,12 +134,21 @@ void AsyncAudioDecoder::DecodeOnBackgroundThread(
     BaseAudioContext* context,
     scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
   DCHECK(!IsMainThread());
-  scoped_refptr<AudioBus> bus = CreateBusFromInMemoryAudioFile(
-      audio_data->Data(), audio_data->ByteLengthAsSizeT(), false, sample_rate);
+  TRACE_EVENT1("webaudio", "AsyncAudioDecoder::DecodeOnBackgroundThread",
+               "encoded_bytes", audio_data->ByteLengthAsSizeT());
+
+  std::unique_ptr<DecodedAudio> decoded;
+  {
+    // The decoded bus is at the file's sample-rate and is released as soon as
+    // it has been converted.
+    scoped_refptr<AudioBus> bus =
+        DecodeAudioFileData(static_cast<const char*>(audio_data->Data()),
+                            audio_data->ByteLengthAsSizeT());
+    if (bus)
+      decoded = ConvertForAudioBuffer(*bus, sample_rate);
+  }
 
   // Decoding is finished, but we need to do the callbacks on the main thread.
-  // A reference to |*bus| is retained by base::OnceCallback and will be removed
-  // after notifyComplete() is done.
   //
   // We also want to avoid notifying the main thread if AudioContext does not
   // exist any more.
@@ -88,7 +159,7 @@ void AsyncAudioDecoder::DecodeOnBackgroundThread(
                             WrapCrossThreadPersistent(audio_data),
                             WrapCrossThreadPersistent(success_callback),
                             WrapCrossThreadPersistent(error_callback),
-                            WTF::RetainedRef(std::move(bus)),
+                            std::move(decoded),
                             WrapCrossThreadPersistent(resolver),
                             WrapCrossThreadPersistent(context)));
   }
@@ -98,12 +169,16 @@ void AsyncAudioDecoder::NotifyComplete(
     DOMArrayBuffer*,
     V8DecodeSuccessCallback* success_callback,
     V8DecodeErrorCallback* error_callback,
-    AudioBus* audio_bus,
+    std::unique_ptr<DecodedAudio> decoded,
     ScriptPromiseResolver* resolver,
     BaseAudioContext* context) {
   DCHECK(IsMainThread());
 
-  AudioBuffer* audio_buffer = AudioBuffer::CreateFromAudioBus(audio_bus);
+  AudioBuffer* audio_buffer =
+      decoded ? AudioBuffer::CreateFromChannelContents(
+                    std::move(decoded->channels), decoded->length,
+                    decoded->sample_rate)
+              : nullptr;
 
   // If the context is available, let the context finish the notification.
   if (context) {
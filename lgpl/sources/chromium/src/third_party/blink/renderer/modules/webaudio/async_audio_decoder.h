@@ -48,6 +48,10 @@ class ScriptPromiseResolver;
 // DOMArrayBuffer in the background thread. Upon successful decoding, a
 // completion callback will be invoked with the decoded PCM data in an
 // AudioBuffer.
+//
+// The decoded (and, if needed, resampled) channels are written straight into
+// the backing stores which the AudioBuffer adopts, so no full-length copy is
+// made on the main thread.
 
 class AsyncAudioDecoder {
   DISALLOW_NEW();
@@ -77,10 +81,17 @@ class AsyncAudioDecoder {
       ScriptPromiseResolver*,
       BaseAudioContext*,
       scoped_refptr<base::SingleThreadTaskRunner>);
+  struct DecodedAudio;
+
+  // Converts |bus| to |sample_rate| channel by channel, into memory which can
+  // be handed to an AudioBuffer. Returns nullptr on allocation failure.
+  static std::unique_ptr<DecodedAudio> ConvertForAudioBuffer(const AudioBus&,
+                                                             float sample_rate);
+
   static void NotifyComplete(DOMArrayBuffer* audio_data,
                              V8DecodeSuccessCallback*,
                              V8DecodeErrorCallback*,
-                             AudioBus*,
+                             std::unique_ptr<DecodedAudio>,
                              ScriptPromiseResolver*,
                              BaseAudioContext*);
 
@@ -29,7 +29,10 @@
 #include "third_party/blink/renderer/modules/webaudio/audio_buffer.h"
 
 #include <memory>
+#include <utility>
+
 #include "third_party/blink/renderer/bindings/modules/v8/v8_audio_buffer_options.h"
+#include "third_party/blink/renderer/core/typed_arrays/dom_array_buffer.h"
 #include "third_party/blink/renderer/modules/webaudio/base_audio_context.h"
 #include "third_party/blink/renderer/platform/audio/audio_bus.h"
 #include "third_party/blink/renderer/platform/audio/audio_file_reader.h"
@@ -136,6 +139,18 @@ AudioBuffer* AudioBuffer::CreateFromAudioBus(AudioBus* bus) {
   return nullptr;
 }
 
+AudioBuffer* AudioBuffer::CreateFromChannelContents(
+    Vector<ArrayBufferContents> channels,
+    uint32_t number_of_frames,
+    float sample_rate) {
+  unsigned number_of_channels = channels.size();
+  AudioBuffer* buffer = MakeGarbageCollected<AudioBuffer>(
+      std::move(channels), number_of_frames, sample_rate);
+  if (buffer->CreatedSuccessfully(number_of_channels))
+    return buffer;
+  return nullptr;
+}
+
 bool AudioBuffer::CreatedSuccessfully(
     unsigned desired_number_of_channels) const {
   return numberOfChannels() == desired_number_of_channels;
@@ -188,6 +203,26 @@ AudioBuffer::AudioBuffer(AudioBus* bus)
   }
 }
 
+AudioBuffer::AudioBuffer(Vector<ArrayBufferContents> channels,
+                         uint32_t number_of_frames,
+                         float sample_rate)
+    : sample_rate_(sample_rate), length_(number_of_frames) {
+  channels_.ReserveCapacity(channels.size());
+  for (ArrayBufferContents& contents : channels) {
+    if (!length_) {
+      channels_.push_back(DOMFloat32Array::Create(0));
+      continue;
+    }
+    // As above, the caller checks that all of the channels were adopted.
+    if (!contents.IsValid() ||
+        contents.DataLength() != length_ * sizeof(float)) {
+      return;
+    }
+    channels_.push_back(DOMFloat32Array::Create(
+        DOMArrayBuffer::Create(std::move(contents)), 0, length_));
+  }
+}
+
 NotShared<DOMFloat32Array> AudioBuffer::getChannelData(
     unsigned channel_index,
     ExceptionState& exception_state) {
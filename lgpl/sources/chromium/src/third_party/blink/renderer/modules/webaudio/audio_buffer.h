@@ -68,7 +68,18 @@ class MODULES_EXPORT AudioBuffer final : public ScriptWrappable {
 
   static AudioBuffer* CreateFromAudioBus(AudioBus*);
 
+  // Adopts |channels| as the channel data, without copying. Each must hold
+  // |number_of_frames| floats. This lets the data be written off the main
+  // thread, e.g. by AsyncAudioDecoder.
+  static AudioBuffer* CreateFromChannelContents(
+      Vector<ArrayBufferContents> channels,
+      uint32_t number_of_frames,
+      float sample_rate);
+
   explicit AudioBuffer(AudioBus*);
+  AudioBuffer(Vector<ArrayBufferContents> channels,
+              uint32_t number_of_frames,
+              float sample_rate);
   // How to initialize the contents of an AudioBuffer.  Default is to
   // zero-initialize (|kZeroInitialize|).  Otherwise, leave the array
   // uninitialized (|kDontInitialize|).
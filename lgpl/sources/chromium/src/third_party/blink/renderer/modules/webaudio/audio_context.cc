@@ -178,6 +178,7 @@ void AudioContext::Uninitialize() {
   StopRendering();
   DidClose();
   RecordAutoplayMetrics();
+  GetDeferredTaskHandler().RecordGraphUpdateHistograms();
   BaseAudioContext::Uninitialize();
 }
 
@@ -579,8 +580,11 @@ bool AudioContext::HandlePreRenderTasks(const AudioIOPosition* output_position,
 
   // At the beginning of every render quantum, try to update the internal
   // rendering graph state (from main thread changes).  It's OK if the tryLock()
-  // fails, we'll just take slightly longer to pick up the changes.
-  if (TryLock()) {
+  // fails, we'll just take slightly longer to pick up the changes. Only this
+  // attempt is recorded, so that each render quantum counts once.
+  bool locked = TryLock();
+  GetDeferredTaskHandler().RecordGraphUpdateAttempt(locked);
+  if (locked) {
     GetDeferredTaskHandler().HandleDeferredTasks();
 
     ResolvePromisesForUnpause();
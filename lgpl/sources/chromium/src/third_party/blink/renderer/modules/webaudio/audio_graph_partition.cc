@@ -0,0 +1,96 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/modules/webaudio/audio_graph_partition.h"
+
+#include <algorithm>
+
+#include "third_party/blink/renderer/modules/webaudio/audio_node.h"
+#include "third_party/blink/renderer/modules/webaudio/audio_node_input.h"
+#include "third_party/blink/renderer/modules/webaudio/audio_node_output.h"
+#include "third_party/blink/renderer/modules/webaudio/deferred_task_handler.h"
+#include "third_party/blink/renderer/platform/wtf/hash_map.h"
+
+namespace blink {
+
+AudioGraphPartition::AudioGraphPartition(AudioNodeInput& input) {
+  DeferredTaskHandler& deferred_task_handler = input.GetDeferredTaskHandler();
+  DCHECK(deferred_task_handler.IsAudioThread());
+  deferred_task_handler.AssertGraphOwner();
+
+  const unsigned number_of_roots = input.NumberOfRenderingConnections();
+  if (!number_of_roots)
+    return;
+
+  // Union-find over the rendering outputs of |input|: two roots end up in the
+  // same set when some handler is reachable from both.
+  Vector<wtf_size_t> parent(number_of_roots);
+  for (wtf_size_t i = 0; i < number_of_roots; ++i)
+    parent[i] = i;
+  auto find = [&parent](wtf_size_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+
+  // Maps every handler visited to the root it was first reached from.
+  HashMap<AudioHandler*, wtf_size_t> owners;
+  Vector<AudioHandler*> stack;
+  for (wtf_size_t root = 0; root < number_of_roots; ++root) {
+    stack.push_back(&input.RenderingOutput(root)->Handler());
+    while (!stack.IsEmpty()) {
+      AudioHandler* handler = stack.back();
+      stack.pop_back();
+      auto result = owners.insert(handler, root);
+      if (!result.is_new_entry) {
+        wtf_size_t other = find(result.stored_value->value);
+        wtf_size_t current = find(root);
+        if (other != current)
+          parent[other] = current;
+        continue;
+      }
+      for (unsigned i = 0; i < handler->NumberOfInputs(); ++i) {
+        AudioNodeInput& handler_input = handler->Input(i);
+        for (unsigned j = 0; j < handler_input.NumberOfRenderingConnections();
+             ++j) {
+          stack.push_back(&handler_input.RenderingOutput(j)->Handler());
+        }
+      }
+    }
+  }
+
+  if (deferred_task_handler.NumberOfConnectedRenderingParams()) {
+    is_complete_ = false;
+    subgraphs_.resize(1);
+    for (wtf_size_t root = 0; root < number_of_roots; ++root)
+      subgraphs_[0].outputs.push_back(input.RenderingOutput(root));
+    subgraphs_[0].size = owners.size();
+    return;
+  }
+
+  // Number the subgraphs in the order their first output appears in |input|.
+  Vector<wtf_size_t> subgraph_of_set(number_of_roots, kNotFound);
+  for (wtf_size_t root = 0; root < number_of_roots; ++root) {
+    wtf_size_t set = find(root);
+    if (subgraph_of_set[set] == kNotFound) {
+      subgraph_of_set[set] = subgraphs_.size();
+      subgraphs_.emplace_back();
+    }
+    subgraphs_[subgraph_of_set[set]].outputs.push_back(
+        input.RenderingOutput(root));
+  }
+  for (const auto& owner : owners)
+    ++subgraphs_[subgraph_of_set[find(owner.value)]].size;
+}
+
+wtf_size_t AudioGraphPartition::LargestSubgraphSize() const {
+  wtf_size_t largest = 0;
+  for (const Subgraph& subgraph : subgraphs_)
+    largest = std::max(largest, subgraph.size);
+  return largest;
+}
+
+}  // namespace blink
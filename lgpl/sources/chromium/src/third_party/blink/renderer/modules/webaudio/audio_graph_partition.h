@@ -0,0 +1,64 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_MODULES_WEBAUDIO_AUDIO_GRAPH_PARTITION_H_
+#define THIRD_PARTY_BLINK_RENDERER_MODULES_WEBAUDIO_AUDIO_GRAPH_PARTITION_H_
+
+#include "third_party/blink/renderer/modules/modules_export.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+class AudioNodeInput;
+class AudioNodeOutput;
+
+// Splits the rendering graph upstream of an AudioNodeInput (normally the
+// destination's) into subgraphs which don't share any AudioHandler. Each
+// subgraph is identified by the rendering outputs of the input which feed it;
+// pulling those outputs touches no handler of any other subgraph.
+//
+// Connections into AudioParams are not visible from the handlers which own the
+// params, so while any AudioParam of the context has rendering connections the
+// dependencies are unknown and everything is reported as a single subgraph.
+//
+// This is diagnostics only: the graph is still rendered in a single pull.
+// Building a partition allocates, so it must not be used on the real-time
+// audio thread. Must be used on the audio thread of an OfflineAudioContext, or
+// in tests, with the graph lock held.
+class MODULES_EXPORT AudioGraphPartition {
+  STACK_ALLOCATED();
+
+ public:
+  explicit AudioGraphPartition(AudioNodeInput&);
+
+  wtf_size_t NumberOfSubgraphs() const { return subgraphs_.size(); }
+  const Vector<AudioNodeOutput*>& SubgraphOutputs(wtf_size_t index) const {
+    return subgraphs_[index].outputs;
+  }
+  // The number of AudioHandlers in the subgraph.
+  wtf_size_t SubgraphSize(wtf_size_t index) const {
+    return subgraphs_[index].size;
+  }
+
+  // The number of handlers in the largest subgraph; this bounds how much of a
+  // render quantum could overlap with the rest.
+  wtf_size_t LargestSubgraphSize() const;
+
+  // False if the split was abandoned because of AudioParam connections.
+  bool IsComplete() const { return is_complete_; }
+
+ private:
+  struct Subgraph {
+    Vector<AudioNodeOutput*> outputs;
+    wtf_size_t size = 0;
+  };
+
+  Vector<Subgraph> subgraphs_;
+  bool is_complete_ = true;
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_MODULES_WEBAUDIO_AUDIO_GRAPH_PARTITION_H_
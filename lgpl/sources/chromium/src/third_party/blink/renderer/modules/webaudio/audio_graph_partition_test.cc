@@ -0,0 +1,130 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/modules/webaudio/audio_graph_partition.h"
+
+#include <memory>
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/frame/local_dom_window.h"
+#include "third_party/blink/renderer/core/testing/dummy_page_holder.h"
+#include "third_party/blink/renderer/modules/webaudio/audio_destination_node.h"
+#include "third_party/blink/renderer/modules/webaudio/audio_node_input.h"
+#include "third_party/blink/renderer/modules/webaudio/audio_node_output.h"
+#include "third_party/blink/renderer/modules/webaudio/audio_node_wiring.h"
+#include "third_party/blink/renderer/modules/webaudio/audio_param.h"
+#include "third_party/blink/renderer/modules/webaudio/deferred_task_handler.h"
+#include "third_party/blink/renderer/modules/webaudio/gain_node.h"
+#include "third_party/blink/renderer/modules/webaudio/offline_audio_context.h"
+
+namespace blink {
+
+class AudioGraphPartitionTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    page_ = std::make_unique<DummyPageHolder>();
+    context_ = OfflineAudioContext::Create(page_->GetFrame().DomWindow(), 2, 1,
+                                           48000, ASSERT_NO_EXCEPTION);
+  }
+
+  GainNode* CreateGain() { return context_->createGain(ASSERT_NO_EXCEPTION); }
+
+  void Connect(AudioNode* from, AudioNode* to) {
+    AudioNodeWiring::Connect(from->Handler().Output(0),
+                             to->Handler().Input(0));
+  }
+
+  // Applies pending connection changes to the rendering graph, as the audio
+  // thread does at the start of a render quantum.
+  void UpdateRenderingGraph() {
+    DeferredTaskHandler& handler = context_->GetDeferredTaskHandler();
+    handler.SetAudioThreadToCurrentThread();
+    handler.HandleDeferredTasks();
+  }
+
+  AudioNodeInput& DestinationInput() {
+    return context_->destination()->Handler().Input(0);
+  }
+
+  std::unique_ptr<DummyPageHolder> page_;
+  Persistent<OfflineAudioContext> context_;
+};
+
+TEST_F(AudioGraphPartitionTest, SeparateChainsAreIndependent) {
+  GainNode* track1 = CreateGain();
+  GainNode* track2 = CreateGain();
+  GainNode* source1 = CreateGain();
+  GainNode* source2 = CreateGain();
+
+  BaseAudioContext::GraphAutoLocker graph_lock(context_);
+  Connect(source1, track1);
+  Connect(source2, track2);
+  Connect(track1, context_->destination());
+  Connect(track2, context_->destination());
+  UpdateRenderingGraph();
+
+  AudioGraphPartition partition(DestinationInput());
+  EXPECT_TRUE(partition.IsComplete());
+  ASSERT_EQ(2u, partition.NumberOfSubgraphs());
+  EXPECT_EQ(1u, partition.SubgraphOutputs(0).size());
+  EXPECT_EQ(1u, partition.SubgraphOutputs(1).size());
+  EXPECT_EQ(2u, partition.SubgraphSize(0));
+  EXPECT_EQ(2u, partition.SubgraphSize(1));
+  EXPECT_EQ(2u, partition.LargestSubgraphSize());
+}
+
+TEST_F(AudioGraphPartitionTest, SharedSourceJoinsChains) {
+  GainNode* track1 = CreateGain();
+  GainNode* track2 = CreateGain();
+  GainNode* track3 = CreateGain();
+  GainNode* shared_source = CreateGain();
+
+  BaseAudioContext::GraphAutoLocker graph_lock(context_);
+  Connect(shared_source, track1);
+  Connect(shared_source, track2);
+  Connect(track1, context_->destination());
+  Connect(track2, context_->destination());
+  Connect(track3, context_->destination());
+  UpdateRenderingGraph();
+
+  AudioGraphPartition partition(DestinationInput());
+  EXPECT_TRUE(partition.IsComplete());
+  ASSERT_EQ(2u, partition.NumberOfSubgraphs());
+  // track1 and track2 can't be pulled separately because both pull
+  // |shared_source|.
+  wtf_size_t shared = partition.SubgraphOutputs(0).size() == 2 ? 0 : 1;
+  EXPECT_EQ(2u, partition.SubgraphOutputs(shared).size());
+  EXPECT_EQ(3u, partition.SubgraphSize(shared));
+  EXPECT_EQ(1u, partition.SubgraphSize(1 - shared));
+}
+
+TEST_F(AudioGraphPartitionTest, ParamConnectionsDisableSplitting) {
+  GainNode* track1 = CreateGain();
+  GainNode* track2 = CreateGain();
+  GainNode* modulator = CreateGain();
+
+  BaseAudioContext::GraphAutoLocker graph_lock(context_);
+  Connect(track1, context_->destination());
+  Connect(track2, context_->destination());
+  AudioNodeWiring::Connect(modulator->Handler().Output(0),
+                           track1->gain()->Handler());
+  UpdateRenderingGraph();
+  EXPECT_EQ(1u, context_->GetDeferredTaskHandler()
+                    .NumberOfConnectedRenderingParams());
+
+  AudioGraphPartition partition(DestinationInput());
+  EXPECT_FALSE(partition.IsComplete());
+  ASSERT_EQ(1u, partition.NumberOfSubgraphs());
+  EXPECT_EQ(2u, partition.SubgraphOutputs(0).size());
+
+  AudioNodeWiring::Disconnect(modulator->Handler().Output(0),
+                              track1->gain()->Handler());
+  EXPECT_EQ(0u, context_->GetDeferredTaskHandler()
+                    .NumberOfConnectedRenderingParams());
+  UpdateRenderingGraph();
+  EXPECT_EQ(0u, context_->GetDeferredTaskHandler()
+                    .NumberOfConnectedRenderingParams());
+  EXPECT_EQ(2u, AudioGraphPartition(DestinationInput()).NumberOfSubgraphs());
+}
+
+}  // namespace blink
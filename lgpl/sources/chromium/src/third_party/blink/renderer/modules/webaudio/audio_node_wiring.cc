@@ -131,6 +131,12 @@ void AudioNodeWiring::Disconnect(AudioNodeOutput& output,
 
   // The param may need to have its rendering state updated.
   param.ChangedOutputs();
+
+  // Stop counting the param as connected once its last connection is broken.
+  // Waiting for the audio thread to update its rendering state isn't enough,
+  // as the param may be destroyed before that happens.
+  if (param.outputs_.IsEmpty())
+    param.SetHasRenderingConnections(false);
 }
 
 void AudioNodeWiring::Disable(AudioNodeOutput& output, AudioNodeInput& input) {
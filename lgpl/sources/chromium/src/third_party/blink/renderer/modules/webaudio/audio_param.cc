@@ -29,6 +29,7 @@
 #include "third_party/blink/renderer/modules/webaudio/audio_graph_tracer.h"
 #include "third_party/blink/renderer/modules/webaudio/audio_node.h"
 #include "third_party/blink/renderer/modules/webaudio/audio_node_output.h"
+#include "third_party/blink/renderer/modules/webaudio/deferred_task_handler.h"
 #include "third_party/blink/renderer/platform/audio/audio_utilities.h"
 #include "third_party/blink/renderer/platform/audio/vector_math.h"
 #include "third_party/blink/renderer/platform/bindings/exception_state.h"
@@ -69,6 +70,18 @@ AudioParamHandler::AudioParamHandler(BaseAudioContext& context,
   timeline_.SetSmoothedValue(default_value);
 }
 
+void AudioParamHandler::DidUpdate() {
+  SetHasRenderingConnections(IsConnected());
+}
+
+void AudioParamHandler::SetHasRenderingConnections(bool connected) {
+  if (connected == has_rendering_connections_)
+    return;
+  GetDeferredTaskHandler().DidUpdateParamRenderingConnections(
+      has_rendering_connections_, connected);
+  has_rendering_connections_ = connected;
+}
+
 AudioDestinationHandler& AudioParamHandler::DestinationHandler() const {
   CHECK(destination_handler_);
   return *destination_handler_;
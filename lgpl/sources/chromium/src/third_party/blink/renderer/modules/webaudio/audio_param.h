@@ -140,7 +140,7 @@ class AudioParamHandler final : public ThreadSafeRefCounted<AudioParamHandler>,
   AudioDestinationHandler& DestinationHandler() const;
 
   // AudioSummingJunction
-  void DidUpdate() override {}
+  void DidUpdate() override;
 
   AudioParamTimeline& Timeline() { return timeline_; }
 
@@ -251,6 +251,15 @@ class AudioParamHandler final : public ThreadSafeRefCounted<AudioParamHandler>,
   // Audio bus to sum in any connections to the AudioParam.
   scoped_refptr<AudioBus> summing_bus_;
 
+  // Updates |has_rendering_connections_| and the count kept by
+  // DeferredTaskHandler::DidUpdateParamRenderingConnections(). Must be called
+  // with the graph lock held.
+  void SetHasRenderingConnections(bool);
+
+  // Whether this was counted by
+  // DeferredTaskHandler::DidUpdateParamRenderingConnections().
+  bool has_rendering_connections_ = false;
+
   friend class AudioNodeWiring;
 };
 
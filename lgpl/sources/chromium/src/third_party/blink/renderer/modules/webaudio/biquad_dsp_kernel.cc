@@ -163,11 +163,7 @@ void BiquadDSPKernel::UpdateTailTime(int coef_index) {
   tail_time_ = clampTo(tail, 0.0, kMaxTailTime);
 }
 
-void BiquadDSPKernel::Process(const float* source,
-                              float* destination,
-                              uint32_t frames_to_process) {
-  DCHECK(source);
-  DCHECK(destination);
+Biquad& BiquadDSPKernel::PrepareBiquad(uint32_t frames_to_process) {
   DCHECK(GetBiquadProcessor());
 
   // Recompute filter coefficients if any of the parameters have changed.
@@ -184,7 +180,17 @@ void BiquadDSPKernel::Process(const float* source,
       UpdateCoefficientsIfNecessary(frames_to_process);
   }
 
-  biquad_.Process(source, destination, frames_to_process);
+  return biquad_;
+}
+
+void BiquadDSPKernel::Process(const float* source,
+                              float* destination,
+                              uint32_t frames_to_process) {
+  DCHECK(source);
+  DCHECK(destination);
+
+  PrepareBiquad(frames_to_process).Process(source, destination,
+                                           frames_to_process);
 }
 
 void BiquadDSPKernel::GetFrequencyResponse(BiquadDSPKernel& kernel,
@@ -49,6 +49,12 @@ class BiquadDSPKernel final : public AudioDSPKernel {
                uint32_t frames_to_process) override;
   void Reset() override { biquad_.Reset(); }
 
+  // Recomputes the filter coefficients if any of the parameters have changed
+  // and returns the biquad to filter the next |frames_to_process| frames with.
+  // Process() is this followed by Biquad::Process(); BiquadProcessor uses it to
+  // filter all of its channels with Biquad::ProcessMultiple().
+  Biquad& PrepareBiquad(uint32_t frames_to_process);
+
   // Get the magnitude and phase response of the given BiquadDSPKernel at the
   // given set of frequencies (in Hz). The phase response is in radians.  This
   // must be called from the main thread.
@@ -27,9 +27,17 @@
 #include "third_party/blink/renderer/modules/webaudio/biquad_dsp_kernel.h"
 #include "third_party/blink/renderer/modules/webaudio/biquad_processor.h"
 #include "third_party/blink/renderer/platform/audio/audio_utilities.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
 
 namespace blink {
 
+namespace {
+
+// Enough for 7.1 audio without allocating on the audio thread.
+constexpr wtf_size_t kInlineChannels = 8;
+
+}  // namespace
+
 BiquadProcessor::BiquadProcessor(float sample_rate,
                                  uint32_t number_of_channels,
                                  AudioParamHandler& frequency,
@@ -127,11 +135,19 @@ void BiquadProcessor::Process(const AudioBus* source,
   CheckForDirtyCoefficients();
 
   // For each channel of our input, process using the corresponding
-  // BiquadDSPKernel into the output channel.
-  for (unsigned i = 0; i < kernels_.size(); ++i)
-    kernels_[i]->Process(source->Channel(i)->Data(),
-                         destination->Channel(i)->MutableData(),
-                         frames_to_process);
+  // BiquadDSPKernel into the output channel. The channels are filtered
+  // together so that they can share SIMD lanes.
+  Vector<Biquad*, kInlineChannels> biquads;
+  Vector<const float*, kInlineChannels> sources;
+  Vector<float*, kInlineChannels> destinations;
+  for (unsigned i = 0; i < kernels_.size(); ++i) {
+    biquads.push_back(&static_cast<BiquadDSPKernel*>(kernels_[i].get())
+                           ->PrepareBiquad(frames_to_process));
+    sources.push_back(source->Channel(i)->Data());
+    destinations.push_back(destination->Channel(i)->MutableData());
+  }
+  Biquad::ProcessMultiple(biquads.data(), sources.data(), destinations.data(),
+                          kernels_.size(), frames_to_process);
 }
 
 void BiquadProcessor::ProcessOnlyAudioParams(uint32_t frames_to_process) {
@@ -35,6 +35,7 @@
 #include "third_party/blink/renderer/platform/audio/reverb.h"
 #include "third_party/blink/renderer/platform/bindings/exception_messages.h"
 #include "third_party/blink/renderer/platform/bindings/exception_state.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 
 // Note about empirical tuning:
 // The maximum FFT size affects reverb performance and accuracy.
@@ -77,6 +78,9 @@ ConvolverHandler::~ConvolverHandler() {
 }
 
 void ConvolverHandler::Process(uint32_t frames_to_process) {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("webaudio.audionode"),
+               "ConvolverHandler::Process");
+
   AudioBus* output_bus = Output(0).Bus();
   DCHECK(output_bus);
 
@@ -25,10 +25,12 @@
 
 #include "third_party/blink/renderer/modules/webaudio/deferred_task_handler.h"
 
+#include "base/metrics/histogram_functions.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/modules/webaudio/audio_node.h"
 #include "third_party/blink/renderer/modules/webaudio/audio_node_output.h"
 #include "third_party/blink/renderer/modules/webaudio/offline_audio_context.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/scheduler/public/post_cancellable_task.h"
 #include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread.h"
@@ -69,6 +71,53 @@ void DeferredTaskHandler::OfflineLock() {
   context_graph_mutex_.lock();
 }
 
+void DeferredTaskHandler::RecordGraphUpdateAttempt(bool acquired_lock) {
+  DCHECK(IsAudioThread());
+  graph_update_attempts_.fetch_add(1, std::memory_order_relaxed);
+  if (!acquired_lock) {
+    missed_graph_update_streak_++;
+    missed_graph_updates_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (!missed_graph_update_streak_)
+    return;
+
+  // Graph changes made on the main thread were delayed by this many render
+  // quantum boundaries.
+  TRACE_EVENT_INSTANT1("webaudio", "DeferredTaskHandler::GraphUpdateDelayed",
+                       TRACE_EVENT_SCOPE_THREAD, "missed_updates",
+                       missed_graph_update_streak_);
+  if (missed_graph_update_streak_ >
+      longest_missed_graph_update_streak_.load(std::memory_order_relaxed)) {
+    longest_missed_graph_update_streak_.store(missed_graph_update_streak_,
+                                              std::memory_order_relaxed);
+  }
+  missed_graph_update_streak_ = 0;
+}
+
+DeferredTaskHandler::GraphUpdateStats DeferredTaskHandler::GetGraphUpdateStats()
+    const {
+  GraphUpdateStats stats;
+  stats.attempts = graph_update_attempts_.load(std::memory_order_relaxed);
+  stats.missed = missed_graph_updates_.load(std::memory_order_relaxed);
+  stats.longest_missed_streak =
+      longest_missed_graph_update_streak_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void DeferredTaskHandler::RecordGraphUpdateHistograms() const {
+  DCHECK(IsMainThread());
+  GraphUpdateStats stats = GetGraphUpdateStats();
+  if (!stats.attempts)
+    return;
+  base::UmaHistogramPercentage(
+      "WebAudio.AudioContext.MissedGraphUpdatePercent",
+      static_cast<int>(stats.missed * 100 / stats.attempts));
+  base::UmaHistogramCounts1000(
+      "WebAudio.AudioContext.LongestMissedGraphUpdateStreak",
+      stats.longest_missed_streak);
+}
+
 void DeferredTaskHandler::BreakConnections() {
   DCHECK(IsAudioThread());
   AssertGraphOwner();
@@ -112,6 +161,9 @@ void DeferredTaskHandler::RemoveMarkedAudioNodeOutput(AudioNodeOutput* output) {
 
 void DeferredTaskHandler::HandleDirtyAudioSummingJunctions() {
   AssertGraphOwner();
+  if (dirty_summing_junctions_.IsEmpty())
+    return;
+  ++rendering_graph_version_;
   for (AudioSummingJunction* junction : dirty_summing_junctions_)
     junction->UpdateRenderingState();
   dirty_summing_junctions_.clear();
@@ -120,6 +172,10 @@ void DeferredTaskHandler::HandleDirtyAudioSummingJunctions() {
 void DeferredTaskHandler::HandleDirtyAudioNodeOutputs() {
   AssertGraphOwner();
 
+  if (dirty_audio_node_outputs_.IsEmpty())
+    return;
+  ++rendering_graph_version_;
+
   HashSet<AudioNodeOutput*> dirty_outputs;
   dirty_audio_node_outputs_.swap(dirty_outputs);
 
@@ -130,6 +186,20 @@ void DeferredTaskHandler::HandleDirtyAudioNodeOutputs() {
     output->UpdateRenderingState();
 }
 
+void DeferredTaskHandler::DidUpdateParamRenderingConnections(
+    bool was_connected,
+    bool is_connected) {
+  AssertGraphOwner();
+  if (was_connected == is_connected)
+    return;
+  if (is_connected) {
+    ++connected_rendering_params_;
+  } else {
+    DCHECK_GT(connected_rendering_params_, 0u);
+    --connected_rendering_params_;
+  }
+}
+
 void DeferredTaskHandler::AddAutomaticPullNode(
     scoped_refptr<AudioHandler> node) {
   AssertGraphOwner();
@@ -302,6 +372,8 @@ scoped_refptr<DeferredTaskHandler> DeferredTaskHandler::Create(
 DeferredTaskHandler::~DeferredTaskHandler() = default;
 
 void DeferredTaskHandler::HandleDeferredTasks() {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("webaudio.audionode"),
+               "DeferredTaskHandler::HandleDeferredTasks");
   UpdateChangedChannelCountMode();
   UpdateChangedChannelInterpretation();
   HandleDirtyAudioSummingJunctions();
@@ -106,6 +106,21 @@ class MODULES_EXPORT DeferredTaskHandler final
   void MarkAudioNodeOutputDirty(AudioNodeOutput*);
   void RemoveMarkedAudioNodeOutput(AudioNodeOutput*);
 
+  // Bumped whenever pending connection changes are applied to the rendering
+  // graph, so that state derived from it can be recomputed lazily. Only
+  // accessed on the audio thread.
+  uint32_t RenderingGraphVersion() const { return rendering_graph_version_; }
+
+  // Tracks how many AudioParams currently have rendering connections. A param
+  // is counted once the audio thread picks up its first connection, and stops
+  // being counted as soon as its last connection is broken. Only accessed when
+  // the graph lock is held.
+  void DidUpdateParamRenderingConnections(bool was_connected,
+                                          bool is_connected);
+  unsigned NumberOfConnectedRenderingParams() const {
+    return connected_rendering_params_;
+  }
+
   // Break connections between nodes.  This is done on the audio thread with the
   // graph lock.
   void BreakConnections();
@@ -161,6 +176,25 @@ class MODULES_EXPORT DeferredTaskHandler final
   // In DCHECK builds, fails if this thread does not own the context's lock.
   void AssertGraphOwner() const { context_graph_mutex_.AssertAcquired(); }
 
+  // Called by the real-time audio thread once per render quantum with
+  // whether TryLock() succeeded, i.e. whether pending graph changes could be
+  // applied or had to be skipped because the main thread held the lock.
+  // This is instrumentation only; it doesn't change how the graph lock is
+  // taken or how long graph changes wait for it.
+  void RecordGraphUpdateAttempt(bool acquired_lock);
+
+  struct GraphUpdateStats {
+    uint64_t attempts = 0;
+    uint64_t missed = 0;
+    // The largest number of consecutive attempts which were missed.
+    uint32_t longest_missed_streak = 0;
+  };
+  // Can be called from any thread.
+  GraphUpdateStats GetGraphUpdateStats() const;
+  // Records GetGraphUpdateStats() to UMA. Called on the main thread once the
+  // real-time context has stopped rendering.
+  void RecordGraphUpdateHistograms() const;
+
   class MODULES_EXPORT GraphAutoLocker {
     STACK_ALLOCATED();
 
@@ -236,6 +270,9 @@ class MODULES_EXPORT DeferredTaskHandler final
   HashSet<AudioSummingJunction*> dirty_summing_junctions_;
   HashSet<AudioNodeOutput*> dirty_audio_node_outputs_;
 
+  uint32_t rendering_graph_version_ = 0;
+  unsigned connected_rendering_params_ = 0;
+
   Vector<scoped_refptr<AudioHandler>> rendering_orphan_handlers_;
   Vector<scoped_refptr<AudioHandler>> deletable_orphan_handlers_;
 
@@ -277,6 +314,13 @@ class MODULES_EXPORT DeferredTaskHandler final
   mutable Mutex automatic_pull_handlers_lock_;
 
   std::atomic<base::PlatformThreadId> audio_thread_;
+
+  // Updated by the audio thread in RecordGraphUpdateAttempt().
+  std::atomic<uint64_t> graph_update_attempts_{0};
+  std::atomic<uint64_t> missed_graph_updates_{0};
+  std::atomic<uint32_t> longest_missed_graph_update_streak_{0};
+  // Only accessed on the audio thread.
+  uint32_t missed_graph_update_streak_ = 0;
 };
 
 }  // namespace blink
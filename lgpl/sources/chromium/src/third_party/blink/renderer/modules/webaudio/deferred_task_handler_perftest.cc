@@ -0,0 +1,112 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/blink/public/platform/scheduler/test/renderer_scheduler_test_support.h"
+#include "third_party/blink/renderer/modules/webaudio/deferred_task_handler.h"
+#include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
+#include "third_party/blink/renderer/platform/scheduler/public/thread.h"
+#include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
+
+namespace blink {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "DeferredTaskHandler.";
+constexpr char kMetricMissedGraphUpdates[] = "missed_graph_updates";
+constexpr char kMetricLongestMissedStreak[] = "longest_missed_streak";
+
+// Number of render quanta the audio thread renders in each story, and the
+// time it spends rendering each of them outside of the graph lock.
+constexpr int kRenderQuanta = 4000;
+constexpr base::TimeDelta kRenderTime = base::TimeDelta::FromMicroseconds(100);
+
+// Does what AudioContext::HandlePreRenderTasks() does with the graph lock at
+// the start of each render quantum.
+void RenderOnAudioThread(DeferredTaskHandler* handler,
+                         std::atomic<bool>* done,
+                         base::WaitableEvent* finished) {
+  handler->SetAudioThreadToCurrentThread();
+  for (int i = 0; i < kRenderQuanta; ++i) {
+    bool locked = handler->TryLock();
+    handler->RecordGraphUpdateAttempt(locked);
+    if (locked) {
+      handler->HandleDeferredTasks();
+      handler->unlock();
+    }
+    base::PlatformThread::Sleep(kRenderTime);
+  }
+  done->store(true, std::memory_order_release);
+  finished->Signal();
+}
+
+}  // namespace
+
+class DeferredTaskHandlerPerfTest : public testing::Test {
+ protected:
+  // Renders on a separate audio thread while this thread, standing in for the
+  // main thread, repeatedly holds the graph lock for |hold_time| and then
+  // releases it for |release_time|, like script that keeps rewiring the graph.
+  // A zero |hold_time| leaves the lock uncontended.
+  void RunStory(const std::string& story,
+                base::TimeDelta hold_time,
+                base::TimeDelta release_time) {
+    scoped_refptr<DeferredTaskHandler> handler = DeferredTaskHandler::Create(
+        scheduler::GetSingleThreadTaskRunnerForTesting());
+    std::unique_ptr<Thread> audio_thread =
+        Thread::CreateThread(ThreadCreationParams(ThreadType::kTestThread)
+                                 .SetThreadNameForTest("AudioThread"));
+    std::atomic<bool> done{false};
+    base::WaitableEvent finished;
+    PostCrossThreadTask(*audio_thread->GetTaskRunner(), FROM_HERE,
+                        CrossThreadBindOnce(&RenderOnAudioThread,
+                                            CrossThreadUnretained(handler.get()),
+                                            CrossThreadUnretained(&done),
+                                            CrossThreadUnretained(&finished)));
+    while (!done.load(std::memory_order_acquire)) {
+      if (!hold_time.is_zero()) {
+        DeferredTaskHandler::GraphAutoLocker locker(*handler);
+        base::PlatformThread::Sleep(hold_time);
+      }
+      base::PlatformThread::Sleep(release_time);
+    }
+    finished.Wait();
+
+    DeferredTaskHandler::GraphUpdateStats stats =
+        handler->GetGraphUpdateStats();
+    ASSERT_EQ(static_cast<uint64_t>(kRenderQuanta), stats.attempts);
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricMissedGraphUpdates, "%");
+    reporter.RegisterImportantMetric(kMetricLongestMissedStreak, "count");
+    reporter.AddResult(kMetricMissedGraphUpdates,
+                       100.0 * stats.missed / stats.attempts);
+    reporter.AddResult(kMetricLongestMissedStreak,
+                       static_cast<size_t>(stats.longest_missed_streak));
+  }
+};
+
+TEST_F(DeferredTaskHandlerPerfTest, Uncontended) {
+  RunStory("uncontended", base::TimeDelta(),
+           base::TimeDelta::FromMilliseconds(1));
+}
+
+TEST_F(DeferredTaskHandlerPerfTest, ShortHolds) {
+  RunStory("short_holds", base::TimeDelta::FromMicroseconds(50),
+           base::TimeDelta::FromMicroseconds(200));
+}
+
+TEST_F(DeferredTaskHandlerPerfTest, LongHolds) {
+  RunStory("long_holds", base::TimeDelta::FromMilliseconds(2),
+           base::TimeDelta::FromMilliseconds(2));
+}
+
+}  // namespace blink
@@ -0,0 +1,69 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/modules/webaudio/deferred_task_handler.h"
+
+#include <memory>
+
+#include "base/synchronization/waitable_event.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/public/platform/scheduler/test/renderer_scheduler_test_support.h"
+#include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
+#include "third_party/blink/renderer/platform/scheduler/public/thread.h"
+#include "third_party/blink/renderer/platform/testing/histogram_tester.h"
+#include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
+
+namespace blink {
+
+namespace {
+
+// Hit, three misses, hit, miss, hit.
+void RecordAttemptsOnAudioThread(DeferredTaskHandler* handler,
+                                 base::WaitableEvent* done) {
+  handler->SetAudioThreadToCurrentThread();
+  for (bool acquired_lock : {true, false, false, false, true, false, true})
+    handler->RecordGraphUpdateAttempt(acquired_lock);
+  done->Signal();
+}
+
+}  // namespace
+
+TEST(DeferredTaskHandlerTest, GraphUpdateStats) {
+  scoped_refptr<DeferredTaskHandler> handler = DeferredTaskHandler::Create(
+      scheduler::GetSingleThreadTaskRunnerForTesting());
+  EXPECT_EQ(0u, handler->GetGraphUpdateStats().attempts);
+
+  std::unique_ptr<Thread> audio_thread =
+      Thread::CreateThread(ThreadCreationParams(ThreadType::kTestThread)
+                               .SetThreadNameForTest("AudioThread"));
+  base::WaitableEvent done;
+  PostCrossThreadTask(*audio_thread->GetTaskRunner(), FROM_HERE,
+                      CrossThreadBindOnce(&RecordAttemptsOnAudioThread,
+                                          CrossThreadUnretained(handler.get()),
+                                          CrossThreadUnretained(&done)));
+  done.Wait();
+
+  DeferredTaskHandler::GraphUpdateStats stats = handler->GetGraphUpdateStats();
+  EXPECT_EQ(7u, stats.attempts);
+  EXPECT_EQ(4u, stats.missed);
+  EXPECT_EQ(3u, stats.longest_missed_streak);
+
+  HistogramTester histogram_tester;
+  handler->RecordGraphUpdateHistograms();
+  histogram_tester.ExpectUniqueSample(
+      "WebAudio.AudioContext.MissedGraphUpdatePercent", 57, 1);
+  histogram_tester.ExpectUniqueSample(
+      "WebAudio.AudioContext.LongestMissedGraphUpdateStreak", 3, 1);
+}
+
+TEST(DeferredTaskHandlerTest, NoGraphUpdateHistogramsWithoutAttempts) {
+  scoped_refptr<DeferredTaskHandler> handler = DeferredTaskHandler::Create(
+      scheduler::GetSingleThreadTaskRunnerForTesting());
+  HistogramTester histogram_tester;
+  handler->RecordGraphUpdateHistograms();
+  histogram_tester.ExpectTotalCount(
+      "WebAudio.AudioContext.MissedGraphUpdatePercent", 0);
+}
+
+}  // namespace blink
@@ -27,16 +27,19 @@
 
 #include <algorithm>
 #include "third_party/blink/public/platform/platform.h"
+#include "third_party/blink/renderer/modules/webaudio/audio_graph_partition.h"
 #include "third_party/blink/renderer/modules/webaudio/audio_node_input.h"
 #include "third_party/blink/renderer/modules/webaudio/audio_node_output.h"
 #include "third_party/blink/renderer/modules/webaudio/audio_worklet.h"
 #include "third_party/blink/renderer/modules/webaudio/audio_worklet_messaging_proxy.h"
 #include "third_party/blink/renderer/modules/webaudio/base_audio_context.h"
+#include "third_party/blink/renderer/modules/webaudio/deferred_task_handler.h"
 #include "third_party/blink/renderer/modules/webaudio/offline_audio_context.h"
 #include "third_party/blink/renderer/platform/audio/audio_bus.h"
 #include "third_party/blink/renderer/platform/audio/audio_utilities.h"
 #include "third_party/blink/renderer/platform/audio/denormal_disabler.h"
 #include "third_party/blink/renderer/platform/audio/hrtf_database_loader.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
 
 namespace blink {
@@ -288,6 +291,8 @@ bool OfflineAudioDestinationHandler::RenderIfNotSuspended(
     return true;
   }
 
+  TraceGraphPartitionIfNeeded();
+
   DCHECK_GE(NumberOfInputs(), 1u);
 
   // This will cause the node(s) connected to us to process, which in turn will
@@ -319,6 +324,29 @@ bool OfflineAudioDestinationHandler::RenderIfNotSuspended(
   return false;
 }
 
+void OfflineAudioDestinationHandler::TraceGraphPartitionIfNeeded() {
+  bool tracing_enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(
+      TRACE_DISABLED_BY_DEFAULT("webaudio.audionode"), &tracing_enabled);
+  if (!tracing_enabled)
+    return;
+
+  DeferredTaskHandler& deferred_task_handler =
+      Context()->GetDeferredTaskHandler();
+  if (deferred_task_handler.RenderingGraphVersion() == traced_graph_version_)
+    return;
+  if (!deferred_task_handler.TryLock())
+    return;
+
+  AudioGraphPartition partition(Input(0));
+  TRACE_COUNTER2(TRACE_DISABLED_BY_DEFAULT("webaudio.audionode"),
+                 "AudioGraphPartition", "independent_subgraphs",
+                 partition.NumberOfSubgraphs(),
+                 "largest_subgraph", partition.LargestSubgraphSize());
+  traced_graph_version_ = deferred_task_handler.RenderingGraphVersion();
+  deferred_task_handler.unlock();
+}
+
 void OfflineAudioDestinationHandler::PrepareTaskRunnerForRendering() {
   DCHECK(IsMainThread());
 
@@ -117,6 +117,15 @@ class OfflineAudioDestinationHandler final : public AudioDestinationHandler {
                             AudioBus* destination_bus,
                             uint32_t number_of_frames);
 
+  // When webaudio node tracing is enabled, reports how the graph feeding this
+  // destination splits into independent subgraphs, each time the rendering
+  // graph changes. See AudioGraphPartition. This is diagnostics only; the
+  // graph is still rendered in one pull on the render thread. It allocates,
+  // which is why only offline rendering calls it and the real-time audio
+  // thread never does. Must be called on the render thread without the graph
+  // lock held; it's skipped if the lock isn't available.
+  void TraceGraphPartitionIfNeeded();
+
   // Prepares a task runner for the rendering based on the operation mode
   // (i.e. non-AudioWorklet or AudioWorklet). This is called when the
   // rendering restarts such as context.resume() after context.suspend().
@@ -154,6 +163,10 @@ class OfflineAudioDestinationHandler final : public AudioDestinationHandler {
   unsigned number_of_channels_;
   float sample_rate_;
 
+  // DeferredTaskHandler::RenderingGraphVersion() when the partition was last
+  // traced. Only accessed on the render thread.
+  uint32_t traced_graph_version_ = 0;
+
   // The rendering thread for the non-AudioWorklet mode. For the AudioWorklet
   // node, AudioWorkletThread will drive the rendering.
   std::unique_ptr<Thread> render_thread_;
@@ -29,6 +29,8 @@
 #ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_AUDIO_AUDIO_FILE_READER_H_
 #define THIRD_PARTY_BLINK_RENDERER_PLATFORM_AUDIO_AUDIO_FILE_READER_H_
 
+#include <stddef.h>
+
 #include "base/memory/scoped_refptr.h"
 #include "third_party/blink/renderer/platform/platform_export.h"
 
@@ -36,6 +38,10 @@ namespace blink {
 
 class AudioBus;
 
+// Decodes the file without any sample-rate conversion or mixing.
+PLATFORM_EXPORT scoped_refptr<AudioBus> DecodeAudioFileData(const char* data,
+                                                            size_t data_size);
+
 // For both create functions:
 // Pass in 0.0 for sampleRate to use the file's sample-rate, otherwise a
 // sample-rate conversion to the requested sampleRate will be made (if it
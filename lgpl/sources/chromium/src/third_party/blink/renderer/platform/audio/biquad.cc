@@ -39,6 +39,10 @@
 #if defined(OS_MACOSX)
 #include <Accelerate/Accelerate.h>
 #endif
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_MACOSX)
+#include "base/cpu.h"
+#include "third_party/blink/renderer/platform/audio/cpu/x86/biquad_x86.h"
+#endif
 
 namespace blink {
 
@@ -189,6 +193,81 @@ void Biquad::Process(const float* source_p,
   }
 }
 
+void Biquad::ProcessMultiple(Biquad* const* biquads,
+                             const float* const* sources,
+                             float* const* destinations,
+                             unsigned number_of_channels,
+                             uint32_t frames_to_process) {
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_MACOSX)
+  static const bool use_avx = base::CPU().has_avx();
+  const size_t lanes_per_pass =
+      use_avx ? biquad_x86::avx::kLanes : biquad_x86::sse::kLanes;
+
+  biquad_x86::Lanes lanes;
+  Biquad* lane_biquads[biquad_x86::Lanes::kMaxLanes];
+  size_t lane_count = 0;
+
+  // Runs the first |count| gathered lanes and stores their filter memory back.
+  auto process_lanes = [&](size_t count) {
+    if (count == biquad_x86::avx::kLanes) {
+      DCHECK(use_avx);
+      biquad_x86::avx::ProcessLanes(lanes, frames_to_process);
+    } else {
+      DCHECK_EQ(count, biquad_x86::sse::kLanes);
+      biquad_x86::sse::ProcessLanes(lanes, frames_to_process);
+    }
+    for (size_t lane = 0; lane < count; ++lane) {
+      Biquad* biquad = lane_biquads[lane];
+      biquad->x1_ = DenormalDisabler::FlushDenormalFloatToZero(lanes.x1[lane]);
+      biquad->x2_ = DenormalDisabler::FlushDenormalFloatToZero(lanes.x2[lane]);
+      biquad->y1_ = DenormalDisabler::FlushDenormalFloatToZero(lanes.y1[lane]);
+      biquad->y2_ = DenormalDisabler::FlushDenormalFloatToZero(lanes.y2[lane]);
+    }
+  };
+
+  for (unsigned i = 0; i < number_of_channels; ++i) {
+    Biquad* biquad = biquads[i];
+    if (biquad->HasSampleAccurateValues()) {
+      biquad->Process(sources[i], destinations[i], frames_to_process);
+      continue;
+    }
+
+    lanes.b0[lane_count] = biquad->b0_[0];
+    lanes.b1[lane_count] = biquad->b1_[0];
+    lanes.b2[lane_count] = biquad->b2_[0];
+    lanes.a1[lane_count] = biquad->a1_[0];
+    lanes.a2[lane_count] = biquad->a2_[0];
+    lanes.x1[lane_count] = biquad->x1_;
+    lanes.x2[lane_count] = biquad->x2_;
+    lanes.y1[lane_count] = biquad->y1_;
+    lanes.y2[lane_count] = biquad->y2_;
+    lanes.source[lane_count] = sources[i];
+    lanes.destination[lane_count] = destinations[i];
+    lane_biquads[lane_count] = biquad;
+
+    if (++lane_count == lanes_per_pass) {
+      process_lanes(lane_count);
+      lane_count = 0;
+    }
+  }
+
+  // Whatever is left over is narrower than a full pass: use SSE for a pair if
+  // possible and finish with the scalar filter.
+  size_t first_scalar_lane = 0;
+  if (lane_count >= biquad_x86::sse::kLanes) {
+    process_lanes(biquad_x86::sse::kLanes);
+    first_scalar_lane = biquad_x86::sse::kLanes;
+  }
+  for (size_t lane = first_scalar_lane; lane < lane_count; ++lane) {
+    lane_biquads[lane]->Process(lanes.source[lane], lanes.destination[lane],
+                                frames_to_process);
+  }
+#else
+  for (unsigned i = 0; i < number_of_channels; ++i)
+    biquads[i]->Process(sources[i], destinations[i], frames_to_process);
+#endif
+}
+
 #if defined(OS_MACOSX)
 
 // Here we have optimized version using Accelerate.framework
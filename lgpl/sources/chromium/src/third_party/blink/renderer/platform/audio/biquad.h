@@ -56,6 +56,16 @@ class PLATFORM_EXPORT Biquad final {
                float* dest_p,
                uint32_t frames_to_process);
 
+  // Filters |number_of_channels| channels, channel i with |biquads[i]|, with
+  // the same results as calling Process() on each. Where SIMD is available,
+  // biquads without sample-accurate coefficients are run several channels at
+  // a time, one channel per lane.
+  static void ProcessMultiple(Biquad* const* biquads,
+                              const float* const* sources,
+                              float* const* destinations,
+                              unsigned number_of_channels,
+                              uint32_t frames_to_process);
+
   bool HasSampleAccurateValues() const { return has_sample_accurate_values_; }
   void SetHasSampleAccurateValues(bool is_sample_accurate) {
     has_sample_accurate_values_ = is_sample_accurate;
@@ -0,0 +1,77 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/audio/biquad.h"
+
+#include <string>
+
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/blink/renderer/platform/audio/audio_array.h"
+#include "third_party/blink/renderer/platform/audio/audio_utilities.h"
+
+namespace blink {
+
+namespace {
+
+constexpr unsigned kChannels = 8;
+constexpr uint32_t kFrames = audio_utilities::kRenderQuantumFrames;
+// About ten seconds of 48 kHz audio.
+constexpr int kQuanta = 4000;
+
+constexpr char kMetricPrefix[] = "Biquad.";
+constexpr char kMetricTimePerQuantum[] = "time_per_quantum";
+
+void ReportTimePerQuantum(const std::string& story, base::TimeDelta elapsed) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricTimePerQuantum, "us");
+  reporter.AddResult(kMetricTimePerQuantum,
+                     elapsed.InMicrosecondsF() / kQuanta);
+}
+
+class BiquadPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (unsigned channel = 0; channel < kChannels; ++channel) {
+      buffers_[channel].Allocate(kFrames);
+      for (uint32_t k = 0; k < kFrames; ++k)
+        buffers_[channel][k] = (k % 32) / 16.0f - 1;
+      biquads_[channel].SetLowpassParams(0, 0.1, 3);
+    }
+  }
+
+  AudioFloatArray buffers_[kChannels];
+  Biquad biquads_[kChannels];
+};
+
+}  // namespace
+
+TEST_F(BiquadPerfTest, ProcessEachChannel) {
+  base::ThreadTicks start = base::ThreadTicks::Now();
+  for (int quantum = 0; quantum < kQuanta; ++quantum) {
+    for (unsigned channel = 0; channel < kChannels; ++channel) {
+      biquads_[channel].Process(buffers_[channel].Data(),
+                                buffers_[channel].Data(), kFrames);
+    }
+  }
+  ReportTimePerQuantum("process_each_channel",
+                       base::ThreadTicks::Now() - start);
+}
+
+TEST_F(BiquadPerfTest, ProcessMultiple) {
+  Biquad* biquads[kChannels];
+  float* buffers[kChannels];
+  for (unsigned channel = 0; channel < kChannels; ++channel) {
+    biquads[channel] = &biquads_[channel];
+    buffers[channel] = buffers_[channel].Data();
+  }
+
+  base::ThreadTicks start = base::ThreadTicks::Now();
+  for (int quantum = 0; quantum < kQuanta; ++quantum)
+    Biquad::ProcessMultiple(biquads, buffers, buffers, kChannels, kFrames);
+  ReportTimePerQuantum("process_multiple", base::ThreadTicks::Now() - start);
+}
+
+}  // namespace blink
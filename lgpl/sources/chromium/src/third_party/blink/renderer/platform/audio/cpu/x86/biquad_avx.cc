@@ -0,0 +1,71 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_MACOSX)
+
+#include "third_party/blink/renderer/platform/audio/cpu/x86/biquad_x86.h"
+
+#include <immintrin.h>
+
+namespace blink {
+namespace biquad_x86 {
+namespace avx {
+
+void ProcessLanes(Lanes& lanes, uint32_t frames_to_process) {
+  const __m256d b0 = _mm256_loadu_pd(lanes.b0);
+  const __m256d b1 = _mm256_loadu_pd(lanes.b1);
+  const __m256d b2 = _mm256_loadu_pd(lanes.b2);
+  const __m256d a1 = _mm256_loadu_pd(lanes.a1);
+  const __m256d a2 = _mm256_loadu_pd(lanes.a2);
+
+  __m256d x1 = _mm256_loadu_pd(lanes.x1);
+  __m256d x2 = _mm256_loadu_pd(lanes.x2);
+  __m256d y1 = _mm256_loadu_pd(lanes.y1);
+  __m256d y2 = _mm256_loadu_pd(lanes.y2);
+
+  const float* source0 = lanes.source[0];
+  const float* source1 = lanes.source[1];
+  const float* source2 = lanes.source[2];
+  const float* source3 = lanes.source[3];
+
+  alignas(16) float output[kLanes];
+
+  for (uint32_t k = 0; k < frames_to_process; ++k) {
+    // Read all inputs before writing any output; processing may be in place.
+    __m256d x = _mm256_set_pd(source3[k], source2[k], source1[k], source0[k]);
+
+    // Same order of operations as the scalar Biquad::Process() so that the
+    // results are identical. Deliberately no FMA, which would round
+    // differently.
+    __m256d y = _mm256_mul_pd(b0, x);
+    y = _mm256_add_pd(y, _mm256_mul_pd(b1, x1));
+    y = _mm256_add_pd(y, _mm256_mul_pd(b2, x2));
+    y = _mm256_sub_pd(y, _mm256_mul_pd(a1, y1));
+    y = _mm256_sub_pd(y, _mm256_mul_pd(a2, y2));
+
+    // The scalar filter keeps its output history in single precision.
+    __m128 y_float = _mm256_cvtpd_ps(y);
+    _mm_store_ps(output, y_float);
+    for (size_t lane = 0; lane < kLanes; ++lane)
+      lanes.destination[lane][k] = output[lane];
+
+    x2 = x1;
+    x1 = x;
+    y2 = y1;
+    y1 = _mm256_cvtps_pd(y_float);
+  }
+
+  _mm256_storeu_pd(lanes.x1, x1);
+  _mm256_storeu_pd(lanes.x2, x2);
+  _mm256_storeu_pd(lanes.y1, y1);
+  _mm256_storeu_pd(lanes.y2, y2);
+}
+
+}  // namespace avx
+}  // namespace biquad_x86
+}  // namespace blink
+
+#endif  // defined(ARCH_CPU_X86_FAMILY) && !defined(OS_MACOSX)
@@ -0,0 +1,67 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_MACOSX)
+
+#include "third_party/blink/renderer/platform/audio/cpu/x86/biquad_x86.h"
+
+#include <emmintrin.h>
+
+namespace blink {
+namespace biquad_x86 {
+namespace sse {
+
+void ProcessLanes(Lanes& lanes, uint32_t frames_to_process) {
+  const __m128d b0 = _mm_loadu_pd(lanes.b0);
+  const __m128d b1 = _mm_loadu_pd(lanes.b1);
+  const __m128d b2 = _mm_loadu_pd(lanes.b2);
+  const __m128d a1 = _mm_loadu_pd(lanes.a1);
+  const __m128d a2 = _mm_loadu_pd(lanes.a2);
+
+  __m128d x1 = _mm_loadu_pd(lanes.x1);
+  __m128d x2 = _mm_loadu_pd(lanes.x2);
+  __m128d y1 = _mm_loadu_pd(lanes.y1);
+  __m128d y2 = _mm_loadu_pd(lanes.y2);
+
+  const float* source0 = lanes.source[0];
+  const float* source1 = lanes.source[1];
+  float* destination0 = lanes.destination[0];
+  float* destination1 = lanes.destination[1];
+
+  for (uint32_t k = 0; k < frames_to_process; ++k) {
+    // Read both inputs before writing any output; processing may be in place.
+    __m128d x = _mm_set_pd(source1[k], source0[k]);
+
+    // Same order of operations as the scalar Biquad::Process() so that the
+    // results are identical.
+    __m128d y = _mm_mul_pd(b0, x);
+    y = _mm_add_pd(y, _mm_mul_pd(b1, x1));
+    y = _mm_add_pd(y, _mm_mul_pd(b2, x2));
+    y = _mm_sub_pd(y, _mm_mul_pd(a1, y1));
+    y = _mm_sub_pd(y, _mm_mul_pd(a2, y2));
+
+    // The scalar filter keeps its output history in single precision.
+    __m128 y_float = _mm_cvtpd_ps(y);
+    destination0[k] = _mm_cvtss_f32(y_float);
+    destination1[k] = _mm_cvtss_f32(_mm_shuffle_ps(y_float, y_float, 1));
+
+    x2 = x1;
+    x1 = x;
+    y2 = y1;
+    y1 = _mm_cvtps_pd(y_float);
+  }
+
+  _mm_storeu_pd(lanes.x1, x1);
+  _mm_storeu_pd(lanes.x2, x2);
+  _mm_storeu_pd(lanes.y1, y1);
+  _mm_storeu_pd(lanes.y2, y2);
+}
+
+}  // namespace sse
+}  // namespace biquad_x86
+}  // namespace blink
+
+#endif  // defined(ARCH_CPU_X86_FAMILY) && !defined(OS_MACOSX)
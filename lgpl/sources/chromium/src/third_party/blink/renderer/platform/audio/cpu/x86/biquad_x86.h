@@ -0,0 +1,56 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_AUDIO_CPU_X86_BIQUAD_X86_H_
+#define THIRD_PARTY_BLINK_RENDERER_PLATFORM_AUDIO_CPU_X86_BIQUAD_X86_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+
+namespace blink {
+namespace biquad_x86 {
+
+// Coefficients and filter memory of several biquads with fixed coefficients,
+// laid out as structure-of-arrays so that each biquad occupies one SIMD lane.
+// Lanes past the number being processed are ignored.
+struct Lanes {
+  STACK_ALLOCATED();
+
+ public:
+  static constexpr size_t kMaxLanes = 4;
+
+  double b0[kMaxLanes];
+  double b1[kMaxLanes];
+  double b2[kMaxLanes];
+  double a1[kMaxLanes];
+  double a2[kMaxLanes];
+
+  double x1[kMaxLanes];
+  double x2[kMaxLanes];
+  double y1[kMaxLanes];
+  double y2[kMaxLanes];
+
+  const float* source[kMaxLanes];
+  float* destination[kMaxLanes];
+};
+
+namespace sse {
+constexpr size_t kLanes = 2;
+// Filters the first two lanes of |lanes|, updating their filter memory.
+void ProcessLanes(Lanes& lanes, uint32_t frames_to_process);
+}  // namespace sse
+
+namespace avx {
+constexpr size_t kLanes = 4;
+// Filters all four lanes of |lanes|, updating their filter memory. Must only
+// be called if the CPU supports AVX.
+void ProcessLanes(Lanes& lanes, uint32_t frames_to_process);
+}  // namespace avx
+
+}  // namespace biquad_x86
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_AUDIO_CPU_X86_BIQUAD_X86_H_
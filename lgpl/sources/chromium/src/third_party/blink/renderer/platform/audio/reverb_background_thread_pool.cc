@@ -0,0 +1,102 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/audio/reverb_background_thread_pool.h"
+
+#include <algorithm>
+
+#include "base/system/sys_info.h"
+#include "third_party/blink/public/platform/platform.h"
+#include "third_party/blink/renderer/platform/scheduler/public/thread.h"
+#include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
+
+namespace blink {
+
+namespace {
+
+// Background stages only need to keep up with the real-time thread on
+// average, so a few threads are enough for any number of convolvers.
+constexpr wtf_size_t kMaxReverbBackgroundThreads = 4;
+
+}  // namespace
+
+ReverbBackgroundThreadPool& ReverbBackgroundThreadPool::Get() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(
+      ReverbBackgroundThreadPool, pool,
+      (std::max(1, std::min(static_cast<int>(kMaxReverbBackgroundThreads),
+                            base::SysInfo::NumberOfProcessors() / 2))));
+  return pool;
+}
+
+ReverbBackgroundThreadPool::ReverbBackgroundThreadPool(wtf_size_t max_threads)
+    : max_threads_(max_threads) {
+  DCHECK_GT(max_threads_, 0u);
+}
+
+ReverbBackgroundThreadPool::~ReverbBackgroundThreadPool() {
+#if DCHECK_IS_ON()
+  for (unsigned users : users_)
+    DCHECK_EQ(users, 0u);
+#endif
+}
+
+Thread* ReverbBackgroundThreadPool::Acquire() {
+  MutexLocker locker(mutex_);
+
+  wtf_size_t least_used = 0;
+  for (wtf_size_t i = 1; i < users_.size(); ++i) {
+    if (users_[i] < users_[least_used])
+      least_used = i;
+  }
+
+  // Only start another thread if every existing one is busy.
+  if (threads_.IsEmpty() ||
+      (users_[least_used] && threads_.size() < max_threads_)) {
+    // FIXME: would be better to up the thread priority here.  It doesn't need
+    // to be real-time, but higher than the default...
+    threads_.push_back(Platform::Current()->CreateThread(
+        ThreadCreationParams(ThreadType::kReverbConvolutionBackgroundThread)));
+    users_.push_back(0);
+    least_used = threads_.size() - 1;
+  }
+
+  ++users_[least_used];
+  return threads_[least_used].get();
+}
+
+void ReverbBackgroundThreadPool::Release(Thread* thread) {
+  std::unique_ptr<Thread> unused_thread;
+  {
+    MutexLocker locker(mutex_);
+    wtf_size_t index = 0;
+    while (index < threads_.size() && threads_[index].get() != thread)
+      ++index;
+    CHECK_LT(index, threads_.size());
+    DCHECK_GT(users_[index], 0u);
+    if (--users_[index])
+      return;
+    unused_thread = std::move(threads_[index]);
+    threads_.EraseAt(index);
+    users_.EraseAt(index);
+  }
+  // Destroying the thread joins it. This happens outside of |mutex_| so that
+  // other convolvers can acquire threads meanwhile.
+  unused_thread.reset();
+}
+
+wtf_size_t ReverbBackgroundThreadPool::NumberOfThreads() const {
+  MutexLocker locker(mutex_);
+  return threads_.size();
+}
+
+unsigned ReverbBackgroundThreadPool::NumberOfUsers(const Thread* thread) const {
+  MutexLocker locker(mutex_);
+  for (wtf_size_t i = 0; i < threads_.size(); ++i) {
+    if (threads_[i].get() == thread)
+      return users_[i];
+  }
+  return 0;
+}
+
+}  // namespace blink
@@ -0,0 +1,62 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_AUDIO_REVERB_BACKGROUND_THREAD_POOL_H_
+#define THIRD_PARTY_BLINK_RENDERER_PLATFORM_AUDIO_REVERB_BACKGROUND_THREAD_POOL_H_
+
+#include <memory>
+
+#include "base/macros.h"
+#include "third_party/blink/renderer/platform/platform_export.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/threading_primitives.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+class Thread;
+
+// The threads which run the background stages of every ReverbConvolver in the
+// process. Instead of each convolver starting a thread of its own, convolvers
+// share a small number of threads, each convolver being assigned to the least
+// used one. Threads are started on demand, and stopped and joined as soon as
+// no convolver is assigned to them, or when the pool is destroyed.
+//
+// All methods are thread-safe.
+class PLATFORM_EXPORT ReverbBackgroundThreadPool {
+  USING_FAST_MALLOC(ReverbBackgroundThreadPool);
+
+ public:
+  static ReverbBackgroundThreadPool& Get();
+
+  explicit ReverbBackgroundThreadPool(wtf_size_t max_threads);
+  // Every convolver must have released its thread by now.
+  ~ReverbBackgroundThreadPool();
+
+  // Returns the thread a new convolver should run its background stages on.
+  // Each call must be balanced by a call to Release() when the convolver is
+  // destroyed. Tasks it posted may still be pending on the thread then; they
+  // must return promptly, as releasing the last user of a thread joins it.
+  Thread* Acquire();
+  void Release(Thread*);
+
+  wtf_size_t MaxThreads() const { return max_threads_; }
+  wtf_size_t NumberOfThreads() const;
+  // The number of convolvers currently assigned to |thread|.
+  unsigned NumberOfUsers(const Thread* thread) const;
+
+ private:
+  const wtf_size_t max_threads_;
+
+  mutable Mutex mutex_;
+  Vector<std::unique_ptr<Thread>> threads_;
+  // Number of convolvers assigned to the thread with the same index.
+  Vector<unsigned> users_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReverbBackgroundThreadPool);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_AUDIO_REVERB_BACKGROUND_THREAD_POOL_H_
@@ -0,0 +1,54 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/audio/reverb_background_thread_pool.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/platform/scheduler/public/thread.h"
+
+namespace blink {
+
+TEST(ReverbBackgroundThreadPoolTest, ThreadsAreSharedUpToTheLimit) {
+  ReverbBackgroundThreadPool pool(2);
+
+  Thread* first = pool.Acquire();
+  Thread* second = pool.Acquire();
+  EXPECT_NE(first, second);
+  EXPECT_EQ(2u, pool.NumberOfThreads());
+
+  // Further convolvers share the existing threads, least used first.
+  Thread* third = pool.Acquire();
+  Thread* fourth = pool.Acquire();
+  EXPECT_EQ(2u, pool.NumberOfThreads());
+  EXPECT_NE(third, fourth);
+  EXPECT_EQ(2u, pool.NumberOfUsers(first));
+  EXPECT_EQ(2u, pool.NumberOfUsers(second));
+
+  pool.Release(first);
+  pool.Release(third);
+  pool.Release(fourth);
+  EXPECT_EQ(1u, pool.NumberOfUsers(second) + pool.NumberOfUsers(first));
+  pool.Release(second);
+}
+
+TEST(ReverbBackgroundThreadPoolTest, UnusedThreadsAreStopped) {
+  ReverbBackgroundThreadPool pool(4);
+
+  Thread* first = pool.Acquire();
+  Thread* second = pool.Acquire();
+  EXPECT_EQ(2u, pool.NumberOfThreads());
+
+  pool.Release(first);
+  EXPECT_EQ(1u, pool.NumberOfThreads());
+  EXPECT_EQ(1u, pool.NumberOfUsers(second));
+
+  // The remaining thread is reused rather than a new one started while it
+  // only has one user.
+  EXPECT_EQ(second, pool.Acquire());
+  pool.Release(second);
+  pool.Release(second);
+  EXPECT_EQ(0u, pool.NumberOfThreads());
+}
+
+}  // namespace blink
@@ -28,16 +28,20 @@
 
 #include "third_party/blink/renderer/platform/audio/reverb_convolver.h"
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
 #include "base/location.h"
-#include "third_party/blink/public/platform/platform.h"
+#include "base/single_thread_task_runner.h"
 #include "third_party/blink/renderer/platform/audio/audio_bus.h"
+#include "third_party/blink/renderer/platform/audio/reverb_background_thread_pool.h"
 #include "third_party/blink/renderer/platform/audio/vector_math.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread.h"
 #include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
+#include "third_party/blink/renderer/platform/wtf/thread_safe_ref_counted.h"
 
 namespace blink {
 
@@ -58,15 +62,111 @@ const size_t kRealtimeFrameLimit = 8192 + 4096;  // ~278msec @ 44.1KHz
 const size_t kMinFFTSize = 128;
 const size_t kMaxRealtimeFFTSize = 2048;
 
+// The background stages process in slices which evenly divide half the FFT
+// size. A task processes at most this many slices before yielding the thread
+// to the other convolvers sharing it.
+const int kBackgroundSliceSize = kMinFFTSize / 2;
+const int kBackgroundSlicesPerTask = 8;
+
+class ReverbConvolver::BackgroundState
+    : public ThreadSafeRefCounted<BackgroundState> {
+ public:
+  explicit BackgroundState(size_t accumulation_buffer_length)
+      : accumulation_buffer_(accumulation_buffer_length),
+        input_buffer_(kInputBufferSize) {}
+
+  ReverbAccumulationBuffer* AccumulationBuffer() {
+    return &accumulation_buffer_;
+  }
+  ReverbInputBuffer* InputBuffer() { return &input_buffer_; }
+  Vector<std::unique_ptr<ReverbConvolverStage>>& Stages() { return stages_; }
+
+  // Set once the convolver has been assigned a background thread.
+  void SetTaskRunner(scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
+    task_runner_ = std::move(task_runner);
+  }
+
+  // Posts ProcessInBackground() to the background thread, unless a task is
+  // already posted but hasn't started yet. Called by the real-time thread
+  // after feeding the input buffer, and by the background thread when a task
+  // yields with input left to process.
+  void PostTaskIfNeeded();
+
+  // Called when the convolver is destroyed. Tasks which are still posted or
+  // running stop at the next slice.
+  void Cancel() { cancelled_.store(true); }
+
+  void ProcessInBackground();
+
+ private:
+  ReverbAccumulationBuffer accumulation_buffer_;
+
+  // One or more background threads read from this input buffer which is fed
+  // from the realtime thread.
+  ReverbInputBuffer input_buffer_;
+
+  Vector<std::unique_ptr<ReverbConvolverStage>> stages_;
+
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
+
+  // Set while a ProcessInBackground() task is posted but hasn't started, so
+  // that at most one is queued on the shared thread at a time.
+  std::atomic<bool> task_pending_{false};
+  std::atomic<bool> cancelled_{false};
+};
+
+void ReverbConvolver::BackgroundState::PostTaskIfNeeded() {
+  if (task_pending_.exchange(true))
+    return;
+  PostCrossThreadTask(
+      *task_runner_, FROM_HERE,
+      CrossThreadBindOnce(&BackgroundState::ProcessInBackground,
+                          WrapRefCounted(this)));
+}
+
+void ReverbConvolver::BackgroundState::ProcessInBackground() {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("webaudio.audionode"),
+               "ReverbConvolver::ProcessInBackground");
+
+  // Clear this before reading the write index so that input written after
+  // this point is picked up either here or by the next task.
+  task_pending_.store(false);
+
+  // Process the stages until their read indices reach the input buffer's
+  // write index, or until this task has used up its slices. Even though it
+  // doesn't seem like every stage needs to maintain its own version of
+  // readIndex we do this in case we want to run in more than one background
+  // thread.
+  int write_index = input_buffer_.WriteIndex();
+  for (int slice = 0; slice < kBackgroundSlicesPerTask; ++slice) {
+    // FIXME: do better to detect buffer overrun...
+    if (cancelled_.load(std::memory_order_relaxed) ||
+        stages_[0]->InputReadIndex() == write_index) {
+      return;
+    }
+
+    // Accumulate contributions from each stage
+    for (size_t i = 0; i < stages_.size(); ++i)
+      stages_[i]->ProcessInBackground(&input_buffer_, kBackgroundSliceSize);
+  }
+
+  // Go to the back of the thread's queue, so that the convolvers sharing the
+  // thread take turns rather than one with a backlog holding up the others.
+  if (!cancelled_.load(std::memory_order_relaxed) &&
+      stages_[0]->InputReadIndex() != write_index) {
+    PostTaskIfNeeded();
+  }
+}
+
 ReverbConvolver::ReverbConvolver(AudioChannel* impulse_response,
                                  size_t render_slice_size,
                                  size_t max_fft_size,
                                  size_t convolver_render_phase,
                                  bool use_background_threads,
                                  float scale)
-    : impulse_response_length_(impulse_response->length()),
-      accumulation_buffer_(impulse_response->length() + render_slice_size),
-      input_buffer_(kInputBufferSize),
+    : state_(base::AdoptRef(new BackgroundState(impulse_response->length() +
+                                                render_slice_size))),
+      impulse_response_length_(impulse_response->length()),
       min_fft_size_(
           kMinFFTSize),  // First stage will have this size - successive
                          // stages will double in size each time
@@ -108,12 +208,12 @@ ReverbConvolver::ReverbConvolver(AudioChannel* impulse_response,
         std::make_unique<ReverbConvolverStage>(
             response, total_response_length, reverb_total_latency, stage_offset,
             stage_size, fft_size, render_phase, render_slice_size,
-            &accumulation_buffer_, scale, use_direct_convolver);
+            state_->AccumulationBuffer(), scale, use_direct_convolver);
 
     bool is_background_stage = false;
 
     if (use_background_threads && stage_offset > kRealtimeFrameLimit) {
-      background_stages_.push_back(std::move(stage));
+      state_->Stages().push_back(std::move(stage));
       is_background_stage = true;
     } else {
       stages_.push_back(std::move(stage));
@@ -134,40 +234,25 @@ ReverbConvolver::ReverbConvolver(AudioChannel* impulse_response,
       fft_size = max_fft_size_;
   }
 
-  // Start up background thread
-  // FIXME: would be better to up the thread priority here.  It doesn't need to
-  // be real-time, but higher than the default...
-  if (use_background_threads && background_stages_.size() > 0) {
-    background_thread_ = Platform::Current()->CreateThread(
-        ThreadCreationParams(ThreadType::kReverbConvolutionBackgroundThread));
+  if (use_background_threads && state_->Stages().size() > 0) {
+    background_thread_ = ReverbBackgroundThreadPool::Get().Acquire();
+    state_->SetTaskRunner(background_thread_->GetTaskRunner());
   }
 }
 
 ReverbConvolver::~ReverbConvolver() {
-  // Wait for background thread to stop
-  background_thread_.reset();
+  if (!background_thread_)
+    return;
+
+  // Waiting for a task that is posted or running could block the caller behind
+  // other convolvers' work on the shared thread. Such a task holds its own
+  // reference to |state_| and returns without doing any more work.
+  state_->Cancel();
+  ReverbBackgroundThreadPool::Get().Release(background_thread_);
 }
 
-void ReverbConvolver::ProcessInBackground() {
-  // Process all of the stages until their read indices reach the input buffer's
-  // write index
-  int write_index = input_buffer_.WriteIndex();
-
-  // Even though it doesn't seem like every stage needs to maintain its own
-  // version of readIndex we do this in case we want to run in more than one
-  // background thread.
-  int read_index;
-
-  while ((read_index = background_stages_[0]->InputReadIndex()) !=
-         write_index) {  // FIXME: do better to detect buffer overrun...
-    // The ReverbConvolverStages need to process in amounts which evenly divide
-    // half the FFT size
-    const int kSliceSize = kMinFFTSize / 2;
-
-    // Accumulate contributions from each stage
-    for (size_t i = 0; i < background_stages_.size(); ++i)
-      background_stages_[i]->ProcessInBackground(this, kSliceSize);
-  }
+ReverbInputBuffer* ReverbConvolver::InputBuffer() {
+  return state_->InputBuffer();
 }
 
 void ReverbConvolver::Process(const AudioChannel* source_channel,
@@ -184,34 +269,30 @@ void ReverbConvolver::Process(const AudioChannel* source_channel,
   DCHECK(destination);
 
   // Feed input buffer (read by all threads)
-  input_buffer_.Write(source, frames_to_process);
+  state_->InputBuffer()->Write(source, frames_to_process);
 
   // Accumulate contributions from each stage
   for (size_t i = 0; i < stages_.size(); ++i)
     stages_[i]->Process(source, frames_to_process);
 
   // Finally read from accumulation buffer
-  accumulation_buffer_.ReadAndClear(destination, frames_to_process);
+  state_->AccumulationBuffer()->ReadAndClear(destination, frames_to_process);
 
   // Now that we've buffered more input, post another task to the background
-  // thread.
-  if (background_thread_) {
-    PostCrossThreadTask(
-        *background_thread_->GetTaskRunner(), FROM_HERE,
-        CrossThreadBindOnce(&ReverbConvolver::ProcessInBackground,
-                            CrossThreadUnretained(this)));
-  }
+  // thread, unless one is already waiting to run.
+  if (background_thread_)
+    state_->PostTaskIfNeeded();
 }
 
 void ReverbConvolver::Reset() {
   for (size_t i = 0; i < stages_.size(); ++i)
     stages_[i]->Reset();
 
-  for (size_t i = 0; i < background_stages_.size(); ++i)
-    background_stages_[i]->Reset();
+  for (size_t i = 0; i < state_->Stages().size(); ++i)
+    state_->Stages()[i]->Reset();
 
-  accumulation_buffer_.Reset();
-  input_buffer_.Reset();
+  state_->AccumulationBuffer()->Reset();
+  state_->InputBuffer()->Reset();
 }
 
 size_t ReverbConvolver::LatencyFrames() const {
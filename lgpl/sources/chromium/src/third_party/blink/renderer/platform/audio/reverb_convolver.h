@@ -31,6 +31,7 @@
 
 #include <memory>
 
+#include "base/memory/scoped_refptr.h"
 #include "third_party/blink/renderer/platform/audio/audio_array.h"
 #include "third_party/blink/renderer/platform/audio/direct_convolver.h"
 #include "third_party/blink/renderer/platform/audio/fft_convolver.h"
@@ -67,23 +68,22 @@ class PLATFORM_EXPORT ReverbConvolver {
                uint32_t frames_to_process);
   void Reset();
 
-  ReverbInputBuffer* InputBuffer() { return &input_buffer_; }
+  ReverbInputBuffer* InputBuffer();
 
   size_t LatencyFrames() const;
 
  private:
-  void ProcessInBackground();
+  // The buffers and the background stages. Tasks posted to
+  // |background_thread_| hold a reference to it, so that the convolver can be
+  // destroyed without waiting for them.
+  class BackgroundState;
+
+  // Declared before |stages_|, which point into its accumulation buffer.
+  scoped_refptr<BackgroundState> state_;
 
   Vector<std::unique_ptr<ReverbConvolverStage>> stages_;
-  Vector<std::unique_ptr<ReverbConvolverStage>> background_stages_;
   size_t impulse_response_length_;
 
-  ReverbAccumulationBuffer accumulation_buffer_;
-
-  // One or more background threads read from this input buffer which is fed
-  // from the realtime thread.
-  ReverbInputBuffer input_buffer_;
-
   // First stage will be of size m_minFFTSize.  Each next stage will be twice as
   // big until we hit m_maxFFTSize.
   size_t min_fft_size_;
@@ -93,8 +93,9 @@ class PLATFORM_EXPORT ReverbConvolver {
   // background processing).
   size_t max_realtime_fft_size_;
 
-  // Background thread and synchronization
-  std::unique_ptr<Thread> background_thread_;
+  // Thread from ReverbBackgroundThreadPool which runs the background stages.
+  // It's shared with other convolvers.
+  Thread* background_thread_ = nullptr;
 
   DISALLOW_COPY_AND_ASSIGN(ReverbConvolver);
 };
@@ -33,7 +33,6 @@
 #include <utility>
 
 #include "third_party/blink/renderer/platform/audio/reverb_accumulation_buffer.h"
-#include "third_party/blink/renderer/platform/audio/reverb_convolver.h"
 #include "third_party/blink/renderer/platform/audio/reverb_input_buffer.h"
 #include "third_party/blink/renderer/platform/audio/vector_math.h"
 
@@ -118,9 +117,9 @@ ReverbConvolverStage::ReverbConvolverStage(
   pre_delay_buffer_.Allocate(delay_buffer_size);
 }
 
-void ReverbConvolverStage::ProcessInBackground(ReverbConvolver* convolver,
-                                               uint32_t frames_to_process) {
-  ReverbInputBuffer* input_buffer = convolver->InputBuffer();
+void ReverbConvolverStage::ProcessInBackground(
+    ReverbInputBuffer* input_buffer,
+    uint32_t frames_to_process) {
   float* source =
       input_buffer->DirectReadFrom(&input_read_index_, frames_to_process);
   Process(source, frames_to_process);
@@ -39,7 +39,7 @@
 namespace blink {
 
 class ReverbAccumulationBuffer;
-class ReverbConvolver;
+class ReverbInputBuffer;
 class FFTConvolver;
 class DirectConvolver;
 
@@ -70,7 +70,7 @@ class PLATFORM_EXPORT ReverbConvolverStage {
   // buffer size (stage_offset).
   void Process(const float* source, uint32_t frames_to_process);
 
-  void ProcessInBackground(ReverbConvolver* convolver,
+  void ProcessInBackground(ReverbInputBuffer* input_buffer,
                            uint32_t frames_to_process);
 
   void Reset();
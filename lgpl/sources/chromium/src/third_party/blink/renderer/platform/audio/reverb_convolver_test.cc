@@ -0,0 +1,41 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/audio/reverb_convolver.h"
+
+#include <memory>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/platform/audio/audio_channel.h"
+#include "third_party/blink/renderer/platform/audio/audio_utilities.h"
+
+namespace blink {
+
+TEST(ReverbConvolverTest, DestroyWithBackgroundTasksPosted) {
+  // Long enough for the tail of the response to run in the background.
+  AudioChannel impulse_response(48000);
+  float* response = impulse_response.MutableData();
+  for (size_t i = 0; i < impulse_response.length(); ++i)
+    response[i] = i % 2 ? 0.5f : -0.5f;
+
+  const size_t frames = audio_utilities::kRenderQuantumFrames;
+  AudioChannel source(frames);
+  AudioChannel destination(frames);
+  float* source_data = source.MutableData();
+  for (size_t i = 0; i < frames; ++i)
+    source_data[i] = 1;
+
+  for (int run = 0; run < 10; ++run) {
+    auto convolver = std::make_unique<ReverbConvolver>(
+        &impulse_response, frames, 32768, 0,
+        /* use_background_threads */ true, 1);
+    for (int i = 0; i < 200; ++i)
+      convolver->Process(&source, &destination, frames);
+    // The posted task holds on to the stages and returns early, so stopping
+    // the now unused background thread only waits for the slice in progress.
+    convolver.reset();
+  }
+}
+
+}  // namespace blink
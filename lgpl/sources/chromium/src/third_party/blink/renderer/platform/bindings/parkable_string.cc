@@ -9,6 +9,7 @@
 #include "base/check_op.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/notreached.h"
 #include "base/process/memory.h"
 #include "base/single_thread_task_runner.h"
 #include "base/timer/elapsed_timer.h"
@@ -26,6 +27,7 @@
 #include "third_party/blink/renderer/platform/wtf/sanitizers.h"
 #include "third_party/blink/renderer/platform/wtf/thread_specific.h"
 #include "third_party/blink/renderer/platform/wtf/vector.h"
+#include "third_party/snappy/src/snappy.h"
 #include "third_party/zlib/google/compression_utils.h"
 
 namespace blink {
@@ -215,11 +217,33 @@ ParkableStringImpl::ParkableMetadata::ParkableMetadata(
       state_(State::kUnparked),
       background_task_in_progress_(false),
       compressed_(nullptr),
+      compression_algorithm_(CompressionAlgorithm::kZlib),
       digest_(*digest),
       age_(Age::kYoung),
       is_8bit_(string.Is8Bit()),
       length_(string.length()) {}
 
+// static
+ParkableStringImpl::CompressionAlgorithm
+ParkableStringImpl::GetCompressionAlgorithm() {
+  if (base::FeatureList::IsEnabled(kCompressParkableStringsWithSnappy))
+    return CompressionAlgorithm::kSnappy;
+  return CompressionAlgorithm::kZlib;
+}
+
+// static
+const char* ParkableStringImpl::CompressionAlgorithmName(
+    CompressionAlgorithm algorithm) {
+  switch (algorithm) {
+    case CompressionAlgorithm::kZlib:
+      return "zlib";
+    case CompressionAlgorithm::kSnappy:
+      return "snappy";
+  }
+  NOTREACHED();
+  return "";
+}
+
 // static
 std::unique_ptr<ParkableStringImpl::SecureDigest>
 ParkableStringImpl::HashString(StringImpl* string) {
@@ -565,23 +589,41 @@ String ParkableStringImpl::UnparkInternal() {
         base::StringPiece(reinterpret_cast<const char*>(data), size);
   }
 
-  // If the buffer size is incorrect, then we have a corrupted data issue,
-  // and in such case there is nothing else to do than crash.
-  CHECK_EQ(compression::GetUncompressedSize(compressed_string_piece),
-           uncompressed_string_piece.size());
-  // If decompression fails, this is either because:
-  // 1. Compressed data is corrupted
-  // 2. Cannot allocate memory in zlib
-  //
-  // (1) is data corruption, and (2) is OOM. In all cases, we cannot
-  // recover the string we need, nothing else to do than to abort.
-  //
-  // Stability sheriffs: If you see this, this is likely an OOM.
-  CHECK(compression::GzipUncompress(compressed_string_piece,
-                                    uncompressed_string_piece));
+  switch (metadata_->compression_algorithm_) {
+    case CompressionAlgorithm::kZlib:
+      // If the buffer size is incorrect, then we have a corrupted data issue,
+      // and in such case there is nothing else to do than crash.
+      CHECK_EQ(compression::GetUncompressedSize(compressed_string_piece),
+               uncompressed_string_piece.size());
+      // If decompression fails, this is either because:
+      // 1. Compressed data is corrupted
+      // 2. Cannot allocate memory in zlib
+      //
+      // (1) is data corruption, and (2) is OOM. In all cases, we cannot
+      // recover the string we need, nothing else to do than to abort.
+      //
+      // Stability sheriffs: If you see this, this is likely an OOM.
+      CHECK(compression::GzipUncompress(compressed_string_piece,
+                                        uncompressed_string_piece));
+      break;
+    case CompressionAlgorithm::kSnappy: {
+      // snappy doesn't allocate, a failure here can only be data corruption.
+      size_t uncompressed_size;
+      CHECK(snappy::GetUncompressedLength(compressed_string_piece.data(),
+                                          compressed_string_piece.size(),
+                                          &uncompressed_size));
+      CHECK_EQ(uncompressed_size, uncompressed_string_piece.size());
+      CHECK(snappy::RawUncompress(
+          compressed_string_piece.data(), compressed_string_piece.size(),
+          const_cast<char*>(uncompressed_string_piece.data())));
+      break;
+    }
+  }
 
   base::TimeDelta elapsed = timer.Elapsed();
   manager.RecordUnparkingTime(elapsed);
+  manager.RecordDecompression(metadata_->compression_algorithm_, size,
+                              elapsed);
   RecordStatistics(CharactersSizeInBytes(), elapsed, ParkingAction::kUnparked);
 
   return uncompressed;
@@ -589,23 +631,47 @@ String ParkableStringImpl::UnparkInternal() {
 
 void ParkableStringImpl::PostBackgroundCompressionTask() {
   DCHECK(!metadata_->background_task_in_progress_);
+  // Also set while waiting for the compression budget, which keeps the string
+  // from aging and from being parked twice.
+  metadata_->background_task_in_progress_ = true;
+  ParkableStringManager::Instance().ScheduleBackgroundCompression(this);
+}
+
+void ParkableStringImpl::StartBackgroundCompression() {
+  DCHECK(metadata_->background_task_in_progress_);
   // |string_|'s data should not be touched except in the compression task.
   AsanPoisonString(string_);
-  metadata_->background_task_in_progress_ = true;
   // |params| keeps |this| alive until |OnParkingCompleteOnMainThread()|.
   auto params = std::make_unique<BackgroundTaskParams>(
       this, string_.Bytes(), string_.CharactersSizeInBytes(),
       Thread::Current()->GetTaskRunner());
   worker_pool::PostTask(
       FROM_HERE, CrossThreadBindOnce(&ParkableStringImpl::CompressInBackground,
-                                     std::move(params)));
+                                     std::move(params),
+                                     GetCompressionAlgorithm()));
+}
+
+bool ParkableStringImpl::MaybeStartQueuedBackgroundCompression() {
+  MutexLocker locker(metadata_->mutex_);
+  AssertOnValidThread();
+  DCHECK(metadata_->background_task_in_progress_);
+  DCHECK_EQ(State::kUnparked, metadata_->state_);
+  // The string may have been accessed or locked while it was waiting. It would
+  // not be parked after compression either, so don't compress it.
+  if (!CanParkNow()) {
+    metadata_->background_task_in_progress_ = false;
+    return false;
+  }
+  StartBackgroundCompression();
+  return true;
 }
 
 // static
 void ParkableStringImpl::CompressInBackground(
-    std::unique_ptr<BackgroundTaskParams> params) {
-  TRACE_EVENT1("blink", "ParkableStringImpl::CompressInBackground", "size",
-               params->size);
+    std::unique_ptr<BackgroundTaskParams> params,
+    CompressionAlgorithm algorithm) {
+  TRACE_EVENT2("blink", "ParkableStringImpl::CompressInBackground", "size",
+               params->size, "algorithm", CompressionAlgorithmName(algorithm));
 
   base::ElapsedTimer timer;
 #if defined(ADDRESS_SANITIZER)
@@ -631,7 +697,8 @@ void ParkableStringImpl::CompressInBackground(
   {
     // Temporary vector. As we don't want to waste memory, the temporary buffer
     // has the same size as the initial data. Compression will fail if this is
-    // not large enough.
+    // not large enough. snappy needs its worst case size, the result is
+    // discarded if it isn't smaller than the initial data.
     //
     // This is not using:
     // - malloc() or any STL container: this is discouraged in blink, and there
@@ -639,18 +706,31 @@ void ParkableStringImpl::CompressInBackground(
     // - WTF::Vector<> as allocation failures result in an OOM crash, whereas
     //   we can fail gracefully. See crbug.com/905777 for an example of OOM
     //   triggered from there.
-    NullableCharBuffer buffer(params->size);
+    NullableCharBuffer buffer(algorithm == CompressionAlgorithm::kSnappy
+                                  ? snappy::MaxCompressedLength(params->size)
+                                  : params->size);
     ok = buffer.data();
     size_t compressed_size;
     if (ok) {
-      // Use partition alloc for zlib's temporary data. This is crucial to avoid
-      // leaking memory on Android, see the details in crbug.com/931553.
-      auto fast_malloc = [](size_t size) {
-        return WTF::Partitions::FastMalloc(size, "ZlibTemporaryData");
-      };
-      ok = compression::GzipCompress(data, buffer.data(), buffer.size(),
-                                     &compressed_size, fast_malloc,
-                                     WTF::Partitions::FastFree);
+      switch (algorithm) {
+        case CompressionAlgorithm::kZlib: {
+          // Use partition alloc for zlib's temporary data. This is crucial to
+          // avoid leaking memory on Android, see the details in
+          // crbug.com/931553.
+          auto fast_malloc = [](size_t size) {
+            return WTF::Partitions::FastMalloc(size, "ZlibTemporaryData");
+          };
+          ok = compression::GzipCompress(data, buffer.data(), buffer.size(),
+                                         &compressed_size, fast_malloc,
+                                         WTF::Partitions::FastFree);
+          break;
+        }
+        case CompressionAlgorithm::kSnappy:
+          snappy::RawCompress(data.data(), data.size(), buffer.data(),
+                              &compressed_size);
+          ok = compressed_size < data.size();
+          break;
+      }
     }
 
 #if defined(ADDRESS_SANITIZER)
@@ -673,31 +753,41 @@ void ParkableStringImpl::CompressInBackground(
       *task_runner, FROM_HERE,
       CrossThreadBindOnce(
           [](std::unique_ptr<BackgroundTaskParams> params,
+             CompressionAlgorithm algorithm,
              std::unique_ptr<Vector<uint8_t>> compressed,
              base::TimeDelta parking_thread_time) {
             auto* string = params->string.get();
             string->OnParkingCompleteOnMainThread(
-                std::move(params), std::move(compressed), parking_thread_time);
+                std::move(params), algorithm, std::move(compressed),
+                parking_thread_time);
           },
-          std::move(params), std::move(compressed), thread_elapsed));
+          std::move(params), algorithm, std::move(compressed),
+          thread_elapsed));
   RecordStatistics(size, timer.Elapsed(), ParkingAction::kParked);
 }
 
 void ParkableStringImpl::OnParkingCompleteOnMainThread(
     std::unique_ptr<BackgroundTaskParams> params,
+    CompressionAlgorithm algorithm,
     std::unique_ptr<Vector<uint8_t>> compressed,
     base::TimeDelta parking_thread_time) {
   DCHECK(metadata_->background_task_in_progress_);
   MutexLocker locker(metadata_->mutex_);
   DCHECK_EQ(State::kUnparked, metadata_->state_);
   metadata_->background_task_in_progress_ = false;
+  auto& manager = ParkableStringManager::Instance();
+  manager.RecordCompression(algorithm, params->size,
+                            compressed ? compressed->size() : 0,
+                            parking_thread_time);
 
   // Always keep the compressed data. Compression is expensive, so even if the
   // uncompressed representation cannot be discarded now, avoid compressing
   // multiple times. This will allow synchronous parking next time.
   DCHECK(!metadata_->compressed_);
-  if (compressed)
+  if (compressed) {
     metadata_->compressed_ = std::move(compressed);
+    metadata_->compression_algorithm_ = algorithm;
+  }
 
   // Between |Park()| and now, things may have happened:
   // 1. |ToString()| or
@@ -712,8 +802,9 @@ void ParkableStringImpl::OnParkingCompleteOnMainThread(
   }
   // Record the time no matter whether the string was parked or not, as the
   // parking cost was paid.
-  ParkableStringManager::Instance().RecordParkingThreadTime(
-      parking_thread_time);
+  manager.RecordParkingThreadTime(parking_thread_time);
+  // May start compressing other strings.
+  manager.OnBackgroundCompressionComplete();
 }
 
 void ParkableStringImpl::PostBackgroundWritingTask() {
@@ -48,6 +48,18 @@ class PLATFORM_EXPORT ParkableStringImpl final
     kNonTransientFailure
   };
   enum class Age { kYoung = 0, kOld = 1, kVeryOld = 2 };
+  // zlib gives the best ratio, snappy is several times faster at both
+  // compression and decompression.
+  enum class CompressionAlgorithm : uint8_t {
+    kZlib = 0,
+    kSnappy = 1,
+    kMaxValue = kSnappy
+  };
+
+  // Algorithm used for strings compressed from now on. A string always keeps
+  // the algorithm it was compressed with.
+  static CompressionAlgorithm GetCompressionAlgorithm();
+  static const char* CompressionAlgorithmName(CompressionAlgorithm);
 
   constexpr static size_t kDigestSize = 32;  // SHA256.
   using SecureDigest = Vector<uint8_t, kDigestSize>;
@@ -189,16 +201,24 @@ class PLATFORM_EXPORT ParkableStringImpl final
   void Unpark() EXCLUSIVE_LOCKS_REQUIRED(metadata_->mutex_);
   String UnparkInternal() EXCLUSIVE_LOCKS_REQUIRED(metadata_->mutex_);
 
+  // Hands the string to ParkableStringManager, which starts compression once
+  // there is room for it in the compression budget.
   void PostBackgroundCompressionTask();
-  static void CompressInBackground(std::unique_ptr<BackgroundTaskParams>);
+  void StartBackgroundCompression();
+  // Called by ParkableStringManager for a string which waited for the budget.
+  // Returns false and gives up if the string cannot be parked anymore.
+  bool MaybeStartQueuedBackgroundCompression();
+  static void CompressInBackground(std::unique_ptr<BackgroundTaskParams>,
+                                   CompressionAlgorithm);
   // Called on the main thread after compression is done.
   // |params| is the same as the one passed to
-  // |PostBackgroundCompressionTask()|,
+  // |CompressInBackground()|,
   // |compressed| is the compressed data, nullptr if compression failed.
   // |parking_thread_time| is the CPU time used by the background compression
   // task.
   void OnParkingCompleteOnMainThread(
       std::unique_ptr<BackgroundTaskParams> params,
+      CompressionAlgorithm algorithm,
       std::unique_ptr<Vector<uint8_t>> compressed,
       base::TimeDelta parking_thread_time);
 
@@ -232,6 +252,8 @@ class PLATFORM_EXPORT ParkableStringImpl final
     State state_;
     bool background_task_in_progress_;
     std::unique_ptr<Vector<uint8_t>> compressed_;
+    // Algorithm |compressed_| and the on-disk data are compressed with.
+    CompressionAlgorithm compression_algorithm_;
     std::unique_ptr<DiskDataAllocator::Metadata> on_disk_metadata_;
     const SecureDigest digest_;
 
@@ -17,6 +17,7 @@
 #include "third_party/blink/renderer/platform/disk_data_allocator.h"
 #include "third_party/blink/renderer/platform/platform_export.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/deque.h"
 #include "third_party/blink/renderer/platform/wtf/hash_functions.h"
 #include "third_party/blink/renderer/platform/wtf/hash_map.h"
 #include "third_party/blink/renderer/platform/wtf/hash_set.h"
@@ -28,6 +29,7 @@ class DiskDataAllocator;
 class ParkableString;
 
 PLATFORM_EXPORT extern const base::Feature kCompressParkableStrings;
+PLATFORM_EXPORT extern const base::Feature kCompressParkableStringsWithSnappy;
 
 class PLATFORM_EXPORT ParkableStringManagerDumpProvider
     : public base::trace_event::MemoryDumpProvider {
@@ -54,6 +56,20 @@ class PLATFORM_EXPORT ParkableStringManager {
 
  public:
   struct Statistics;
+  // Cumulative, per compression algorithm.
+  struct CodecStatistics {
+    size_t compressions = 0;
+    // Strings which did not become smaller, or failed to compress.
+    size_t failed_compressions = 0;
+    size_t input_size = 0;
+    // Of the successful compressions only.
+    size_t original_size = 0;
+    size_t compressed_size = 0;
+    base::TimeDelta compression_thread_time;
+    size_t decompressions = 0;
+    size_t decompressed_size = 0;
+    base::TimeDelta decompression_time;
+  };
 
   static ParkableStringManager& Instance();
   ~ParkableStringManager();
@@ -72,6 +88,21 @@ class PLATFORM_EXPORT ParkableStringManager {
   // Public for testing.
   constexpr static int kAgingIntervalInSeconds = 2;
 
+  const CodecStatistics& codec_statistics(
+      ParkableStringImpl::CompressionAlgorithm algorithm) const {
+    return codec_statistics_[static_cast<size_t>(algorithm)];
+  }
+
+  // Number of background compression tasks which may run at the same time.
+  // Other strings wait for a task to complete. By default, half of the cores,
+  // which leaves room for the rest of the renderer when many strings are
+  // parked at once, e.g. on memory pressure.
+  size_t MaxConcurrentBackgroundCompressions() const;
+  // 0 restores the default.
+  void SetMaxConcurrentBackgroundCompressionsForTesting(size_t max) {
+    max_concurrent_background_compressions_for_testing_ = max;
+  }
+
   static const char* kAllocatorDumpName;
   // Relies on secure hash equality for deduplication. If one day SHA256 becomes
   // insecure, then this would need to be updated to a more robust hash.
@@ -92,6 +123,11 @@ class PLATFORM_EXPORT ParkableStringManager {
   void OnReadFromDisk(ParkableStringImpl*);
   void OnUnparked(ParkableStringImpl*);
 
+  // Starts compressing |string| now if the budget allows it, later otherwise.
+  void ScheduleBackgroundCompression(ParkableStringImpl* string);
+  void OnBackgroundCompressionComplete();
+  void StartPendingBackgroundCompressions();
+
   void ParkAll(ParkableStringImpl::ParkingMode mode);
   void RecordStatisticsAfter5Minutes() const;
   void AgeStringsAndPark();
@@ -109,6 +145,15 @@ class PLATFORM_EXPORT ParkableStringManager {
   void RecordDiskReadTime(base::TimeDelta read_time) {
     total_disk_read_time_ += read_time;
   }
+  // |compressed_size| is 0 if compression failed.
+  void RecordCompression(ParkableStringImpl::CompressionAlgorithm,
+                         size_t original_size,
+                         size_t compressed_size,
+                         base::TimeDelta thread_time);
+  void RecordDecompression(ParkableStringImpl::CompressionAlgorithm,
+                           size_t size,
+                           base::TimeDelta time);
+  void DumpCodecStatistics(base::trace_event::ProcessMemoryDump* pmd) const;
 
   Statistics ComputeStatistics() const;
 
@@ -140,9 +185,21 @@ class PLATFORM_EXPORT ParkableStringManager {
   StringMap parked_strings_;
   StringMap on_disk_strings_;
 
+  size_t background_compressions_in_flight_;
+  size_t max_concurrent_background_compressions_for_testing_;
+  // Strings waiting for the compression budget, in parking order.
+  Deque<scoped_refptr<ParkableStringImpl>> pending_background_compressions_;
+
+  static constexpr size_t kNumCompressionAlgorithms =
+      static_cast<size_t>(
+          ParkableStringImpl::CompressionAlgorithm::kMaxValue) +
+      1;
+  CodecStatistics codec_statistics_[kNumCompressionAlgorithms];
+
   std::unique_ptr<DiskDataAllocator> allocator_for_testing_;
 
   friend class ParkableStringTest;
+  friend class ParkableStringPerfTest;
   FRIEND_TEST_ALL_PREFIXES(ParkableStringTest, SynchronousCompression);
   DISALLOW_COPY_AND_ASSIGN(ParkableStringManager);
 };
@@ -0,0 +1,152 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/test/scoped_feature_list.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/blink/renderer/platform/bindings/parkable_string.h"
+#include "third_party/blink/renderer/platform/bindings/parkable_string_manager.h"
+#include "third_party/blink/renderer/platform/disk_data_allocator_test_utils.h"
+#include "third_party/blink/renderer/platform/testing/unit_test_helpers.h"
+#include "third_party/blink/renderer/platform/wtf/shared_buffer.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+namespace {
+
+// Framework and library sources of various sizes and styles, minified or not.
+const char* const kCorpus[] = {
+    "todomvc/architecture-examples/angularjs/node_modules/angular/angular.js",
+    "todomvc/architecture-examples/jquery/node_modules/jquery/dist/jquery.js",
+    "todomvc/architecture-examples/jquery/node_modules/handlebars/dist/"
+    "handlebars.js",
+    "todomvc/architecture-examples/react/node_modules/react-dom/dist/"
+    "react-dom.min.js",
+    "todomvc/architecture-examples/vuejs-cli/dist/static/js/"
+    "vendor.e7008001a8bed009bbf1.js",
+    "todomvc/dependency-examples/flight/flight/node_modules/requirejs/"
+    "require.js",
+    "flightjs-example-app/components/bootstrap/js/bootstrap.js",
+};
+
+// Each file is loaded several times with a different prefix, so that the
+// strings are not deduplicated and the corpus resembles a page with 10+MB of
+// script.
+constexpr int kCopies = 8;
+
+constexpr char kMetricPrefix[] = "ParkableString.";
+constexpr char kMetricCompressionRatio[] = "compression_ratio";
+constexpr char kMetricParkingWallTime[] = "parking_wall_time";
+constexpr char kMetricCompressionThreadTime[] = "compression_thread_time";
+constexpr char kMetricUnparkingTime[] = "unparking_time";
+constexpr char kMetricUnparkingThroughput[] = "unparking_throughput";
+
+}  // namespace
+
+// Parks and unparks the corpus with every compression algorithm, with the
+// default compression budget and with a single compression at a time.
+class ParkableStringPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    auto& manager = ParkableStringManager::Instance();
+    manager.ResetForTesting();
+    manager.SetDataAllocatorForTesting(
+        std::make_unique<InMemoryDataAllocator>());
+
+    for (const char* path : kCorpus) {
+      Vector<char> data =
+          test::ReadFromFile(test::BlinkRootDir() +
+                             "/perf_tests/speedometer/resources/" + path)
+              ->CopyAs<Vector<char>>();
+      ASSERT_FALSE(data.IsEmpty()) << path;
+      sources_.push_back(String::FromUTF8(data.data(), data.size()));
+    }
+  }
+
+  void TearDown() override {
+    ParkableStringManager::Instance().ResetForTesting();
+  }
+
+  // |max_concurrent_compressions| is 0 for the default budget.
+  void ParkAndUnpark(ParkableStringImpl::CompressionAlgorithm algorithm,
+                     size_t max_concurrent_compressions) {
+    base::test::ScopedFeatureList features;
+    if (algorithm == ParkableStringImpl::CompressionAlgorithm::kSnappy)
+      features.InitAndEnableFeature(kCompressParkableStringsWithSnappy);
+    else
+      features.InitAndDisableFeature(kCompressParkableStringsWithSnappy);
+
+    auto& manager = ParkableStringManager::Instance();
+    manager.ResetForTesting();
+    manager.SetDataAllocatorForTesting(
+        std::make_unique<InMemoryDataAllocator>());
+    manager.SetMaxConcurrentBackgroundCompressionsForTesting(
+        max_concurrent_compressions);
+
+    Vector<ParkableString> strings;
+    size_t total_size = 0;
+    for (int copy = 0; copy < kCopies; ++copy) {
+      for (const String& source : sources_) {
+        String prefixed = String::Number(copy) + source;
+        strings.push_back(ParkableString(prefixed.ReleaseImpl()));
+        total_size += strings.back().CharactersSizeInBytes();
+      }
+    }
+
+    base::TimeTicks park_start = base::TimeTicks::Now();
+    manager.PurgeMemory();
+    task_environment_.RunUntilIdle();
+    base::TimeDelta park_time = base::TimeTicks::Now() - park_start;
+    for (const ParkableString& string : strings)
+      EXPECT_TRUE(string.Impl()->is_parked());
+
+    base::TimeTicks unpark_start = base::TimeTicks::Now();
+    for (const ParkableString& string : strings)
+      string.ToString();
+    base::TimeDelta unpark_time = base::TimeTicks::Now() - unpark_start;
+
+    const auto& stats = manager.codec_statistics(algorithm);
+    std::string story =
+        std::string(ParkableStringImpl::CompressionAlgorithmName(algorithm)) +
+        (max_concurrent_compressions == 1 ? "_single_compression"
+                                          : "_default_budget");
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricCompressionRatio, "%");
+    reporter.RegisterImportantMetric(kMetricParkingWallTime, "ms");
+    reporter.RegisterImportantMetric(kMetricCompressionThreadTime, "ms");
+    reporter.RegisterImportantMetric(kMetricUnparkingTime, "ms");
+    reporter.RegisterImportantMetric(kMetricUnparkingThroughput, "MB/s");
+    // Nothing is recorded if no string was compressed, e.g. if the corpus
+    // could not be read.
+    ASSERT_GT(stats.original_size, 0u);
+    reporter.AddResult(kMetricCompressionRatio,
+                       100.0 * stats.compressed_size / stats.original_size);
+    reporter.AddResult(kMetricParkingWallTime, park_time.InMillisecondsF());
+    reporter.AddResult(kMetricCompressionThreadTime,
+                       stats.compression_thread_time.InMillisecondsF());
+    reporter.AddResult(kMetricUnparkingTime, unpark_time.InMillisecondsF());
+    reporter.AddResult(kMetricUnparkingThroughput,
+                       total_size / unpark_time.InSecondsF() / 1e6);
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  Vector<String> sources_;
+};
+
+TEST_F(ParkableStringPerfTest, Zlib) {
+  ParkAndUnpark(ParkableStringImpl::CompressionAlgorithm::kZlib, 1);
+  ParkAndUnpark(ParkableStringImpl::CompressionAlgorithm::kZlib, 0);
+}
+
+TEST_F(ParkableStringPerfTest, Snappy) {
+  ParkAndUnpark(ParkableStringImpl::CompressionAlgorithm::kSnappy, 1);
+  ParkAndUnpark(ParkableStringImpl::CompressionAlgorithm::kSnappy, 0);
+}
+
+}  // namespace blink
@@ -121,6 +121,16 @@ class ParkableStringTest : public ::testing::Test {
     ParkableStringManager::Instance().SetDataAllocatorForTesting(nullptr);
   }
 
+  size_t BackgroundCompressionsInFlight() {
+    return ParkableStringManager::Instance()
+        .background_compressions_in_flight_;
+  }
+
+  size_t PendingBackgroundCompressions() {
+    return ParkableStringManager::Instance()
+        .pending_background_compressions_.size();
+  }
+
   base::test::TaskEnvironment task_environment_;
 };
 
@@ -1104,6 +1114,128 @@ TEST_F(ParkableStringTest, ReportTotalDiskTime) {
       1);
 }
 
+TEST_F(ParkableStringTest, SnappyCompression) {
+  String original = MakeLargeString();
+  ParkableString parkable(MakeLargeString().ReleaseImpl());
+  {
+    base::test::ScopedFeatureList features;
+    features.InitAndEnableFeature(kCompressParkableStringsWithSnappy);
+    EXPECT_TRUE(ParkAndWait(parkable));
+  }
+  EXPECT_TRUE(parkable.Impl()->is_parked());
+  EXPECT_LT(parkable.Impl()->compressed_size(),
+            parkable.CharactersSizeInBytes());
+
+  // The string is decompressed with the algorithm it was compressed with.
+  EXPECT_EQ(original, parkable.ToString());
+
+  auto& manager = ParkableStringManager::Instance();
+  const auto& snappy_stats = manager.codec_statistics(
+      ParkableStringImpl::CompressionAlgorithm::kSnappy);
+  EXPECT_EQ(1u, snappy_stats.compressions);
+  EXPECT_EQ(1u, snappy_stats.decompressions);
+  EXPECT_EQ(0u, manager
+                    .codec_statistics(
+                        ParkableStringImpl::CompressionAlgorithm::kZlib)
+                    .compressions);
+}
+
+TEST_F(ParkableStringTest, SnappyDontCompressRandomString) {
+  base::test::ScopedFeatureList features;
+  features.InitAndEnableFeature(kCompressParkableStringsWithSnappy);
+  Vector<unsigned char> data(kSizeKb * 1000);
+  base::RandBytes(data.data(), data.size());
+  ParkableString parkable(String(data.data(), data.size()).ReleaseImpl());
+
+  EXPECT_TRUE(ParkAndWait(parkable));
+  EXPECT_FALSE(parkable.Impl()->is_parked());
+  EXPECT_FALSE(parkable.Impl()->has_compressed_data());
+  EXPECT_EQ(1u, ParkableStringManager::Instance()
+                    .codec_statistics(
+                        ParkableStringImpl::CompressionAlgorithm::kSnappy)
+                    .failed_compressions);
+}
+
+TEST_F(ParkableStringTest, BackgroundCompressionBudget) {
+  ParkableStringManager::Instance()
+      .SetMaxConcurrentBackgroundCompressionsForTesting(1);
+  ParkableString parkable1(MakeLargeString('a').ReleaseImpl());
+  ParkableString parkable2(MakeLargeString('b').ReleaseImpl());
+  ParkableString parkable3(MakeLargeString('c').ReleaseImpl());
+
+  for (const auto* parkable : {&parkable1, &parkable2, &parkable3}) {
+    EXPECT_TRUE(
+        parkable->Impl()->Park(ParkableStringImpl::ParkingMode::kCompress));
+    // Waiting strings cannot be aged or parked again.
+    EXPECT_TRUE(parkable->Impl()->background_task_in_progress_for_testing());
+  }
+  EXPECT_EQ(1u, BackgroundCompressionsInFlight());
+  EXPECT_EQ(2u, PendingBackgroundCompressions());
+
+  RunPostedTasks();
+  EXPECT_EQ(0u, BackgroundCompressionsInFlight());
+  EXPECT_EQ(0u, PendingBackgroundCompressions());
+  EXPECT_TRUE(parkable1.Impl()->is_parked());
+  EXPECT_TRUE(parkable2.Impl()->is_parked());
+  EXPECT_TRUE(parkable3.Impl()->is_parked());
+}
+
+TEST_F(ParkableStringTest, AccessWhileWaitingForCompressionBudget) {
+  ParkableStringManager::Instance()
+      .SetMaxConcurrentBackgroundCompressionsForTesting(1);
+  ParkableString parkable1(MakeLargeString('a').ReleaseImpl());
+  ParkableString parkable2(MakeLargeString('b').ReleaseImpl());
+
+  EXPECT_TRUE(
+      parkable1.Impl()->Park(ParkableStringImpl::ParkingMode::kCompress));
+  EXPECT_TRUE(
+      parkable2.Impl()->Park(ParkableStringImpl::ParkingMode::kCompress));
+  EXPECT_EQ(1u, PendingBackgroundCompressions());
+
+  // The access makes the string young, it is not compressed anymore.
+  parkable2.ToString();
+  RunPostedTasks();
+  EXPECT_TRUE(parkable1.Impl()->is_parked());
+  EXPECT_FALSE(parkable2.Impl()->is_parked());
+  EXPECT_FALSE(parkable2.Impl()->has_compressed_data());
+  EXPECT_FALSE(parkable2.Impl()->background_task_in_progress_for_testing());
+  EXPECT_EQ(1u, ParkableStringManager::Instance()
+                    .codec_statistics(
+                        ParkableStringImpl::CompressionAlgorithm::kZlib)
+                    .compressions);
+}
+
+TEST_F(ParkableStringTest, ReportCodecStatistics) {
+  using base::trace_event::MemoryAllocatorDump;
+  using testing::ByRef;
+  using testing::Contains;
+  using testing::Eq;
+
+  ParkableString parkable(MakeLargeString().ReleaseImpl());
+  ParkAndWait(parkable);
+  parkable.ToString();
+
+  base::trace_event::MemoryDumpArgs args = {
+      base::trace_event::MemoryDumpLevelOfDetail::DETAILED};
+  base::trace_event::ProcessMemoryDump pmd(args);
+  ParkableStringManager::Instance().OnMemoryDump(&pmd);
+  EXPECT_EQ(nullptr, pmd.GetAllocatorDump("parkable_strings/codec/snappy"));
+  MemoryAllocatorDump* dump =
+      pmd.GetAllocatorDump("parkable_strings/codec/zlib");
+  ASSERT_NE(nullptr, dump);
+
+  MemoryAllocatorDump::Entry compressions("compressions", "objects", 1);
+  EXPECT_THAT(dump->entries(), Contains(Eq(ByRef(compressions))));
+  MemoryAllocatorDump::Entry original("compression_original_size", "bytes",
+                                      kSizeKb * 1000);
+  EXPECT_THAT(dump->entries(), Contains(Eq(ByRef(original))));
+  MemoryAllocatorDump::Entry output("compression_output_size", "bytes",
+                                    kCompressedSize);
+  EXPECT_THAT(dump->entries(), Contains(Eq(ByRef(output))));
+  MemoryAllocatorDump::Entry decompressions("decompressions", "objects", 1);
+  EXPECT_THAT(dump->entries(), Contains(Eq(ByRef(decompressions))));
+}
+
 class ParkableStringTestWithQueuedThreadPool : public ParkableStringTest {
  public:
   ParkableStringTestWithQueuedThreadPool()
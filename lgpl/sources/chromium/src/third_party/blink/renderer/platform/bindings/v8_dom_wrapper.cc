@@ -30,6 +30,7 @@
 
 #include "third_party/blink/renderer/platform/bindings/v8_dom_wrapper.h"
 
+#include "base/macros.h"
 #include "third_party/blink/renderer/platform/bindings/v8_binding.h"
 #include "third_party/blink/renderer/platform/bindings/v8_object_constructor.h"
 #include "third_party/blink/renderer/platform/bindings/v8_per_context_data.h"
@@ -70,6 +71,36 @@ v8::Local<v8::Object> V8DOMWrapper::CreateWrapper(
   return wrapper;
 }
 
+V8WrapperBatch::V8WrapperBatch(v8::Isolate* isolate,
+                               v8::Local<v8::Object> creation_context,
+                               const WrapperTypeInfo* type)
+    : isolate_(isolate),
+      creation_context_(creation_context),
+      scope_(creation_context, isolate, type),
+      per_context_data_(V8PerContextData::From(scope_.GetContext())) {}
+
+void V8WrapperBatch::Wrap(ScriptWrappable* object) {
+  DCHECK(!scope_.AccessCheckFailed());
+  if (!DOMDataStore::GetWrapper(object, isolate_).IsEmpty())
+    return;
+
+  const WrapperTypeInfo* type = object->GetWrapperTypeInfo();
+  v8::Local<v8::Object> wrapper;
+  if (per_context_data_) {
+    if (type != boilerplate_type_) {
+      boilerplate_ = per_context_data_->WrapperBoilerplate(type);
+      boilerplate_type_ = type;
+    }
+    wrapper = boilerplate_->Clone();
+  } else {
+    // The context is detached; let CreateWrapper() deal with it.
+    wrapper = V8DOMWrapper::CreateWrapper(isolate_, creation_context_, type);
+  }
+  // |object| had no wrapper above, so |wrapper| is the one associated.
+  ignore_result(
+      V8DOMWrapper::AssociateObjectWithWrapper(isolate_, object, type, wrapper));
+}
+
 bool V8DOMWrapper::IsWrapper(v8::Isolate* isolate, v8::Local<v8::Value> value) {
   if (value.IsEmpty() || !value->IsObject())
     return false;
@@ -45,6 +45,7 @@
 
 namespace blink {
 
+class V8PerContextData;
 struct WrapperTypeInfo;
 
 // Contains utility methods to create wrappers, associate ScriptWrappable
@@ -225,6 +226,38 @@ class V8WrapperInstantiationScope {
   bool access_check_failed_;
 };
 
+// Creates the wrappers of several objects that share a creation context, such
+// as the items of a node list, as ScriptWrappable::Wrap() does for each of
+// them. The creation context is entered and checked once for the whole batch,
+// and the wrapper boilerplate is looked up once per run of objects of the same
+// type rather than once per object.
+//
+// Must only be used for types that don't override ScriptWrappable::Wrap() or
+// ScriptWrappable::AssociateWithWrapper().
+class PLATFORM_EXPORT V8WrapperBatch {
+  STACK_ALLOCATED();
+
+ public:
+  // |type| is used to report a failed access check.
+  V8WrapperBatch(v8::Isolate*,
+                 v8::Local<v8::Object> creation_context,
+                 const WrapperTypeInfo* type);
+
+  bool AccessCheckFailed() const { return scope_.AccessCheckFailed(); }
+
+  // Creates a wrapper for |object| in the current world, unless it already has
+  // one.
+  void Wrap(ScriptWrappable* object);
+
+ private:
+  v8::Isolate* isolate_;
+  v8::Local<v8::Object> creation_context_;
+  V8WrapperInstantiationScope scope_;
+  V8PerContextData* per_context_data_;
+  const WrapperTypeInfo* boilerplate_type_ = nullptr;
+  v8::Local<v8::Object> boilerplate_;
+};
+
 }  // namespace blink
 
 #endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_BINDINGS_V8_DOM_WRAPPER_H_
@@ -82,7 +82,7 @@ V8PerContextData* V8PerContextData::From(v8::Local<v8::Context> context) {
   return ScriptState::From(context)->PerContextData();
 }
 
-v8::Local<v8::Object> V8PerContextData::CreateWrapperFromCacheSlowCase(
+v8::Local<v8::Object> V8PerContextData::CreateWrapperBoilerplate(
     const WrapperTypeInfo* type) {
   v8::Context::Scope scope(GetContext());
   v8::Local<v8::Function> interface_object = ConstructorForType(type);
@@ -91,7 +91,7 @@ v8::Local<v8::Object> V8PerContextData::CreateWrapperFromCacheSlowCase(
       V8ObjectConstructor::NewInstance(isolate_, interface_object)
           .ToLocalChecked();
   wrapper_boilerplates_.Set(type, instance_template);
-  return instance_template->Clone();
+  return instance_template;
 }
 
 v8::Local<v8::Function> V8PerContextData::ConstructorForTypeSlowCase(
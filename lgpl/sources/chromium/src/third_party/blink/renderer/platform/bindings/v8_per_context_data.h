@@ -72,9 +72,15 @@ class PLATFORM_EXPORT V8PerContextData final {
   // object, and then simply Clone that object each time we need a new one.
   // This is faster than going through the full object creation process.
   v8::Local<v8::Object> CreateWrapperFromCache(const WrapperTypeInfo* type) {
+    return WrapperBoilerplate(type)->Clone();
+  }
+
+  // Returns the boilerplate object that CreateWrapperFromCache() clones, so
+  // that callers creating many wrappers of the same type can look it up once.
+  v8::Local<v8::Object> WrapperBoilerplate(const WrapperTypeInfo* type) {
     v8::Local<v8::Object> boilerplate = wrapper_boilerplates_.Get(type);
-    return !boilerplate.IsEmpty() ? boilerplate->Clone()
-                                  : CreateWrapperFromCacheSlowCase(type);
+    return !boilerplate.IsEmpty() ? boilerplate
+                                  : CreateWrapperBoilerplate(type);
   }
 
   v8::Local<v8::Function> ConstructorForType(const WrapperTypeInfo* type) {
@@ -125,7 +131,7 @@ class PLATFORM_EXPORT V8PerContextData final {
   Data* GetData(const char* key);
 
  private:
-  v8::Local<v8::Object> CreateWrapperFromCacheSlowCase(const WrapperTypeInfo*);
+  v8::Local<v8::Object> CreateWrapperBoilerplate(const WrapperTypeInfo*);
   v8::Local<v8::Function> ConstructorForTypeSlowCase(const WrapperTypeInfo*);
 
   v8::Isolate* isolate_;
@@ -105,6 +105,17 @@ void DiskDataAllocator::ReleaseChunk(const Metadata& metadata) {
 std::unique_ptr<DiskDataAllocator::Metadata> DiskDataAllocator::Write(
     const void* data,
     size_t size) {
+  Vector<base::span<const char>> pieces;
+  pieces.push_back(
+      base::make_span(reinterpret_cast<const char*>(data), size));
+  return Write(pieces);
+}
+
+std::unique_ptr<DiskDataAllocator::Metadata> DiskDataAllocator::Write(
+    const Vector<base::span<const char>>& pieces) {
+  size_t size = 0;
+  for (const auto& piece : pieces)
+    size += piece.size();
   Metadata chosen_chunk = {0, 0};
 
   {
@@ -115,12 +126,20 @@ std::unique_ptr<DiskDataAllocator::Metadata> DiskDataAllocator::Write(
     chosen_chunk = FindChunk(size);
   }  // Don't hold the lock during the actual Write().
 
-  int size_int = static_cast<int>(size);
-  const char* data_char = reinterpret_cast<const char*>(data);
-  int written = DoWrite(chosen_chunk.start_offset(), data_char, size_int);
+  int64_t offset = chosen_chunk.start_offset();
+  bool failed = false;
+  for (const auto& piece : pieces) {
+    int size_int = static_cast<int>(piece.size());
+    int written = DoWrite(offset, piece.data(), size_int);
+    if (size_int != written) {
+      failed = true;
+      break;
+    }
+    offset += size_int;
+  }
 
   MutexLocker locker(mutex_);
-  if (size_int != written) {
+  if (failed) {
     // Assume that the error is not transient. This can happen if the disk is
     // full for instance, in which case it is likely better not to try writing
     // later.
@@ -137,8 +156,6 @@ std::unique_ptr<DiskDataAllocator::Metadata> DiskDataAllocator::Write(
 }
 
 void DiskDataAllocator::Read(const Metadata& metadata, void* data) {
-  DCHECK(IsMainThread());
-
   // Doesn't need locking as files support concurrent access, and we don't
   // update metadata.
   char* data_char = reinterpret_cast<char*>(data);
@@ -180,7 +197,7 @@ int DiskDataAllocator::DoWrite(int64_t offset, const char* data, int size) {
 }
 
 void DiskDataAllocator::DoRead(int64_t offset, char* data, int size) {
-  // This happens on the main thread, which is typically not allowed. This is
+  // This may happen on the main thread, which is typically not allowed. This is
   // fine as this is expected to happen rarely, and only be slow with memory
   // pressure, in which case writing to/reading from disk is better than
   // swapping out random parts of the memory. See crbug.com/1029320 for details.
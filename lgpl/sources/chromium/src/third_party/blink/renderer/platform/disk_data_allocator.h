@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 
+#include "base/containers/span.h"
 #include "base/files/file.h"
 #include "base/synchronization/lock.h"
 #include "mojo/public/cpp/bindings/receiver.h"
@@ -15,6 +16,7 @@
 #include "third_party/blink/renderer/platform/platform_export.h"
 #include "third_party/blink/renderer/platform/wtf/threading.h"
 #include "third_party/blink/renderer/platform/wtf/threading_primitives.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
 
 namespace blink {
 
@@ -26,8 +28,8 @@ namespace blink {
 // available.
 //
 // Threading:
-// - Reads must be done from the main thread
-// - Writes can be done from any thread.
+// - Reads and writes can be done from any thread. A read must not overlap with
+//   |Discard()| of the same data.
 // - public methods are thread-safe, and unless otherwise noted, can be called
 //   from any thread.
 class PLATFORM_EXPORT DiskDataAllocator : public mojom::blink::DiskAllocator {
@@ -60,9 +62,11 @@ class PLATFORM_EXPORT DiskDataAllocator : public mojom::blink::DiskAllocator {
   // Returns |nullptr| in case of error.
   // Note that this performs a blocking disk write.
   std::unique_ptr<Metadata> Write(const void* data, size_t size);
+  // Same as above, for data made of several pieces which are stored one after
+  // the other. Saves flattening them in memory first.
+  std::unique_ptr<Metadata> Write(const Vector<base::span<const char>>& pieces);
 
   // Reads data. A read failure is fatal.
-  // Must be called from the main thread.
   // Can be called at any time before |Discard()| destroys |metadata|.
   //
   // |data| must point to an area large enough to fit a |metadata.size|-ed
@@ -70,6 +70,25 @@ TEST_F(DiskDataAllocatorTest, ReadWrite) {
   EXPECT_EQ(0, memcmp(&read_data[0], random_data.c_str(), kSize));
 }
 
+TEST_F(DiskDataAllocatorTest, ReadWritePieces) {
+  InMemoryDataAllocator allocator;
+
+  constexpr size_t kSize = 1000;
+  std::string random_data = base::RandBytesAsString(kSize);
+  Vector<base::span<const char>> pieces;
+  pieces.push_back(base::make_span(random_data.c_str(), 300));
+  pieces.push_back(base::make_span(random_data.c_str() + 300, 0));
+  pieces.push_back(base::make_span(random_data.c_str() + 300, kSize - 300));
+  auto metadata = allocator.Write(pieces);
+  EXPECT_TRUE(metadata);
+  EXPECT_EQ(kSize, metadata->size());
+
+  auto read_data = std::vector<char>(kSize);
+  allocator.Read(*metadata, &read_data[0]);
+
+  EXPECT_EQ(0, memcmp(&read_data[0], random_data.c_str(), kSize));
+}
+
 TEST_F(DiskDataAllocatorTest, ReadWriteDiscardMultiple) {
   InMemoryDataAllocator allocator;
 
@@ -4,6 +4,7 @@
 
 #include "third_party/blink/renderer/platform/graphics/canvas_resource_dispatcher.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/debug/stack_trace.h"
@@ -30,7 +31,6 @@
 namespace blink {
 
 enum {
-  kMaxPendingCompositorFrames = 2,
   kMaxUnreclaimedPlaceholderFrames = 3,
 };
 
@@ -164,13 +164,21 @@ void CanvasResourceDispatcher::DispatchFrameSync(
     return;
   }
 
+  if (commit_start_time.is_null())
+    commit_start_time = base::TimeTicks::Now();
   pending_compositor_frames_++;
+  frame_pacing_statistics_.frames_submitted++;
   WTF::Vector<viz::ReturnedResource> resources;
   sink_->SubmitCompositorFrameSync(
       parent_local_surface_id_allocator_.GetCurrentLocalSurfaceIdAllocation()
           .local_surface_id(),
       std::move(frame), base::nullopt, 0, &resources);
-  DidReceiveCompositorFrameAck(resources);
+  // The return is the ack of this frame, not of the oldest frame submitted
+  // asynchronously, so it bypasses DidReceiveCompositorFrameAck().
+  ReclaimResources(resources);
+  pending_compositor_frames_--;
+  DCHECK_GE(pending_compositor_frames_, 0);
+  DidPresentCompositorFrame(commit_start_time);
 }
 
 void CanvasResourceDispatcher::DispatchFrame(
@@ -186,13 +194,44 @@ void CanvasResourceDispatcher::DispatchFrame(
     return;
   }
 
-  pending_compositor_frames_++;
+  DidSubmitCompositorFrame(commit_start_time);
   sink_->SubmitCompositorFrame(
       parent_local_surface_id_allocator_.GetCurrentLocalSurfaceIdAllocation()
           .local_surface_id(),
       std::move(frame), base::nullopt, 0);
 }
 
+void CanvasResourceDispatcher::DispatchOrDeferFrame(
+    scoped_refptr<CanvasResource> canvas_resource,
+    base::TimeTicks commit_start_time,
+    const SkIRect& damage_rect,
+    bool needs_vertical_flip,
+    bool is_opaque) {
+  SkIRect frame_damage_rect = damage_rect;
+  if (deferred_frame_) {
+    frame_damage_rect.join(deferred_frame_->damage_rect);
+    deferred_frame_.reset();
+    frame_pacing_statistics_.frames_dropped++;
+  }
+  if (HasTooManyPendingFrames()) {
+    deferred_frame_ =
+        DeferredFrame{std::move(canvas_resource), commit_start_time,
+                      frame_damage_rect, needs_vertical_flip, is_opaque};
+    return;
+  }
+  DispatchFrame(std::move(canvas_resource), commit_start_time,
+                frame_damage_rect, needs_vertical_flip, is_opaque);
+}
+
+void CanvasResourceDispatcher::MaybeDispatchDeferredFrame() {
+  if (!deferred_frame_ || HasTooManyPendingFrames())
+    return;
+  DeferredFrame frame = std::move(*deferred_frame_);
+  deferred_frame_.reset();
+  DispatchFrame(std::move(frame.canvas_resource), frame.commit_start_time,
+                frame.damage_rect, frame.needs_vertical_flip, frame.is_opaque);
+}
+
 bool CanvasResourceDispatcher::PrepareFrame(
     scoped_refptr<CanvasResource> canvas_resource,
     base::TimeTicks commit_start_time,
@@ -300,11 +339,36 @@ bool CanvasResourceDispatcher::PrepareFrame(
   return true;
 }
 
+void CanvasResourceDispatcher::DidSubmitCompositorFrame(
+    base::TimeTicks commit_start_time) {
+  pending_compositor_frames_++;
+  frame_pacing_statistics_.frames_submitted++;
+  pending_frame_commit_times_.push_back(
+      commit_start_time.is_null() ? base::TimeTicks::Now() : commit_start_time);
+}
+
 void CanvasResourceDispatcher::DidReceiveCompositorFrameAck(
     const WTF::Vector<viz::ReturnedResource>& resources) {
   ReclaimResources(resources);
   pending_compositor_frames_--;
   DCHECK_GE(pending_compositor_frames_, 0);
+
+  // Acks come back in submission order.
+  if (!pending_frame_commit_times_.IsEmpty()) {
+    DidPresentCompositorFrame(pending_frame_commit_times_.front());
+    pending_frame_commit_times_.pop_front();
+  }
+
+  MaybeDispatchDeferredFrame();
+}
+
+void CanvasResourceDispatcher::DidPresentCompositorFrame(
+    base::TimeTicks commit_start_time) {
+  base::TimeDelta latency = base::TimeTicks::Now() - commit_start_time;
+  frame_pacing_statistics_.frames_presented++;
+  frame_pacing_statistics_.total_latency += latency;
+  frame_pacing_statistics_.max_latency =
+      std::max(frame_pacing_statistics_.max_latency, latency);
 }
 
 void CanvasResourceDispatcher::SetNeedsBeginFrame(bool needs_begin_frame) {
@@ -329,7 +393,15 @@ void CanvasResourceDispatcher::SetNeedsBeginFrameInternal() {
 }
 
 bool CanvasResourceDispatcher::HasTooManyPendingFrames() const {
-  return pending_compositor_frames_ >= kMaxPendingCompositorFrames;
+  return pending_compositor_frames_ >= max_pending_compositor_frames_;
+}
+
+void CanvasResourceDispatcher::SetMaxPendingCompositorFrames(
+    int max_pending_frames) {
+  DCHECK_GE(max_pending_frames, 1);
+  DCHECK_LE(max_pending_frames, kMaxPendingCompositorFramesLimit);
+  max_pending_compositor_frames_ = max_pending_frames;
+  MaybeDispatchDeferredFrame();
 }
 
 void CanvasResourceDispatcher::OnBeginFrame(
@@ -339,6 +411,10 @@ void CanvasResourceDispatcher::OnBeginFrame(
   if (HasTooManyPendingFrames() ||
       (begin_frame_args.type == viz::BeginFrameArgs::MISSED &&
        base::TimeTicks::Now() > begin_frame_args.deadline)) {
+    // Only a BeginFrame the canvas asked for would have produced a frame.
+    // Worker animation frames are counted by DidDropFrameForBackPressure().
+    if (needs_begin_frame_)
+      frame_pacing_statistics_.frames_dropped++;
     sink_->DidNotProduceFrame(current_begin_frame_ack_);
     return;
   }
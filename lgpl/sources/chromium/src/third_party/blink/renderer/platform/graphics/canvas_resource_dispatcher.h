@@ -8,6 +8,8 @@
 #include <memory>
 
 #include "base/memory/read_only_shared_memory_region.h"
+#include "base/optional.h"
+#include "base/time/time.h"
 #include "components/viz/common/frame_sinks/begin_frame_args.h"
 #include "components/viz/common/resources/resource_id.h"
 #include "components/viz/common/surfaces/parent_local_surface_id_allocator.h"
@@ -17,6 +19,8 @@
 #include "third_party/blink/public/mojom/frame_sinks/embedded_frame_sink.mojom-blink.h"
 #include "third_party/blink/renderer/platform/geometry/int_size.h"
 #include "third_party/blink/renderer/platform/platform_export.h"
+#include "third_party/blink/renderer/platform/wtf/deque.h"
+#include "third_party/skia/include/core/SkRect.h"
 
 namespace blink {
 
@@ -41,6 +45,26 @@ class PLATFORM_EXPORT CanvasResourceDispatcher
     kInvalidPlaceholderCanvasId = -1,
   };
 
+  // Cumulative since the dispatcher was created.
+  struct FramePacingStatistics {
+    unsigned frames_submitted = 0;
+    // Frames acknowledged by the compositor.
+    unsigned frames_presented = 0;
+    // Frames which could not be produced. Two sources feed it, and a canvas is
+    // driven by one of them at a time:
+    // - BeginFrames requested through SetNeedsBeginFrame(), when the canvas
+    //   draws outside of a worker animation frame, skipped in OnBeginFrame()
+    //   for back-pressure or a missed deadline;
+    // - worker animation frames aborted for back-pressure, which come from
+    //   the worker's own BeginFrame source, see DidDropFrameForBackPressure().
+    // Also counts frames deferred by DispatchOrDeferFrame() and replaced by
+    // a later one before they could be dispatched.
+    unsigned frames_dropped = 0;
+    // From the start of the commit to the compositor frame ack.
+    base::TimeDelta total_latency;
+    base::TimeDelta max_latency;
+  };
+
   CanvasResourceDispatcher(CanvasResourceDispatcherClient*,
                            uint32_t client_id,
                            uint32_t sink_id,
@@ -57,6 +81,14 @@ class PLATFORM_EXPORT CanvasResourceDispatcher
                      const SkIRect& damage_rect,
                      bool needs_vertical_flip,
                      bool is_opaque);
+  // Like DispatchFrame(), but if HasTooManyPendingFrames(), keeps the frame
+  // until an ack makes room for it instead. A frame kept this way is replaced
+  // by the next one, which then also covers its damage.
+  void DispatchOrDeferFrame(scoped_refptr<CanvasResource>,
+                            base::TimeTicks commit_start_time,
+                            const SkIRect& damage_rect,
+                            bool needs_vertical_flip,
+                            bool is_opaque);
   void ReclaimResource(viz::ResourceId);
   void DispatchFrameSync(scoped_refptr<CanvasResource>,
                          base::TimeTicks commit_start_time,
@@ -67,6 +99,26 @@ class PLATFORM_EXPORT CanvasResourceDispatcher
     current_begin_frame_ack_ = viz::BeginFrameAck(args, true);
   }
   bool HasTooManyPendingFrames() const;
+  int PendingCompositorFrames() const { return pending_compositor_frames_; }
+
+  // Number of frames which may be in flight to the compositor before the
+  // producer is throttled. Double buffering by default.
+  static constexpr int kDefaultMaxPendingCompositorFrames = 2;
+  static constexpr int kMaxPendingCompositorFramesLimit = 4;
+  int MaxPendingCompositorFrames() const {
+    return max_pending_compositor_frames_;
+  }
+  void SetMaxPendingCompositorFrames(int max_pending_frames);
+
+  // Called when a worker animation frame is skipped because of
+  // HasTooManyPendingFrames(). Those never reach OnBeginFrame(), so they are
+  // not counted twice.
+  void DidDropFrameForBackPressure() {
+    frame_pacing_statistics_.frames_dropped++;
+  }
+  const FramePacingStatistics& frame_pacing_statistics() const {
+    return frame_pacing_statistics_;
+  }
 
   void Reshape(const IntSize&);
 
@@ -108,6 +160,26 @@ class PLATFORM_EXPORT CanvasResourceDispatcher
   bool suspend_animation_ = false;
   bool needs_begin_frame_ = false;
   int pending_compositor_frames_ = 0;
+  int max_pending_compositor_frames_ = kDefaultMaxPendingCompositorFrames;
+
+  // Commit start times of the frames submitted asynchronously and waiting for
+  // an ack, in submission order. Synchronous frames are acked on return.
+  Deque<base::TimeTicks> pending_frame_commit_times_;
+  FramePacingStatistics frame_pacing_statistics_;
+
+  struct DeferredFrame {
+    scoped_refptr<CanvasResource> canvas_resource;
+    base::TimeTicks commit_start_time;
+    SkIRect damage_rect;
+    bool needs_vertical_flip;
+    bool is_opaque;
+  };
+  // The frame kept by DispatchOrDeferFrame() until an ack makes room for it.
+  base::Optional<DeferredFrame> deferred_frame_;
+
+  void DidSubmitCompositorFrame(base::TimeTicks commit_start_time);
+  void DidPresentCompositorFrame(base::TimeTicks commit_start_time);
+  void MaybeDispatchDeferredFrame();
 
   void SetNeedsBeginFrameInternal();
 
@@ -64,6 +64,18 @@ class CanvasResourceDispatcherTest
                                false /* is-opaque */);
   }
 
+  void DispatchOrDeferOneFrame(const SkIRect& damage_rect) {
+    dispatcher_->DispatchOrDeferFrame(
+        resource_provider_->ProduceCanvasResource(), base::TimeTicks(),
+        damage_rect, false /* needs_vertical_flip */, false /* is-opaque */);
+  }
+
+  const SkIRect* GetDeferredFrameDamageRect() {
+    if (!dispatcher_->deferred_frame_)
+      return nullptr;
+    return &dispatcher_->deferred_frame_->damage_rect;
+  }
+
   unsigned GetNumUnreclaimedFramesPosted() {
     return dispatcher_->num_unreclaimed_frames_posted_;
   }
@@ -194,6 +206,74 @@ TEST_F(CanvasResourceDispatcherTest, PlaceholderBeingBlocked) {
   EXPECT_EQ(2u, GetNumUnreclaimedFramesPosted());
 }
 
+TEST_F(CanvasResourceDispatcherTest, MaxPendingFramesAndFramePacing) {
+  CreateCanvasResourceDispatcher();
+  EXPECT_CALL(*(Dispatcher()), PostImageToPlaceholder(_, _))
+      .Times(testing::AnyNumber());
+  EXPECT_EQ(CanvasResourceDispatcher::kDefaultMaxPendingCompositorFrames,
+            Dispatcher()->MaxPendingCompositorFrames());
+
+  // Triple buffering: the third frame in flight throttles the producer.
+  Dispatcher()->SetMaxPendingCompositorFrames(3);
+  DispatchOneFrame();
+  DispatchOneFrame();
+  EXPECT_FALSE(Dispatcher()->HasTooManyPendingFrames());
+  DispatchOneFrame();
+  EXPECT_TRUE(Dispatcher()->HasTooManyPendingFrames());
+  EXPECT_EQ(3, Dispatcher()->PendingCompositorFrames());
+  Dispatcher()->DidDropFrameForBackPressure();
+
+  // An ack relieves the back-pressure, and is accounted for in the latency.
+  Dispatcher()->DidReceiveCompositorFrameAck({});
+  EXPECT_FALSE(Dispatcher()->HasTooManyPendingFrames());
+  EXPECT_EQ(2, Dispatcher()->PendingCompositorFrames());
+
+  const CanvasResourceDispatcher::FramePacingStatistics& statistics =
+      Dispatcher()->frame_pacing_statistics();
+  EXPECT_EQ(3u, statistics.frames_submitted);
+  EXPECT_EQ(1u, statistics.frames_presented);
+  EXPECT_EQ(1u, statistics.frames_dropped);
+  EXPECT_GE(statistics.max_latency, base::TimeDelta());
+  EXPECT_EQ(statistics.total_latency, statistics.max_latency);
+
+  // Lowering the limit applies to the frames already in flight.
+  Dispatcher()->SetMaxPendingCompositorFrames(2);
+  EXPECT_TRUE(Dispatcher()->HasTooManyPendingFrames());
+}
+
+TEST_F(CanvasResourceDispatcherTest, DeferFrameWhileTooManyPendingFrames) {
+  CreateCanvasResourceDispatcher();
+  EXPECT_CALL(*(Dispatcher()), PostImageToPlaceholder(_, _))
+      .Times(testing::AnyNumber());
+  DispatchOneFrame();
+  DispatchOneFrame();
+  ASSERT_TRUE(Dispatcher()->HasTooManyPendingFrames());
+
+  // Frames committed at the limit wait, the last one replacing the others.
+  DispatchOrDeferOneFrame(SkIRect::MakeXYWH(0, 0, 1, 1));
+  DispatchOrDeferOneFrame(SkIRect::MakeXYWH(5, 5, 1, 1));
+  EXPECT_EQ(2, Dispatcher()->PendingCompositorFrames());
+  ASSERT_TRUE(GetDeferredFrameDamageRect());
+  EXPECT_EQ(SkIRect::MakeXYWH(0, 0, 6, 6), *GetDeferredFrameDamageRect());
+
+  // An ack dispatches the deferred frame, which keeps the limit.
+  Dispatcher()->DidReceiveCompositorFrameAck({});
+  EXPECT_FALSE(GetDeferredFrameDamageRect());
+  EXPECT_EQ(2, Dispatcher()->PendingCompositorFrames());
+
+  const CanvasResourceDispatcher::FramePacingStatistics& statistics =
+      Dispatcher()->frame_pacing_statistics();
+  EXPECT_EQ(3u, statistics.frames_submitted);
+  EXPECT_EQ(1u, statistics.frames_presented);
+  EXPECT_EQ(1u, statistics.frames_dropped);
+
+  // Without back-pressure, the frame is dispatched right away.
+  Dispatcher()->DidReceiveCompositorFrameAck({});
+  DispatchOrDeferOneFrame(SkIRect::MakeWH(1, 1));
+  EXPECT_FALSE(GetDeferredFrameDamageRect());
+  EXPECT_EQ(4u, statistics.frames_submitted);
+}
+
 TEST_P(CanvasResourceDispatcherTest, DispatchFrame) {
   ScopedTestingPlatformSupport<TestingPlatformSupport> platform;
   ::testing::InSequence s;
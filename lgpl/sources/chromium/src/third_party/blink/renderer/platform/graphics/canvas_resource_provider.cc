@@ -1251,7 +1251,7 @@ void CanvasResourceProvider::RecycleResource(
     scoped_refptr<CanvasResource> resource) {
   // We don't want to keep an arbitrary large number of canvases.
   if (canvas_resources_.size() >
-      static_cast<unsigned int>(kMaxRecycledCanvasResources))
+      static_cast<unsigned int>(max_recycled_canvas_resources_))
     return;
 
   // Need to check HasOneRef() because if there are outstanding references to
@@ -1268,6 +1268,16 @@ void CanvasResourceProvider::SetResourceRecyclingEnabled(bool value) {
     ClearRecycledResources();
 }
 
+void CanvasResourceProvider::SetMaxRecycledResources(
+    int max_recycled_resources) {
+  DCHECK_GE(max_recycled_resources, 1);
+  max_recycled_canvas_resources_ = max_recycled_resources;
+  if (canvas_resources_.size() >
+      static_cast<unsigned int>(max_recycled_canvas_resources_)) {
+    canvas_resources_.Shrink(max_recycled_canvas_resources_);
+  }
+}
+
 void CanvasResourceProvider::ClearRecycledResources() {
   canvas_resources_.clear();
 }
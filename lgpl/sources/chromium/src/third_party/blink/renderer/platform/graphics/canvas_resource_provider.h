@@ -166,6 +166,10 @@ class PLATFORM_EXPORT CanvasResourceProvider
 
   void RecycleResource(scoped_refptr<CanvasResource>);
   void SetResourceRecyclingEnabled(bool);
+  // Number of released resources kept for reuse. Producers which keep more
+  // frames in flight, e.g. a triple buffered OffscreenCanvas, need a larger
+  // pool to avoid reallocating a resource for every frame.
+  void SetMaxRecycledResources(int max_recycled_resources);
   void ClearRecycledResources();
   scoped_refptr<CanvasResource> NewOrRecycledResource();
 
@@ -297,8 +301,10 @@ class PLATFORM_EXPORT CanvasResourceProvider
   bool resource_recycling_enabled_ = true;
   bool is_single_buffered_ = false;
 
-  // The maximum number of in-flight resources waiting to be used for recycling.
+  // The default maximum number of in-flight resources waiting to be used for
+  // recycling.
   static constexpr int kMaxRecycledCanvasResources = 2;
+  int max_recycled_canvas_resources_ = kMaxRecycledCanvasResources;
   // The maximum number of draw ops executed on the canvas, after which the
   // underlying GrContext is flushed.
   static constexpr int kMaxDrawsBeforeContextFlush = 50;
@@ -166,6 +166,77 @@ ALWAYS_INLINE void PackOneRowOfRGBA8LittleToR8(const uint8_t*& source,
   pixels_per_row -= pixels_per_row_trunc;
 }
 
+// Premultiplies four RGBA8 pixels. The color components are truncated from
+// c * (a / 255.0f), which gives the same results as the scalar code.
+ALWAYS_INLINE __m128i PremultiplyFourPixelsOfRGBA8Little(__m128i rgba) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128 max_pixel_value = _mm_set1_ps(255.0f);
+  const __m128i alpha_mask = _mm_set1_epi32(0xff000000);
+
+  __m128i pixels01 = _mm_unpacklo_epi8(rgba, zero);
+  __m128i pixels23 = _mm_unpackhi_epi8(rgba, zero);
+  __m128 pixel[4] = {_mm_cvtepi32_ps(_mm_unpacklo_epi16(pixels01, zero)),
+                     _mm_cvtepi32_ps(_mm_unpackhi_epi16(pixels01, zero)),
+                     _mm_cvtepi32_ps(_mm_unpacklo_epi16(pixels23, zero)),
+                     _mm_cvtepi32_ps(_mm_unpackhi_epi16(pixels23, zero))};
+  __m128i premultiplied[4];
+  for (int i = 0; i < 4; ++i) {
+    __m128 alpha =
+        _mm_shuffle_ps(pixel[i], pixel[i], _MM_SHUFFLE(3, 3, 3, 3));
+    premultiplied[i] = _mm_cvttps_epi32(
+        _mm_mul_ps(pixel[i], _mm_div_ps(alpha, max_pixel_value)));
+  }
+  __m128i result = _mm_packus_epi16(
+      _mm_packs_epi32(premultiplied[0], premultiplied[1]),
+      _mm_packs_epi32(premultiplied[2], premultiplied[3]));
+  // Alpha itself is kept as is.
+  return _mm_or_si128(_mm_andnot_si128(alpha_mask, result),
+                      _mm_and_si128(rgba, alpha_mask));
+}
+
+ALWAYS_INLINE void PackOneRowOfRGBA8LittleToPremultipliedRGBA8(
+    const uint8_t*& source,
+    uint8_t*& destination,
+    unsigned& pixels_per_row) {
+  unsigned pixels_per_row_trunc = (pixels_per_row / 4) * 4;
+
+  for (unsigned i = 0; i < pixels_per_row_trunc; i += 4) {
+    __m128i rgba = _mm_loadu_si128((const __m128i*)(source));
+    _mm_storeu_si128((__m128i*)(destination),
+                     PremultiplyFourPixelsOfRGBA8Little(rgba));
+
+    source += 16;
+    destination += 16;
+  }
+
+  pixels_per_row -= pixels_per_row_trunc;
+}
+
+// Swizzles and premultiplies in a single pass, without the intermediate RGBA8
+// row.
+ALWAYS_INLINE void UnpackOneRowOfBGRA8LittleToPremultipliedRGBA8(
+    const uint8_t*& source,
+    uint8_t*& destination,
+    unsigned& pixels_per_row) {
+  __m128i br_mask = _mm_set1_epi32(0x00ff00ff);
+  __m128i ga_mask = _mm_set1_epi32(0xff00ff00);
+  unsigned pixels_per_row_trunc = (pixels_per_row / 4) * 4;
+
+  for (unsigned i = 0; i < pixels_per_row_trunc; i += 4) {
+    __m128i bgra = _mm_loadu_si128((const __m128i*)(source));
+    __m128i rgba = _mm_shufflehi_epi16(_mm_shufflelo_epi16(bgra, 0xB1), 0xB1);
+    rgba = _mm_or_si128(_mm_and_si128(rgba, br_mask),
+                        _mm_and_si128(bgra, ga_mask));
+    _mm_storeu_si128((__m128i*)(destination),
+                     PremultiplyFourPixelsOfRGBA8Little(rgba));
+
+    source += 16;
+    destination += 16;
+  }
+
+  pixels_per_row -= pixels_per_row_trunc;
+}
+
 // This function deliberately doesn't mutate the incoming source, destination,
 // or pixelsPerRow arguments, since it always handles the full row.
 ALWAYS_INLINE void PackOneRowOfRGBA8LittleToRGBA8(const uint8_t* source,
@@ -1516,6 +1516,10 @@ void Pack<WebGLImageConversion::kDataFormatRGBA8,
           uint8_t>(const uint8_t* source,
                    uint8_t* destination,
                    unsigned pixels_per_row) {
+#if defined(ARCH_CPU_X86_FAMILY)
+  simd::PackOneRowOfRGBA8LittleToPremultipliedRGBA8(source, destination,
+                                                    pixels_per_row);
+#endif
   for (unsigned i = 0; i < pixels_per_row; ++i) {
     float scale_factor = source[3] / 255.0f;
     uint8_t source_r =
@@ -2747,6 +2751,64 @@ void Pack<WebGLImageConversion::kDataFormatRG32F,
   }
 }
 
+// Conversions which unpack and pack a row in a single pass, without going
+// through the intermediate format. Only the combinations which are common on
+// texture uploads, e.g. premultiplying N32 video frames and ImageBitmaps, are
+// fused.
+template <int SrcFormat, int DstFormat, int alphaOp>
+struct HasFusedConversion {
+  STATIC_ONLY(HasFusedConversion);
+  static const bool value = false;
+};
+
+#if !defined(ARCH_CPU_BIG_ENDIAN)
+template <>
+struct HasFusedConversion<WebGLImageConversion::kDataFormatBGRA8,
+                          WebGLImageConversion::kDataFormatRGBA8,
+                          WebGLImageConversion::kAlphaDoPremultiply> {
+  STATIC_ONLY(HasFusedConversion);
+  static const bool value = true;
+};
+#endif
+
+template <int SrcFormat,
+          int DstFormat,
+          int alphaOp,
+          typename SourceType,
+          typename DstType>
+void UnpackAndPack(const SourceType*, DstType*, unsigned) {
+  NOTREACHED();
+}
+
+template <>
+void UnpackAndPack<WebGLImageConversion::kDataFormatBGRA8,
+                   WebGLImageConversion::kDataFormatRGBA8,
+                   WebGLImageConversion::kAlphaDoPremultiply,
+                   uint8_t,
+                   uint8_t>(const uint8_t* source,
+                            uint8_t* destination,
+                            unsigned pixels_per_row) {
+#if defined(ARCH_CPU_X86_FAMILY)
+  simd::UnpackOneRowOfBGRA8LittleToPremultipliedRGBA8(source, destination,
+                                                      pixels_per_row);
+#endif
+  for (unsigned i = 0; i < pixels_per_row; ++i) {
+    float scale_factor = source[3] / 255.0f;
+    uint8_t source_r =
+        static_cast<uint8_t>(static_cast<float>(source[2]) * scale_factor);
+    uint8_t source_g =
+        static_cast<uint8_t>(static_cast<float>(source[1]) * scale_factor);
+    uint8_t source_b =
+        static_cast<uint8_t>(static_cast<float>(source[0]) * scale_factor);
+    destination[0] = source_r;
+    destination[1] = source_g;
+    destination[2] = source_b;
+    destination[3] = source[3];
+    source += 4;
+    destination += 4;
+  }
+}
+
 bool HasAlpha(int format) {
   return format == WebGLImageConversion::kDataFormatA8 ||
          format == WebGLImageConversion::kDataFormatA16F ||
@@ -3444,6 +3506,8 @@ void FormatConverter::Convert() {
   const bool kTrivialPack = DstFormat == kIntermFormat &&
                             alphaOp == WebGLImageConversion::kAlphaDoNothing;
   DCHECK(!kTrivialUnpack || !kTrivialPack);
+  const bool kFusedConversion =
+      HasFusedConversion<SrcFormat, DstFormat, alphaOp>::value;
 
   const SrcType* src_row_start =
       static_cast<const SrcType*>(static_cast<const void*>(
@@ -3483,6 +3547,17 @@ void FormatConverter::Convert() {
       src_row_start += src_stride_in_elements *
                        (unpack_image_height_ - src_sub_rectangle_.Height());
     }
+  } else if (kFusedConversion) {
+    for (int d = 0; d < depth_; ++d) {
+      for (int i = 0; i < src_sub_rectangle_.Height(); ++i) {
+        UnpackAndPack<SrcFormat, DstFormat, alphaOp>(
+            src_row_start, dst_row_start, src_sub_rectangle_.Width());
+        src_row_start += src_stride_in_elements;
+        dst_row_start += dst_stride_in_elements;
+      }
+      src_row_start += src_stride_in_elements *
+                       (unpack_image_height_ - src_sub_rectangle_.Height());
+    }
   } else {
     for (int d = 0; d < depth_; ++d) {
       for (int i = 0; i < src_sub_rectangle_.Height(); ++i) {
@@ -6,6 +6,9 @@
 
 #include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/platform/geometry/int_rect.h"
+#include "third_party/blink/renderer/platform/geometry/int_size.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
 
 namespace blink {
 
@@ -170,4 +173,45 @@ TEST_F(WebGLImageConversionTest, ConvertRGBA8ToRGB565) {
             memcmp(expected_data, destination_data, sizeof(destination_data)));
 }
 
+// Premultiplies and flips an image whose width is not a multiple of the SIMD
+// width, and checks every pixel against the reference formula.
+TEST_F(WebGLImageConversionTest, ExtractImageDataPremultiplyAndFlipY) {
+  constexpr int kWidth = 7;
+  constexpr int kHeight = 3;
+  Vector<uint8_t> source_data;
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    source_data.push_back(i * 37);
+    source_data.push_back(255 - i * 11);
+    source_data.push_back(i * 53);
+    source_data.push_back(i * 13);
+  }
+
+  for (auto source_format : {WebGLImageConversion::kDataFormatRGBA8,
+                             WebGLImageConversion::kDataFormatBGRA8}) {
+    bool is_bgra = source_format == WebGLImageConversion::kDataFormatBGRA8;
+    Vector<uint8_t> data;
+    ASSERT_TRUE(WebGLImageConversion::ExtractImageData(
+        source_data.data(), source_format, IntSize(kWidth, kHeight),
+        IntRect(0, 0, kWidth, kHeight), 1, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+        true /* flip_y */, true /* premultiply_alpha */, data));
+    ASSERT_EQ(source_data.size(), data.size());
+
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        const uint8_t* source = &source_data[(y * kWidth + x) * 4];
+        const uint8_t* destination =
+            &data[((kHeight - 1 - y) * kWidth + x) * 4];
+        float scale_factor = source[3] / 255.0f;
+        uint8_t r = is_bgra ? source[2] : source[0];
+        uint8_t b = is_bgra ? source[0] : source[2];
+        EXPECT_EQ(static_cast<uint8_t>(r * scale_factor), destination[0]);
+        EXPECT_EQ(static_cast<uint8_t>(source[1] * scale_factor),
+                  destination[1]);
+        EXPECT_EQ(static_cast<uint8_t>(b * scale_factor), destination[2]);
+        EXPECT_EQ(source[3], destination[3]);
+      }
+    }
+  }
+}
+
 }  // namespace blink
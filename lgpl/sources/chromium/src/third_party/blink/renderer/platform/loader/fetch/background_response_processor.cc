@@ -0,0 +1,146 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/loader/fetch/background_response_processor.h"
+
+#include <algorithm>
+
+#include "base/containers/span.h"
+#include "base/memory/ptr_util.h"
+#include "base/task/thread_pool.h"
+#include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
+#include "third_party/blink/renderer/platform/wtf/functional.h"
+
+namespace blink {
+
+constexpr size_t BackgroundResponseProcessor::kMaxInitialBufferSize;
+
+// static
+void BackgroundResponseProcessor::Start(
+    mojo::ScopedDataPipeConsumerHandle body,
+    size_t expected_size,
+    const Vector<HashAlgorithm>& digest_algorithms,
+    scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner,
+    ResultCallback callback) {
+  // The processor is created here and handed over to the background sequence
+  // as a whole, since the data pipe handle can't be passed across threads on
+  // its own.
+  auto processor = base::WrapUnique(new BackgroundResponseProcessor(
+      std::move(body), expected_size, digest_algorithms,
+      std::move(reply_task_runner), std::move(callback)));
+  // The main thread is waiting for the result, hence USER_BLOCKING.
+  auto task_runner = base::ThreadPool::CreateSequencedTaskRunner(
+      {base::TaskPriority::USER_BLOCKING});
+  PostCrossThreadTask(
+      *task_runner, FROM_HERE,
+      CrossThreadBindOnce(
+          &BackgroundResponseProcessor::StartOnBackgroundSequence,
+          WTF::Passed(std::move(processor)), task_runner));
+}
+
+BackgroundResponseProcessor::BackgroundResponseProcessor(
+    mojo::ScopedDataPipeConsumerHandle body,
+    size_t expected_size,
+    const Vector<HashAlgorithm>& digest_algorithms,
+    scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner,
+    ResultCallback callback)
+    : body_(std::move(body)),
+      digest_algorithms_(digest_algorithms),
+      result_(std::make_unique<Result>()),
+      reply_task_runner_(std::move(reply_task_runner)),
+      callback_(std::move(callback)) {
+  initial_buffer_.ReserveInitialCapacity(static_cast<wtf_size_t>(
+      std::min(expected_size, kMaxInitialBufferSize)));
+}
+
+BackgroundResponseProcessor::~BackgroundResponseProcessor() = default;
+
+// static
+void BackgroundResponseProcessor::StartOnBackgroundSequence(
+    std::unique_ptr<BackgroundResponseProcessor> processor,
+    scoped_refptr<base::SequencedTaskRunner> task_runner) {
+  // Digestors are created here so that all the hashing state lives on the
+  // background sequence.
+  for (HashAlgorithm algorithm : processor->digest_algorithms_)
+    processor->digestors_.push_back(std::make_unique<Digestor>(algorithm));
+
+  // From here on |processor| owns itself and is deleted in Finish().
+  BackgroundResponseProcessor* self = processor.release();
+  self->watcher_ = std::make_unique<mojo::SimpleWatcher>(
+      FROM_HERE, mojo::SimpleWatcher::ArmingPolicy::AUTOMATIC,
+      std::move(task_runner));
+  MojoResult rv = self->watcher_->Watch(
+      self->body_.get(), MOJO_HANDLE_SIGNAL_READABLE,
+      MOJO_WATCH_CONDITION_SATISFIED,
+      WTF::BindRepeating(&BackgroundResponseProcessor::OnReadable,
+                         WTF::Unretained(self)));
+  if (rv != MOJO_RESULT_OK)
+    self->Finish(false);
+}
+
+void BackgroundResponseProcessor::OnReadable(
+    MojoResult result,
+    const mojo::HandleSignalsState& state) {
+  if (result == MOJO_RESULT_CANCELLED) {
+    Finish(false);
+    return;
+  }
+
+  while (true) {
+    const void* buffer = nullptr;
+    uint32_t available = 0;
+    MojoResult read_result =
+        body_->BeginReadData(&buffer, &available, MOJO_READ_DATA_FLAG_NONE);
+    if (read_result == MOJO_RESULT_SHOULD_WAIT)
+      return;
+    if (read_result == MOJO_RESULT_FAILED_PRECONDITION) {
+      // The producer closed the pipe: the whole body has been read.
+      Finish(true);
+      return;
+    }
+    if (read_result != MOJO_RESULT_OK) {
+      Finish(false);
+      return;
+    }
+
+    const char* data = static_cast<const char*>(buffer);
+    Append(data, available);
+    for (auto& digestor : digestors_) {
+      digestor->Update(
+          base::as_bytes(base::make_span(data, static_cast<size_t>(available))));
+    }
+    body_->EndReadData(available);
+  }
+}
+
+void BackgroundResponseProcessor::Append(const char* data, size_t length) {
+  if (!result_->body) {
+    if (length <= initial_buffer_.capacity() - initial_buffer_.size()) {
+      initial_buffer_.Append(data, static_cast<wtf_size_t>(length));
+      return;
+    }
+    result_->body = SharedBuffer::AdoptVector(initial_buffer_);
+  }
+  result_->body->Append(data, length);
+}
+
+void BackgroundResponseProcessor::Finish(bool succeeded) {
+  if (!result_->body)
+    result_->body = SharedBuffer::AdoptVector(initial_buffer_);
+  result_->succeeded = succeeded;
+  if (succeeded) {
+    for (wtf_size_t i = 0; i < digestors_.size(); ++i) {
+      DigestValue digest;
+      if (digestors_[i]->Finish(digest))
+        result_->digests.insert(digest_algorithms_[i], digest);
+    }
+  }
+  PostCrossThreadTask(
+      *reply_task_runner_, FROM_HERE,
+      CrossThreadBindOnce(std::move(callback_),
+                          WTF::Passed(std::move(result_))));
+  delete this;
+}
+
+}  // namespace blink
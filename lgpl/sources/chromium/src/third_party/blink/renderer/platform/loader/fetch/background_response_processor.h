@@ -0,0 +1,106 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_LOADER_FETCH_BACKGROUND_RESPONSE_PROCESSOR_H_
+#define THIRD_PARTY_BLINK_RENDERER_PLATFORM_LOADER_FETCH_BACKGROUND_RESPONSE_PROCESSOR_H_
+
+#include <memory>
+
+#include "base/memory/scoped_refptr.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
+#include "third_party/blink/renderer/platform/crypto.h"
+#include "third_party/blink/renderer/platform/loader/subresource_integrity.h"
+#include "third_party/blink/renderer/platform/platform_export.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
+#include "third_party/blink/renderer/platform/wtf/shared_buffer.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace base {
+class SequencedTaskRunner;
+class SingleThreadTaskRunner;
+}  // namespace base
+
+namespace blink {
+
+// Reads a whole response body from a data pipe on a thread pool sequence, so
+// that the loading thread doesn't see the body chunk by chunk. The body is
+// assembled into a SharedBuffer which the resource adopts without copying, and
+// the digests needed for the subresource integrity check are computed while
+// the bytes arrive.
+//
+// Instances are created by Start() and delete themselves on the background
+// sequence once the data pipe is closed.
+class PLATFORM_EXPORT BackgroundResponseProcessor final {
+  USING_FAST_MALLOC(BackgroundResponseProcessor);
+
+ public:
+  struct Result {
+    USING_FAST_MALLOC(Result);
+
+   public:
+    // Never null. Only this Result refers to it, so it can be handed over
+    // to the loading thread.
+    scoped_refptr<SharedBuffer> body;
+    SubresourceIntegrity::PrecomputedDigests digests;
+    // False if the body couldn't be read to the end. Note that the body may
+    // still be truncated if the network load fails; the loader learns about
+    // that separately.
+    bool succeeded = false;
+  };
+
+  using ResultCallback = CrossThreadOnceFunction<void(std::unique_ptr<Result>)>;
+
+  // Starts reading |body|. |expected_size| is only used to size the first
+  // part of the buffer up front and can be zero. |callback| is run on
+  // |reply_task_runner|.
+  static void Start(mojo::ScopedDataPipeConsumerHandle body,
+                    size_t expected_size,
+                    const Vector<HashAlgorithm>& digest_algorithms,
+                    scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner,
+                    ResultCallback callback);
+
+  ~BackgroundResponseProcessor();
+
+  // The first part of the body is read into a contiguous buffer of
+  // |expected_size|, but never more than this, whatever the response claims
+  // its length is. Anything beyond it is appended to the SharedBuffer in
+  // segments, so a large body is never copied into a bigger buffer.
+  static constexpr size_t kMaxInitialBufferSize = 16 * 1024 * 1024;
+
+ private:
+  BackgroundResponseProcessor(
+      mojo::ScopedDataPipeConsumerHandle body,
+      size_t expected_size,
+      const Vector<HashAlgorithm>& digest_algorithms,
+      scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner,
+      ResultCallback callback);
+
+  static void StartOnBackgroundSequence(
+      std::unique_ptr<BackgroundResponseProcessor> processor,
+      scoped_refptr<base::SequencedTaskRunner> task_runner);
+
+  void OnReadable(MojoResult, const mojo::HandleSignalsState&);
+  void Append(const char* data, size_t length);
+  // Replies to the loading thread and deletes |this|.
+  void Finish(bool succeeded);
+
+  mojo::ScopedDataPipeConsumerHandle body_;
+  std::unique_ptr<mojo::SimpleWatcher> watcher_;
+  Vector<HashAlgorithm> digest_algorithms_;
+  Vector<std::unique_ptr<Digestor>> digestors_;
+  // Receives the body until it would have to grow beyond its reserved
+  // capacity. It's then adopted by |result_->body|, which takes the rest.
+  Vector<char> initial_buffer_;
+  std::unique_ptr<Result> result_;
+  const scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner_;
+  ResultCallback callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundResponseProcessor);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_LOADER_FETCH_BACKGROUND_RESPONSE_PROCESSOR_H_
@@ -0,0 +1,137 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/loader/fetch/background_response_processor.h"
+
+#include <string>
+
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
+
+namespace blink {
+
+class BackgroundResponseProcessorTest : public testing::Test {
+ public:
+  using Result = BackgroundResponseProcessor::Result;
+
+  std::unique_ptr<Result> Process(mojo::ScopedDataPipeConsumerHandle body,
+                                  size_t expected_size,
+                                  const Vector<HashAlgorithm>& algorithms) {
+    base::RunLoop run_loop;
+    quit_closure_ = run_loop.QuitClosure();
+    BackgroundResponseProcessor::Start(
+        std::move(body), expected_size, algorithms,
+        base::ThreadTaskRunnerHandle::Get(),
+        CrossThreadBindOnce(&BackgroundResponseProcessorTest::DidProcess,
+                            CrossThreadUnretained(this)));
+    run_loop.Run();
+    return std::move(result_);
+  }
+
+ private:
+  void DidProcess(std::unique_ptr<Result> result) {
+    result_ = std::move(result);
+    std::move(quit_closure_).Run();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::OnceClosure quit_closure_;
+  std::unique_ptr<Result> result_;
+};
+
+namespace {
+
+mojo::ScopedDataPipeConsumerHandle CreateClosedPipe(const std::string& data) {
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  MojoCreateDataPipeOptions options{sizeof(MojoCreateDataPipeOptions),
+                                    MOJO_CREATE_DATA_PIPE_FLAG_NONE, 1,
+                                    static_cast<uint32_t>(data.size() + 1)};
+  EXPECT_EQ(MOJO_RESULT_OK,
+            mojo::CreateDataPipe(&options, &producer, &consumer));
+  if (!data.empty()) {
+    uint32_t size = data.size();
+    EXPECT_EQ(MOJO_RESULT_OK, producer->WriteData(data.c_str(), &size,
+                                                  MOJO_WRITE_DATA_FLAG_NONE));
+    EXPECT_EQ(data.size(), size);
+  }
+  return consumer;
+}
+
+std::string BodyAsString(const BackgroundResponseProcessor::Result& result) {
+  Vector<char> body = result.body->CopyAs<Vector<char>>();
+  return std::string(body.data(), body.size());
+}
+
+}  // namespace
+
+TEST_F(BackgroundResponseProcessorTest, ReadsWholeBody) {
+  const std::string kData = "console.log('hello from the background');";
+
+  auto result = Process(CreateClosedPipe(kData), kData.size(), {});
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->succeeded);
+  EXPECT_EQ(kData, BodyAsString(*result));
+  EXPECT_TRUE(result->digests.IsEmpty());
+}
+
+TEST_F(BackgroundResponseProcessorTest, ComputesDigests) {
+  const std::string kData = "body { color: green; }";
+
+  auto result = Process(CreateClosedPipe(kData), 0,
+                        {kHashAlgorithmSha256, kHashAlgorithmSha384});
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->succeeded);
+  EXPECT_EQ(2u, result->digests.size());
+
+  for (HashAlgorithm algorithm : {kHashAlgorithmSha256, kHashAlgorithmSha384}) {
+    DigestValue expected;
+    ASSERT_TRUE(ComputeDigest(algorithm, kData.c_str(), kData.size(), expected));
+    auto it = result->digests.find(algorithm);
+    ASSERT_NE(it, result->digests.end());
+    EXPECT_EQ(expected, it->value);
+  }
+}
+
+TEST_F(BackgroundResponseProcessorTest, EmptyBody) {
+  auto result = Process(CreateClosedPipe(std::string()), 0,
+                        {kHashAlgorithmSha256});
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->succeeded);
+  EXPECT_TRUE(result->body->IsEmpty());
+  EXPECT_EQ(1u, result->digests.size());
+}
+
+TEST_F(BackgroundResponseProcessorTest, ExpectedSizeIsOnlyAHint) {
+  const std::string kData = "short";
+
+  // A bogus content length must not truncate the body.
+  auto result = Process(CreateClosedPipe(kData), 1u << 30, {});
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->succeeded);
+  EXPECT_EQ(kData, BodyAsString(*result));
+}
+
+TEST_F(BackgroundResponseProcessorTest, BodyLargerThanExpected) {
+  // Several segments beyond the expected size.
+  std::string data(5 * SharedBuffer::kSegmentSize, 'a');
+  for (size_t i = 0; i < data.size(); i += 7)
+    data[i] = 'b';
+
+  auto result = Process(CreateClosedPipe(data), SharedBuffer::kSegmentSize,
+                        {kHashAlgorithmSha256});
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->succeeded);
+  EXPECT_EQ(data, BodyAsString(*result));
+
+  DigestValue expected;
+  ASSERT_TRUE(
+      ComputeDigest(kHashAlgorithmSha256, data.c_str(), data.size(), expected));
+  EXPECT_EQ(expected, result->digests.at(kHashAlgorithmSha256));
+}
+
+}  // namespace blink
@@ -26,10 +26,13 @@
 
 #include "base/auto_reset.h"
 #include "base/bind.h"
+#include "base/task/thread_pool.h"
 #include "third_party/blink/public/platform/platform.h"
+#include "third_party/blink/renderer/platform/disk_data_allocator.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_loading_log.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/weborigin/security_origin.h"
 #include "third_party/blink/renderer/platform/wtf/assertions.h"
 #include "third_party/blink/renderer/platform/wtf/math_extras.h"
@@ -37,6 +40,7 @@
 namespace blink {
 
 static Persistent<MemoryCache>* g_memory_cache;
+static DiskDataAllocator* g_disk_tier_allocator_for_testing;
 
 static const unsigned kCDefaultCacheCapacity = 8192 * 1024;
 static const base::TimeDelta kCMinDelayBeforeLiveDecodedPrune =
@@ -48,6 +52,12 @@ static const base::TimeDelta kCMaxPruneDeferralDelay =
 // again.
 static const float kCTargetPrunePercentage = .95f;
 
+// Smaller bodies are not worth a disk write and read.
+static const size_t kCDiskTierMinResourceSize = 256 * 1024;
+static const size_t kCDefaultDiskTierCapacity = 256 * 1024 * 1024;
+static const base::TimeDelta kCDefaultDelayBeforeMovingDataToDisk =
+    base::TimeDelta::FromSeconds(30);
+
 MemoryCache* GetMemoryCache() {
   DCHECK(WTF::IsMainThread());
   if (!g_memory_cache) {
@@ -85,7 +95,10 @@ MemoryCache::MemoryCache(
       capacity_(kCDefaultCacheCapacity),
       delay_before_live_decoded_prune_(kCMinDelayBeforeLiveDecodedPrune),
       size_(0),
-      task_runner_(std::move(task_runner)) {
+      task_runner_(std::move(task_runner)),
+      disk_tier_capacity_(kCDefaultDiskTierCapacity),
+      delay_before_moving_data_to_disk_(kCDefaultDelayBeforeMovingDataToDisk),
+      disk_tier_timer_(task_runner_, this, &MemoryCache::DiskTierTimerFired) {
   MemoryCacheDumpProvider::Instance()->SetMemoryCache(this);
   if (MemoryPressureListenerRegistry::IsLowEndDevice())
     MemoryPressureListenerRegistry::Instance().RegisterClient(this);
@@ -278,6 +291,8 @@ void MemoryCache::Update(Resource* resource, size_t old_size, size_t new_size) {
   ptrdiff_t delta = new_size - old_size;
   DCHECK(delta >= 0 || size_ >= static_cast<size_t>(-delta));
   size_ += delta;
+  if (resource->EncodedSize() >= kCDiskTierMinResourceSize)
+    ScheduleMovingDataToDisk();
 }
 
 void MemoryCache::RemoveURLFromCache(const KURL& url) {
@@ -393,6 +408,137 @@ void MemoryCache::PruneNow(PruneStrategy strategy) {
   prune_time_stamp_ = base::TimeTicks::Now();
 }
 
+void MemoryCache::ScheduleMovingDataToDisk() {
+  if (!RuntimeEnabledFeatures::MemoryCacheDiskTierEnabled() ||
+      disk_tier_timer_.IsActive()) {
+    return;
+  }
+  disk_tier_timer_.StartOneShot(delay_before_moving_data_to_disk_, FROM_HERE);
+}
+
+void MemoryCache::MoveIdleDataToDisk() {
+  DCHECK(WTF::IsMainThread());
+  if (!RuntimeEnabledFeatures::MemoryCacheDiskTierEnabled() ||
+      !DiskTierAllocator().may_write()) {
+    return;
+  }
+  TRACE_EVENT0("blink", "MemoryCache::MoveIdleDataToDisk");
+
+  size_t on_disk_size = GetDiskTierStatistics().on_disk_size;
+  bool has_recently_used_data = false;
+  const base::TimeTicks now = base::TimeTicks::Now();
+  for (const auto& resource_map_iter : resource_maps_) {
+    for (const auto& resource_iter : *resource_map_iter.value) {
+      Resource* resource = resource_iter.value->GetResource();
+      DCHECK(resource);
+      if (resource->EncodedSize() < kCDiskTierMinResourceSize ||
+          !resource->CanMoveDataToDisk()) {
+        continue;
+      }
+      if (now - resource->LastDataAccessTime() <
+          delay_before_moving_data_to_disk_) {
+        has_recently_used_data = true;
+        continue;
+      }
+      // An unchanged body already on disk is dropped from memory for free.
+      if (!resource->HasDataOnDisk()) {
+        if (on_disk_size + resource->EncodedSize() > disk_tier_capacity_)
+          continue;
+        on_disk_size += resource->EncodedSize();
+      }
+      resource->MoveDataToDisk(DiskTierTaskRunner(), task_runner_);
+    }
+  }
+  // No pass is scheduled for resources which did not fit, the next large
+  // resource added or read back schedules one.
+  if (has_recently_used_data)
+    ScheduleMovingDataToDisk();
+}
+
+MemoryCache::DiskTierStatistics MemoryCache::GetDiskTierStatistics() const {
+  DiskTierStatistics stats;
+  for (const auto& resource_map_iter : resource_maps_) {
+    for (const auto& resource_iter : *resource_map_iter.value) {
+      Resource* resource = resource_iter.value->GetResource();
+      DCHECK(resource);
+      if (resource->HasDataOnDisk()) {
+        stats.on_disk_count++;
+        stats.on_disk_size += resource->EncodedSize();
+      }
+      if (resource->IsDataOnDisk()) {
+        stats.dropped_from_memory_count++;
+        stats.dropped_from_memory_size += resource->EncodedSize();
+      }
+    }
+  }
+  stats.moved_to_disk_count = moved_to_disk_count_;
+  stats.moved_to_disk_size = moved_to_disk_size_;
+  stats.read_from_disk_count = read_from_disk_count_;
+  stats.read_from_disk_size = read_from_disk_size_;
+  return stats;
+}
+
+void MemoryCache::DidMoveDataToDisk(size_t size) {
+  moved_to_disk_count_++;
+  moved_to_disk_size_ += size;
+}
+
+void MemoryCache::DidReadDataFromDisk(size_t size) {
+  read_from_disk_count_++;
+  read_from_disk_size_ += size;
+  ScheduleMovingDataToDisk();
+}
+
+// static
+DiskDataAllocator& MemoryCache::DiskTierAllocator() {
+  if (g_disk_tier_allocator_for_testing)
+    return *g_disk_tier_allocator_for_testing;
+  return DiskDataAllocator::Instance();
+}
+
+// static
+void MemoryCache::SetDiskTierAllocatorForTesting(DiskDataAllocator* allocator) {
+  g_disk_tier_allocator_for_testing = allocator;
+}
+
+base::SequencedTaskRunner& MemoryCache::DiskTierTaskRunner() {
+  if (!disk_tier_task_runner_) {
+    disk_tier_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  }
+  return *disk_tier_task_runner_;
+}
+
+base::SequencedTaskRunner& MemoryCache::DiskTierReadTaskRunner() {
+  // Reads hold back clients, so they don't wait behind best-effort writes.
+  if (!disk_tier_read_task_runner_) {
+    disk_tier_read_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  }
+  return *disk_tier_read_task_runner_;
+}
+
+void MemoryCache::DumpDiskTier(WebProcessMemoryDump* memory_dump) const {
+  DiskTierStatistics stats = GetDiskTierStatistics();
+  // No "size" here, these bytes are not in memory.
+  WebMemoryAllocatorDump* dump =
+      memory_dump->CreateMemoryAllocatorDump("web_cache/Disk_tier");
+  dump->AddScalar("on_disk_size", "bytes", stats.on_disk_size);
+  dump->AddScalar("on_disk_count", "objects", stats.on_disk_count);
+  dump->AddScalar("dropped_from_memory_size", "bytes",
+                  stats.dropped_from_memory_size);
+  dump->AddScalar("dropped_from_memory_count", "objects",
+                  stats.dropped_from_memory_count);
+  dump->AddScalar("moved_to_disk_size", "bytes", stats.moved_to_disk_size);
+  dump->AddScalar("moved_to_disk_count", "objects", stats.moved_to_disk_count);
+  dump->AddScalar("read_from_disk_size", "bytes", stats.read_from_disk_size);
+  dump->AddScalar("read_from_disk_count", "objects",
+                  stats.read_from_disk_count);
+  dump->AddScalar("capacity", "bytes", disk_tier_capacity_);
+}
+
 void MemoryCache::UpdateFramePaintTimestamp() {
   last_frame_paint_time_stamp_ = base::TimeTicks::Now();
 }
@@ -435,6 +581,8 @@ bool MemoryCache::OnMemoryDump(WebMemoryDumpLevelOfDetail level_of_detail,
         memory_dump->CreateMemoryAllocatorDump("web_cache/Other_resources");
     dump8->AddScalar("size", "bytes",
                      stats.other.encoded_size + stats.other.overhead_size);
+    if (RuntimeEnabledFeatures::MemoryCacheDiskTierEnabled())
+      DumpDiskTier(memory_dump);
     return true;
   }
 
@@ -444,6 +592,8 @@ bool MemoryCache::OnMemoryDump(WebMemoryDumpLevelOfDetail level_of_detail,
       resource->OnMemoryDump(level_of_detail, memory_dump);
     }
   }
+  if (RuntimeEnabledFeatures::MemoryCacheDiskTierEnabled())
+    DumpDiskTier(memory_dump);
   return true;
 }
 
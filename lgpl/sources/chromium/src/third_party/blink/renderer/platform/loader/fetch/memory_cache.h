@@ -27,11 +27,13 @@
 #define THIRD_PARTY_BLINK_RENDERER_PLATFORM_LOADER_FETCH_MEMORY_CACHE_H_
 
 #include "base/macros.h"
+#include "base/sequenced_task_runner.h"
 #include "third_party/blink/renderer/platform/instrumentation/memory_pressure_listener.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/memory_cache_dump_provider.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource.h"
 #include "third_party/blink/renderer/platform/platform_export.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread.h"
+#include "third_party/blink/renderer/platform/timer.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
 #include "third_party/blink/renderer/platform/wtf/hash_map.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_hash.h"
@@ -40,6 +42,7 @@
 
 namespace blink {
 
+class DiskDataAllocator;
 class KURL;
 
 // Member<MemoryCacheEntry> + MemoryCacheEntry::clearResourceWeak() monitors
@@ -110,6 +113,24 @@ class PLATFORM_EXPORT MemoryCache final : public GarbageCollected<MemoryCache>,
     TypeStatistic other;
   };
 
+  struct DiskTierStatistics {
+    STACK_ALLOCATED();
+
+   public:
+    // Resources in the cache with a copy of their body on disk, and the size
+    // of these copies. Writes in flight are included.
+    size_t on_disk_count = 0;
+    size_t on_disk_size = 0;
+    // Resources in the cache whose body is only on disk.
+    size_t dropped_from_memory_count = 0;
+    size_t dropped_from_memory_size = 0;
+    // Totals since the cache was created.
+    size_t moved_to_disk_count = 0;
+    size_t moved_to_disk_size = 0;
+    size_t read_from_disk_count = 0;
+    size_t read_from_disk_size = 0;
+  };
+
   Resource* ResourceForURL(const KURL&) const;
   Resource* ResourceForURL(const KURL&, const String& cache_identifier) const;
   HeapVector<Member<Resource>> ResourcesForURL(const KURL&) const;
@@ -132,6 +153,41 @@ class PLATFORM_EXPORT MemoryCache final : public GarbageCollected<MemoryCache>,
     delay_before_live_decoded_prune_ = seconds;
   }
 
+  // Disk tier: with MemoryCacheDiskTier enabled, the bodies of large resources
+  // which were not used for |delay_before_moving_data_to_disk_| are moved to
+  // disk, up to |disk_tier_capacity_| bytes. See Resource::MoveDataToDisk().
+  void SetDiskTierCapacity(size_t total_bytes) {
+    disk_tier_capacity_ = total_bytes;
+  }
+  size_t DiskTierCapacity() const { return disk_tier_capacity_; }
+  void SetDelayBeforeMovingDataToDisk(base::TimeDelta delay) {
+    delay_before_moving_data_to_disk_ = delay;
+  }
+  // Moves the bodies of idle resources to disk, and schedules another pass if
+  // some resources are not idle yet.
+  void MoveIdleDataToDisk();
+  DiskTierStatistics GetDiskTierStatistics() const;
+
+  // Called by Resource.
+  void DidMoveDataToDisk(size_t size);
+  void DidReadDataFromDisk(size_t size);
+  // Bodies are read back on this task runner, and the replies are posted to
+  // DiskTierReplyTaskRunner().
+  base::SequencedTaskRunner& DiskTierReadTaskRunner();
+  scoped_refptr<base::SingleThreadTaskRunner> DiskTierReplyTaskRunner() const {
+    return task_runner_;
+  }
+
+  // Thread safe.
+  static DiskDataAllocator& DiskTierAllocator();
+  static void SetDiskTierAllocatorForTesting(DiskDataAllocator*);
+  // Used for both writes and reads.
+  void SetDiskTierTaskRunnerForTesting(
+      scoped_refptr<base::SequencedTaskRunner> task_runner) {
+    disk_tier_task_runner_ = task_runner;
+    disk_tier_read_task_runner_ = std::move(task_runner);
+  }
+
   void EvictResources();
 
   void Prune();
@@ -178,6 +234,11 @@ class PLATFORM_EXPORT MemoryCache final : public GarbageCollected<MemoryCache>,
   void PruneResources(PruneStrategy);
   void PruneNow(PruneStrategy);
 
+  void ScheduleMovingDataToDisk();
+  void DiskTierTimerFired(TimerBase*) { MoveIdleDataToDisk(); }
+  base::SequencedTaskRunner& DiskTierTaskRunner();
+  void DumpDiskTier(WebProcessMemoryDump*) const;
+
   bool in_prune_resources_;
   bool prune_pending_;
   base::TimeDelta max_prune_deferral_delay_;
@@ -194,6 +255,16 @@ class PLATFORM_EXPORT MemoryCache final : public GarbageCollected<MemoryCache>,
 
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
+  size_t disk_tier_capacity_;
+  base::TimeDelta delay_before_moving_data_to_disk_;
+  size_t moved_to_disk_count_ = 0;
+  size_t moved_to_disk_size_ = 0;
+  size_t read_from_disk_count_ = 0;
+  size_t read_from_disk_size_ = 0;
+  TaskRunnerTimer<MemoryCache> disk_tier_timer_;
+  scoped_refptr<base::SequencedTaskRunner> disk_tier_task_runner_;
+  scoped_refptr<base::SequencedTaskRunner> disk_tier_read_task_runner_;
+
   friend class MemoryCacheTest;
 
   DISALLOW_COPY_AND_ASSIGN(MemoryCache);
@@ -32,15 +32,18 @@
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/public/platform/platform.h"
+#include "third_party/blink/renderer/platform/disk_data_allocator_test_utils.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
 #include "third_party/blink/renderer/platform/loader/fetch/raw_resource.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_loader_options.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_request.h"
 #include "third_party/blink/renderer/platform/loader/testing/mock_fetch_context.h"
+#include "third_party/blink/renderer/platform/loader/testing/mock_resource.h"
 #include "third_party/blink/renderer/platform/loader/testing/mock_resource_client.h"
 #include "third_party/blink/renderer/platform/loader/testing/test_loader_factory.h"
 #include "third_party/blink/renderer/platform/loader/testing/test_resource_fetcher_properties.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 #include "third_party/blink/renderer/platform/testing/testing_platform_support_with_mock_scheduler.h"
 #include "third_party/blink/renderer/platform/testing/unit_test_helpers.h"
 #include "third_party/blink/renderer/platform/weborigin/kurl.h"
@@ -419,4 +422,201 @@ TEST_F(MemoryCacheTest, RemoveURLFromCache) {
   EXPECT_FALSE(GetMemoryCache()->Contains(resource2));
 }
 
+class MemoryCacheDiskTierTest : public MemoryCacheTest {
+ protected:
+  static constexpr size_t kLargeResourceSize = 300 * 1024;
+
+  void SetUp() override {
+    MemoryCacheTest::SetUp();
+    MemoryCache::SetDiskTierAllocatorForTesting(&allocator_);
+    GetMemoryCache()->SetDiskTierTaskRunnerForTesting(
+        platform_->test_task_runner());
+    GetMemoryCache()->SetDelayBeforeMovingDataToDisk(base::TimeDelta());
+  }
+
+  void TearDown() override {
+    platform_->RunUntilIdle();
+    GetMemoryCache()->EvictResources();
+    // Resources discard their copy on disk when they are destroyed.
+    ThreadState::Current()->CollectAllGarbageForTesting(
+        BlinkGC::kNoHeapPointersOnStack);
+    EXPECT_EQ(static_cast<size_t>(allocator_.disk_footprint()),
+              allocator_.free_chunks_size());
+    MemoryCache::SetDiskTierAllocatorForTesting(nullptr);
+    MemoryCacheTest::TearDown();
+  }
+
+  Resource* CreateCachedResource(const char* url, size_t size) {
+    Resource* resource = RawResource::CreateForTest(
+        KURL(url), SecurityOrigin::CreateUniqueOpaque(), ResourceType::kRaw);
+    Vector<char> body(SafeCast<wtf_size_t>(size));
+    for (wtf_size_t i = 0; i < body.size(); ++i)
+      body[i] = static_cast<char>(i * 7);
+    resource->AppendData(body.data(), body.size());
+    resource->FinishForTest();
+    GetMemoryCache()->Add(resource);
+    return resource;
+  }
+
+  static bool HasBody(const Resource* resource, size_t size) {
+    scoped_refptr<const SharedBuffer> buffer = resource->ResourceBuffer();
+    if (!buffer || buffer->size() != size)
+      return false;
+    Vector<char> body = buffer->CopyAs<Vector<char>>();
+    for (wtf_size_t i = 0; i < body.size(); ++i) {
+      if (body[i] != static_cast<char>(i * 7))
+        return false;
+    }
+    return true;
+  }
+
+  ScopedMemoryCacheDiskTierForTest disk_tier_{true};
+  InMemoryDataAllocator allocator_;
+};
+
+TEST_F(MemoryCacheDiskTierTest, MovesIdleDataToDisk) {
+  Persistent<Resource> resource =
+      CreateCachedResource("http://test/large", kLargeResourceSize);
+  EXPECT_FALSE(resource->HasDataOnDisk());
+
+  // Adding the resource scheduled a pass, which posted the write.
+  platform_->RunUntilIdle();
+  EXPECT_TRUE(resource->IsDataOnDisk());
+  EXPECT_EQ(0u, resource->EncodedSizeMemoryUsageForTesting());
+  EXPECT_EQ(kLargeResourceSize, resource->EncodedSize());
+
+  MemoryCache::DiskTierStatistics stats =
+      GetMemoryCache()->GetDiskTierStatistics();
+  EXPECT_EQ(1u, stats.on_disk_count);
+  EXPECT_EQ(kLargeResourceSize, stats.on_disk_size);
+  EXPECT_EQ(1u, stats.dropped_from_memory_count);
+  EXPECT_EQ(1u, stats.moved_to_disk_count);
+  EXPECT_EQ(0u, stats.read_from_disk_count);
+
+  // Asking for the body reads it back off the main thread.
+  GetMemoryCache()->SetDelayBeforeMovingDataToDisk(
+      base::TimeDelta::FromHours(1));
+  EXPECT_FALSE(resource->ResourceBuffer());
+  EXPECT_TRUE(resource->IsDataOnDisk());
+  platform_->RunUntilIdle();
+  EXPECT_TRUE(HasBody(resource, kLargeResourceSize));
+  EXPECT_FALSE(resource->IsDataOnDisk());
+  EXPECT_TRUE(resource->HasDataOnDisk());
+  EXPECT_EQ(kLargeResourceSize, resource->EncodedSizeMemoryUsageForTesting());
+  stats = GetMemoryCache()->GetDiskTierStatistics();
+  EXPECT_EQ(1u, stats.read_from_disk_count);
+  EXPECT_EQ(kLargeResourceSize, stats.read_from_disk_size);
+
+  // The copy on disk is still valid, no write is needed this time.
+  GetMemoryCache()->SetDelayBeforeMovingDataToDisk(base::TimeDelta());
+  GetMemoryCache()->MoveIdleDataToDisk();
+  EXPECT_TRUE(resource->IsDataOnDisk());
+  EXPECT_EQ(2u, GetMemoryCache()->GetDiskTierStatistics().moved_to_disk_count);
+}
+
+TEST_F(MemoryCacheDiskTierTest, ClientWaitsForDataOnDisk) {
+  const KURL url("http://test/large");
+  Persistent<MockResource> resource = MakeGarbageCollected<MockResource>(url);
+  ResourceResponse response(url);
+  response.SetHttpStatusCode(200);
+  resource->SetResponse(response);
+  Vector<char> body(kLargeResourceSize);
+  for (wtf_size_t i = 0; i < body.size(); ++i)
+    body[i] = static_cast<char>(i * 7);
+  resource->AppendData(body.data(), body.size());
+  resource->FinishForTest();
+  GetMemoryCache()->Add(resource);
+  platform_->RunUntilIdle();
+  ASSERT_TRUE(resource->IsDataOnDisk());
+  GetMemoryCache()->SetDelayBeforeMovingDataToDisk(
+      base::TimeDelta::FromHours(1));
+
+  Persistent<MockResourceClient> client =
+      MakeGarbageCollected<MockResourceClient>();
+  resource->AddClient(client, platform_->test_task_runner().get());
+  EXPECT_FALSE(client->NotifyFinishedCalled());
+
+  // The client is notified once the body is back in memory.
+  platform_->RunUntilIdle();
+  EXPECT_TRUE(client->NotifyFinishedCalled());
+  EXPECT_FALSE(resource->IsDataOnDisk());
+  EXPECT_TRUE(HasBody(resource, kLargeResourceSize));
+  resource->RemoveClient(client);
+}
+
+TEST_F(MemoryCacheDiskTierTest, KeepsDataOfSynchronousCacheHitTypes) {
+  Resource* script = RawResource::CreateForTest(
+      KURL("http://test/script"), SecurityOrigin::CreateUniqueOpaque(),
+      ResourceType::kScript);
+  Vector<char> body(kLargeResourceSize);
+  script->AppendData(body.data(), body.size());
+  script->FinishForTest();
+  GetMemoryCache()->Add(script);
+
+  platform_->RunUntilIdle();
+  EXPECT_FALSE(script->HasDataOnDisk());
+}
+
+TEST_F(MemoryCacheDiskTierTest, KeepsSmallAndRecentlyUsedData) {
+  GetMemoryCache()->SetDelayBeforeMovingDataToDisk(
+      base::TimeDelta::FromHours(1));
+  Persistent<Resource> small = CreateCachedResource("http://test/small", 1024);
+  Persistent<Resource> large =
+      CreateCachedResource("http://test/large", kLargeResourceSize);
+
+  GetMemoryCache()->MoveIdleDataToDisk();
+  platform_->RunUntilIdle();
+  EXPECT_FALSE(small->HasDataOnDisk());
+  EXPECT_FALSE(large->HasDataOnDisk());
+
+  GetMemoryCache()->SetDelayBeforeMovingDataToDisk(base::TimeDelta());
+  GetMemoryCache()->MoveIdleDataToDisk();
+  platform_->RunUntilIdle();
+  EXPECT_FALSE(small->HasDataOnDisk());
+  EXPECT_TRUE(large->IsDataOnDisk());
+}
+
+TEST_F(MemoryCacheDiskTierTest, KeepsDataUsedWhileWriting) {
+  GetMemoryCache()->SetDelayBeforeMovingDataToDisk(
+      base::TimeDelta::FromHours(1));
+  Persistent<Resource> resource =
+      CreateCachedResource("http://test/large", kLargeResourceSize);
+  GetMemoryCache()->SetDelayBeforeMovingDataToDisk(base::TimeDelta());
+
+  GetMemoryCache()->MoveIdleDataToDisk();
+  EXPECT_TRUE(resource->HasDataOnDisk());
+  EXPECT_TRUE(HasBody(resource, kLargeResourceSize));
+  platform_->RunUntilIdle();
+
+  EXPECT_TRUE(resource->HasDataOnDisk());
+  EXPECT_FALSE(resource->IsDataOnDisk());
+  EXPECT_EQ(0u, GetMemoryCache()->GetDiskTierStatistics().moved_to_disk_count);
+}
+
+TEST_F(MemoryCacheDiskTierTest, RespectsCapacity) {
+  GetMemoryCache()->SetDiskTierCapacity(kLargeResourceSize * 3 / 2);
+  Persistent<Resource> resource1 =
+      CreateCachedResource("http://test/large1", kLargeResourceSize);
+  Persistent<Resource> resource2 =
+      CreateCachedResource("http://test/large2", kLargeResourceSize);
+
+  platform_->RunUntilIdle();
+  EXPECT_NE(resource1->IsDataOnDisk(), resource2->IsDataOnDisk());
+  EXPECT_EQ(kLargeResourceSize,
+            GetMemoryCache()->GetDiskTierStatistics().on_disk_size);
+}
+
+TEST_F(MemoryCacheDiskTierTest, DiscardsStaleCopy) {
+  Persistent<Resource> resource =
+      CreateCachedResource("http://test/large", kLargeResourceSize);
+  platform_->RunUntilIdle();
+  ASSERT_TRUE(resource->IsDataOnDisk());
+
+  resource->SetResourceBuffer(SharedBuffer::Create("body", 4));
+  EXPECT_FALSE(resource->HasDataOnDisk());
+  EXPECT_EQ(static_cast<size_t>(allocator_.disk_footprint()),
+            allocator_.free_chunks_size());
+  EXPECT_EQ(4u, resource->ResourceBuffer()->size());
+}
+
 }  // namespace blink
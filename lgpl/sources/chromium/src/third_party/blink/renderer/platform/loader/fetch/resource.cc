@@ -53,8 +53,10 @@
 #include "third_party/blink/renderer/platform/loader/fetch/resource_load_timing.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_loader.h"
 #include "third_party/blink/renderer/platform/network/http_parsers.h"
+#include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread_scheduler.h"
 #include "third_party/blink/renderer/platform/weborigin/kurl.h"
+#include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
 #include "third_party/blink/renderer/platform/wtf/math_extras.h"
 #include "third_party/blink/renderer/platform/wtf/shared_buffer.h"
 #include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
@@ -171,6 +173,7 @@ Resource::Resource(const ResourceRequestHead& request,
 
 Resource::~Resource() {
   InstanceCounters::DecrementCounter(InstanceCounters::kResourceCounter);
+  DiscardDataOnDisk();
 }
 
 void Resource::Trace(Visitor* visitor) const {
@@ -221,9 +224,12 @@ void Resource::CheckResourceIntegrity() {
     data_length = Data()->size();
   }
 
-  if (SubresourceIntegrity::CheckSubresourceIntegrity(IntegrityMetadata(), data,
-                                                      data_length, Url(), *this,
-                                                      integrity_report_info_)) {
+  if (SubresourceIntegrity::CheckSubresourceIntegrity(
+          IntegrityMetadata(), data, data_length, Url(), *this,
+          integrity_report_info_,
+          precomputed_integrity_digests_.IsEmpty()
+              ? nullptr
+              : &precomputed_integrity_digests_)) {
     integrity_disposition_ = ResourceIntegrityDisposition::kPassed;
   } else {
     integrity_disposition_ = ResourceIntegrityDisposition::kFailed;
@@ -254,15 +260,45 @@ void Resource::AppendData(const char* data, size_t length) {
   DCHECK(!is_revalidating_);
   DCHECK(!ErrorOccurred());
   if (options_.data_buffering_policy == kBufferData) {
+    precomputed_integrity_digests_.clear();
+    // Only loaded bodies go to disk, and they are cleared before a reload.
+    DCHECK(!IsDataOnDisk());
+    if (data_ && disk_write_pending_) {
+      // The disk tier writer still reads |data_|, append to a copy instead.
+      Vector<char> copy = data_->CopyAs<Vector<char>>();
+      data_ = SharedBuffer::AdoptVector(copy);
+    }
+    DiscardDataOnDisk();
     if (data_)
       data_->Append(data, length);
     else
       data_ = SharedBuffer::Create(data, length);
+    last_data_access_time_ = base::TimeTicks::Now();
     SetEncodedSize(data_->size());
   }
   NotifyDataReceived(data, length);
 }
 
+void Resource::AppendBufferedBody(
+    scoped_refptr<SharedBuffer> body,
+    SubresourceIntegrity::PrecomputedDigests digests) {
+  TRACE_EVENT1("blink", "Resource::AppendBufferedBody", "length",
+               body->size());
+  DCHECK(!is_revalidating_);
+  DCHECK(!ErrorOccurred());
+  DCHECK_EQ(options_.data_buffering_policy, kBufferData);
+  DCHECK(!data_);
+  DiscardDataOnDisk();
+  data_ = std::move(body);
+  precomputed_integrity_digests_ = std::move(digests);
+  last_data_access_time_ = base::TimeTicks::Now();
+  SetEncodedSize(data_->size());
+  // Clients still get DataReceived() for each segment, but they are delivered
+  // in one go.
+  for (const auto& span : *data_)
+    NotifyDataReceived(span.data(), span.size());
+}
+
 void Resource::NotifyDataReceived(const char* data, size_t length) {
   ResourceClientWalker<ResourceClient> w(Clients());
   while (ResourceClient* c = w.Next())
@@ -273,15 +309,213 @@ void Resource::SetResourceBuffer(scoped_refptr<SharedBuffer> resource_buffer) {
   DCHECK(!is_revalidating_);
   DCHECK(!ErrorOccurred());
   DCHECK_EQ(options_.data_buffering_policy, kBufferData);
+  DiscardDataOnDisk();
   data_ = std::move(resource_buffer);
+  precomputed_integrity_digests_.clear();
+  last_data_access_time_ = base::TimeTicks::Now();
   SetEncodedSize(data_->size());
 }
 
+static bool NeedsSynchronousCacheHit(ResourceType type,
+                                     const ResourceLoaderOptions& options) {
+  // Synchronous requests must always succeed or fail synchronously.
+  if (options.synchronous_policy == kRequestSynchronously)
+    return true;
+  // Some resources types default to return data synchronously. For most of
+  // these, it's because there are web tests that expect data to return
+  // synchronously in case of cache hit. In the case of fonts, there was a
+  // performance regression.
+  // FIXME: Get to the point where we don't need to special-case sync/async
+  // behavior for different resource types.
+  if (type == ResourceType::kCSSStyleSheet)
+    return true;
+  if (type == ResourceType::kScript)
+    return true;
+  if (type == ResourceType::kFont)
+    return true;
+  return false;
+}
+
+SharedBuffer* Resource::Data() const {
+  if (IsDataOnDisk()) {
+    ReadDataFromDisk();
+    return nullptr;
+  }
+  if (data_)
+    last_data_access_time_ = base::TimeTicks::Now();
+  return data_.get();
+}
+
 void Resource::ClearData() {
+  DiscardDataOnDisk();
   data_ = nullptr;
+  precomputed_integrity_digests_.clear();
   encoded_size_memory_usage_ = 0;
 }
 
+bool Resource::CanMoveDataToDisk() const {
+  // Clients of these get the body synchronously, and there would be no time to
+  // read it back.
+  if (NeedsSynchronousCacheHit(GetType(), options_))
+    return false;
+  return data_ && !disk_write_pending_ &&
+         GetStatus() == ResourceStatus::kCached && !is_revalidating_ &&
+         options_.data_buffering_policy == kBufferData;
+}
+
+void Resource::MoveDataToDisk(
+    base::SequencedTaskRunner& writer_task_runner,
+    scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner) {
+  DCHECK(IsMainThread());
+  DCHECK(CanMoveDataToDisk());
+  if (on_disk_data_) {
+    // Written before and unchanged since then.
+    DropDataInMemory();
+    return;
+  }
+  TRACE_EVENT1("blink", "Resource::MoveDataToDisk", "size", data_->size());
+  // |data_| is not thread safe. The writer gets its segments, which are not
+  // modified while the write is pending, see AppendData().
+  auto data = std::make_unique<DataForDisk>();
+  data->buffer = data_;
+  for (const auto& span : *data_)
+    data->segments.push_back(span);
+  disk_write_pending_ = true;
+  PostCrossThreadTask(
+      writer_task_runner, FROM_HERE,
+      CrossThreadBindOnce(&Resource::WriteDataToDiskInBackground,
+                          WTF::Passed(std::move(data)),
+                          WrapCrossThreadWeakPersistent(this), data_version_,
+                          last_data_access_time_,
+                          std::move(reply_task_runner)));
+}
+
+// static
+void Resource::WriteDataToDiskInBackground(
+    std::unique_ptr<DataForDisk> data,
+    CrossThreadWeakPersistent<Resource> resource,
+    uint64_t data_version,
+    base::TimeTicks last_data_access_time,
+    scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner) {
+  std::unique_ptr<DiskDataAllocator::Metadata> metadata =
+      MemoryCache::DiskTierAllocator().Write(data->segments);
+  // |data| goes back to the main thread to be released there.
+  PostCrossThreadTask(
+      *reply_task_runner, FROM_HERE,
+      CrossThreadBindOnce(&Resource::DidWriteDataToDisk, std::move(resource),
+                          data_version, last_data_access_time,
+                          WTF::Passed(std::move(data)),
+                          WTF::Passed(std::move(metadata))));
+}
+
+// static
+void Resource::DidWriteDataToDisk(
+    CrossThreadWeakPersistent<Resource> weak_resource,
+    uint64_t data_version,
+    base::TimeTicks last_data_access_time,
+    std::unique_ptr<DataForDisk> data,
+    std::unique_ptr<DiskDataAllocator::Metadata> metadata) {
+  Resource* resource = weak_resource.Get();
+  if (!resource || resource->data_version_ != data_version) {
+    // The resource is gone, or its body changed while it was being written.
+    if (metadata)
+      MemoryCache::DiskTierAllocator().Discard(std::move(metadata));
+    return;
+  }
+  DCHECK(resource->disk_write_pending_);
+  DCHECK(!resource->on_disk_data_);
+  resource->disk_write_pending_ = false;
+  // Writing failed.
+  if (!metadata)
+    return;
+  resource->on_disk_data_ = std::move(metadata);
+  // Keep the body in memory if it was used while being written.
+  if (resource->data_ &&
+      resource->last_data_access_time_ == last_data_access_time) {
+    resource->DropDataInMemory();
+  }
+}
+
+void Resource::ReadDataFromDisk() const {
+  DCHECK(IsMainThread());
+  DCHECK(IsDataOnDisk());
+  if (disk_read_pending_)
+    return;
+  TRACE_EVENT1("blink", "Resource::ReadDataFromDisk", "size",
+               on_disk_data_->size());
+  disk_read_pending_ = true;
+  MemoryCache* memory_cache = GetMemoryCache();
+  PostCrossThreadTask(
+      memory_cache->DiskTierReadTaskRunner(), FROM_HERE,
+      CrossThreadBindOnce(&Resource::ReadDataFromDiskInBackground,
+                          WTF::Passed(std::move(on_disk_data_)),
+                          WrapCrossThreadWeakPersistent(
+                              const_cast<Resource*>(this)),
+                          data_version_,
+                          memory_cache->DiskTierReplyTaskRunner()));
+}
+
+// static
+void Resource::ReadDataFromDiskInBackground(
+    std::unique_ptr<DiskDataAllocator::Metadata> metadata,
+    CrossThreadWeakPersistent<Resource> resource,
+    uint64_t data_version,
+    scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner) {
+  auto data = std::make_unique<Vector<char>>();
+  data->Grow(SafeCast<wtf_size_t>(metadata->size()));
+  MemoryCache::DiskTierAllocator().Read(*metadata, data->data());
+  PostCrossThreadTask(
+      *reply_task_runner, FROM_HERE,
+      CrossThreadBindOnce(&Resource::DidReadDataFromDisk, std::move(resource),
+                          data_version, WTF::Passed(std::move(metadata)),
+                          WTF::Passed(std::move(data))));
+}
+
+// static
+void Resource::DidReadDataFromDisk(
+    CrossThreadWeakPersistent<Resource> weak_resource,
+    uint64_t data_version,
+    std::unique_ptr<DiskDataAllocator::Metadata> metadata,
+    std::unique_ptr<Vector<char>> data) {
+  Resource* resource = weak_resource.Get();
+  if (!resource || resource->data_version_ != data_version) {
+    // The resource is gone, or its body was replaced during the read.
+    MemoryCache::DiskTierAllocator().Discard(std::move(metadata));
+  } else {
+    DCHECK(resource->disk_read_pending_);
+    DCHECK(!resource->data_);
+    DCHECK(!resource->on_disk_data_);
+    resource->disk_read_pending_ = false;
+    resource->on_disk_data_ = std::move(metadata);
+    resource->data_ = SharedBuffer::AdoptVector(*data);
+    resource->encoded_size_memory_usage_ = resource->data_->size();
+    resource->last_data_access_time_ = base::TimeTicks::Now();
+    GetMemoryCache()->DidReadDataFromDisk(resource->data_->size());
+  }
+  // Clients added while the body was on disk were held back until now.
+  if (resource && !resource->clients_awaiting_callback_.IsEmpty())
+    resource->FinishPendingClients();
+}
+
+void Resource::DropDataInMemory() {
+  DCHECK(data_);
+  DCHECK(on_disk_data_);
+  size_t size = data_->size();
+  data_ = nullptr;
+  encoded_size_memory_usage_ = 0;
+  GetMemoryCache()->DidMoveDataToDisk(size);
+}
+
+void Resource::DiscardDataOnDisk() {
+  if (!HasDataOnDisk())
+    return;
+  ++data_version_;
+  disk_write_pending_ = false;
+  disk_read_pending_ = false;
+  if (on_disk_data_)
+    MemoryCache::DiskTierAllocator().Discard(std::move(on_disk_data_));
+}
+
 void Resource::TriggerNotificationForFinishObservers(
     base::SingleThreadTaskRunner* task_runner) {
   if (finish_observers_.IsEmpty())
@@ -305,26 +539,6 @@ void Resource::SetDataBufferingPolicy(
   SetEncodedSize(0);
 }
 
-static bool NeedsSynchronousCacheHit(ResourceType type,
-                                     const ResourceLoaderOptions& options) {
-  // Synchronous requests must always succeed or fail synchronously.
-  if (options.synchronous_policy == kRequestSynchronously)
-    return true;
-  // Some resources types default to return data synchronously. For most of
-  // these, it's because there are web tests that expect data to return
-  // synchronously in case of cache hit. In the case of fonts, there was a
-  // performance regression.
-  // FIXME: Get to the point where we don't need to special-case sync/async
-  // behavior for different resource types.
-  if (type == ResourceType::kCSSStyleSheet)
-    return true;
-  if (type == ResourceType::kScript)
-    return true;
-  if (type == ResourceType::kFont)
-    return true;
-  return false;
-}
-
 void Resource::FinishAsError(const ResourceError& error,
                              base::SingleThreadTaskRunner* task_runner) {
   error_ = error;
@@ -591,6 +805,10 @@ void Resource::WillAddClientOrObserver() {
   if (!HasClientsOrObservers()) {
     is_alive_ = true;
   }
+  // Clients are notified asynchronously, which gives time to read the body
+  // back. See FinishPendingClients().
+  if (IsDataOnDisk())
+    ReadDataFromDisk();
 }
 
 void Resource::AddClient(ResourceClient* client,
@@ -705,6 +923,11 @@ void Resource::SetEncodedSize(size_t encoded_size) {
 }
 
 void Resource::FinishPendingClients() {
+  // Clients wait while the body is read back from disk, DidReadDataFromDisk()
+  // calls this again.
+  if (IsDataOnDisk())
+    return;
+
   // We're going to notify clients one by one. It is simple if the client does
   // nothing. However there are a couple other things that can happen.
   //
@@ -897,8 +1120,11 @@ void Resource::OnMemoryDump(WebMemoryDumpLevelOfDetail level_of_detail,
   else
     dump->AddScalar("dead_size", "bytes", encoded_size_memory_usage_);
 
+  // Data() would start reading the body back from disk.
   if (data_)
-    GetSharedBufferMemoryDump(Data(), dump_name, memory_dump);
+    GetSharedBufferMemoryDump(data_.get(), dump_name, memory_dump);
+  if (on_disk_data_)
+    dump->AddScalar("on_disk_size", "bytes", on_disk_data_->size());
 
   if (level_of_detail == WebMemoryDumpLevelOfDetail::kDetailed) {
     String url_to_report = Url().GetString();
@@ -33,6 +33,8 @@
 #include "mojo/public/cpp/base/big_buffer.h"
 #include "third_party/blink/public/mojom/loader/code_cache.mojom-blink-forward.h"
 #include "third_party/blink/public/platform/scheduler/web_scoped_virtual_time_pauser.h"
+#include "third_party/blink/renderer/platform/disk_data_allocator.h"
+#include "third_party/blink/renderer/platform/heap/persistent.h"
 #include "third_party/blink/renderer/platform/instrumentation/memory_pressure_listener.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/web_process_memory_dump.h"
 #include "third_party/blink/renderer/platform/loader/fetch/integrity_metadata.h"
@@ -152,6 +154,13 @@ class PLATFORM_EXPORT Resource : public GarbageCollected<Resource>,
 
   virtual WTF::TextEncoding Encoding() const { return WTF::TextEncoding(); }
   virtual void AppendData(const char*, size_t);
+  // Called instead of AppendData() when the whole body was read off the
+  // loading thread. |body| is adopted as the resource buffer without copying.
+  // |digests| were computed from |body| while it was read, and save hashing it
+  // again in CheckResourceIntegrity(). They are dropped as soon as the buffer
+  // changes.
+  void AppendBufferedBody(scoped_refptr<SharedBuffer> body,
+                          SubresourceIntegrity::PrecomputedDigests digests);
   virtual void FinishAsError(const ResourceError&,
                              base::SingleThreadTaskRunner*);
 
@@ -247,10 +256,15 @@ class PLATFORM_EXPORT Resource : public GarbageCollected<Resource>,
   void FinishForTest() { Finish(base::TimeTicks(), nullptr); }
 
   virtual scoped_refptr<const SharedBuffer> ResourceBuffer() const {
-    return data_;
+    return Data();
   }
   void SetResourceBuffer(scoped_refptr<SharedBuffer>);
 
+  // Whether the body can be read and assembled on a background thread. Only
+  // resources which don't look at the body until it is complete should return
+  // true. See ResourceLoader::ShouldProcessResponseBodyInBackground().
+  virtual bool CanProcessResponseBodyInBackground() const { return false; }
+
   virtual bool WillFollowRedirect(const ResourceRequest&,
                                   const ResourceResponse&);
 
@@ -367,6 +381,25 @@ class PLATFORM_EXPORT Resource : public GarbageCollected<Resource>,
   // Used by the MemoryCache to reduce the memory consumption of the entry.
   void Prune();
 
+  // Used by the MemoryCache to move the buffered body of a large idle resource
+  // to disk. It is read back off the main thread when a client is added, and
+  // the client is only notified once the body is back in memory. The copy on
+  // disk is kept until the body changes, so that moving an unchanged body to
+  // disk again only drops it from memory.
+  bool CanMoveDataToDisk() const;
+  void MoveDataToDisk(base::SequencedTaskRunner& writer_task_runner,
+                      scoped_refptr<base::SingleThreadTaskRunner>);
+  // Whether the body is only on disk, or being read back.
+  bool IsDataOnDisk() const {
+    return !data_ && (on_disk_data_ || disk_read_pending_);
+  }
+  // Whether there is a copy of the body on disk, or one is being written or
+  // read.
+  bool HasDataOnDisk() const {
+    return on_disk_data_ || disk_write_pending_ || disk_read_pending_;
+  }
+  base::TimeTicks LastDataAccessTime() const { return last_data_access_time_; }
+
   virtual void OnMemoryDump(WebMemoryDumpLevelOfDetail,
                             WebProcessMemoryDump*) const;
 
@@ -466,7 +499,8 @@ class PLATFORM_EXPORT Resource : public GarbageCollected<Resource>,
   void SetPreviewsState(WebURLRequest::PreviewsState);
   void ClearRangeRequestHeader();
 
-  SharedBuffer* Data() const { return data_.get(); }
+  // Returns null while the body is on disk, and starts reading it back.
+  SharedBuffer* Data() const;
   void ClearData();
 
   virtual void SetEncoding(const String&) {}
@@ -497,6 +531,41 @@ class PLATFORM_EXPORT Resource : public GarbageCollected<Resource>,
   void CheckResourceIntegrity();
   void TriggerNotificationForFinishObservers(base::SingleThreadTaskRunner*);
 
+  // A body on its way to disk. |buffer| keeps |segments| alive while the
+  // writer reads them, and is only referenced and released on the main thread.
+  struct DataForDisk {
+    USING_FAST_MALLOC(DataForDisk);
+
+   public:
+    scoped_refptr<const SharedBuffer> buffer;
+    Vector<base::span<const char>> segments;
+  };
+
+  static void WriteDataToDiskInBackground(
+      std::unique_ptr<DataForDisk>,
+      CrossThreadWeakPersistent<Resource>,
+      uint64_t data_version,
+      base::TimeTicks last_data_access_time,
+      scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner);
+  static void DidWriteDataToDisk(
+      CrossThreadWeakPersistent<Resource>,
+      uint64_t data_version,
+      base::TimeTicks last_data_access_time,
+      std::unique_ptr<DataForDisk>,
+      std::unique_ptr<DiskDataAllocator::Metadata>);
+  void ReadDataFromDisk() const;
+  static void ReadDataFromDiskInBackground(
+      std::unique_ptr<DiskDataAllocator::Metadata>,
+      CrossThreadWeakPersistent<Resource>,
+      uint64_t data_version,
+      scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner);
+  static void DidReadDataFromDisk(CrossThreadWeakPersistent<Resource>,
+                                  uint64_t data_version,
+                                  std::unique_ptr<DiskDataAllocator::Metadata>,
+                                  std::unique_ptr<Vector<char>>);
+  void DropDataInMemory();
+  void DiscardDataOnDisk();
+
   ResourceType type_;
   ResourceStatus status_;
 
@@ -507,7 +576,7 @@ class PLATFORM_EXPORT Resource : public GarbageCollected<Resource>,
   base::TimeTicks load_response_end_;
 
   size_t encoded_size_;
-  size_t encoded_size_memory_usage_;
+  mutable size_t encoded_size_memory_usage_;
   size_t decoded_size_;
 
   String cache_identifier_;
@@ -522,6 +591,10 @@ class PLATFORM_EXPORT Resource : public GarbageCollected<Resource>,
 
   ResourceIntegrityDisposition integrity_disposition_;
   SubresourceIntegrity::ReportInfo integrity_report_info_;
+  // Digests of |data_| passed to AppendBufferedBody(). Cleared whenever
+  // |data_| is replaced, appended to or cleared, so that they never describe
+  // another body.
+  SubresourceIntegrity::PrecomputedDigests precomputed_integrity_digests_;
 
   // Ordered list of all redirects followed while fetching this resource.
   Vector<RedirectPair> redirect_chain_;
@@ -548,7 +621,17 @@ class PLATFORM_EXPORT Resource : public GarbageCollected<Resource>,
   Member<ResourceLoader> loader_;
   ResourceResponse response_;
 
-  scoped_refptr<SharedBuffer> data_;
+  mutable scoped_refptr<SharedBuffer> data_;
+
+  // Copy of |data_| on disk, see MoveDataToDisk(). The reader owns it while
+  // |disk_read_pending_|, so that it can't be discarded during the read.
+  mutable std::unique_ptr<DiskDataAllocator::Metadata> on_disk_data_;
+  bool disk_write_pending_ = false;
+  mutable bool disk_read_pending_ = false;
+  // Incremented when the copy on disk becomes stale, so that writes which
+  // were in flight at that time are dropped.
+  uint64_t data_version_ = 0;
+  mutable base::TimeTicks last_data_access_time_;
 
   WebScopedVirtualTimePauser virtual_time_pauser_;
 
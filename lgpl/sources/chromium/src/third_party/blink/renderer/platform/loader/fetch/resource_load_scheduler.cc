@@ -13,9 +13,11 @@
 #include "base/numerics/safe_conversions.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/time/default_clock.h"
+#include "base/time/default_tick_clock.h"
 #include "third_party/blink/public/mojom/devtools/console_message.mojom-blink.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/platform/instrumentation/histogram.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/loader/fetch/console_logger.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher_properties.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
@@ -73,6 +75,7 @@ uint32_t GetFieldTrialUint32Param(const char* trial_name,
 
 constexpr ResourceLoadScheduler::ClientId
     ResourceLoadScheduler::kInvalidClientId;
+constexpr size_t ResourceLoadScheduler::kOutstandingLimitPerHost;
 
 ResourceLoadScheduler::ResourceLoadScheduler(
     ThrottlingPolicy initial_throttling_policy,
@@ -86,6 +89,7 @@ ResourceLoadScheduler::ResourceLoadScheduler(
           resource_fetcher_properties_->GetOutstandingThrottledLimit()),
       console_logger_(console_logger),
       clock_(base::DefaultClock::GetInstance()),
+      tick_clock_(base::DefaultTickClock::GetInstance()),
       throttle_option_override_(throttle_option_override) {
   if (!frame_or_worker_scheduler)
     return;
@@ -136,6 +140,15 @@ void ResourceLoadScheduler::Request(ResourceLoadSchedulerClient* client,
                                     ResourceLoadPriority priority,
                                     int intra_priority,
                                     ResourceLoadScheduler::ClientId* id) {
+  Request(client, option, priority, intra_priority, String(), id);
+}
+
+void ResourceLoadScheduler::Request(ResourceLoadSchedulerClient* client,
+                                    ThrottleOption option,
+                                    ResourceLoadPriority priority,
+                                    int intra_priority,
+                                    const String& host,
+                                    ResourceLoadScheduler::ClientId* id) {
   *id = GenerateClientId();
   if (is_shutdown_)
     return;
@@ -149,7 +162,7 @@ void ResourceLoadScheduler::Request(ResourceLoadSchedulerClient* client,
   // Check if the request can be throttled.
   ClientIdWithPriority request_info(*id, priority, intra_priority);
   if (!IsClientDelayable(option)) {
-    Run(*id, client, false);
+    Run(*id, client, false, priority, host);
     return;
   }
 
@@ -160,7 +173,7 @@ void ResourceLoadScheduler::Request(ResourceLoadSchedulerClient* client,
   pending_requests_[option].insert(request_info);
   pending_request_map_.insert(
       *id, MakeGarbageCollected<ClientInfo>(client, option, priority,
-                                            intra_priority));
+                                            intra_priority, host));
 
   // Remember the ClientId since MaybeRun() below may destruct the caller
   // instance and |id| may be inaccessible after the call.
@@ -197,8 +210,23 @@ bool ResourceLoadScheduler::Release(
   if (id == kInvalidClientId)
     return false;
 
-  if (running_requests_.Contains(id)) {
-    running_requests_.erase(id);
+  auto running = running_requests_.find(id);
+  if (running != running_requests_.end()) {
+    if (hints.IsValid()) {
+      throughput_estimator_.AddSample(
+          tick_clock_->NowTicks() - running->value.start_time,
+          hints.encoded_data_length(), running_requests_.size());
+      TRACE_COUNTER_ID1(
+          "blink", "ResourceLoadScheduler::AdaptiveOutstandingLimit", this,
+          throughput_estimator_.OutstandingLimit(normal_outstanding_limit_));
+    }
+    if (!running->value.host.IsEmpty()) {
+      auto per_host = running_requests_per_host_.find(running->value.host);
+      DCHECK(per_host != running_requests_per_host_.end());
+      if (--per_host->value == 0)
+        running_requests_per_host_.erase(per_host);
+    }
+    running_requests_.erase(running);
     running_throttleable_requests_.erase(id);
 
     if (option == ReleaseOption::kReleaseAndSchedule)
@@ -273,24 +301,48 @@ bool ResourceLoadScheduler::IsPendingRequestEffectivelyEmpty(
   return true;
 }
 
+ResourceLoadScheduler::PendingQueue::iterator
+ResourceLoadScheduler::FindRunnableRequest(ThrottleOption option) {
+  PendingQueue& queue = pending_requests_[option];
+  if (queue.empty() || !IsClientDelayable(option))
+    return queue.begin();
+
+  for (auto it = queue.begin(); it != queue.end(); ++it) {
+    // The queue is sorted by priority, and lower priorities never have a
+    // higher limit.
+    if (running_throttleable_requests_.size() >=
+        GetOutstandingLimit(it->priority)) {
+      return queue.end();
+    }
+    if (option != ThrottleOption::kThrottleable ||
+        !IsLowPriorityForAdaptiveScheduling(it->priority)) {
+      return it;
+    }
+    auto found = pending_request_map_.find(it->client_id);
+    // Released requests are picked so that MaybeRun() drops them.
+    if (found == pending_request_map_.end() || found->value->host.IsEmpty())
+      return it;
+    auto per_host = running_requests_per_host_.find(found->value->host);
+    if (per_host == running_requests_per_host_.end() ||
+        per_host->value < kOutstandingLimitPerHost) {
+      return it;
+    }
+    // The host is busy. Look for a request to another host.
+  }
+  return queue.end();
+}
+
 bool ResourceLoadScheduler::GetNextPendingRequest(ClientId* id) {
   auto& stoppable_queue = pending_requests_[ThrottleOption::kStoppable];
   auto& throttleable_queue = pending_requests_[ThrottleOption::kThrottleable];
 
   // Check if stoppable or throttleable requests are allowed to be run.
-  auto stoppable_it = stoppable_queue.begin();
-  bool has_runnable_stoppable_request =
-      stoppable_it != stoppable_queue.end() &&
-      (!IsClientDelayable(ThrottleOption::kStoppable) ||
-       running_throttleable_requests_.size() <
-           GetOutstandingLimit(stoppable_it->priority));
-
-  auto throttleable_it = throttleable_queue.begin();
+  auto stoppable_it = FindRunnableRequest(ThrottleOption::kStoppable);
+  bool has_runnable_stoppable_request = stoppable_it != stoppable_queue.end();
+
+  auto throttleable_it = FindRunnableRequest(ThrottleOption::kThrottleable);
   bool has_runnable_throttleable_request =
-      throttleable_it != throttleable_queue.end() &&
-      (!IsClientDelayable(ThrottleOption::kThrottleable) ||
-       running_throttleable_requests_.size() <
-           GetOutstandingLimit(throttleable_it->priority));
+      throttleable_it != throttleable_queue.end();
 
   if (!has_runnable_throttleable_request && !has_runnable_stoppable_request)
     return false;
@@ -329,20 +381,57 @@ void ResourceLoadScheduler::MaybeRun() {
       continue;  // Already released.
     ResourceLoadSchedulerClient* client = found->value->client;
     ThrottleOption option = found->value->option;
+    ResourceLoadPriority priority = found->value->priority;
+    String host = found->value->host;
     pending_request_map_.erase(found);
-    Run(id, client, option == ThrottleOption::kThrottleable);
+    Run(id, client, option == ThrottleOption::kThrottleable, priority, host);
   }
 }
 
 void ResourceLoadScheduler::Run(ResourceLoadScheduler::ClientId id,
                                 ResourceLoadSchedulerClient* client,
-                                bool throttleable) {
-  running_requests_.insert(id);
+                                bool throttleable,
+                                ResourceLoadPriority priority,
+                                const String& host) {
+  RunningRequestInfo info;
+  info.start_time = tick_clock_->NowTicks();
+  if (throttleable && !host.IsEmpty() && !multiplexed_hosts_.Contains(host) &&
+      IsLowPriorityForAdaptiveScheduling(priority)) {
+    info.host = host;
+    auto result = running_requests_per_host_.insert(host, 0u);
+    ++result.stored_value->value;
+  }
+  running_requests_.insert(id, info);
   if (throttleable)
     running_throttleable_requests_.insert(id);
   client->Run();
 }
 
+void ResourceLoadScheduler::SetHostMultiplexesRequests(const String& host) {
+  if (host.IsEmpty() || !multiplexed_hosts_.insert(host).is_new_entry)
+    return;
+  // Requests already running against |host| stop counting against the
+  // per-host limit, and the ones waiting for them can run now.
+  if (running_requests_per_host_.Take(host)) {
+    for (auto& running : running_requests_) {
+      if (running.value.host == host)
+        running.value.host = String();
+    }
+    MaybeRun();
+  }
+}
+
+bool ResourceLoadScheduler::IsAdaptiveSchedulingEnabled() const {
+  return RuntimeEnabledFeatures::AdaptiveResourceLoadSchedulingEnabled();
+}
+
+bool ResourceLoadScheduler::IsLowPriorityForAdaptiveScheduling(
+    ResourceLoadPriority priority) const {
+  return IsAdaptiveSchedulingEnabled() &&
+         policy_ == ThrottlingPolicy::kNormal &&
+         priority < ResourceLoadPriority::kHigh;
+}
+
 size_t ResourceLoadScheduler::GetOutstandingLimit(
     ResourceLoadPriority priority) const {
   size_t limit = kOutstandingUnlimited;
@@ -367,6 +456,10 @@ size_t ResourceLoadScheduler::GetOutstandingLimit(
       break;
     case ThrottlingPolicy::kNormal:
       limit = std::min(limit, normal_outstanding_limit_);
+      if (IsLowPriorityForAdaptiveScheduling(priority)) {
+        limit = std::min(limit, throughput_estimator_.OutstandingLimit(
+                                    normal_outstanding_limit_));
+      }
       break;
   }
   return limit;
@@ -403,4 +496,9 @@ void ResourceLoadScheduler::SetClockForTesting(const base::Clock* clock) {
   clock_ = clock;
 }
 
+void ResourceLoadScheduler::SetTickClockForTesting(
+    const base::TickClock* tick_clock) {
+  tick_clock_ = tick_clock;
+}
+
 }  // namespace blink
@@ -12,12 +12,16 @@
 #include "third_party/blink/renderer/platform/heap/garbage_collected.h"
 #include "third_party/blink/renderer/platform/heap/heap_allocator.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_load_throughput_estimator.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_loader_options.h"
 #include "third_party/blink/renderer/platform/scheduler/public/frame_scheduler.h"
+#include "third_party/blink/renderer/platform/wtf/hash_map.h"
 #include "third_party/blink/renderer/platform/wtf/hash_set.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 
 namespace base {
 class Clock;
+class TickClock;
 }
 
 namespace blink {
@@ -81,6 +85,18 @@ class PLATFORM_EXPORT ResourceLoadSchedulerClient
 //     and sub frames. When the frame has been background for more than five
 //     minutes, all throttleable resource loading requests are throttled
 //     indefinitely (i.e., threshold is zero in such a circumstance).
+//
+// With the AdaptiveResourceLoadScheduling runtime feature, requests whose
+// priority is less than |kHigh| are further limited in the normal mode:
+//  - The number of such requests running at once follows what
+//    ResourceLoadThroughputEstimator derives from the round trip time and the
+//    throughput of the requests finished so far.
+//  - At most |kOutstandingLimitPerHost| of them run against a single host,
+//    which matches the connections the network stack opens per HTTP/1.1 host.
+//    Hosts which answered over a multiplexed connection (HTTP/2 or QUIC), as
+//    reported with SetHostMultiplexesRequests(), are not limited.
+// Render-blocking requests and images in the viewport get at least |kHigh|
+// from ResourceFetcher, so they are never held back by these limits.
 class PLATFORM_EXPORT ResourceLoadScheduler final
     : public GarbageCollected<ResourceLoadScheduler>,
       public FrameOrWorkerScheduler::Observer {
@@ -163,6 +179,9 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
   static constexpr size_t kOutstandingUnlimited =
       std::numeric_limits<size_t>::max();
 
+  // Used with the AdaptiveResourceLoadScheduling feature.
+  static constexpr size_t kOutstandingLimitPerHost = 6;
+
   ResourceLoadScheduler(ThrottlingPolicy initial_throttling_poilcy,
                         ThrottleOptionOverride throttle_option_override,
                         const DetachableResourceFetcherProperties&,
@@ -191,6 +210,14 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
                ResourceLoadPriority,
                int intra_priority,
                ClientId*);
+  // Same as above. |host| is the host the request is sent to, and is used to
+  // spread low priority requests over hosts.
+  void Request(ResourceLoadSchedulerClient*,
+               ThrottleOption,
+               ResourceLoadPriority,
+               int intra_priority,
+               const String& host,
+               ClientId*);
 
   // Updates the priority information of the given client. This function may
   // initiate a new resource loading.
@@ -207,6 +234,15 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
   // haven't call Release() yet.
   bool IsRunning(ClientId id) { return running_requests_.Contains(id); }
 
+  // Tells that |host| serves requests over a multiplexed connection, so that
+  // requests to it aren't held back by |kOutstandingLimitPerHost|. This
+  // function may initiate a new resource loading.
+  void SetHostMultiplexesRequests(const String& host);
+
+  const ResourceLoadThroughputEstimator& GetThroughputEstimator() const {
+    return throughput_estimator_;
+  }
+
   // Sets outstanding limit for testing.
   void SetOutstandingLimitForTesting(size_t limit) {
     SetOutstandingLimitForTesting(limit, limit);
@@ -219,6 +255,8 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
   // The caller is the owner of the |clock|. The |clock| must outlive the
   // ResourceLoadScheduler.
   void SetClockForTesting(const base::Clock* clock);
+  // Same as above, for the clock which times running requests.
+  void SetTickClockForTesting(const base::TickClock* tick_clock);
 
   void SetThrottleOptionOverride(
       ThrottleOptionOverride throttle_option_override) {
@@ -255,11 +293,13 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
     ClientInfo(ResourceLoadSchedulerClient* client,
                ThrottleOption option,
                ResourceLoadPriority priority,
-               int intra_priority)
+               int intra_priority,
+               const String& host)
         : client(client),
           option(option),
           priority(priority),
-          intra_priority(intra_priority) {}
+          intra_priority(intra_priority),
+          host(host) {}
 
     void Trace(Visitor* visitor) const { visitor->Trace(client); }
 
@@ -267,8 +307,19 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
     ThrottleOption option;
     ResourceLoadPriority priority;
     int intra_priority;
+    const String host;
+  };
+
+  struct RunningRequestInfo {
+    DISALLOW_NEW();
+    base::TimeTicks start_time;
+    // Empty unless the request counts against the per-host limit.
+    String host;
   };
 
+  using PendingQueue =
+      std::set<ClientIdWithPriority, ClientIdWithPriority::Compare>;
+
   // Checks if |pending_requests_| for the specified option is effectively
   // empty, that means it does not contain any request that is still alive in
   // |pending_request_map_|.
@@ -277,6 +328,16 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
   // Gets the highest priority pending request that is allowed to be run.
   bool GetNextPendingRequest(ClientId* id);
 
+  // Returns the highest priority request in the queue for |option| that is
+  // allowed to be run, or the end of the queue.
+  PendingQueue::iterator FindRunnableRequest(ThrottleOption option);
+
+  bool IsAdaptiveSchedulingEnabled() const;
+
+  // Whether a request with |priority| counts against the per-host limit and
+  // the adaptive limit.
+  bool IsLowPriorityForAdaptiveScheduling(ResourceLoadPriority) const;
+
   // Returns whether we can throttle a request with the given option based
   // on life cycle state.
   bool IsClientDelayable(ThrottleOption option) const;
@@ -288,7 +349,11 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
   void MaybeRun();
 
   // Grants a client to run,
-  void Run(ClientId, ResourceLoadSchedulerClient*, bool throttleable);
+  void Run(ClientId,
+           ResourceLoadSchedulerClient*,
+           bool throttleable,
+           ResourceLoadPriority,
+           const String& host);
 
   size_t GetOutstandingLimit(ResourceLoadPriority priority) const;
 
@@ -319,10 +384,19 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
   ClientId current_id_ = kInvalidClientId;
 
   // Holds clients that were granted and are running.
-  HashSet<ClientId> running_requests_;
+  HashMap<ClientId, RunningRequestInfo> running_requests_;
 
   HashSet<ClientId> running_throttleable_requests_;
 
+  // Number of running requests per host, for those counting against the
+  // per-host limit.
+  HashMap<String, size_t> running_requests_per_host_;
+
+  // Hosts which are exempt from the per-host limit.
+  HashSet<String> multiplexed_hosts_;
+
+  ResourceLoadThroughputEstimator throughput_estimator_;
+
   // Holds a flag to omit repeating console messages.
   bool is_console_info_shown_ = false;
 
@@ -334,9 +408,7 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
 
   // We use std::set here because WTF doesn't have its counterpart.
   // This tracks two sets of requests, throttleable and stoppable.
-  std::map<ThrottleOption,
-           std::set<ClientIdWithPriority, ClientIdWithPriority::Compare>>
-      pending_requests_;
+  std::map<ThrottleOption, PendingQueue> pending_requests_;
 
   // Remembers elapsed times in seconds when the top request in each queue is
   // processed.
@@ -349,6 +421,8 @@ class PLATFORM_EXPORT ResourceLoadScheduler final
   const Member<DetachableConsoleLogger> console_logger_;
 
   const base::Clock* clock_;
+  // Times running requests for |throughput_estimator_|.
+  const base::TickClock* tick_clock_;
 
   ThrottleOptionOverride throttle_option_override_;
 
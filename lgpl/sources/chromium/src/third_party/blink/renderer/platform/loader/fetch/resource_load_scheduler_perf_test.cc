@@ -0,0 +1,311 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays a trace of subresource requests against ResourceLoadScheduler on a
+// simulated network, and reports when the important requests and the whole
+// page finish loading with and without the adaptive scheduling policy. The
+// scheduling decisions themselves are covered by
+// resource_load_scheduler_test.cc.
+//
+// A recorded trace can be given with --resource-load-trace=<path>. Each line
+// describes one request:
+//   <start time in ms> <priority> <host> <encoded size in bytes>
+// where <priority> is one of VeryLow, Low, Medium, High and VeryHigh, as
+// recorded by ResourceFetcher. Empty lines and lines starting with '#' are
+// ignored. Without a trace, a synthetic one shaped like a page loading a few
+// hundred images from CDNs is used.
+
+#include <algorithm>
+#include <string>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/test/simple_test_tick_clock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/blink/renderer/platform/heap/persistent.h"
+#include "third_party/blink/renderer/platform/loader/fetch/console_logger.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_load_scheduler.h"
+#include "third_party/blink/renderer/platform/loader/testing/test_resource_fetcher_properties.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
+#include "third_party/blink/renderer/platform/scheduler/test/fake_frame_scheduler.h"
+#include "third_party/blink/renderer/platform/wtf/functional.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+namespace {
+
+constexpr char kTraceSwitch[] = "resource-load-trace";
+
+struct TraceEntry {
+  base::TimeDelta start_time;
+  ResourceLoadPriority priority;
+  String host;
+  int64_t bytes;
+};
+
+bool ParsePriority(const std::string& name, ResourceLoadPriority* priority) {
+  static const struct {
+    const char* name;
+    ResourceLoadPriority priority;
+  } kPriorities[] = {
+      {"VeryLow", ResourceLoadPriority::kVeryLow},
+      {"Low", ResourceLoadPriority::kLow},
+      {"Medium", ResourceLoadPriority::kMedium},
+      {"High", ResourceLoadPriority::kHigh},
+      {"VeryHigh", ResourceLoadPriority::kVeryHigh},
+  };
+  for (const auto& entry : kPriorities) {
+    if (name == entry.name) {
+      *priority = entry.priority;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ParseTrace(const std::string& text, Vector<TraceEntry>* trace) {
+  for (const std::string& line : base::SplitString(
+           text, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (line[0] == '#')
+      continue;
+    std::vector<std::string> fields = base::SplitString(
+        line, " \t", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    int64_t start_ms;
+    TraceEntry entry;
+    if (fields.size() != 4 || !base::StringToInt64(fields[0], &start_ms) ||
+        !ParsePriority(fields[1], &entry.priority) ||
+        !base::StringToInt64(fields[3], &entry.bytes)) {
+      LOG(ERROR) << "Malformed trace line: " << line;
+      return false;
+    }
+    entry.start_time = base::TimeDelta::FromMilliseconds(start_ms);
+    entry.host = String::FromUTF8(fields[2]);
+    trace->push_back(entry);
+  }
+  std::stable_sort(trace->begin(), trace->end(),
+                   [](const TraceEntry& a, const TraceEntry& b) {
+                     return a.start_time < b.start_time;
+                   });
+  return true;
+}
+
+// A page with render-blocking styles and scripts, some of which are only
+// discovered once the first ones arrived, and 320 images and other low
+// priority resources spread over four CDN hosts.
+Vector<TraceEntry> SyntheticTrace() {
+  Vector<TraceEntry> trace;
+  auto add = [&trace](int start_ms, ResourceLoadPriority priority,
+                      const char* host, int64_t bytes) {
+    trace.push_back(TraceEntry{base::TimeDelta::FromMilliseconds(start_ms),
+                               priority, host, bytes});
+  };
+  add(0, ResourceLoadPriority::kVeryHigh, "www.example.test", 40 * 1000);
+  add(0, ResourceLoadPriority::kHigh, "static.example.test", 150 * 1000);
+  const char* const kHosts[] = {"img1.cdn.test", "img2.cdn.test",
+                                "img3.cdn.test", "assets.cdn.test"};
+  for (int i = 0; i < 320; ++i) {
+    add(5 + i / 4, i % 10 ? ResourceLoadPriority::kLow
+                          : ResourceLoadPriority::kVeryLow,
+        kHosts[i % 4], 8 * 1000 + (i * 7919) % (120 * 1000));
+  }
+  for (int i = 0; i < 8; ++i) {
+    add(300 + 150 * i, ResourceLoadPriority::kHigh, "static.example.test",
+        30 * 1000 + i * 10 * 1000);
+  }
+  return trace;
+}
+
+// The network is a single bottleneck link shared fairly by all requests
+// which are transferring. Each request first waits for a round trip.
+struct NetworkConditions {
+  base::TimeDelta round_trip_time;
+  int64_t bytes_per_second;
+};
+
+struct SimulationResult {
+  base::TimeDelta important_requests_done;
+  base::TimeDelta all_requests_done;
+};
+
+class SimulatedClient final : public GarbageCollected<SimulatedClient>,
+                              public ResourceLoadSchedulerClient {
+  USING_GARBAGE_COLLECTED_MIXIN(SimulatedClient);
+
+ public:
+  explicit SimulatedClient(base::OnceClosure on_run)
+      : on_run_(std::move(on_run)) {}
+
+  void Run() override { std::move(on_run_).Run(); }
+
+ private:
+  base::OnceClosure on_run_;
+};
+
+class Simulation {
+ public:
+  Simulation(const Vector<TraceEntry>& trace, NetworkConditions network)
+      : trace_(trace), network_(network), requests_(trace.size()) {}
+
+  SimulationResult Run() {
+    auto* properties = MakeGarbageCollected<TestResourceFetcherProperties>();
+    auto frame_scheduler = std::make_unique<scheduler::FakeFrameScheduler>();
+    scheduler_ = MakeGarbageCollected<ResourceLoadScheduler>(
+        ResourceLoadScheduler::ThrottlingPolicy::kNormal,
+        ResourceLoadScheduler::ThrottleOptionOverride::kNone,
+        properties->MakeDetachable(), frame_scheduler.get(),
+        *MakeGarbageCollected<DetachableConsoleLogger>());
+    scheduler_->SetTickClockForTesting(&tick_clock_);
+
+    const base::TimeDelta kStep = base::TimeDelta::FromMilliseconds(1);
+    const base::TimeDelta kTimeout = base::TimeDelta::FromMinutes(10);
+    const double bytes_per_step = network_.bytes_per_second * kStep.InSecondsF();
+    wtf_size_t next_request = 0;
+    wtf_size_t finished_requests = 0;
+    SimulationResult result;
+
+    for (base::TimeDelta now; finished_requests < trace_.size(); now += kStep) {
+      CHECK_LT(now, kTimeout);
+      now_ = now;
+      while (next_request < trace_.size() &&
+             trace_[next_request].start_time <= now) {
+        StartRequest(next_request++);
+      }
+
+      Vector<wtf_size_t> transferring;
+      for (wtf_size_t index : running_) {
+        if (requests_[index].start_time + network_.round_trip_time <= now)
+          transferring.push_back(index);
+      }
+      Vector<wtf_size_t> finished;
+      for (wtf_size_t index : transferring) {
+        requests_[index].remaining_bytes -=
+            bytes_per_step / transferring.size();
+        if (requests_[index].remaining_bytes <= 0)
+          finished.push_back(index);
+      }
+
+      tick_clock_.Advance(kStep);
+      now_ += kStep;
+      for (wtf_size_t index : finished) {
+        running_.EraseAt(running_.Find(index));
+        ++finished_requests;
+        const TraceEntry& entry = trace_[index];
+        base::TimeDelta done = now + kStep;
+        result.all_requests_done = std::max(result.all_requests_done, done);
+        if (entry.priority >= ResourceLoadPriority::kHigh) {
+          result.important_requests_done =
+              std::max(result.important_requests_done, done);
+        }
+        // This may start other requests, which begin in the next step.
+        scheduler_->Release(
+            requests_[index].client_id,
+            ResourceLoadScheduler::ReleaseOption::kReleaseAndSchedule,
+            ResourceLoadScheduler::TrafficReportHints(entry.bytes,
+                                                      entry.bytes));
+      }
+    }
+    scheduler_->Shutdown();
+    return result;
+  }
+
+ private:
+  struct RequestState {
+    ResourceLoadScheduler::ClientId client_id =
+        ResourceLoadScheduler::kInvalidClientId;
+    base::TimeDelta start_time;
+    double remaining_bytes = 0;
+  };
+
+  void StartRequest(wtf_size_t index) {
+    const TraceEntry& entry = trace_[index];
+    auto* client = MakeGarbageCollected<SimulatedClient>(
+        WTF::Bind(&Simulation::OnRun, WTF::Unretained(this), index));
+    scheduler_->Request(client,
+                        ResourceLoadScheduler::ThrottleOption::kThrottleable,
+                        entry.priority, 0 /* intra_priority */, entry.host,
+                        &requests_[index].client_id);
+  }
+
+  void OnRun(wtf_size_t index) {
+    requests_[index].start_time = now_;
+    requests_[index].remaining_bytes = trace_[index].bytes;
+    running_.push_back(index);
+  }
+
+  const Vector<TraceEntry>& trace_;
+  const NetworkConditions network_;
+  Vector<RequestState> requests_;
+  Vector<wtf_size_t> running_;
+  base::TimeDelta now_;
+  base::SimpleTestTickClock tick_clock_;
+  Persistent<ResourceLoadScheduler> scheduler_;
+};
+
+constexpr char kMetricPrefix[] = "ResourceLoadScheduler.";
+constexpr char kMetricImportantRequestsDone[] = "important_requests_done";
+constexpr char kMetricAllRequestsDone[] = "all_requests_done";
+
+struct NamedNetworkConditions {
+  const char* name;
+  NetworkConditions conditions;
+};
+
+const NamedNetworkConditions kNetworks[] = {
+    // A slow mobile connection.
+    {"slow_mobile", {base::TimeDelta::FromMilliseconds(300), 200 * 1000}},
+    // Roughly a 4G connection.
+    {"4g", {base::TimeDelta::FromMilliseconds(100), 1500 * 1000}},
+    // A fast connection to far away servers.
+    {"fast_far_away",
+     {base::TimeDelta::FromMilliseconds(200), 10 * 1000 * 1000}},
+};
+
+}  // namespace
+
+class ResourceLoadSchedulerPerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    base::FilePath path =
+        base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+            kTraceSwitch);
+    if (path.empty()) {
+      trace_ = SyntheticTrace();
+      return;
+    }
+    std::string text;
+    ASSERT_TRUE(base::ReadFileToString(path, &text)) << path;
+    ASSERT_TRUE(ParseTrace(text, &trace_));
+  }
+
+  void Simulate(const NamedNetworkConditions& network, bool adaptive) {
+    ScopedAdaptiveResourceLoadSchedulingForTest adaptive_scheduling(adaptive);
+    SimulationResult result = Simulation(trace_, network.conditions).Run();
+
+    std::string story = network.name;
+    story += adaptive ? "_adaptive" : "_fixed";
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricImportantRequestsDone, "ms");
+    reporter.RegisterImportantMetric(kMetricAllRequestsDone, "ms");
+    reporter.AddResult(kMetricImportantRequestsDone,
+                       result.important_requests_done.InMillisecondsF());
+    reporter.AddResult(kMetricAllRequestsDone,
+                       result.all_requests_done.InMillisecondsF());
+  }
+
+ protected:
+  Vector<TraceEntry> trace_;
+};
+
+TEST_F(ResourceLoadSchedulerPerfTest, ReplayTrace) {
+  for (const auto& network : kNetworks) {
+    Simulate(network, false);
+    Simulate(network, true);
+  }
+}
+
+}  // namespace blink
@@ -5,6 +5,7 @@
 #include "third_party/blink/renderer/platform/loader/fetch/resource_load_scheduler.h"
 
 #include <memory>
+#include "base/test/simple_test_tick_clock.h"
 #include "base/test/test_mock_time_task_runner.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/platform/heap/persistent.h"
@@ -694,5 +695,213 @@ TEST_F(ResourceLoadSchedulerTest, ConsoleMessage) {
   EXPECT_TRUE(Release(id2));
 }
 
+class ResourceLoadSchedulerAdaptiveTest : public ResourceLoadSchedulerTest {
+ public:
+  void SetUp() override {
+    ResourceLoadSchedulerTest::SetUp();
+    Scheduler()->SetTickClockForTesting(&tick_clock_);
+    Scheduler()->LoosenThrottlingPolicy();
+    Scheduler()->SetOutstandingLimitForTesting(100);
+  }
+
+  MockClient* Request(ResourceLoadPriority priority,
+                      const String& host,
+                      ResourceLoadScheduler::ClientId* id) {
+    MockClient* client = MakeGarbageCollected<MockClient>();
+    Scheduler()->Request(client, ThrottleOption::kThrottleable, priority,
+                         0 /* intra_priority */, host, id);
+    EXPECT_NE(ResourceLoadScheduler::kInvalidClientId, *id);
+    return client;
+  }
+
+  // Runs a request which takes |duration| to transfer |bytes|.
+  void Load(base::TimeDelta duration, int64_t bytes) {
+    ResourceLoadScheduler::ClientId id;
+    MockClient* client =
+        Request(ResourceLoadPriority::kHigh, "sample.test", &id);
+    EXPECT_TRUE(client->WasRun());
+    tick_clock_.Advance(duration);
+    EXPECT_TRUE(Scheduler()->Release(
+        id, ResourceLoadScheduler::ReleaseOption::kReleaseAndSchedule,
+        ResourceLoadScheduler::TrafficReportHints(bytes, bytes)));
+  }
+
+ private:
+  ScopedAdaptiveResourceLoadSchedulingForTest adaptive_scheduling_{true};
+  base::SimpleTestTickClock tick_clock_;
+};
+
+TEST_F(ResourceLoadSchedulerAdaptiveTest, PerHostLimit) {
+  HeapVector<Member<MockClient>> clients;
+  Vector<ResourceLoadScheduler::ClientId> ids;
+  for (size_t i = 0; i <= ResourceLoadScheduler::kOutstandingLimitPerHost;
+       ++i) {
+    ResourceLoadScheduler::ClientId id;
+    clients.push_back(Request(ResourceLoadPriority::kLow, "cdn.test", &id));
+    ids.push_back(id);
+  }
+  for (size_t i = 0; i < ResourceLoadScheduler::kOutstandingLimitPerHost; ++i)
+    EXPECT_TRUE(clients[i]->WasRun());
+  EXPECT_FALSE(clients.back()->WasRun());
+
+  // Other hosts and important requests don't wait for the busy host.
+  ResourceLoadScheduler::ClientId other_host_id;
+  EXPECT_TRUE(Request(ResourceLoadPriority::kLow, "other.test", &other_host_id)
+                  ->WasRun());
+  ResourceLoadScheduler::ClientId high_id;
+  EXPECT_TRUE(
+      Request(ResourceLoadPriority::kHigh, "cdn.test", &high_id)->WasRun());
+
+  EXPECT_TRUE(ReleaseAndSchedule(ids.front()));
+  EXPECT_TRUE(clients.back()->WasRun());
+
+  for (wtf_size_t i = 1; i < ids.size(); ++i)
+    EXPECT_TRUE(Release(ids[i]));
+  EXPECT_TRUE(Release(other_host_id));
+  EXPECT_TRUE(Release(high_id));
+}
+
+TEST_F(ResourceLoadSchedulerAdaptiveTest, BusyHostIsSkipped) {
+  Scheduler()->SetOutstandingLimitForTesting(
+      ResourceLoadScheduler::kOutstandingLimitPerHost + 1);
+  Vector<ResourceLoadScheduler::ClientId> busy_host_ids;
+  for (size_t i = 0; i < ResourceLoadScheduler::kOutstandingLimitPerHost;
+       ++i) {
+    ResourceLoadScheduler::ClientId id;
+    EXPECT_TRUE(Request(ResourceLoadPriority::kLow, "a.test", &id)->WasRun());
+    busy_host_ids.push_back(id);
+  }
+  ResourceLoadScheduler::ClientId other_id;
+  EXPECT_TRUE(
+      Request(ResourceLoadPriority::kLow, "d.test", &other_id)->WasRun());
+
+  // All of these wait for the overall limit.
+  MockClient::MockClientDelegate delegate;
+  ResourceLoadScheduler::ClientId id_a, id_b, id_c;
+  MockClient* client_a =
+      Request(ResourceLoadPriority::kMedium, "a.test", &id_a);
+  MockClient* client_b = Request(ResourceLoadPriority::kLow, "b.test", &id_b);
+  MockClient* client_c =
+      Request(ResourceLoadPriority::kVeryLow, "c.test", &id_c);
+  client_a->SetDelegate(&delegate);
+  client_b->SetDelegate(&delegate);
+  client_c->SetDelegate(&delegate);
+  EXPECT_FALSE(client_a->WasRun());
+  EXPECT_FALSE(client_b->WasRun());
+  EXPECT_FALSE(client_c->WasRun());
+
+  // A free slot goes to the highest priority request whose host isn't busy.
+  EXPECT_TRUE(ReleaseAndSchedule(other_id));
+  EXPECT_TRUE(ReleaseAndSchedule(id_b));
+  // Once the busy host has room, its request runs.
+  EXPECT_TRUE(ReleaseAndSchedule(busy_host_ids.front()));
+
+  const auto& order = delegate.client_order();
+  ASSERT_EQ(3u, order.size());
+  EXPECT_EQ(client_b, order[0]);
+  EXPECT_EQ(client_c, order[1]);
+  EXPECT_EQ(client_a, order[2]);
+
+  for (wtf_size_t i = 1; i < busy_host_ids.size(); ++i)
+    EXPECT_TRUE(Release(busy_host_ids[i]));
+  EXPECT_TRUE(Release(id_a));
+  EXPECT_TRUE(Release(id_c));
+}
+
+TEST_F(ResourceLoadSchedulerAdaptiveTest, MultiplexedHostIsNotLimited) {
+  HeapVector<Member<MockClient>> clients;
+  Vector<ResourceLoadScheduler::ClientId> ids;
+  for (size_t i = 0; i <= ResourceLoadScheduler::kOutstandingLimitPerHost;
+       ++i) {
+    ResourceLoadScheduler::ClientId id;
+    clients.push_back(Request(ResourceLoadPriority::kLow, "h2.test", &id));
+    ids.push_back(id);
+  }
+  EXPECT_FALSE(clients.back()->WasRun());
+
+  // The first response tells that the host speaks HTTP/2. The waiting request
+  // runs, and so do later ones.
+  Scheduler()->SetHostMultiplexesRequests("h2.test");
+  EXPECT_TRUE(clients.back()->WasRun());
+  for (int i = 0; i < 4; ++i) {
+    ResourceLoadScheduler::ClientId id;
+    EXPECT_TRUE(Request(ResourceLoadPriority::kLow, "h2.test", &id)->WasRun());
+    ids.push_back(id);
+  }
+
+  // Other hosts are still limited.
+  Vector<ResourceLoadScheduler::ClientId> other_ids;
+  MockClient* last_other_client = nullptr;
+  for (size_t i = 0; i <= ResourceLoadScheduler::kOutstandingLimitPerHost;
+       ++i) {
+    ResourceLoadScheduler::ClientId id;
+    last_other_client = Request(ResourceLoadPriority::kLow, "h1.test", &id);
+    other_ids.push_back(id);
+  }
+  EXPECT_FALSE(last_other_client->WasRun());
+
+  // Releasing the requests which started before the host was known to
+  // multiplex doesn't let more requests to other hosts run.
+  for (ResourceLoadScheduler::ClientId id : ids)
+    EXPECT_TRUE(ReleaseAndSchedule(id));
+  EXPECT_FALSE(last_other_client->WasRun());
+
+  for (ResourceLoadScheduler::ClientId id : other_ids)
+    EXPECT_TRUE(Release(id));
+}
+
+TEST_F(ResourceLoadSchedulerTest, NoPerHostLimitWithoutAdaptiveScheduling) {
+  ScopedAdaptiveResourceLoadSchedulingForTest adaptive_scheduling(false);
+  Scheduler()->LoosenThrottlingPolicy();
+  Scheduler()->SetOutstandingLimitForTesting(100);
+
+  Vector<ResourceLoadScheduler::ClientId> ids;
+  for (size_t i = 0; i <= ResourceLoadScheduler::kOutstandingLimitPerHost;
+       ++i) {
+    ResourceLoadScheduler::ClientId id;
+    MockClient* client = MakeGarbageCollected<MockClient>();
+    Scheduler()->Request(client, ThrottleOption::kThrottleable,
+                         ResourceLoadPriority::kLow, 0 /* intra_priority */,
+                         "cdn.test", &id);
+    EXPECT_TRUE(client->WasRun());
+    ids.push_back(id);
+  }
+  for (ResourceLoadScheduler::ClientId id : ids)
+    EXPECT_TRUE(Release(id));
+}
+
+TEST_F(ResourceLoadSchedulerAdaptiveTest, AdaptiveLimit) {
+  // A slow network: 400ms round trips and about 50kB/s.
+  for (int i = 0; i < 4; ++i)
+    Load(base::TimeDelta::FromMilliseconds(400), 1000);
+  for (int i = 0; i < 4; ++i)
+    Load(base::TimeDelta::FromSeconds(2), 100 * 1000);
+  ASSERT_TRUE(Scheduler()->GetThroughputEstimator().HasEstimate());
+  size_t limit = Scheduler()->GetThroughputEstimator().OutstandingLimit(100);
+  ASSERT_LT(limit, 10u);
+
+  HeapVector<Member<MockClient>> clients;
+  Vector<ResourceLoadScheduler::ClientId> ids;
+  for (size_t i = 0; i <= limit; ++i) {
+    ResourceLoadScheduler::ClientId id;
+    // Spread over hosts so that the per-host limit doesn't kick in.
+    clients.push_back(Request(ResourceLoadPriority::kLow,
+                              "host" + String::Number(i) + ".test", &id));
+    ids.push_back(id);
+  }
+  for (size_t i = 0; i < limit; ++i)
+    EXPECT_TRUE(clients[i]->WasRun());
+  EXPECT_FALSE(clients.back()->WasRun());
+
+  // Render-blocking and visible resources get at least kHigh.
+  ResourceLoadScheduler::ClientId high_id;
+  EXPECT_TRUE(
+      Request(ResourceLoadPriority::kHigh, "host0.test", &high_id)->WasRun());
+
+  for (ResourceLoadScheduler::ClientId id : ids)
+    EXPECT_TRUE(Release(id));
+  EXPECT_TRUE(Release(high_id));
+}
+
 }  // namespace
 }  // namespace blink
@@ -0,0 +1,89 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/loader/fetch/resource_load_throughput_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/check_op.h"
+
+namespace blink {
+
+constexpr size_t ResourceLoadThroughputEstimator::kMinSamples;
+constexpr size_t ResourceLoadThroughputEstimator::kMinOutstandingLimit;
+constexpr size_t ResourceLoadThroughputEstimator::kMaxOutstandingLimit;
+constexpr int64_t ResourceLoadThroughputEstimator::kSmallTransferBytes;
+constexpr double ResourceLoadThroughputEstimator::kSampleWeight;
+
+namespace {
+
+double Average(double average, double sample) {
+  if (average == 0)
+    return sample;
+  return average + ResourceLoadThroughputEstimator::kSampleWeight *
+                       (sample - average);
+}
+
+}  // namespace
+
+void ResourceLoadThroughputEstimator::AddSample(base::TimeDelta duration,
+                                                int64_t bytes,
+                                                size_t concurrent_requests) {
+  DCHECK_GE(concurrent_requests, 1u);
+  if (duration <= base::TimeDelta() || bytes < 0)
+    return;
+
+  ++sample_count_;
+  min_duration_ = std::min(min_duration_, duration);
+  transfer_bytes_ = Average(transfer_bytes_, bytes);
+
+  if (bytes <= kSmallTransferBytes) {
+    small_transfer_duration_ = base::TimeDelta::FromMicrosecondsD(Average(
+        small_transfer_duration_.InMicrosecondsF(), duration.InMicrosecondsF()));
+    return;
+  }
+  // The connection was shared with the other running requests, so it could
+  // carry about |concurrent_requests| times what this one got.
+  throughput_ = Average(throughput_, bytes * concurrent_requests /
+                                         duration.InSecondsF());
+}
+
+bool ResourceLoadThroughputEstimator::HasEstimate() const {
+  return sample_count_ >= kMinSamples && throughput_ > 0;
+}
+
+base::TimeDelta ResourceLoadThroughputEstimator::EstimatedRoundTripTime()
+    const {
+  DCHECK(HasEstimate());
+  // Without small transfers the shortest request is the best upper bound.
+  if (small_transfer_duration_.is_zero())
+    return min_duration_;
+  return std::min(small_transfer_duration_, min_duration_ * 4);
+}
+
+double ResourceLoadThroughputEstimator::EstimatedThroughput() const {
+  DCHECK(HasEstimate());
+  return throughput_;
+}
+
+size_t ResourceLoadThroughputEstimator::OutstandingLimit(
+    size_t default_limit) const {
+  if (!HasEstimate())
+    return default_limit;
+  // Little's law: a request spends a round trip waiting, and then its size
+  // divided by the throughput transferring. Keeping the connection busy needs
+  // one more request per average transfer that fits in a round trip.
+  double bandwidth_delay_product =
+      EstimatedThroughput() * EstimatedRoundTripTime().InSecondsF();
+  double limit =
+      1 + std::ceil(bandwidth_delay_product / std::max(transfer_bytes_, 1.0));
+  size_t upper_bound = std::min(kMaxOutstandingLimit, default_limit);
+  size_t lower_bound = std::min(kMinOutstandingLimit, upper_bound);
+  if (limit >= upper_bound)
+    return upper_bound;
+  return std::max(lower_bound, static_cast<size_t>(limit));
+}
+
+}  // namespace blink
@@ -0,0 +1,74 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_LOADER_FETCH_RESOURCE_LOAD_THROUGHPUT_ESTIMATOR_H_
+#define THIRD_PARTY_BLINK_RENDERER_PLATFORM_LOADER_FETCH_RESOURCE_LOAD_THROUGHPUT_ESTIMATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/time/time.h"
+#include "third_party/blink/renderer/platform/platform_export.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+
+namespace blink {
+
+// Estimates the round trip time and the throughput a frame sees from the
+// requests it finished, and derives how many low priority requests can be in
+// flight at once. The idea is the one of a bandwidth-delay product: enough
+// requests should be running to keep the connection busy while each of them
+// waits for its first byte, but not more, since every extra request takes
+// bandwidth away from the more important ones started later.
+//
+// The estimator only sees what ResourceLoadScheduler sees, i.e. the time
+// between granting a request and releasing it, and the number of bytes it
+// transferred. Estimates are exponentially weighted moving averages.
+class PLATFORM_EXPORT ResourceLoadThroughputEstimator final {
+  DISALLOW_NEW();
+
+ public:
+  // No estimate is made from fewer samples than this.
+  static constexpr size_t kMinSamples = 4;
+  // Bounds for OutstandingLimit().
+  static constexpr size_t kMinOutstandingLimit = 2;
+  static constexpr size_t kMaxOutstandingLimit = 32;
+  // Transfers up to this size are dominated by latency and are used to
+  // estimate the round trip time. Larger ones are used for the throughput.
+  static constexpr int64_t kSmallTransferBytes = 16 * 1024;
+  // Weight of a new sample in the moving averages.
+  static constexpr double kSampleWeight = 0.2;
+
+  ResourceLoadThroughputEstimator() = default;
+
+  // Records a finished request which took |duration| to transfer |bytes|
+  // while |concurrent_requests| requests (itself included) were running.
+  void AddSample(base::TimeDelta duration,
+                 int64_t bytes,
+                 size_t concurrent_requests);
+
+  bool HasEstimate() const;
+
+  // These must only be called when HasEstimate() returns true.
+  base::TimeDelta EstimatedRoundTripTime() const;
+  double EstimatedThroughput() const;  // In bytes per second.
+
+  // Returns the number of low priority requests which should be allowed in
+  // flight, never more than |default_limit|. Returns |default_limit| while
+  // there is no estimate.
+  size_t OutstandingLimit(size_t default_limit) const;
+
+  size_t sample_count() const { return sample_count_; }
+
+ private:
+  size_t sample_count_ = 0;
+  base::TimeDelta min_duration_ = base::TimeDelta::Max();
+  // Zero until the first sample of the corresponding kind was seen.
+  base::TimeDelta small_transfer_duration_;
+  double throughput_ = 0;
+  double transfer_bytes_ = 0;
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_LOADER_FETCH_RESOURCE_LOAD_THROUGHPUT_ESTIMATOR_H_
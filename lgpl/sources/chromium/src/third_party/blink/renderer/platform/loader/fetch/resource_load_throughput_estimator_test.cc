@@ -0,0 +1,79 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/loader/fetch/resource_load_throughput_estimator.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace blink {
+
+namespace {
+
+base::TimeDelta Milliseconds(int64_t ms) {
+  return base::TimeDelta::FromMilliseconds(ms);
+}
+
+}  // namespace
+
+TEST(ResourceLoadThroughputEstimatorTest, NoEstimateWithoutSamples) {
+  ResourceLoadThroughputEstimator estimator;
+  EXPECT_FALSE(estimator.HasEstimate());
+  EXPECT_EQ(1024u, estimator.OutstandingLimit(1024));
+
+  // Small transfers alone say nothing about the throughput.
+  for (int i = 0; i < 10; ++i)
+    estimator.AddSample(Milliseconds(100), 500, 1);
+  EXPECT_FALSE(estimator.HasEstimate());
+  EXPECT_EQ(1024u, estimator.OutstandingLimit(1024));
+}
+
+TEST(ResourceLoadThroughputEstimatorTest, IgnoresInvalidSamples) {
+  ResourceLoadThroughputEstimator estimator;
+  estimator.AddSample(base::TimeDelta(), 100 * 1000, 1);
+  estimator.AddSample(Milliseconds(100), -1, 1);
+  EXPECT_EQ(0u, estimator.sample_count());
+}
+
+TEST(ResourceLoadThroughputEstimatorTest, Estimates) {
+  ResourceLoadThroughputEstimator estimator;
+  for (int i = 0; i < 4; ++i)
+    estimator.AddSample(Milliseconds(50), 2000, 1);
+  // 200kB in 100ms while sharing the connection with another request.
+  for (int i = 0; i < 4; ++i)
+    estimator.AddSample(Milliseconds(100), 200 * 1000, 2);
+
+  ASSERT_TRUE(estimator.HasEstimate());
+  EXPECT_EQ(Milliseconds(50), estimator.EstimatedRoundTripTime());
+  EXPECT_DOUBLE_EQ(4 * 1000 * 1000, estimator.EstimatedThroughput());
+}
+
+TEST(ResourceLoadThroughputEstimatorTest, LimitFollowsBandwidthDelayProduct) {
+  // A fast network with long round trips needs many requests in flight.
+  ResourceLoadThroughputEstimator fast;
+  for (int i = 0; i < 4; ++i)
+    fast.AddSample(Milliseconds(200), 10 * 1000, 1);
+  for (int i = 0; i < 4; ++i)
+    fast.AddSample(Milliseconds(300), 1000 * 1000, 1);
+  ASSERT_TRUE(fast.HasEstimate());
+
+  // A slow network is saturated by a couple of requests.
+  ResourceLoadThroughputEstimator slow;
+  for (int i = 0; i < 4; ++i)
+    slow.AddSample(Milliseconds(400), 1000, 1);
+  for (int i = 0; i < 4; ++i)
+    slow.AddSample(Milliseconds(4000), 100 * 1000, 1);
+  ASSERT_TRUE(slow.HasEstimate());
+
+  EXPECT_GT(fast.OutstandingLimit(1024), slow.OutstandingLimit(1024));
+  EXPECT_EQ(ResourceLoadThroughputEstimator::kMinOutstandingLimit,
+            slow.OutstandingLimit(1024));
+  EXPECT_LE(fast.OutstandingLimit(1024),
+            ResourceLoadThroughputEstimator::kMaxOutstandingLimit);
+
+  // The limit never exceeds the one given.
+  EXPECT_EQ(1u, fast.OutstandingLimit(1));
+  EXPECT_EQ(1u, slow.OutstandingLimit(1));
+}
+
+}  // namespace blink
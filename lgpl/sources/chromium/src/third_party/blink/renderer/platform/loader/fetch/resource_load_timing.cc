@@ -103,7 +103,8 @@ bool ResourceLoadTiming::operator==(const ResourceLoadTiming& other) const {
          receive_headers_start_ == other.receive_headers_start_ &&
          receive_headers_end_ == other.receive_headers_end_ &&
          ssl_start_ == other.ssl_start_ && ssl_end_ == other.ssl_end_ &&
-         push_start_ == other.push_start_ && push_end_ == other.push_end_;
+         push_start_ == other.push_start_ && push_end_ == other.push_end_ &&
+         queueing_time_ == other.queueing_time_;
 }
 
 bool ResourceLoadTiming::operator!=(const ResourceLoadTiming& other) const {
@@ -192,6 +193,10 @@ void ResourceLoadTiming::SetPushEnd(base::TimeTicks push_end) {
   push_end_ = push_end;
 }
 
+void ResourceLoadTiming::SetQueueingTime(base::TimeDelta queueing_time) {
+  queueing_time_ = queueing_time;
+}
+
 double ResourceLoadTiming::CalculateMillisecondDelta(
     base::TimeTicks time) const {
   return time.is_null() ? -1 : (time - request_time_).InMillisecondsF();
@@ -64,6 +64,10 @@ class PLATFORM_EXPORT ResourceLoadTiming
   void SetSslEnd(base::TimeTicks);
   void SetPushStart(base::TimeTicks);
   void SetPushEnd(base::TimeTicks);
+  // The time the request waited in ResourceLoadScheduler before it was
+  // started. This is known to the renderer only, and isn't sent over mojo.
+  // DevTools reports it as Network.ResourceTiming.rendererQueueingTime.
+  void SetQueueingTime(base::TimeDelta);
 
   base::TimeTicks DnsStart() const { return dns_start_; }
   base::TimeTicks RequestTime() const { return request_time_; }
@@ -86,6 +90,7 @@ class PLATFORM_EXPORT ResourceLoadTiming
   base::TimeTicks SslEnd() const { return ssl_end_; }
   base::TimeTicks PushStart() const { return push_start_; }
   base::TimeTicks PushEnd() const { return push_end_; }
+  base::TimeDelta QueueingTime() const { return queueing_time_; }
 
   double CalculateMillisecondDelta(base::TimeTicks) const;
 
@@ -141,6 +146,8 @@ class PLATFORM_EXPORT ResourceLoadTiming
   base::TimeTicks ssl_end_;
   base::TimeTicks push_start_;
   base::TimeTicks push_end_;
+
+  base::TimeDelta queueing_time_;
 };
 
 }  // namespace blink
@@ -67,6 +67,7 @@
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher_properties.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_load_observer.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_load_timing.h"
 #include "third_party/blink/renderer/platform/loader/fetch/response_body_loader.h"
 #include "third_party/blink/renderer/platform/loader/fetch/shared_buffer_bytes_consumer.h"
 #include "third_party/blink/renderer/platform/loader/fetch/url_loader/request_conversion.h"
@@ -81,6 +82,7 @@
 #include "third_party/blink/renderer/platform/weborigin/scheme_registry.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
 #include "third_party/blink/renderer/platform/wtf/assertions.h"
+#include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
 #include "third_party/blink/renderer/platform/wtf/shared_buffer.h"
 #include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
@@ -423,6 +425,7 @@ void ResourceLoader::Trace(Visitor* visitor) const {
   visitor->Trace(scheduler_);
   visitor->Trace(resource_);
   visitor->Trace(response_body_loader_);
+  visitor->Trace(background_response_client_);
   visitor->Trace(data_pipe_completion_notifier_);
   ResourceLoadSchedulerClient::Trace(visitor);
 }
@@ -511,8 +514,10 @@ void ResourceLoader::Start() {
     throttle_option =
         ResourceLoadScheduler::ThrottleOption::kCanNotBeStoppedOrThrottled;
   }
+  scheduler_request_time_ = base::TimeTicks::Now();
   scheduler_->Request(this, throttle_option, request.Priority(),
-                      request.IntraPriorityValue(), &scheduler_client_id_);
+                      request.IntraPriorityValue(), request.Url().Host(),
+                      &scheduler_client_id_);
 }
 
 void ResourceLoader::DidStartLoadingResponseBodyInternal(
@@ -528,12 +533,69 @@ void ResourceLoader::DidStartLoadingResponseBodyInternal(
     // When streaming, unpause virtual time early to prevent deadlocking
     // against stream consumer in case stream has backpressure enabled.
     resource_->VirtualTimePauser().UnpauseVirtualTime();
-  } else {
-    response_body_loader_->Start();
+    return;
+  }
+
+  if (ShouldProcessResponseBodyInBackground()) {
+    ResponseBodyLoaderClient* client = nullptr;
+    mojo::ScopedDataPipeConsumerHandle body =
+        response_body_loader_->DrainAsDataPipe(&client);
+    if (body) {
+      background_response_client_ = client;
+      int64_t expected_size = resource_->GetResponse().ExpectedContentLength();
+      BackgroundResponseProcessor::Start(
+          std::move(body),
+          expected_size > 0 ? static_cast<size_t>(expected_size) : 0,
+          SubresourceIntegrity::DigestAlgorithmsForCheck(
+              resource_->IntegrityMetadata()),
+          task_runner_for_body_loader_,
+          CrossThreadBindOnce(
+              &ResourceLoader::DidProcessResponseBodyInBackground,
+              WrapCrossThreadWeakPersistent(this)));
+      return;
+    }
   }
+  response_body_loader_->Start();
+}
+
+bool ResourceLoader::ShouldProcessResponseBodyInBackground() const {
+  if (!RuntimeEnabledFeatures::BackgroundResponseProcessingEnabled())
+    return false;
+  // Resources which aren't buffered look at each chunk as it arrives, and
+  // there is nothing to gain from assembling their body elsewhere.
+  if (resource_->Options().data_buffering_policy != kBufferData)
+    return false;
+  return resource_->CanProcessResponseBodyInBackground();
+}
+
+void ResourceLoader::DidProcessResponseBodyInBackground(
+    std::unique_ptr<BackgroundResponseProcessor::Result> result) {
+  ResponseBodyLoaderClient* client = background_response_client_.Release();
+  if (!client || response_body_loader_->IsAborted())
+    return;
+  if (!result->succeeded) {
+    client->DidFailLoadingBody();
+    return;
+  }
+
+  TRACE_EVENT1("blink", "ResourceLoader::DidProcessResponseBodyInBackground",
+               "length", result->body->size());
+  // An empty body leaves the resource without data, just like AppendData()
+  // is never called for one. Its digests are dropped along with it.
+  if (result->body->size()) {
+    if (auto* observer = fetcher_->GetResourceLoadObserver()) {
+      for (const auto& span : *result->body)
+        observer->DidReceiveData(resource_->InspectorId(), span);
+    }
+    resource_->AppendBufferedBody(std::move(result->body),
+                                  std::move(result->digests));
+  }
+  client->DidFinishLoadingBody();
 }
 
 void ResourceLoader::Run() {
+  if (!scheduler_request_time_.is_null())
+    scheduler_queueing_time_ = base::TimeTicks::Now() - scheduler_request_time_;
   StartWith(resource_->GetResourceRequest());
 }
 
@@ -1091,6 +1153,15 @@ void ResourceLoader::DidReceiveResponseInternal(
   const ResourceResponse& response_to_pass =
       response_with_type ? *response_with_type : response;
 
+  if (ResourceLoadTiming* timing = response_to_pass.GetResourceLoadTiming())
+    timing->SetQueueingTime(scheduler_queueing_time_);
+
+  // Also true for QUIC.
+  if (response_to_pass.WasFetchedViaSPDY()) {
+    scheduler_->SetHostMultiplexesRequests(
+        response_to_pass.CurrentRequestUrl().Host());
+  }
+
   // FrameType never changes during the lifetime of a request.
   if (auto* observer = fetcher_->GetResourceLoadObserver()) {
     ResourceRequest request_for_obserber(initial_request);
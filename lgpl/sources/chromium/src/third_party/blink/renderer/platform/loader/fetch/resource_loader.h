@@ -40,6 +40,7 @@
 #include "third_party/blink/public/platform/web_url_loader.h"
 #include "third_party/blink/public/platform/web_url_loader_client.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
+#include "third_party/blink/renderer/platform/loader/fetch/background_response_processor.h"
 #include "third_party/blink/renderer/platform/loader/fetch/data_pipe_bytes_consumer.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_load_scheduler.h"
@@ -157,6 +158,12 @@ class PLATFORM_EXPORT ResourceLoader final
 
   void DidStartLoadingResponseBodyInternal(BytesConsumer& bytes_consumer);
 
+  // Whether the body should be drained as a data pipe and read by a
+  // BackgroundResponseProcessor instead of being delivered chunk by chunk.
+  bool ShouldProcessResponseBodyInBackground() const;
+  void DidProcessResponseBodyInBackground(
+      std::unique_ptr<BackgroundResponseProcessor::Result>);
+
   // ResourceLoadSchedulerClient.
   void Run() override;
 
@@ -214,6 +221,9 @@ class PLATFORM_EXPORT ResourceLoader final
   Member<Resource> resource_;
   ResourceRequestBody request_body_;
   Member<ResponseBodyLoader> response_body_loader_;
+  // The client to report to once a BackgroundResponseProcessor is done with
+  // the drained body.
+  Member<ResponseBodyLoaderClient> background_response_client_;
   Member<DataPipeBytesConsumer::CompletionNotifier>
       data_pipe_completion_notifier_;
   // code_cache_request_ is created only if required. It is required to check
@@ -233,6 +243,10 @@ class PLATFORM_EXPORT ResourceLoader final
   bool blob_finished_ = false;
   bool blob_response_started_ = false;
   bool has_seen_end_of_body_ = false;
+  // When Request() was called on |scheduler_|, and how long it took until
+  // Run() was called.
+  base::TimeTicks scheduler_request_time_;
+  base::TimeDelta scheduler_queueing_time_;
   // If DidFinishLoading is called while downloading to a blob before the blob
   // is finished, we might have to defer actually handling the event. This
   // struct is used to store the information needed to refire DidFinishLoading
@@ -6,14 +6,19 @@
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/public/platform/platform.h"
+#include "third_party/blink/renderer/platform/crypto.h"
+#include "third_party/blink/renderer/platform/loader/fetch/integrity_metadata.h"
 #include "third_party/blink/renderer/platform/loader/fetch/memory_cache.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_loader_options.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_request.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_response.h"
+#include "third_party/blink/renderer/platform/loader/subresource_integrity.h"
 #include "third_party/blink/renderer/platform/loader/testing/mock_resource.h"
 #include "third_party/blink/renderer/platform/loader/testing/mock_resource_client.h"
 #include "third_party/blink/renderer/platform/testing/testing_platform_support_with_mock_scheduler.h"
 #include "third_party/blink/renderer/platform/testing/url_test_helpers.h"
 #include "third_party/blink/renderer/platform/wtf/shared_buffer.h"
+#include "third_party/blink/renderer/platform/wtf/text/base64.h"
 #include "third_party/blink/renderer/platform/wtf/vector.h"
 
 namespace blink {
@@ -263,6 +268,56 @@ TEST(ResourceTest, RevalidationFailed) {
   EXPECT_FALSE(resource->IsAlive());
 }
 
+TEST(ResourceTest, PrecomputedIntegrityDigestsAreDroppedWithTheBody) {
+  ScopedTestingPlatformSupport<TestingPlatformSupportWithMockScheduler>
+      platform_;
+  const char kBody[] = "abcd";
+  const char kOtherBody[] = "wxyz";
+  DigestValue digest;
+  ASSERT_TRUE(ComputeDigest(kHashAlgorithmSha256, kBody, 4, digest));
+  SubresourceIntegrity::PrecomputedDigests digests;
+  digests.insert(kHashAlgorithmSha256, digest);
+
+  const KURL url("https://test.example.com/");
+  ResourceLoaderOptions options;
+  options.integrity_metadata.insert(IntegrityMetadataPair(
+      Base64Encode(base::make_span(digest.data(), digest.size())),
+      IntegrityAlgorithm::kSha256));
+  ResourceResponse response(url);
+  response.SetHttpStatusCode(200);
+  response.SetType(network::mojom::FetchResponseType::kBasic);
+
+  auto* resource =
+      MakeGarbageCollected<MockResource>(ResourceRequest(url), options);
+  resource->ResponseReceived(response);
+  resource->AppendBufferedBody(SharedBuffer::Create(kBody, 4), digests);
+  resource->FinishForTest();
+  EXPECT_EQ(ResourceIntegrityDisposition::kPassed,
+            resource->IntegrityDisposition());
+
+  // The digests of |kBody| must not be used to check a different body.
+  auto* cleared_resource =
+      MakeGarbageCollected<MockResource>(ResourceRequest(url), options);
+  cleared_resource->ResponseReceived(response);
+  cleared_resource->AppendBufferedBody(SharedBuffer::Create(kBody, 4),
+                                       digests);
+  cleared_resource->ClearData();
+  cleared_resource->AppendData(kOtherBody, 4);
+  cleared_resource->FinishForTest();
+  EXPECT_EQ(ResourceIntegrityDisposition::kFailed,
+            cleared_resource->IntegrityDisposition());
+
+  auto* appended_resource =
+      MakeGarbageCollected<MockResource>(ResourceRequest(url), options);
+  appended_resource->ResponseReceived(response);
+  appended_resource->AppendBufferedBody(SharedBuffer::Create(kBody, 4),
+                                        digests);
+  appended_resource->AppendData(kOtherBody, 4);
+  appended_resource->FinishForTest();
+  EXPECT_EQ(ResourceIntegrityDisposition::kFailed,
+            appended_resource->IntegrityDisposition());
+}
+
 TEST(ResourceTest, RevalidationSucceeded) {
   ScopedTestingPlatformSupport<TestingPlatformSupportWithMockScheduler>
       platform_;
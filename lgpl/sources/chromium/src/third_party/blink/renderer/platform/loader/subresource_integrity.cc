@@ -72,7 +72,8 @@ bool SubresourceIntegrity::CheckSubresourceIntegrity(
     size_t size,
     const KURL& resource_url,
     const Resource& resource,
-    ReportInfo& report_info) {
+    ReportInfo& report_info,
+    const PrecomputedDigests* precomputed_digests) {
   // FetchResponseType::kError never arrives because it is a loading error.
   DCHECK_NE(resource.GetResponse().GetType(),
             network::mojom::FetchResponseType::kError);
@@ -90,7 +91,8 @@ bool SubresourceIntegrity::CheckSubresourceIntegrity(
 
   return CheckSubresourceIntegrityImpl(
       metadata_set, content, size, resource_url,
-      resource.GetResponse().HttpHeaderField("Integrity"), report_info);
+      resource.GetResponse().HttpHeaderField("Integrity"), report_info,
+      precomputed_digests);
 }
 
 bool SubresourceIntegrity::CheckSubresourceIntegrity(
@@ -111,8 +113,9 @@ bool SubresourceIntegrity::CheckSubresourceIntegrity(
   // TODO(vogelheim): crbug.com/753349, figure out how deal with Ed25519
   //                  checking here.
   String integrity_header;
-  return CheckSubresourceIntegrityImpl(
-      metadata_set, content, size, resource_url, integrity_header, report_info);
+  return CheckSubresourceIntegrityImpl(metadata_set, content, size,
+                                       resource_url, integrity_header,
+                                       report_info, nullptr);
 }
 
 bool SubresourceIntegrity::CheckSubresourceIntegrityImpl(
@@ -121,7 +124,8 @@ bool SubresourceIntegrity::CheckSubresourceIntegrityImpl(
     size_t size,
     const KURL& resource_url,
     const String integrity_header,
-    ReportInfo& report_info) {
+    ReportInfo& report_info,
+    const PrecomputedDigests* precomputed_digests) {
   if (!metadata_set.size())
     return true;
 
@@ -134,7 +138,8 @@ bool SubresourceIntegrity::CheckSubresourceIntegrityImpl(
   }
   for (const IntegrityMetadata& metadata : metadata_set) {
     if (metadata.Algorithm() == max_algorithm &&
-        (*checker)(metadata, content, size, integrity_header)) {
+        (*checker)(metadata, content, size, integrity_header,
+                   precomputed_digests)) {
       report_info.AddUseCount(ReportInfo::UseCounterFeature::
                                   kSRIElementWithMatchingIntegrityAttribute);
       if (report_ed25519) {
@@ -148,7 +153,8 @@ bool SubresourceIntegrity::CheckSubresourceIntegrityImpl(
   // If we arrive here, none of the "strongest" constaints have validated
   // the data we received. Report this fact.
   DigestValue digest;
-  if (ComputeDigest(kHashAlgorithmSha256, content, size, digest)) {
+  if (GetDigest(kHashAlgorithmSha256, content, size, precomputed_digests,
+                digest)) {
     // This message exposes the digest of the resource to the console.
     // Because this is only to the console, that's okay for now, but we
     // need to be very careful not to expose this in exceptions or
@@ -169,6 +175,29 @@ bool SubresourceIntegrity::CheckSubresourceIntegrityImpl(
   return false;
 }
 
+Vector<HashAlgorithm> SubresourceIntegrity::DigestAlgorithmsForCheck(
+    const IntegrityMetadataSet& metadata_set) {
+  Vector<HashAlgorithm> algorithms;
+  if (metadata_set.IsEmpty())
+    return algorithms;
+
+  // Only the strongest algorithm is checked, and a SHA-256 digest is reported
+  // to the console when the check fails.
+  algorithms.push_back(kHashAlgorithmSha256);
+  switch (FindBestAlgorithm(metadata_set)) {
+    case IntegrityAlgorithm::kSha384:
+      algorithms.push_back(kHashAlgorithmSha384);
+      break;
+    case IntegrityAlgorithm::kSha512:
+      algorithms.push_back(kHashAlgorithmSha512);
+      break;
+    case IntegrityAlgorithm::kSha256:
+    case IntegrityAlgorithm::kEd25519:
+      break;
+  }
+  return algorithms;
+}
+
 IntegrityAlgorithm SubresourceIntegrity::FindBestAlgorithm(
     const IntegrityMetadataSet& metadata_set) {
   // Find the "strongest" algorithm in the set. (This relies on
@@ -211,7 +240,8 @@ bool SubresourceIntegrity::CheckSubresourceIntegrityDigest(
     const IntegrityMetadata& metadata,
     const char* content,
     size_t size,
-    const String& integrity_header) {
+    const String& integrity_header,
+    const PrecomputedDigests* precomputed_digests) {
   blink::HashAlgorithm hash_algo = kHashAlgorithmSha256;
   switch (metadata.Algorithm()) {
     case IntegrityAlgorithm::kSha256:
@@ -229,7 +259,7 @@ bool SubresourceIntegrity::CheckSubresourceIntegrityDigest(
   }
 
   DigestValue digest;
-  if (!ComputeDigest(hash_algo, content, size, digest))
+  if (!GetDigest(hash_algo, content, size, precomputed_digests, digest))
     return false;
 
   Vector<char> hash_vector;
@@ -240,11 +270,28 @@ bool SubresourceIntegrity::CheckSubresourceIntegrityDigest(
   return DigestsEqual(digest, converted_hash_vector);
 }
 
+bool SubresourceIntegrity::GetDigest(
+    HashAlgorithm algorithm,
+    const char* content,
+    size_t size,
+    const PrecomputedDigests* precomputed_digests,
+    DigestValue& digest) {
+  if (precomputed_digests) {
+    auto it = precomputed_digests->find(algorithm);
+    if (it != precomputed_digests->end()) {
+      digest = it->value;
+      return true;
+    }
+  }
+  return ComputeDigest(algorithm, content, size, digest);
+}
+
 bool SubresourceIntegrity::CheckSubresourceIntegritySignature(
     const IntegrityMetadata& metadata,
     const char* content,
     size_t size,
-    const String& integrity_header) {
+    const String& integrity_header,
+    const PrecomputedDigests* precomputed_digests) {
   DCHECK_EQ(IntegrityAlgorithm::kEd25519, metadata.Algorithm());
 
   Vector<char> pubkey;
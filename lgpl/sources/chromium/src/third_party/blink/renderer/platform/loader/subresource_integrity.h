@@ -6,9 +6,11 @@
 #define THIRD_PARTY_BLINK_RENDERER_PLATFORM_LOADER_SUBRESOURCE_INTEGRITY_H_
 
 #include "base/gtest_prod_util.h"
+#include "third_party/blink/renderer/platform/crypto.h"
 #include "third_party/blink/renderer/platform/loader/fetch/integrity_metadata.h"
 #include "third_party/blink/renderer/platform/platform_export.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/hash_map.h"
 #include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 #include "third_party/blink/renderer/platform/wtf/vector.h"
 
@@ -59,15 +61,22 @@ class PLATFORM_EXPORT SubresourceIntegrity final {
     kSignatures  // Also support the ed25519 signature scheme.
   };
 
+  // Digests of a resource body computed before the check, e.g. while the body
+  // was being read on a background thread.
+  using PrecomputedDigests = HashMap<HashAlgorithm, DigestValue>;
+
   // The version with the IntegrityMetadataSet passed as the first argument
   // assumes that the integrity attribute has already been parsed, and the
-  // IntegrityMetadataSet represents the result of that parsing.
-  static bool CheckSubresourceIntegrity(const IntegrityMetadataSet&,
-                                        const char* content,
-                                        size_t content_size,
-                                        const KURL& resource_url,
-                                        const Resource&,
-                                        ReportInfo&);
+  // IntegrityMetadataSet represents the result of that parsing. Digests found
+  // in |precomputed_digests| are used instead of hashing |content| again.
+  static bool CheckSubresourceIntegrity(
+      const IntegrityMetadataSet&,
+      const char* content,
+      size_t content_size,
+      const KURL& resource_url,
+      const Resource&,
+      ReportInfo&,
+      const PrecomputedDigests* precomputed_digests = nullptr);
   static bool CheckSubresourceIntegrity(const String&,
                                         IntegrityFeatures,
                                         const char* content,
@@ -75,6 +84,11 @@ class PLATFORM_EXPORT SubresourceIntegrity final {
                                         const KURL& resource_url,
                                         ReportInfo&);
 
+  // Returns the digests CheckSubresourceIntegrity() may compute for
+  // |metadata_set|, so that they can be computed ahead of the check.
+  static Vector<HashAlgorithm> DigestAlgorithmsForCheck(
+      const IntegrityMetadataSet& metadata_set);
+
   // The IntegrityMetadataSet arguments are out parameters which contain the
   // set of all valid, parsed metadata from |attribute|.
   static IntegrityParseResult ParseIntegrityAttribute(
@@ -98,12 +112,14 @@ class PLATFORM_EXPORT SubresourceIntegrity final {
                            GetCheckFunctionForAlgorithm);
 
   // The core implementation for all CheckSubresoureIntegrity functions.
-  static bool CheckSubresourceIntegrityImpl(const IntegrityMetadataSet&,
-                                            const char*,
-                                            size_t,
-                                            const KURL& resource_url,
-                                            const String integrity_header,
-                                            ReportInfo&);
+  static bool CheckSubresourceIntegrityImpl(
+      const IntegrityMetadataSet&,
+      const char*,
+      size_t,
+      const KURL& resource_url,
+      const String integrity_header,
+      ReportInfo&,
+      const PrecomputedDigests* precomputed_digests);
 
   enum AlgorithmParseResult {
     kAlgorithmValid,
@@ -116,18 +132,30 @@ class PLATFORM_EXPORT SubresourceIntegrity final {
   typedef bool (*CheckFunction)(const IntegrityMetadata&,
                                 const char*,
                                 size_t,
-                                const String&);
+                                const String&,
+                                const PrecomputedDigests*);
   static CheckFunction GetCheckFunctionForAlgorithm(IntegrityAlgorithm);
 
-  static bool CheckSubresourceIntegrityDigest(const IntegrityMetadata&,
-                                              const char*,
-                                              size_t,
-                                              const String& integrity_header);
+  static bool CheckSubresourceIntegrityDigest(
+      const IntegrityMetadata&,
+      const char*,
+      size_t,
+      const String& integrity_header,
+      const PrecomputedDigests* precomputed_digests);
   static bool CheckSubresourceIntegritySignature(
       const IntegrityMetadata&,
       const char*,
       size_t,
-      const String& integrity_header);
+      const String& integrity_header,
+      const PrecomputedDigests* precomputed_digests);
+
+  // Looks |algorithm| up in |precomputed_digests| and falls back to hashing
+  // |content|.
+  static bool GetDigest(HashAlgorithm algorithm,
+                        const char* content,
+                        size_t size,
+                        const PrecomputedDigests* precomputed_digests,
+                        DigestValue& digest);
 
   static AlgorithmParseResult ParseAttributeAlgorithm(const UChar*& begin,
                                                       const UChar* end,
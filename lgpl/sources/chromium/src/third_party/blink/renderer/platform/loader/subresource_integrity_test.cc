@@ -620,4 +620,51 @@ TEST_F(SubresourceIntegrityTest, GetCheckFunctionForAlgorithm) {
                   IntegrityAlgorithm::kEd25519));
 }
 
+TEST_F(SubresourceIntegrityTest, DigestAlgorithmsForCheck) {
+  EXPECT_TRUE(
+      SubresourceIntegrity::DigestAlgorithmsForCheck(IntegrityMetadataSet())
+          .IsEmpty());
+  EXPECT_EQ(Vector<HashAlgorithm>({kHashAlgorithmSha256}),
+            SubresourceIntegrity::DigestAlgorithmsForCheck(
+                IntegrityMetadataSet({{"", IntegrityAlgorithm::kSha256}})));
+  EXPECT_EQ(Vector<HashAlgorithm>({kHashAlgorithmSha256, kHashAlgorithmSha384}),
+            SubresourceIntegrity::DigestAlgorithmsForCheck(
+                IntegrityMetadataSet({{"", IntegrityAlgorithm::kSha256},
+                                      {"", IntegrityAlgorithm::kSha384}})));
+  EXPECT_EQ(Vector<HashAlgorithm>({kHashAlgorithmSha256, kHashAlgorithmSha512}),
+            SubresourceIntegrity::DigestAlgorithmsForCheck(
+                IntegrityMetadataSet({{"", IntegrityAlgorithm::kSha512}})));
+}
+
+TEST_F(SubresourceIntegrityTest, PrecomputedDigests) {
+  IntegrityMetadataSet metadata_set;
+  ASSERT_EQ(SubresourceIntegrity::kIntegrityParseValidResult,
+            SubresourceIntegrity::ParseIntegrityAttribute(
+                kSha256Integrity, Features(), metadata_set));
+  Resource* resource = CreateTestResource(
+      sec_url, network::mojom::RequestMode::kNoCors,
+      network::mojom::FetchResponseType::kBasic);
+
+  DigestValue digest;
+  ASSERT_TRUE(ComputeDigest(kHashAlgorithmSha256, kBasicScript,
+                            strlen(kBasicScript), digest));
+  SubresourceIntegrity::PrecomputedDigests precomputed;
+  precomputed.insert(kHashAlgorithmSha256, digest);
+
+  // The precomputed digest is used instead of hashing |content|, which here
+  // doesn't match the integrity metadata on its own.
+  SubresourceIntegrity::ReportInfo report_info;
+  EXPECT_TRUE(SubresourceIntegrity::CheckSubresourceIntegrity(
+      metadata_set, "", 0, sec_url, *resource, report_info, &precomputed));
+  EXPECT_FALSE(SubresourceIntegrity::CheckSubresourceIntegrity(
+      metadata_set, "", 0, sec_url, *resource, report_info));
+
+  // Digests for other algorithms are computed from |content|.
+  SubresourceIntegrity::PrecomputedDigests other_algorithm;
+  other_algorithm.insert(kHashAlgorithmSha384, digest);
+  EXPECT_TRUE(SubresourceIntegrity::CheckSubresourceIntegrity(
+      metadata_set, kBasicScript, strlen(kBasicScript), sec_url, *resource,
+      report_info, &other_algorithm));
+}
+
 }  // namespace blink
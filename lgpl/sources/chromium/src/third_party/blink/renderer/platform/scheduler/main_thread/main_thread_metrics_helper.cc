@@ -189,6 +189,8 @@ void MainThreadMetricsHelper::ResetForTest(base::TimeTicks now) {
           &MainThreadMetricsHelper::RecordForegroundMainThreadTaskLoad,
           base::Unretained(this)),
       kThreadLoadTrackerReportingInterval);
+
+  task_queue_latency_recorder_.Reset();
 }
 
 namespace {
@@ -253,6 +255,10 @@ void MainThreadMetricsHelper::RecordTaskMetrics(
       queue ? queue->queue_type() : MainThreadTaskQueue::QueueType::kDetached;
   base::TimeDelta duration = task_timing.wall_duration();
 
+  task_queue_latency_recorder_.RecordTask(
+      queue_type, static_cast<TaskType>(task.task_type), task.queue_time,
+      task_timing.start_time(), task_timing.end_time());
+
   // Discard anomalously long idle periods.
   if (last_reported_task_ &&
       task_timing.start_time() - last_reported_task_.value() >
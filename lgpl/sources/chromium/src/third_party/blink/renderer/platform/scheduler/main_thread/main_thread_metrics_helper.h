@@ -15,6 +15,7 @@
 #include "third_party/blink/renderer/platform/scheduler/common/metrics_helper.h"
 #include "third_party/blink/renderer/platform/scheduler/common/thread_load_tracker.h"
 #include "third_party/blink/renderer/platform/scheduler/main_thread/main_thread_task_queue.h"
+#include "third_party/blink/renderer/platform/scheduler/main_thread/task_queue_latency_recorder.h"
 #include "third_party/blink/renderer/platform/scheduler/main_thread/use_case.h"
 #include "third_party/blink/renderer/platform/scheduler/public/frame_status.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread_type.h"
@@ -64,6 +65,13 @@ class PLATFORM_EXPORT MainThreadMetricsHelper : public MetricsHelper {
 
   void ResetForTest(base::TimeTicks now);
 
+  const TaskQueueLatencyRecorder& task_queue_latency_recorder() const {
+    return task_queue_latency_recorder_;
+  }
+  TaskQueueLatencyRecorder& task_queue_latency_recorder() {
+    return task_queue_latency_recorder_;
+  }
+
  private:
   using TaskDurationPerQueueTypeMetricReporter =
       scheduling_metrics::TaskDurationMetricReporter<
@@ -151,6 +159,8 @@ class PLATFORM_EXPORT MainThreadMetricsHelper : public MetricsHelper {
 
   MainThreadTaskLoadState main_thread_task_load_state_;
 
+  TaskQueueLatencyRecorder task_queue_latency_recorder_;
+
   base::TimeTicks current_task_slice_start_time_;
 
   // Number of safepoints during inside the current top-level tasks in which
@@ -403,6 +403,29 @@ TEST_F(MainThreadMetricsHelperTest, Metrics_PerUseCase) {
           Bucket(static_cast<int>(UseCase::kMainThreadGesture), 6)));
 }
 
+TEST_F(MainThreadMetricsHelperTest, TaskQueueLatency) {
+  const base::TimeTicks start = Now() + base::TimeDelta::FromSeconds(1);
+  FastForwardTo(start + base::TimeDelta::FromMilliseconds(10));
+  scoped_refptr<MainThreadTaskQueueForTest> queue(
+      new MainThreadTaskQueueForTest(QueueType::kInput));
+  FakeTask task(static_cast<int>(TaskType::kUserInteraction));
+  task.queue_time = start - base::TimeDelta::FromMilliseconds(200);
+  metrics_helper_->RecordTaskMetrics(
+      queue.get(), task,
+      FakeTaskTiming(start, start + base::TimeDelta::FromMilliseconds(10)));
+
+  const TaskQueueLatencyRecorder& recorder =
+      metrics_helper_->task_queue_latency_recorder();
+  const auto& stats = recorder.StatsForQueueType(QueueType::kInput);
+  EXPECT_EQ(1u, stats.run_time.count());
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(10), stats.run_time.total());
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(200),
+            stats.queueing_time.total());
+  EXPECT_EQ(1u, stats.starved_task_count);
+  EXPECT_EQ(1u, recorder.StatsForTaskType(TaskType::kUserInteraction)
+                    .starved_task_count);
+}
+
 TEST_F(MainThreadMetricsHelperTest, GetFrameStatusTest) {
   DCHECK_EQ(GetFrameStatus(nullptr), FrameStatus::kNone);
 
@@ -2106,6 +2106,11 @@ void MainThreadSchedulerImpl::AsValueIntoLocked(
   state->BeginDictionary("task_queue_throttler");
   task_queue_throttler_->AsValueInto(state, optional_now);
   state->EndDictionary();
+
+  state->BeginDictionary("task_queue_latency");
+  main_thread_only().metrics_helper.task_queue_latency_recorder().AsValueInto(
+      state);
+  state->EndDictionary();
 }
 
 bool MainThreadSchedulerImpl::TaskQueuePolicy::IsQueueEnabled(
@@ -2907,6 +2912,19 @@ void MainThreadSchedulerImpl::OnSafepointExited() {
   main_thread_only().metrics_helper.OnSafepointExited(helper_.NowTicks());
 }
 
+String MainThreadSchedulerImpl::GetTaskQueueLatencyStatsAsJSON() const {
+  helper_.CheckOnValidThread();
+  base::trace_event::TracedValueJSON value;
+  main_thread_only().metrics_helper.task_queue_latency_recorder().AsValueInto(
+      &value);
+  return String::FromUTF8(value.ToJSON());
+}
+
+void MainThreadSchedulerImpl::ResetTaskQueueLatencyStats() {
+  helper_.CheckOnValidThread();
+  main_thread_only().metrics_helper.task_queue_latency_recorder().Reset();
+}
+
 void MainThreadSchedulerImpl::ExecuteAfterCurrentTask(
     base::OnceClosure on_completion_task) {
   main_thread_only().on_task_completion_callbacks.push_back(
@@ -0,0 +1,168 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/scheduler/main_thread/task_queue_latency_recorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "base/bits.h"
+#include "base/trace_event/traced_value.h"
+#include "third_party/blink/renderer/platform/scheduler/common/tracing_helper.h"
+#include "third_party/blink/renderer/platform/scheduler/main_thread/task_type_names.h"
+
+namespace blink {
+namespace scheduler {
+
+constexpr size_t TaskQueueLatencyRecorder::kNumberOfBuckets;
+constexpr base::TimeDelta TaskQueueLatencyRecorder::kDefaultStarvationThreshold;
+
+TaskQueueLatencyRecorder::Histogram::Histogram() {
+  buckets_.fill(0);
+}
+
+// static
+size_t TaskQueueLatencyRecorder::Histogram::BucketForSample(
+    base::TimeDelta sample) {
+  int64_t microseconds = sample.InMicroseconds();
+  if (microseconds < 2)
+    return 0;
+  uint32_t clamped = static_cast<uint32_t>(std::min<int64_t>(
+      microseconds, std::numeric_limits<uint32_t>::max()));
+  return std::min<size_t>(base::bits::Log2Floor(clamped),
+                          kNumberOfBuckets - 1);
+}
+
+// static
+base::TimeDelta TaskQueueLatencyRecorder::Histogram::BucketUpperBound(
+    size_t bucket) {
+  DCHECK_LT(bucket, kNumberOfBuckets);
+  return base::TimeDelta::FromMicroseconds(int64_t{1} << (bucket + 1));
+}
+
+void TaskQueueLatencyRecorder::Histogram::Add(base::TimeDelta sample) {
+  ++buckets_[BucketForSample(sample)];
+  ++count_;
+  total_ += sample;
+  max_ = std::max(max_, sample);
+}
+
+base::TimeDelta TaskQueueLatencyRecorder::Histogram::Percentile(
+    double fraction) const {
+  if (!count_)
+    return base::TimeDelta();
+  DCHECK_GE(fraction, 0.0);
+  DCHECK_LE(fraction, 1.0);
+  uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(fraction * count_)));
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < kNumberOfBuckets; ++bucket) {
+    seen += buckets_[bucket];
+    if (seen >= rank)
+      return BucketUpperBound(bucket);
+  }
+  NOTREACHED();
+  return BucketUpperBound(kNumberOfBuckets - 1);
+}
+
+void TaskQueueLatencyRecorder::Histogram::AsValueInto(
+    base::trace_event::TracedValue* state) const {
+  state->SetInteger("count", static_cast<int>(count_));
+  state->SetDouble("total_ms", total_.InMillisecondsF());
+  state->SetDouble("max_ms", max_.InMillisecondsF());
+  state->SetDouble("p50_ms", Percentile(0.5).InMillisecondsF());
+  state->SetDouble("p95_ms", Percentile(0.95).InMillisecondsF());
+  state->SetDouble("p99_ms", Percentile(0.99).InMillisecondsF());
+  // Trailing empty buckets are left out.
+  size_t used_buckets = kNumberOfBuckets;
+  while (used_buckets && !buckets_[used_buckets - 1])
+    --used_buckets;
+  state->BeginArray("buckets");
+  for (size_t bucket = 0; bucket < used_buckets; ++bucket)
+    state->AppendInteger(buckets_[bucket]);
+  state->EndArray();
+}
+
+void TaskQueueLatencyRecorder::Stats::AsValueInto(
+    base::trace_event::TracedValue* state) const {
+  state->BeginDictionary("queueing_time");
+  queueing_time.AsValueInto(state);
+  state->EndDictionary();
+  state->BeginDictionary("run_time");
+  run_time.AsValueInto(state);
+  state->EndDictionary();
+  state->SetInteger("starved_task_count", static_cast<int>(starved_task_count));
+}
+
+TaskQueueLatencyRecorder::TaskQueueLatencyRecorder(
+    base::TimeDelta starvation_threshold)
+    : starvation_threshold_(starvation_threshold) {}
+
+TaskQueueLatencyRecorder::~TaskQueueLatencyRecorder() = default;
+
+void TaskQueueLatencyRecorder::RecordTask(
+    MainThreadTaskQueue::QueueType queue_type,
+    TaskType task_type,
+    base::TimeTicks queue_time,
+    base::TimeTicks start_time,
+    base::TimeTicks end_time) {
+  DCHECK_LE(start_time, end_time);
+  Stats& queue_stats = per_queue_type_[static_cast<size_t>(queue_type)];
+  Stats& task_stats = per_task_type_[static_cast<size_t>(task_type)];
+
+  base::TimeDelta run_time = end_time - start_time;
+  queue_stats.run_time.Add(run_time);
+  task_stats.run_time.Add(run_time);
+
+  if (queue_time.is_null())
+    return;
+  base::TimeDelta queueing_time =
+      std::max(base::TimeDelta(), start_time - queue_time);
+  queue_stats.queueing_time.Add(queueing_time);
+  task_stats.queueing_time.Add(queueing_time);
+
+  if (queueing_time < starvation_threshold_)
+    return;
+  ++queue_stats.starved_task_count;
+  ++task_stats.starved_task_count;
+  TRACE_EVENT_INSTANT2(TracingCategoryName::kInfo, "StarvedTask",
+                       TRACE_EVENT_SCOPE_THREAD, "queue_type",
+                       MainThreadTaskQueue::NameForQueueType(queue_type),
+                       "queueing_time_ms", queueing_time.InMillisecondsF());
+}
+
+void TaskQueueLatencyRecorder::Reset() {
+  per_queue_type_.fill(Stats());
+  per_task_type_.fill(Stats());
+}
+
+void TaskQueueLatencyRecorder::AsValueInto(
+    base::trace_event::TracedValue* state) const {
+  state->SetDouble("starvation_threshold_ms",
+                   starvation_threshold_.InMillisecondsF());
+  state->BeginDictionary("per_queue_type");
+  for (size_t i = 0; i < per_queue_type_.size(); ++i) {
+    if (per_queue_type_[i].IsEmpty())
+      continue;
+    state->BeginDictionary(MainThreadTaskQueue::NameForQueueType(
+        static_cast<MainThreadTaskQueue::QueueType>(i)));
+    per_queue_type_[i].AsValueInto(state);
+    state->EndDictionary();
+  }
+  state->EndDictionary();
+  state->BeginDictionary("per_task_type");
+  for (size_t i = 0; i < per_task_type_.size(); ++i) {
+    if (per_task_type_[i].IsEmpty())
+      continue;
+    state->BeginDictionary(
+        TaskTypeNames::TaskTypeToString(static_cast<TaskType>(i)));
+    per_task_type_[i].AsValueInto(state);
+    state->EndDictionary();
+  }
+  state->EndDictionary();
+}
+
+}  // namespace scheduler
+}  // namespace blink
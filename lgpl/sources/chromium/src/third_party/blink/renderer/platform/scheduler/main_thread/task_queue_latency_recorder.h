@@ -0,0 +1,120 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_SCHEDULER_MAIN_THREAD_TASK_QUEUE_LATENCY_RECORDER_H_
+#define THIRD_PARTY_BLINK_RENDERER_PLATFORM_SCHEDULER_MAIN_THREAD_TASK_QUEUE_LATENCY_RECORDER_H_
+
+#include <array>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "third_party/blink/public/platform/task_type.h"
+#include "third_party/blink/renderer/platform/platform_export.h"
+#include "third_party/blink/renderer/platform/scheduler/main_thread/main_thread_task_queue.h"
+
+namespace base {
+namespace trace_event {
+class TracedValue;
+}  // namespace trace_event
+}  // namespace base
+
+namespace blink {
+namespace scheduler {
+
+// Keeps per-queue-type and per-task-type statistics of how long main thread
+// tasks waited between being posted and starting to run (queueing time), how
+// long they ran, and how many of them were starved, i.e. waited longer than
+// a threshold. Unlike the UMA reporters in MainThreadMetricsHelper these are
+// kept in memory so that they can be inspected in traces and from tests.
+//
+// Recording a task is a handful of additions into fixed-size arrays, cheap
+// enough to be done for every task. Must only be used on the main thread.
+class PLATFORM_EXPORT TaskQueueLatencyRecorder {
+ public:
+  // Histograms use log2 buckets of microseconds: bucket 0 holds durations
+  // below 2us and bucket i holds [2^i, 2^(i+1)) us. The last bucket also holds
+  // everything above 2^kNumberOfBuckets us (~16s).
+  static constexpr size_t kNumberOfBuckets = 24;
+
+  static constexpr base::TimeDelta kDefaultStarvationThreshold =
+      base::TimeDelta::FromMilliseconds(100);
+
+  class PLATFORM_EXPORT Histogram {
+   public:
+    Histogram();
+
+    void Add(base::TimeDelta sample);
+
+    uint64_t count() const { return count_; }
+    base::TimeDelta total() const { return total_; }
+    base::TimeDelta max() const { return max_; }
+    uint32_t bucket_count(size_t bucket) const { return buckets_[bucket]; }
+
+    // Returns the exclusive upper bound of the bucket in which the sample of
+    // rank |fraction| * count() falls; zero when empty.
+    base::TimeDelta Percentile(double fraction) const;
+
+    static size_t BucketForSample(base::TimeDelta sample);
+    static base::TimeDelta BucketUpperBound(size_t bucket);
+
+    void AsValueInto(base::trace_event::TracedValue* state) const;
+
+   private:
+    std::array<uint32_t, kNumberOfBuckets> buckets_;
+    uint64_t count_ = 0;
+    base::TimeDelta total_;
+    base::TimeDelta max_;
+  };
+
+  struct PLATFORM_EXPORT Stats {
+    // Tasks without a queue time (e.g. posted before queue time recording was
+    // enabled) only contribute to |run_time|.
+    Histogram queueing_time;
+    Histogram run_time;
+    uint64_t starved_task_count = 0;
+
+    bool IsEmpty() const { return !run_time.count(); }
+    void AsValueInto(base::trace_event::TracedValue* state) const;
+  };
+
+  explicit TaskQueueLatencyRecorder(
+      base::TimeDelta starvation_threshold = kDefaultStarvationThreshold);
+  ~TaskQueueLatencyRecorder();
+
+  // |queue_time| may be null if it wasn't recorded for the task.
+  void RecordTask(MainThreadTaskQueue::QueueType queue_type,
+                  TaskType task_type,
+                  base::TimeTicks queue_time,
+                  base::TimeTicks start_time,
+                  base::TimeTicks end_time);
+
+  const Stats& StatsForQueueType(
+      MainThreadTaskQueue::QueueType queue_type) const {
+    return per_queue_type_[static_cast<size_t>(queue_type)];
+  }
+  const Stats& StatsForTaskType(TaskType task_type) const {
+    return per_task_type_[static_cast<size_t>(task_type)];
+  }
+
+  base::TimeDelta starvation_threshold() const { return starvation_threshold_; }
+
+  void Reset();
+
+  // Writes the non-empty entries, keyed by queue and task type names.
+  void AsValueInto(base::trace_event::TracedValue* state) const;
+
+ private:
+  const base::TimeDelta starvation_threshold_;
+
+  std::array<Stats, static_cast<size_t>(MainThreadTaskQueue::QueueType::kCount)>
+      per_queue_type_;
+  std::array<Stats, static_cast<size_t>(TaskType::kCount)> per_task_type_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskQueueLatencyRecorder);
+};
+
+}  // namespace scheduler
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_SCHEDULER_MAIN_THREAD_TASK_QUEUE_LATENCY_RECORDER_H_
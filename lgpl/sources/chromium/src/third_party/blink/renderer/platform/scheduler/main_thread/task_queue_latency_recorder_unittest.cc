@@ -0,0 +1,129 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/scheduler/main_thread/task_queue_latency_recorder.h"
+
+#include "base/trace_event/traced_value.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace blink {
+namespace scheduler {
+
+using QueueType = MainThreadTaskQueue::QueueType;
+using Histogram = TaskQueueLatencyRecorder::Histogram;
+
+namespace {
+
+base::TimeDelta Milliseconds(int64_t ms) {
+  return base::TimeDelta::FromMilliseconds(ms);
+}
+
+base::TimeDelta Microseconds(int64_t us) {
+  return base::TimeDelta::FromMicroseconds(us);
+}
+
+}  // namespace
+
+TEST(TaskQueueLatencyRecorderTest, BucketForSample) {
+  EXPECT_EQ(0u, Histogram::BucketForSample(base::TimeDelta()));
+  EXPECT_EQ(0u, Histogram::BucketForSample(Microseconds(1)));
+  EXPECT_EQ(1u, Histogram::BucketForSample(Microseconds(2)));
+  EXPECT_EQ(1u, Histogram::BucketForSample(Microseconds(3)));
+  EXPECT_EQ(10u, Histogram::BucketForSample(Microseconds(1024)));
+  EXPECT_EQ(TaskQueueLatencyRecorder::kNumberOfBuckets - 1,
+            Histogram::BucketForSample(base::TimeDelta::FromMinutes(10)));
+
+  for (size_t bucket = 0; bucket < TaskQueueLatencyRecorder::kNumberOfBuckets;
+       ++bucket) {
+    EXPECT_LT(bucket, Histogram::BucketForSample(
+                          Histogram::BucketUpperBound(bucket)));
+  }
+}
+
+TEST(TaskQueueLatencyRecorderTest, Percentile) {
+  Histogram histogram;
+  EXPECT_EQ(base::TimeDelta(), histogram.Percentile(0.5));
+
+  for (int i = 0; i < 98; ++i)
+    histogram.Add(Microseconds(100));
+  histogram.Add(Milliseconds(10));
+  histogram.Add(Milliseconds(20));
+
+  EXPECT_EQ(100u, histogram.count());
+  EXPECT_EQ(Milliseconds(20), histogram.max());
+  EXPECT_EQ(Microseconds(98 * 100) + Milliseconds(30), histogram.total());
+  EXPECT_EQ(Microseconds(128), histogram.Percentile(0.5));
+  EXPECT_EQ(Microseconds(128), histogram.Percentile(0.95));
+  EXPECT_EQ(Microseconds(16384), histogram.Percentile(0.99));
+  EXPECT_EQ(Microseconds(32768), histogram.Percentile(1.0));
+}
+
+TEST(TaskQueueLatencyRecorderTest, RecordsPerQueueAndTaskType) {
+  TaskQueueLatencyRecorder recorder(Milliseconds(50));
+  base::TimeTicks start = base::TimeTicks() + base::TimeDelta::FromSeconds(1);
+
+  recorder.RecordTask(QueueType::kFrameLoading, TaskType::kNetworking,
+                      start - Milliseconds(10), start, start + Milliseconds(2));
+  recorder.RecordTask(QueueType::kFrameLoading, TaskType::kNetworking,
+                      start - Milliseconds(60), start, start + Milliseconds(1));
+  recorder.RecordTask(QueueType::kInput, TaskType::kUserInteraction,
+                      start - Milliseconds(1), start, start + Milliseconds(4));
+
+  const auto& loading = recorder.StatsForQueueType(QueueType::kFrameLoading);
+  EXPECT_EQ(2u, loading.run_time.count());
+  EXPECT_EQ(Milliseconds(3), loading.run_time.total());
+  EXPECT_EQ(2u, loading.queueing_time.count());
+  EXPECT_EQ(Milliseconds(60), loading.queueing_time.max());
+  EXPECT_EQ(1u, loading.starved_task_count);
+
+  const auto& networking = recorder.StatsForTaskType(TaskType::kNetworking);
+  EXPECT_EQ(2u, networking.run_time.count());
+  EXPECT_EQ(1u, networking.starved_task_count);
+
+  const auto& input = recorder.StatsForQueueType(QueueType::kInput);
+  EXPECT_EQ(1u, input.run_time.count());
+  EXPECT_EQ(0u, input.starved_task_count);
+
+  EXPECT_TRUE(recorder.StatsForQueueType(QueueType::kDefault).IsEmpty());
+
+  recorder.Reset();
+  EXPECT_TRUE(recorder.StatsForQueueType(QueueType::kFrameLoading).IsEmpty());
+  EXPECT_TRUE(recorder.StatsForTaskType(TaskType::kNetworking).IsEmpty());
+  EXPECT_EQ(0u, recorder.StatsForTaskType(TaskType::kNetworking)
+                    .queueing_time.bucket_count(
+                        Histogram::BucketForSample(Milliseconds(10))));
+}
+
+TEST(TaskQueueLatencyRecorderTest, TasksWithoutQueueTime) {
+  TaskQueueLatencyRecorder recorder;
+  base::TimeTicks start = base::TimeTicks() + base::TimeDelta::FromSeconds(1);
+
+  recorder.RecordTask(QueueType::kDefault, TaskType::kInternalDefault,
+                      base::TimeTicks(), start, start + Milliseconds(5));
+
+  const auto& stats = recorder.StatsForQueueType(QueueType::kDefault);
+  EXPECT_EQ(1u, stats.run_time.count());
+  EXPECT_EQ(0u, stats.queueing_time.count());
+  EXPECT_EQ(0u, stats.starved_task_count);
+}
+
+TEST(TaskQueueLatencyRecorderTest, AsValueIntoSkipsEmptyEntries) {
+  TaskQueueLatencyRecorder recorder;
+  base::TimeTicks start = base::TimeTicks() + base::TimeDelta::FromSeconds(1);
+  recorder.RecordTask(QueueType::kInput, TaskType::kUserInteraction,
+                      start - Milliseconds(1), start, start + Milliseconds(1));
+
+  base::trace_event::TracedValueJSON value;
+  recorder.AsValueInto(&value);
+  std::string json = value.ToJSON();
+  EXPECT_NE(std::string::npos,
+            json.find(MainThreadTaskQueue::NameForQueueType(QueueType::kInput)));
+  EXPECT_EQ(std::string::npos,
+            json.find(MainThreadTaskQueue::NameForQueueType(
+                QueueType::kFrameLoading)));
+  EXPECT_NE(std::string::npos, json.find("UserInteraction"));
+}
+
+}  // namespace scheduler
+}  // namespace blink
@@ -14,6 +14,7 @@
 #include "third_party/blink/public/platform/scheduler/web_thread_scheduler.h"
 #include "third_party/blink/renderer/platform/scheduler/public/page_scheduler.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 #include "third_party/blink/renderer/platform/wtf/vector.h"
 
 namespace v8 {
@@ -152,6 +153,13 @@ class PLATFORM_EXPORT ThreadScheduler {
   virtual void OnSafepointEntered() {}
   virtual void OnSafepointExited() {}
 
+  // Returns the per-queue-type and per-task-type queueing time, run time and
+  // starvation statistics collected since the last reset, serialized as JSON,
+  // or an empty string if this scheduler doesn't collect them. Only the main
+  // thread scheduler does.
+  virtual String GetTaskQueueLatencyStatsAsJSON() const { return String(); }
+  virtual void ResetTaskQueueLatencyStats() {}
+
   // Test helpers.
 
   // Return a reference to an underlying main thread WebThreadScheduler object.
@@ -0,0 +1,110 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/scheduler/main_thread/task_queue_latency_recorder.h"
+
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/blink/public/platform/scheduler/test/renderer_scheduler_test_support.h"
+#include "third_party/blink/renderer/platform/testing/unit_test_helpers.h"
+#include "third_party/blink/renderer/platform/timer.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "TaskQueueLatencyRecorder.";
+constexpr char kMetricTrivialTaskCost[] = "trivial_task_cost";
+constexpr char kMetricRecordTaskCost[] = "record_task_cost";
+constexpr char kMetricRecordingOverhead[] = "recording_overhead";
+
+// Recording must not add more than this to the cost of running a task.
+constexpr double kMaxRecordingOverheadPercent = 1;
+
+}  // namespace
+
+// Compares the cost of recording a task in TaskQueueLatencyRecorder with the
+// cost of posting and running a trivial task, which is the lower bound on the
+// work the scheduler does per task.
+class TaskQueueLatencyRecorderPerfTest : public testing::Test {
+ public:
+  void NopTask(TimerBase*) {}
+
+  void RecordStartRunTime(TimerBase*) { run_start_ = base::ThreadTicks::Now(); }
+
+  void RecordEndRunTime(TimerBase*) {
+    run_end_ = base::ThreadTicks::Now();
+    base::RunLoop::QuitCurrentDeprecated();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ThreadTicks run_start_;
+  base::ThreadTicks run_end_;
+};
+
+TEST_F(TaskQueueLatencyRecorderPerfTest, RecordingOverhead) {
+  const int kNumIterations = 10000;
+
+  Vector<std::unique_ptr<TaskRunnerTimer<TaskQueueLatencyRecorderPerfTest>>>
+      timers(kNumIterations);
+  for (int i = 0; i < kNumIterations; i++) {
+    timers[i].reset(new TaskRunnerTimer<TaskQueueLatencyRecorderPerfTest>(
+        scheduler::GetSingleThreadTaskRunnerForTesting(), this,
+        &TaskQueueLatencyRecorderPerfTest::NopTask));
+  }
+  TaskRunnerTimer<TaskQueueLatencyRecorderPerfTest> measure_run_start(
+      scheduler::GetSingleThreadTaskRunnerForTesting(), this,
+      &TaskQueueLatencyRecorderPerfTest::RecordStartRunTime);
+  TaskRunnerTimer<TaskQueueLatencyRecorderPerfTest> measure_run_end(
+      scheduler::GetSingleThreadTaskRunnerForTesting(), this,
+      &TaskQueueLatencyRecorderPerfTest::RecordEndRunTime);
+
+  base::ThreadTicks post_start = base::ThreadTicks::Now();
+  measure_run_start.StartOneShot(base::TimeDelta(), FROM_HERE);
+  for (int i = 0; i < kNumIterations; i++)
+    timers[i]->StartOneShot(base::TimeDelta(), FROM_HERE);
+  measure_run_end.StartOneShot(base::TimeDelta(), FROM_HERE);
+  base::ThreadTicks post_end = base::ThreadTicks::Now();
+
+  test::EnterRunLoop();
+
+  // Spread the samples over queue types, task types and buckets so that the
+  // recorder doesn't only hit a single hot cache line.
+  scheduler::TaskQueueLatencyRecorder recorder;
+  const int kNumQueueTypes =
+      static_cast<int>(scheduler::MainThreadTaskQueue::QueueType::kCount);
+  const int kNumTaskTypes = static_cast<int>(TaskType::kCount);
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::ThreadTicks record_start = base::ThreadTicks::Now();
+  for (int i = 0; i < kNumIterations; i++) {
+    base::TimeTicks start = now + base::TimeDelta::FromMicroseconds(i);
+    recorder.RecordTask(
+        static_cast<scheduler::MainThreadTaskQueue::QueueType>(
+            i % kNumQueueTypes),
+        static_cast<TaskType>(i % kNumTaskTypes),
+        start - base::TimeDelta::FromMicroseconds(i * 37 % 100000), start,
+        start + base::TimeDelta::FromMicroseconds(i * 13 % 5000));
+  }
+  base::ThreadTicks record_end = base::ThreadTicks::Now();
+
+  double task_time = ((post_end - post_start) + (run_end_ - run_start_))
+                         .InMicrosecondsF();
+  double record_time = (record_end - record_start).InMicrosecondsF();
+  double overhead_percent = 100 * record_time / task_time;
+
+  perf_test::PerfResultReporter reporter(kMetricPrefix, "recording_overhead");
+  reporter.RegisterImportantMetric(kMetricTrivialTaskCost, "us");
+  reporter.RegisterImportantMetric(kMetricRecordTaskCost, "us");
+  reporter.RegisterImportantMetric(kMetricRecordingOverhead, "%");
+  reporter.AddResult(kMetricTrivialTaskCost, task_time / kNumIterations);
+  reporter.AddResult(kMetricRecordTaskCost, record_time / kNumIterations);
+  reporter.AddResult(kMetricRecordingOverhead, overhead_percent);
+  EXPECT_LT(overhead_percent, kMaxRecordingOverheadPercent);
+}
+
+}  // namespace blink
@@ -0,0 +1,95 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/time/time.h"
+#include "base/timer/lap_timer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/blink/renderer/platform/geometry/int_rect.h"
+#include "third_party/blink/renderer/platform/geometry/int_size.h"
+#include "third_party/blink/renderer/platform/graphics/gpu/webgl_image_conversion.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+namespace {
+
+constexpr int kTimeLimitMillis = 3000;
+constexpr int kWarmupRuns = 5;
+constexpr int kTimeCheckInterval = 1;
+
+// A 4K video frame.
+constexpr int kWidth = 3840;
+constexpr int kHeight = 2160;
+
+constexpr char kMetricPrefix[] = "WebGLImageConversion.";
+constexpr char kMetricThroughput[] = "throughput";
+
+}  // namespace
+
+// Measures the CPU side of texImage2D() for full frames, i.e. the conversion
+// into the upload buffer, without a GPU.
+class WebGLImageConversionPerfTest : public testing::Test {
+ protected:
+  WebGLImageConversionPerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {
+    source_data_.resize(kWidth * kHeight * 4);
+    for (wtf_size_t i = 0; i < source_data_.size(); ++i)
+      source_data_[i] = static_cast<uint8_t>(i * 7 + i / 4);
+  }
+
+  void ExtractImageData(WebGLImageConversion::DataFormat source_format,
+                        bool flip_y,
+                        bool premultiply_alpha,
+                        const std::string& story) {
+    Vector<uint8_t> data;
+    timer_.Reset();
+    do {
+      ASSERT_TRUE(WebGLImageConversion::ExtractImageData(
+          source_data_.data(), source_format, IntSize(kWidth, kHeight),
+          IntRect(0, 0, kWidth, kHeight), 1, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+          flip_y, premultiply_alpha, data));
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricThroughput, "MB/s");
+    reporter.AddResult(kMetricThroughput,
+                       timer_.LapsPerSecond() * source_data_.size() / 1e6);
+  }
+
+  base::LapTimer timer_;
+  Vector<uint8_t> source_data_;
+};
+
+TEST_F(WebGLImageConversionPerfTest, RGBA8FlipY) {
+  ExtractImageData(WebGLImageConversion::kDataFormatRGBA8, true, false,
+                   "RGBA8_flipY");
+}
+
+TEST_F(WebGLImageConversionPerfTest, RGBA8Premultiply) {
+  ExtractImageData(WebGLImageConversion::kDataFormatRGBA8, false, true,
+                   "RGBA8_premultiply");
+}
+
+TEST_F(WebGLImageConversionPerfTest, RGBA8PremultiplyFlipY) {
+  ExtractImageData(WebGLImageConversion::kDataFormatRGBA8, true, true,
+                   "RGBA8_premultiply_flipY");
+}
+
+TEST_F(WebGLImageConversionPerfTest, BGRA8ToRGBA8) {
+  ExtractImageData(WebGLImageConversion::kDataFormatBGRA8, false, false,
+                   "BGRA8");
+}
+
+TEST_F(WebGLImageConversionPerfTest, BGRA8ToRGBA8PremultiplyFlipY) {
+  ExtractImageData(WebGLImageConversion::kDataFormatBGRA8, true, true,
+                   "BGRA8_premultiply_flipY");
+}
+
+}  // namespace blink
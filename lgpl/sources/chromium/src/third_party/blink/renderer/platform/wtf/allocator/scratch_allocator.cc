@@ -0,0 +1,31 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/wtf/allocator/scratch_allocator.h"
+
+#include "third_party/blink/renderer/platform/wtf/allocator/partitions.h"
+
+namespace WTF {
+
+void* ScratchAllocator::AllocateBacking(size_t size, const char* type_name) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  if (void* result = arena.Allocate(size))
+    return result;
+  if (arena.IsActive())
+    arena.RecordFallback(size);
+  return Partitions::BufferMalloc(size, type_name);
+}
+
+void ScratchAllocator::FreeBacking(void* address) {
+  if (!address)
+    return;
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  if (arena.Contains(address)) {
+    arena.Free(address);
+    return;
+  }
+  Partitions::BufferFree(address);
+}
+
+}  // namespace WTF
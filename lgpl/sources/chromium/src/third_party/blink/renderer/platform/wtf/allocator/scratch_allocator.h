@@ -0,0 +1,64 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_ALLOCATOR_SCRATCH_ALLOCATOR_H_
+#define THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_ALLOCATOR_SCRATCH_ALLOCATOR_H_
+
+// Allocator for the backing stores of transient, off-heap collections. While a
+// ScratchArena::PhaseScope is active on the current thread, backings are
+// bump-allocated from the thread's ScratchArena; otherwise this behaves exactly
+// like PartitionAllocator. The collection objects themselves are still
+// allocated by PartitionAllocator.
+//
+// Only use this for collections that are created and destroyed within a single
+// lifecycle phase, e.g. members of stack-allocated builders and resolvers.
+
+#include <string.h>
+
+#include "third_party/blink/renderer/platform/wtf/allocator/partition_allocator.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/scratch_arena.h"
+#include "third_party/blink/renderer/platform/wtf/wtf_export.h"
+
+namespace WTF {
+
+class WTF_EXPORT ScratchAllocator : public PartitionAllocator {
+ public:
+  template <typename T>
+  static T* AllocateVectorBacking(size_t size) {
+    return reinterpret_cast<T*>(
+        AllocateBacking(size, WTF_HEAP_PROFILER_TYPE_NAME(T)));
+  }
+  static void FreeVectorBacking(void* address) { FreeBacking(address); }
+  static inline bool ShrinkVectorBacking(void* address,
+                                         size_t quantized_current_size,
+                                         size_t quantized_shrunk_size) {
+    // Shrinking in place is always fine for arena backings; the slack is
+    // reclaimed when the phase ends.
+    return quantized_current_size == quantized_shrunk_size ||
+           ScratchArena::ForCurrentThread().Contains(address);
+  }
+
+  template <typename T, typename HashTable>
+  static T* AllocateHashTableBacking(size_t size) {
+    return reinterpret_cast<T*>(
+        AllocateBacking(size, WTF_HEAP_PROFILER_TYPE_NAME(T)));
+  }
+  template <typename T, typename HashTable>
+  static T* AllocateZeroedHashTableBacking(size_t size) {
+    void* result = AllocateBacking(size, WTF_HEAP_PROFILER_TYPE_NAME(T));
+    memset(result, 0, size);
+    return reinterpret_cast<T*>(result);
+  }
+  static void FreeHashTableBacking(void* address) { FreeBacking(address); }
+
+ private:
+  static void* AllocateBacking(size_t, const char* type_name);
+  static void FreeBacking(void* address);
+};
+
+}  // namespace WTF
+
+using WTF::ScratchAllocator;
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_ALLOCATOR_SCRATCH_ALLOCATOR_H_
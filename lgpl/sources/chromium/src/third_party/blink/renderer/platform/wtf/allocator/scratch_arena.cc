@@ -0,0 +1,264 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/wtf/allocator/scratch_arena.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+#include "base/memory/aligned_memory.h"
+#include "base/metrics/histogram_macros.h"
+#include "third_party/blink/renderer/platform/wtf/assertions.h"
+#include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
+#include "third_party/blink/renderer/platform/wtf/thread_specific.h"
+
+namespace WTF {
+
+namespace {
+
+// Number of chunks kept around between phases. Anything above this is
+// returned to PartitionAlloc when the arena is reset, so that a single
+// pathological phase doesn't pin memory forever.
+constexpr size_t kRetainedChunks = 4;
+
+size_t AlignUp(size_t size) {
+  return (size + ScratchArena::kAlignment - 1) &
+         ~(ScratchArena::kAlignment - 1);
+}
+
+}  // namespace
+
+struct ScratchArena::Chunk {
+  USING_FAST_MALLOC(Chunk);
+
+ public:
+  Chunk()
+      : base(static_cast<uint8_t*>(
+            base::AlignedAlloc(kChunkSize, /* alignment = */ kChunkSize))) {}
+  ~Chunk() { base::AlignedFree(base); }
+
+  uint8_t* const base;
+  size_t offset = 0;
+  // Number of backings in this chunk that haven't been freed.
+  size_t live_allocations = 0;
+  Chunk* next = nullptr;
+};
+
+// Precedes every backing handed out by the arena.
+struct ScratchArena::AllocationHeader {
+  Chunk* chunk;
+  uint64_t generation;
+};
+
+// static
+ScratchArena::AllocationHeader* ScratchArena::HeaderFor(void* address) {
+  static_assert(sizeof(AllocationHeader) <= kHeaderSize,
+                "kHeaderSize must hold an AllocationHeader");
+  return reinterpret_cast<AllocationHeader*>(static_cast<uint8_t*>(address) -
+                                             kHeaderSize);
+}
+
+// static
+uintptr_t ScratchArena::ChunkAddressFor(const void* address) {
+  static_assert((kChunkSize & (kChunkSize - 1)) == 0,
+                "kChunkSize must be a power of two");
+  return reinterpret_cast<uintptr_t>(address) & ~(kChunkSize - 1);
+}
+
+// static
+ScratchArena& ScratchArena::ForCurrentThread() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(ThreadSpecific<ScratchArena>, arena, ());
+  return *arena;
+}
+
+ScratchArena::ScratchArena() = default;
+
+ScratchArena::~ScratchArena() {
+  DCHECK(!IsActive());
+  for (Chunk* list : {first_chunk_, orphaned_chunks_}) {
+    for (Chunk* chunk = list; chunk;) {
+      Chunk* next = chunk->next;
+      delete chunk;
+      chunk = next;
+    }
+  }
+}
+
+ScratchArena::PhaseScope::PhaseScope(Phase phase)
+    : arena_(ScratchArena::ForCurrentThread()),
+      previous_phase_(arena_.CurrentPhase()) {
+  arena_.EnterPhase(phase);
+}
+
+ScratchArena::PhaseScope::~PhaseScope() {
+  arena_.LeavePhase(previous_phase_);
+}
+
+void ScratchArena::EnterPhase(Phase phase) {
+  ++scope_depth_;
+  phase_ = phase;
+}
+
+void ScratchArena::LeavePhase(Phase previous) {
+  DCHECK(IsActive());
+  if (--scope_depth_ == 0)
+    Reset();
+  phase_ = previous;
+}
+
+void ScratchArena::Reset() {
+  CurrentStats().resets++;
+  size_t outlived_allocations = live_allocations_;
+  CurrentStats().outlived_allocations += outlived_allocations;
+  RecordPhaseHistograms(outlived_allocations);
+
+  // Chunks with live backings in them leave the arena, so that the next phase
+  // can't hand out their memory again. The rest are reused, up to
+  // kRetainedChunks.
+  size_t kept = 0;
+  Chunk* last_kept = nullptr;
+  for (Chunk* chunk = first_chunk_; chunk;) {
+    Chunk* next = chunk->next;
+    chunk->next = nullptr;
+    if (chunk->live_allocations) {
+      chunk->next = orphaned_chunks_;
+      orphaned_chunks_ = chunk;
+      ++orphaned_chunk_count_;
+      --chunk_count_;
+    } else if (kept < kRetainedChunks) {
+      chunk->offset = 0;
+      if (last_kept)
+        last_kept->next = chunk;
+      else
+        first_chunk_ = chunk;
+      last_kept = chunk;
+      ++kept;
+    } else {
+      DeleteChunk(chunk);
+      --chunk_count_;
+    }
+    chunk = next;
+  }
+  if (!last_kept)
+    first_chunk_ = nullptr;
+  current_chunk_ = first_chunk_;
+  last_allocation_ = nullptr;
+  bytes_in_use_ = 0;
+  phase_peak_bytes_in_use_ = 0;
+  live_allocations_ = 0;
+  ++generation_;
+}
+
+void ScratchArena::RecordPhaseHistograms(size_t outlived_allocations) const {
+  if (!phase_peak_bytes_in_use_ && !outlived_allocations)
+    return;
+  UMA_HISTOGRAM_COUNTS_1M("Blink.ScratchArena.PeakBytesInUse",
+                          phase_peak_bytes_in_use_);
+  UMA_HISTOGRAM_COUNTS_1000("Blink.ScratchArena.OutlivedAllocations",
+                            outlived_allocations);
+}
+
+void ScratchArena::ReleaseOrphanedChunk(Chunk* chunk) {
+  DCHECK(!chunk->live_allocations);
+  Chunk** link = &orphaned_chunks_;
+  while (*link != chunk) {
+    DCHECK(*link);
+    link = &(*link)->next;
+  }
+  *link = chunk->next;
+  --orphaned_chunk_count_;
+  DeleteChunk(chunk);
+}
+
+ScratchArena::Chunk* ScratchArena::NewChunk() {
+  Chunk* chunk = new Chunk();
+  chunk_addresses_.insert(reinterpret_cast<uintptr_t>(chunk->base));
+  ++chunk_count_;
+  if (current_chunk_) {
+    chunk->next = current_chunk_->next;
+    current_chunk_->next = chunk;
+  } else {
+    first_chunk_ = chunk;
+  }
+  return chunk;
+}
+
+void ScratchArena::DeleteChunk(Chunk* chunk) {
+  chunk_addresses_.erase(reinterpret_cast<uintptr_t>(chunk->base));
+  delete chunk;
+}
+
+void* ScratchArena::Allocate(size_t size) {
+  if (!IsActive() || size > kMaxScratchAllocationSize)
+    return nullptr;
+
+  size = AlignUp(size);
+  size_t size_with_header = size + kHeaderSize;
+  if (!current_chunk_)
+    current_chunk_ = NewChunk();
+  if (current_chunk_->offset + size_with_header > kChunkSize) {
+    current_chunk_ = current_chunk_->next ? current_chunk_->next : NewChunk();
+    DCHECK_EQ(0u, current_chunk_->offset);
+  }
+
+  auto* header = reinterpret_cast<AllocationHeader*>(current_chunk_->base +
+                                                     current_chunk_->offset);
+  header->chunk = current_chunk_;
+  header->generation = generation_;
+  uint8_t* result = reinterpret_cast<uint8_t*>(header) + kHeaderSize;
+  current_chunk_->offset += size_with_header;
+  current_chunk_->live_allocations++;
+  last_allocation_ = result;
+  bytes_in_use_ += size_with_header;
+  phase_peak_bytes_in_use_ =
+      std::max(phase_peak_bytes_in_use_, bytes_in_use_);
+  ++live_allocations_;
+
+  Stats& stats = CurrentStats();
+  stats.arena_allocations++;
+  stats.arena_bytes += size;
+  stats.peak_bytes_in_use = std::max(stats.peak_bytes_in_use, bytes_in_use_);
+  return result;
+}
+
+void ScratchArena::Free(void* address) {
+  DCHECK(Contains(address));
+  AllocationHeader* header = HeaderFor(address);
+  Chunk* chunk = header->chunk;
+  CHECK_GT(chunk->live_allocations, 0u);
+  --chunk->live_allocations;
+
+  if (header->generation != generation_) {
+    // The backing outlived its phase. Its chunk was taken out of the arena at
+    // reset and goes away with its last backing.
+    if (!chunk->live_allocations)
+      ReleaseOrphanedChunk(chunk);
+    return;
+  }
+
+  DCHECK_GT(live_allocations_, 0u);
+  --live_allocations_;
+  // Growing a container frees its previous backing right after allocating the
+  // new one, so only the most recent allocation can be rolled back cheaply.
+  if (address != last_allocation_)
+    return;
+  DCHECK_EQ(chunk, current_chunk_);
+  uint8_t* start = reinterpret_cast<uint8_t*>(header);
+  size_t freed = chunk->base + chunk->offset - start;
+  chunk->offset -= freed;
+  bytes_in_use_ -= freed;
+  last_allocation_ = nullptr;
+}
+
+bool ScratchArena::Contains(const void* address) const {
+  return chunk_addresses_.Contains(ChunkAddressFor(address));
+}
+
+void ScratchArena::RecordFallback(size_t size) {
+  Stats& stats = CurrentStats();
+  stats.fallback_allocations++;
+  stats.fallback_bytes += size;
+}
+
+}  // namespace WTF
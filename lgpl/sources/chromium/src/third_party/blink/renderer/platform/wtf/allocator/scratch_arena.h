@@ -0,0 +1,165 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_ALLOCATOR_SCRATCH_ARENA_H_
+#define THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_ALLOCATOR_SCRATCH_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/macros.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/hash_set.h"
+#include "third_party/blink/renderer/platform/wtf/wtf_export.h"
+
+namespace WTF {
+
+// A per-thread bump allocator for backing stores of containers that only live
+// for the duration of a single lifecycle phase (style recalc, layout, ...).
+//
+// The arena is only active while a ScratchArena::PhaseScope is on the stack.
+// Allocations made through ScratchAllocator outside of a scope, or larger
+// than kMaxScratchAllocationSize, fall back to PartitionAlloc. When the
+// outermost PhaseScope is left, the arena is reset and its chunks are reused
+// by the next phase.
+//
+// Containers allocated from the arena are not supposed to outlive the phase,
+// but one that does, e.g. because it was created before the phase and grown
+// during it, stays valid: every backing is tagged with the phase generation
+// and its chunk, and a chunk that still holds live backings at reset is taken
+// out of the arena instead of being reused. It is released once its last
+// backing is freed. Such backings are counted in Stats::outlived_allocations.
+//
+// The memory of a freed backing is only reclaimed if it was the most recent
+// allocation; everything else is reclaimed when the phase ends.
+class WTF_EXPORT ScratchArena final {
+  USING_FAST_MALLOC(ScratchArena);
+
+ public:
+  enum class Phase {
+    kStyle,
+    kLayout,
+    kOther,
+  };
+  static constexpr size_t kPhaseCount = static_cast<size_t>(Phase::kOther) + 1;
+
+  // Per-phase allocation counters. They are cumulative for the lifetime of
+  // the thread and can be compared before and after a phase to measure how
+  // many allocations were kept off the general allocator.
+  struct Stats {
+    size_t arena_allocations = 0;
+    size_t arena_bytes = 0;
+    size_t fallback_allocations = 0;
+    size_t fallback_bytes = 0;
+    size_t peak_bytes_in_use = 0;
+    size_t resets = 0;
+    size_t outlived_allocations = 0;
+  };
+
+  // Enters |phase| on the current thread's arena. Scopes nest; allocations
+  // are attributed to the innermost phase and the arena is reset only when
+  // the outermost scope exits.
+  class WTF_EXPORT PhaseScope final {
+    STACK_ALLOCATED();
+
+   public:
+    explicit PhaseScope(Phase);
+    ~PhaseScope();
+
+   private:
+    ScratchArena& arena_;
+    Phase previous_phase_;
+
+    DISALLOW_COPY_AND_ASSIGN(PhaseScope);
+  };
+
+  // Chunks are aligned to their size, so that the chunk an address belongs to
+  // is found by masking it.
+  static constexpr size_t kChunkSize = 64 * 1024;
+  static constexpr size_t kMaxScratchAllocationSize = kChunkSize / 4;
+  static constexpr size_t kAlignment = 16;
+
+  static ScratchArena& ForCurrentThread();
+
+  ScratchArena();
+  ~ScratchArena();
+
+  bool IsActive() const { return scope_depth_ > 0; }
+  Phase CurrentPhase() const { return phase_; }
+
+  // Returns nullptr if the allocation can't be served from the arena; the
+  // caller is responsible for falling back to another allocator in that case.
+  void* Allocate(size_t size);
+  // |address| must have been returned by Allocate().
+  void Free(void* address);
+  // Constant time; this is checked on every free of a ScratchAllocator
+  // backing.
+  bool Contains(const void* address) const;
+
+  // Accounts an allocation that was served by the fallback allocator.
+  void RecordFallback(size_t size);
+
+  const Stats& GetStats(Phase phase) const {
+    return stats_[static_cast<size_t>(phase)];
+  }
+  size_t BytesInUse() const { return bytes_in_use_; }
+  size_t LiveAllocations() const { return live_allocations_; }
+  size_t ChunkCount() const { return chunk_count_; }
+  // Number of chunks taken out of the arena because backings in them outlived
+  // their phase, and not released yet.
+  size_t OrphanedChunkCount() const { return orphaned_chunk_count_; }
+
+ private:
+  struct Chunk;
+  struct AllocationHeader;
+
+  // Space reserved for the AllocationHeader in front of every backing.
+  static constexpr size_t kHeaderSize = kAlignment;
+
+  static AllocationHeader* HeaderFor(void* address);
+  static uintptr_t ChunkAddressFor(const void* address);
+
+  void EnterPhase(Phase);
+  void LeavePhase(Phase previous);
+  void Reset();
+  Chunk* NewChunk();
+  void DeleteChunk(Chunk*);
+  void ReleaseOrphanedChunk(Chunk*);
+  void RecordPhaseHistograms(size_t outlived_allocations) const;
+  Stats& CurrentStats() { return stats_[static_cast<size_t>(phase_)]; }
+
+  // Chunks form a singly linked list; |current_chunk_| is the one being
+  // bumped. Chunks past |current_chunk_| are empty and kept for reuse.
+  Chunk* first_chunk_ = nullptr;
+  Chunk* current_chunk_ = nullptr;
+  size_t chunk_count_ = 0;
+
+  // Chunks that held live backings when the arena was reset. They are never
+  // bumped again.
+  Chunk* orphaned_chunks_ = nullptr;
+  size_t orphaned_chunk_count_ = 0;
+
+  // Start addresses of all chunks above, in the arena or orphaned.
+  HashSet<uintptr_t> chunk_addresses_;
+
+  // Incremented on every reset; backings from an earlier generation are stale.
+  uint64_t generation_ = 0;
+
+  uint8_t* last_allocation_ = nullptr;
+  size_t bytes_in_use_ = 0;
+  size_t phase_peak_bytes_in_use_ = 0;
+  size_t live_allocations_ = 0;
+
+  unsigned scope_depth_ = 0;
+  Phase phase_ = Phase::kOther;
+  Stats stats_[kPhaseCount];
+
+  DISALLOW_COPY_AND_ASSIGN(ScratchArena);
+};
+
+}  // namespace WTF
+
+using WTF::ScratchArena;
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_ALLOCATOR_SCRATCH_ARENA_H_
@@ -0,0 +1,210 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/wtf/allocator/scratch_arena.h"
+
+#include <string.h>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/scratch_allocator.h"
+#include "third_party/blink/renderer/platform/wtf/hash_map.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace WTF {
+
+namespace {
+
+using ScratchVector = Vector<int, 0, ScratchAllocator>;
+using ScratchHashMap =
+    HashMap<int, int, IntHash<int>, HashTraits<int>, HashTraits<int>,
+            ScratchAllocator>;
+
+}  // namespace
+
+TEST(ScratchArenaTest, InactiveArenaFallsBackToPartitionAlloc) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  ASSERT_FALSE(arena.IsActive());
+  size_t allocations_before =
+      arena.GetStats(ScratchArena::Phase::kOther).arena_allocations;
+
+  ScratchVector vector;
+  vector.push_back(1);
+  EXPECT_FALSE(arena.Contains(vector.data()));
+  EXPECT_EQ(allocations_before,
+            arena.GetStats(ScratchArena::Phase::kOther).arena_allocations);
+}
+
+TEST(ScratchArenaTest, VectorBackingComesFromArena) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  ScratchArena::PhaseScope scope(ScratchArena::Phase::kLayout);
+  size_t allocations_before =
+      arena.GetStats(ScratchArena::Phase::kLayout).arena_allocations;
+  {
+    ScratchVector vector;
+    for (int i = 0; i < 100; ++i)
+      vector.push_back(i);
+    EXPECT_TRUE(arena.Contains(vector.data()));
+    for (int i = 0; i < 100; ++i)
+      EXPECT_EQ(i, vector[i]);
+    EXPECT_EQ(1u, arena.LiveAllocations());
+  }
+  EXPECT_EQ(0u, arena.LiveAllocations());
+  EXPECT_GT(arena.GetStats(ScratchArena::Phase::kLayout).arena_allocations,
+            allocations_before);
+}
+
+TEST(ScratchArenaTest, HashMapBackingComesFromArena) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  ScratchArena::PhaseScope scope(ScratchArena::Phase::kStyle);
+  ScratchHashMap map;
+  for (int i = 1; i <= 1000; ++i)
+    map.insert(i, i * 2);
+  EXPECT_EQ(1000u, map.size());
+  for (int i = 1; i <= 1000; ++i)
+    EXPECT_EQ(i * 2, map.at(i));
+  EXPECT_GT(arena.GetStats(ScratchArena::Phase::kStyle).arena_allocations,
+            0u);
+}
+
+TEST(ScratchArenaTest, FreeingLastAllocationReclaimsSpace) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  ScratchArena::PhaseScope scope(ScratchArena::Phase::kOther);
+  size_t in_use_before = arena.BytesInUse();
+  void* first = arena.Allocate(64);
+  ASSERT_TRUE(first);
+  EXPECT_GE(arena.BytesInUse(), in_use_before + 64);
+  arena.Free(first);
+  EXPECT_EQ(in_use_before, arena.BytesInUse());
+  void* second = arena.Allocate(32);
+  EXPECT_EQ(first, second);
+  arena.Free(second);
+}
+
+TEST(ScratchArenaTest, LargeAllocationsFallBack) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  ScratchArena::PhaseScope scope(ScratchArena::Phase::kLayout);
+  size_t fallbacks_before =
+      arena.GetStats(ScratchArena::Phase::kLayout).fallback_allocations;
+  ScratchVector vector;
+  vector.ReserveInitialCapacity(ScratchArena::kMaxScratchAllocationSize);
+  EXPECT_FALSE(arena.Contains(vector.data()));
+  EXPECT_EQ(fallbacks_before + 1,
+            arena.GetStats(ScratchArena::Phase::kLayout).fallback_allocations);
+}
+
+TEST(ScratchArenaTest, NestedScopesResetOnlyWhenOutermostExits) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  size_t resets_before =
+      arena.GetStats(ScratchArena::Phase::kStyle).resets;
+  {
+    ScratchArena::PhaseScope style_scope(ScratchArena::Phase::kStyle);
+    {
+      ScratchArena::PhaseScope layout_scope(ScratchArena::Phase::kLayout);
+      EXPECT_EQ(ScratchArena::Phase::kLayout, arena.CurrentPhase());
+    }
+    EXPECT_TRUE(arena.IsActive());
+    EXPECT_EQ(ScratchArena::Phase::kStyle, arena.CurrentPhase());
+    ScratchVector vector;
+    vector.push_back(42);
+    EXPECT_GT(arena.BytesInUse(), 0u);
+  }
+  EXPECT_FALSE(arena.IsActive());
+  EXPECT_EQ(0u, arena.BytesInUse());
+  EXPECT_EQ(resets_before + 1,
+            arena.GetStats(ScratchArena::Phase::kStyle).resets);
+}
+
+TEST(ScratchArenaTest, GrowsAcrossChunks) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  ScratchArena::PhaseScope scope(ScratchArena::Phase::kLayout);
+  Vector<void*> allocations;
+  size_t count = 2 * ScratchArena::kChunkSize / 256;
+  for (size_t i = 0; i < count; ++i) {
+    void* ptr = arena.Allocate(256);
+    ASSERT_TRUE(ptr);
+    allocations.push_back(ptr);
+  }
+  EXPECT_GE(arena.ChunkCount(), 2u);
+  for (void* ptr : allocations)
+    EXPECT_TRUE(arena.Contains(ptr));
+  for (auto it = allocations.rbegin(); it != allocations.rend(); ++it)
+    arena.Free(*it);
+}
+
+TEST(ScratchArenaTest, ContainsChecksChunkBounds) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  ScratchArena::PhaseScope scope(ScratchArena::Phase::kLayout);
+  uint8_t* ptr = static_cast<uint8_t*>(arena.Allocate(64));
+  ASSERT_TRUE(ptr);
+  uint8_t* chunk_start = reinterpret_cast<uint8_t*>(
+      reinterpret_cast<uintptr_t>(ptr) & ~(ScratchArena::kChunkSize - 1));
+  EXPECT_TRUE(arena.Contains(chunk_start));
+  EXPECT_TRUE(arena.Contains(chunk_start + ScratchArena::kChunkSize - 1));
+  EXPECT_FALSE(arena.Contains(chunk_start - 1));
+  EXPECT_FALSE(arena.Contains(chunk_start + ScratchArena::kChunkSize));
+  arena.Free(ptr);
+}
+
+TEST(ScratchArenaTest, BackingOutlivingPhaseIsNotReused) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  size_t outlived_before =
+      arena.GetStats(ScratchArena::Phase::kLayout).outlived_allocations;
+  void* outlived;
+  {
+    ScratchArena::PhaseScope scope(ScratchArena::Phase::kLayout);
+    outlived = arena.Allocate(64);
+    ASSERT_TRUE(outlived);
+    memset(outlived, 0xab, 64);
+  }
+  EXPECT_EQ(outlived_before + 1,
+            arena.GetStats(ScratchArena::Phase::kLayout).outlived_allocations);
+  EXPECT_EQ(1u, arena.OrphanedChunkCount());
+  EXPECT_TRUE(arena.Contains(outlived));
+
+  {
+    // The next phase must not hand out the outlived backing's memory.
+    ScratchArena::PhaseScope scope(ScratchArena::Phase::kLayout);
+    void* next = arena.Allocate(64);
+    ASSERT_TRUE(next);
+    memset(next, 0xcd, 64);
+    for (int i = 0; i < 64; ++i)
+      EXPECT_EQ(0xab, static_cast<uint8_t*>(outlived)[i]);
+
+    // Freeing the stale backing doesn't affect the current phase.
+    arena.Free(outlived);
+    EXPECT_EQ(1u, arena.LiveAllocations());
+    EXPECT_EQ(0u, arena.OrphanedChunkCount());
+    arena.Free(next);
+    EXPECT_EQ(0u, arena.LiveAllocations());
+  }
+}
+
+TEST(ScratchArenaTest, ContainerCreatedBeforePhaseSurvivesIt) {
+  ScratchArena& arena = ScratchArena::ForCurrentThread();
+  ScratchVector vector;
+  vector.push_back(0);
+  {
+    ScratchArena::PhaseScope scope(ScratchArena::Phase::kStyle);
+    for (int i = 1; i < 100; ++i)
+      vector.push_back(i);
+  }
+  {
+    // Another phase allocating over the same chunks must not clobber it.
+    ScratchArena::PhaseScope scope(ScratchArena::Phase::kStyle);
+    ScratchVector other;
+    for (int i = 0; i < 100; ++i)
+      other.push_back(-1);
+    for (int i = 0; i < 100; ++i)
+      EXPECT_EQ(i, vector[i]);
+  }
+  // Growing outside of a phase moves the backing out of the arena.
+  for (int i = 100; i < 1000; ++i)
+    vector.push_back(i);
+  EXPECT_FALSE(arena.Contains(vector.data()));
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, vector[i]);
+  EXPECT_EQ(0u, arena.OrphanedChunkCount());
+}
+
+}  // namespace WTF